@@ -11,6 +11,9 @@ namespace Angazi
 		uint32_t windowHeight = 720;
 		bool escapeToQuit = true;
 		bool maximizeWindow = false;
+		std::filesystem::path profileCapturePath; // if set, the profiler events are saved here as a Chrome trace on exit
+		std::filesystem::path logFilePath; // if set, the log is also written to this file
+		uint32_t jobWorkerCount = 0; // 0 = one worker per hardware thread, minus the main thread
 	};
 
 	class App
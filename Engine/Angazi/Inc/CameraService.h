@@ -7,7 +7,7 @@ namespace Angazi
 	class CameraService : public Service
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(CameraService);
 
 		void Initialize() override;
 		void ShowInspectorProperties() override;
@@ -9,7 +9,7 @@ namespace Angazi
 	class ColliderComponent : public Component
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(ColliderComponent);
 
 		void Initialize() override;
 		void DebugUI() override;
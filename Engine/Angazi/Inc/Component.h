@@ -7,7 +7,7 @@ namespace Angazi
 	class Component
 	{
 	public:
-		META_CLASS_DECLARE
+		META_CLASS_DECLARE(Component)
 
 		Component(const Component&) = delete;
 		Component& operator=(const Component&) = delete;
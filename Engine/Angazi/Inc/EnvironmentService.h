@@ -7,7 +7,7 @@ namespace Angazi
 	class EnvironmentService : public Service
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(EnvironmentService);
 
 		void Terminate() override;
 		
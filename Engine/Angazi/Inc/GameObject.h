@@ -6,14 +6,14 @@ namespace Angazi
 	class GameObject;
 	class GameWorld;
 
-	using GameObjectAllocator = Core::TypedAllocator<GameObject>;
-	using GameObjectHandle = Core::Handle<GameObject>;
-	using GameObjectHandlePool = Core::HandlePool<GameObject>;
+	using GameObjectAllocator = Core::ConcurrentTypedAllocator<GameObject>;
+	using GameObjectHandle = Core::WideHandle<GameObject>;
+	using GameObjectHandlePool = Core::DenseHandlePool<GameObject>;
 
 	class GameObject final
 	{
 	public:
-		META_CLASS_DECLARE
+		META_CLASS_DECLARE(GameObject)
 
 		GameObject() = default;
 		GameObject(const GameObject&) = delete;
@@ -37,9 +37,11 @@ namespace Angazi
 		{
 			static_assert(std::is_base_of_v<Component, ComponentType>,"GameObject -- Cannot add type T which is not derived from Component.");
 			//ASSERT(!mInitialized, " GameObject -- Cannot add new components once the game object is already initialized.");
-			for (auto& component : mComponents)
-				if (component->GetMetaClass() == ComponentType::StaticGetMetaClass()) return nullptr;
+			constexpr uint32_t typeId = ComponentType::StaticGetTypeId();
+			for (auto id : mComponentTypeIds)
+				if (id == typeId) return nullptr;
 
+			mComponentTypeIds.push_back(typeId);
 			auto& newComponent = mComponents.emplace_back(std::make_unique<ComponentType>());
 			newComponent->mOwner = this;
 			return static_cast<ComponentType*>(newComponent.get());
@@ -48,10 +50,12 @@ namespace Angazi
 		template <class ComponentType>
 		const ComponentType* GetComponent() const
 		{
-			for (auto& component : mComponents)
+			// Scan the packed ids instead of calling GetMetaClass on every component
+			constexpr uint32_t typeId = ComponentType::StaticGetTypeId();
+			for (size_t i = 0; i < mComponentTypeIds.size(); ++i)
 			{
-				if (component->GetMetaClass() == ComponentType::StaticGetMetaClass())
-					return static_cast<const ComponentType*>(component.get());
+				if (mComponentTypeIds[i] == typeId)
+					return static_cast<const ComponentType*>(mComponents[i].get());
 			}
 			return nullptr;
 		}
@@ -84,6 +88,7 @@ namespace Angazi
 		GameWorld* mWorld = nullptr;
 		GameObjectHandle mHandle;
 		Components mComponents;
+		std::vector<uint32_t> mComponentTypeIds;		// parallel to mComponents
 		
 		std::string mName = "NoName";
 		std::filesystem::path mFilePath = "NoFilePath";
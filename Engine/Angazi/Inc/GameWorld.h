@@ -10,6 +10,7 @@ namespace Angazi
 	class GameWorld
 	{
 	public:
+		// 'capacity' is a starting size, the world grows past it as needed
 		void Initialize(size_t capacity);
 		void Terminate();
 
@@ -19,6 +20,7 @@ namespace Angazi
 			static_assert(std::is_base_of_v<Service,ServiceType>, "GameWorld -- 'ServiceType' must be derived from type 'Service'.");
 			ASSERT(!mInitialized, "GameWorld -- cannot add service after world has already been initialized.");
 
+			mServiceTypeIds.push_back(ServiceType::StaticGetTypeId());
 			auto& newService = mServices.emplace_back(std::make_unique<ServiceType>());
 			newService->mWorld = this;
 			return static_cast<ServiceType*>(newService.get());
@@ -27,10 +29,11 @@ namespace Angazi
 		template <class ServiceType>
 		const ServiceType* GetService() const
 		{
-			for (auto& service : mServices)
+			constexpr uint32_t typeId = ServiceType::StaticGetTypeId();
+			for (size_t i = 0; i < mServiceTypeIds.size(); ++i)
 			{
-				if (service->GetMetaClass() == ServiceType::StaticGetMetaClass())
-					return static_cast<const ServiceType*>(service.get());
+				if (mServiceTypeIds[i] == typeId)
+					return static_cast<const ServiceType*>(mServices[i].get());
 			}
 			return nullptr;
 		}
@@ -67,11 +70,11 @@ namespace Angazi
 		using GameObjectList = std::vector<GameObject*>;
 
 		Services mServices;
+		std::vector<uint32_t> mServiceTypeIds;			// parallel to mServices
 
 		std::unique_ptr<GameObjectAllocator> mGameObjectAllocator;
 		std::unique_ptr<GameObjectHandlePool> mGameObjectHandlePool;
 
-		GameObjectList mUpdateList;
 		GameObjectList mDestroyList;
 
 		std::filesystem::path mSceneFilePath = "";
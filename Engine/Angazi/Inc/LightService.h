@@ -7,7 +7,7 @@ namespace Angazi
 	class LightService : public Service
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(LightService);
 
 
 		void Initialize() override;
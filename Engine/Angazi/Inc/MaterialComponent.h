@@ -9,7 +9,7 @@ namespace Angazi
 	class MaterialComponent : public Component
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(MaterialComponent);
 		
 		void Initialize() override;
 		void ShowInspectorProperties() override;
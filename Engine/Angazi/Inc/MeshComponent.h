@@ -10,7 +10,7 @@ namespace Angazi
 	class MeshComponent : public Component
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(MeshComponent);
 
 		void Initialize() override;
 		void Render() override;
@@ -7,7 +7,7 @@ namespace Angazi
 	class Service
 	{
 	public:
-		META_CLASS_DECLARE
+		META_CLASS_DECLARE(Service)
 	public:
 		Service() = default;
 		virtual ~Service() = default;
@@ -7,7 +7,7 @@ namespace Angazi
 	class ShaderService : public Service
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(ShaderService);
 
 		void Terminate() override;
 		void ShowInspectorProperties() override;
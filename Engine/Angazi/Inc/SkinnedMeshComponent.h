@@ -10,7 +10,7 @@ namespace Angazi
 	class SkinnedMeshComponent : public Component
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(SkinnedMeshComponent);
 
 		void Initialize() override;
 		void Terminate() override;
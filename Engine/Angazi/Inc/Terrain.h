@@ -17,9 +17,15 @@ namespace Angazi
 
 		void DrawEditorUI();
 
+		// Heights are in world space, matching what is rendered
+		float GetHeight(float x, float z) const { return mHeightfield.GetHeight(x, z); }
+		void GetHeights(const float* x, const float* z, float* heights, size_t count) const { mHeightfield.GetHeights(x, z, heights, count); }
+		const Physics::Heightfield& GetHeightfield() const { return mHeightfield; }
+
 	private:
 		void GenerateVertices();
 		void GenerateIndices();
+		void UpdateHeightfield();
 
 		struct ConstantData
 		{
@@ -40,6 +46,7 @@ namespace Angazi
 
 		Graphics::Mesh mMesh;
 		Graphics::MeshBuffer mMeshBuffer;
+		Physics::Heightfield mHeightfield;
 
 		ConstantData mConstantData;
 
@@ -51,5 +58,6 @@ namespace Angazi
 
 		float mHeightScale = 1.0f;
 		float mCellSize = 1.0f;
+		float mWorldScale = 0.3f;
 	};
 }
\ No newline at end of file
@@ -11,7 +11,7 @@ namespace Angazi
 	class TerrainService : public Service
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(TerrainService);
 
 		void Initialize() override;
 		void Terminate() override;
@@ -19,6 +19,8 @@ namespace Angazi
 		void Render() override;
 		void ShowInspectorProperties() override;
 
+		const Terrain& GetTerrain() const { return mTerrain; }
+
 	private:
 		const CameraService* mCameraService = nullptr;
 		const LightService* mLightService = nullptr;
@@ -7,7 +7,7 @@ namespace Angazi
 	class TransformComponent : public Component
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(TransformComponent);
 
 		void Initialize() override;
 		void DebugUI() override;
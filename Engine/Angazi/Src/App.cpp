@@ -16,10 +16,15 @@ void Angazi::App::ChangeState(const std::string& name)
 
 void Angazi::App::Run(AppConfig appConfig)
 {
-	LOG("App -- Running ... ");
-
 	mAppConfig = std::move(appConfig);
 
+	Logger::Settings logSettings;
+	logSettings.filePath = mAppConfig.logFilePath;
+	Logger::StaticInitialize(logSettings);
+
+	LOG("App -- Running ... ");
+	Profiler::SetThreadName("Main");
+
 	LOG("App -- Registering meta types ... ");
 	Core::StaticMetaRegister();
 	Math::StaticMetaRegister();
@@ -29,6 +34,13 @@ void Angazi::App::Run(AppConfig appConfig)
 	// Initialize timer
 	TimeUtil::GetTime();
 
+	FrameAllocator::StaticInitialize();
+	EventBus::StaticInitialize();
+
+	// Worker threads for the parallel paths in Math::Batch, culling and BVH builds
+	LOG("App -- Starting job system ... ");
+	JobSystem::StaticInitialize(mAppConfig.jobWorkerCount);
+
 	// Setup out application window
 	LOG("App -- Creating window ... ");
 	mWindow.Initialize(GetModuleHandle(NULL), mAppConfig.appName.c_str(), mAppConfig.windowWidth, mAppConfig.windowHeight);
@@ -74,6 +86,8 @@ void Angazi::App::Run(AppConfig appConfig)
 	mRunning = true;
 	while (mRunning)
 	{
+		PROFILE_FRAME();
+
 		mWindow.ProcessMessage();
 		if (!mWindow.IsActive())
 		{
@@ -102,7 +116,16 @@ void Angazi::App::Run(AppConfig appConfig)
 		//float deltaTime = Math::Min( TimeUtil::GetDeltaTime(), 1.0f / 60.0f);
 		float deltaTime = TimeUtil::GetDeltaTime();
 		//LOG("dt = %.5f",deltaTime);
-		mCurrentState->Update(deltaTime);
+		{
+			PROFILE_SCOPE("App::DispatchEvents");
+			EventBus::Get()->Dispatch();
+		}
+		{
+			PROFILE_SCOPE("App::Update");
+			mCurrentState->Update(deltaTime);
+		}
+
+		PROFILE_SCOPE("App::Render");
 
 		auto graphicsSystem = GraphicsSystem::Get();
 		graphicsSystem->BeginRender();
@@ -116,10 +139,20 @@ void Angazi::App::Run(AppConfig appConfig)
 		DebugUI::EndRender();
 
 		graphicsSystem->EndRender();
+
+		FrameAllocator::Get()->EndFrame();
+		MemoryTracker::EndFrame();
+		Logger::Get()->DispatchEvents();
 	}
 
 	mCurrentState->Terminate();
 
+	if (!mAppConfig.profileCapturePath.empty())
+	{
+		LOG("App -- Saving profile capture ...");
+		Profiler::ExportChromeTrace(mAppConfig.profileCapturePath);
+	}
+
 	//Terminate engine systems
 	InputSystem::StaticTerminate();
 
@@ -132,8 +165,14 @@ void Angazi::App::Run(AppConfig appConfig)
 	TextureManager::StaticTerminate();
 	GraphicsSystem::StaticTerminate();
 
+	JobSystem::StaticTerminate();
+	EventBus::StaticTerminate();
+	FrameAllocator::StaticTerminate();
+
 	//Terminate window
 	mWindow.Terminate();
+
+	Logger::StaticTerminate();
 }
 bool Angazi::App::OpenFileDialog(char fileName[MAX_PATH], const char * title, const char * filter)
 {
@@ -59,8 +59,15 @@ void Editor::ShowWorldView()
 	ImGui::SetNextItemOpen(true);
 	if (ImGui::TreeNode("Game Objects"))
 	{
-		for (auto gameObject : mWorld.mUpdateList)
+		// Deleting from the popup destroys right away, keep the list in place until we are done
+		auto& gameObjects = *mWorld.mGameObjectHandlePool;
+		gameObjects.Lock();
+		for (size_t i = 0; i < gameObjects.Size(); ++i)
 		{
+			GameObject* gameObject = gameObjects[i];
+			if (gameObject == nullptr)
+				continue;
+
 			ImGui::PushID(gameObject);
 
 			if (!gameObject->mEnabled)
@@ -89,6 +96,7 @@ void Editor::ShowWorldView()
 			}
 			ImGui::PopID();
 		}
+		gameObjects.Unlock();
 		ImGui::TreePop();
 	}
 	if (InputSystem::Get()->IsMousePressed(MouseButton::RBUTTON) && ImGui::IsWindowHovered() && !gameobjectflag)
@@ -143,12 +151,11 @@ void Editor::ShowInspectorView()
 
 		if (ImGui::BeginPopup("Add_Component"))
 		{
-			auto metaClasses = Angazi::Core::Meta::GetAllMetaClasses();
-			for (auto& [name, metaClass] : metaClasses)
+			for (auto metaClass : Angazi::Core::Meta::GetAllMetaClasses())
 			{
 				if (metaClass->GetParent() == Component::StaticGetMetaClass())
 				{
-					if (ImGui::Selectable(name.c_str()))
+					if (ImGui::Selectable(metaClass->GetName()))
 					{
 						auto component = mSelectedGameObject->AddComponent(metaClass);
 						if(component)
@@ -45,11 +45,13 @@ void Angazi::GameObject::RenderShadows()
 
 Component* GameObject::AddComponent(const Core::Meta::MetaClass* metaClass)
 {
-	for (auto& component : mComponents)
-		if (component->GetMetaClass() == metaClass) return component.get();
+	const uint32_t typeId = metaClass->GetTypeId();
+	for (size_t i = 0; i < mComponentTypeIds.size(); ++i)
+		if (mComponentTypeIds[i] == typeId) return mComponents[i].get();
 
 	Component* newComponent = static_cast<Component*>(metaClass->Create());
 	newComponent->mOwner = this;
+	mComponentTypeIds.push_back(typeId);
 	mComponents.emplace_back(std::unique_ptr<Component>(newComponent));
 	return newComponent;
 }
@@ -30,13 +30,8 @@ void GameWorld::Terminate()
 	ASSERT(!mUpdating, "GameWorld -- Cannot terminate during an update.");
 
 	// Destroy all active objects
-	mUpdating = true;
-	std::for_each(mUpdateList.begin(), mUpdateList.end(), [this](auto gameObject)
-	{
-		Destroy(gameObject->GetHandle());
-	});
-	mUpdating = false;
-	mUpdateList.clear();
+	mDestroyList.insert(mDestroyList.end(), mGameObjectHandlePool->begin(), mGameObjectHandlePool->end());
+	mGameObjectHandlePool->Flush();
 
 	// Now destroy everything
 	ProcessDestroyList();
@@ -68,8 +63,7 @@ GameObjectHandle GameWorld::Create(const std::filesystem::path& templateFileName
 	gameObject->mHandle = handle;
 	//gameObject->Initialize();
 
-	// Add game object to the update list
-	mUpdateList.push_back(gameObject);
+	// The handle pool doubles as the update list
 	return handle;
 }
 
@@ -112,18 +106,24 @@ void GameWorld::LoadScene(const std::filesystem::path& sceneFileName)
 
 void GameWorld::UnloadScene()
 {
-	mDestroyList = mUpdateList;
+	for (auto gameObject : *mGameObjectHandlePool)
+	{
+		if (gameObject)
+			mDestroyList.push_back(gameObject);
+	}
+	for (auto gameObject : mDestroyList)
+		mGameObjectHandlePool->Unregister(gameObject->GetHandle());
 	mInitialized = false;
 	mSceneFilePath = "";
 }
 
 GameObjectHandle GameWorld::Find(const std::string& name)
 {
-	auto iter = std::find_if(mUpdateList.begin(), mUpdateList.end(), [&name](auto gameObject)
+	auto iter = std::find_if(mGameObjectHandlePool->begin(), mGameObjectHandlePool->end(), [&name](auto gameObject)
 	{
-		return gameObject->GetName() == name;
+		return gameObject && gameObject->GetName() == name;
 	});
-	if (iter != mUpdateList.end())
+	if (iter != mGameObjectHandlePool->end())
 		return (*iter)->GetHandle();
 
 	return GameObjectHandle();
@@ -131,7 +131,7 @@ GameObjectHandle GameWorld::Find(const std::string& name)
 
 void GameWorld::SaveScene(const std::filesystem::path& sceneFilePath)
 {
-	if (mUpdateList.empty())
+	if (mGameObjectHandlePool->Size() == 0)
 		return;
 
 	if (sceneFilePath != "")
@@ -151,7 +151,7 @@ void GameWorld::SaveScene(const std::filesystem::path& sceneFilePath)
 
 	Value gameObjects(kArrayType);
 	Value val(kObjectType);
-	for (auto& gameObject : mUpdateList)
+	for (auto gameObject : *mGameObjectHandlePool)
 	{
 		Value obj(kObjectType);
 		val.SetString(gameObject->mFilePath.u8string().c_str(), allocator);
@@ -198,24 +198,27 @@ void GameWorld::Destroy(GameObjectHandle handle)
 
 void GameWorld::Update(float deltaTime)
 {
+	PROFILE_FUNCTION();
 	ASSERT(!mUpdating, "GameWorld -- Already updaing the world!");
 
-	// Lock the update list
+	// Lock the update list, objects destroyed now leave a nullptr behind
 	mUpdating = true;
+	mGameObjectHandlePool->Lock();
 
 	for (auto& service : mServices)
 		service->Update(deltaTime);
 
 	// Re-compute size in case new objects are added to the update
 	// list during iteration.
-	for (size_t i = 0; i < mUpdateList.size(); ++i)
+	for (size_t i = 0; i < mGameObjectHandlePool->Size(); ++i)
 	{
-		GameObject* gameObject = mUpdateList[i];
-		if (gameObject->GetHandle().IsValid() && gameObject->mEnabled)
+		GameObject* gameObject = (*mGameObjectHandlePool)[i];
+		if (gameObject && gameObject->mEnabled)
 			gameObject->Update(deltaTime);
 	}
 
 	// Unlock the update list
+	mGameObjectHandlePool->Unlock();
 	mUpdating = false;
 
 	// Now we can safely destroy objects
@@ -224,9 +227,10 @@ void GameWorld::Update(float deltaTime)
 
 void GameWorld::Render()
 {
+	PROFILE_FUNCTION();
 	for (auto& service : mServices)
 		service->Render();
-	for (auto gameObject : mUpdateList)
+	for (auto gameObject : *mGameObjectHandlePool)
 		if (gameObject->mEnabled)
 			gameObject->Render();
 }
@@ -235,7 +239,7 @@ void GameWorld::DebugUI()
 {
 	for (auto& service : mServices)
 		service->DebugUI();
-	for (auto gameObject : mUpdateList)
+	for (auto gameObject : *mGameObjectHandlePool)
 		if (gameObject->mEnabled)
 			gameObject->DebugUI();
 }
@@ -250,7 +254,7 @@ void GameWorld::RenderShadowMap()
 
 		shadowEffect->Begin();
 		shadowEffect->SetLightDirection(light.direction, camera);
-		for (auto gameObject : mUpdateList)
+		for (auto gameObject : *mGameObjectHandlePool)
 			if (gameObject->mEnabled)
 				gameObject->RenderShadows();
 		shadowEffect->End();
@@ -265,11 +269,6 @@ void GameWorld::DestroyInternal(GameObject* gameObject)
 	if (gameObject == nullptr)
 		return;
 
-	// First remove it from the update list
-	auto iter = std::find(mUpdateList.begin(), mUpdateList.end(), gameObject);
-	if (iter != mUpdateList.end())
-		mUpdateList.erase(iter);
-
 	// Terminate the game object
 	gameObject->Terminate();
 
@@ -30,12 +30,14 @@ void Terrain::Initialize(uint32_t numRows, uint32_t numCols, float cellSize)
 
 	GenerateIndices();
 	GenerateVertices();
+	UpdateHeightfield();
 
 	mMeshBuffer.Initialize(mMesh, true);
 }
 
 void Terrain::Terminate()
 {
+	mHeightfield.Terminate();
 	mMeshBuffer.Terminate();
 	mDiffuseTexture.Terminate();
 	mNormalTexture.Terminate();
@@ -68,6 +70,7 @@ void Terrain::LoadHeightmap(const std::filesystem::path & filePath)
 	fclose(file);
 
 	Graphics::MeshBuilder::ComputeNormals(mMesh);
+	UpdateHeightfield();
 	mMeshBuffer.Update(mMesh.vertices.data(), static_cast<uint32_t>(mMesh.vertices.size()));
 }
 // get 3 indices
@@ -93,7 +96,7 @@ void Terrain::SetClippingPlane(const Math::Vector4 & plane)
 
 void Terrain::Render(const Graphics::Camera & camera)
 {
-	auto world = Math::Matrix4::Scaling(0.3f);
+	auto world = Math::Matrix4::Scaling(mWorldScale);
 	//auto world = Math::Matrix4::Identity;
 	auto view = camera.GetViewMatrix();
 	auto projection = camera.GetPerspectiveMatrix();
@@ -176,3 +179,14 @@ void Terrain::GenerateIndices()
 		}
 	}
 }
+
+void Terrain::UpdateHeightfield()
+{
+	// Vertex (x, z) lives at index x + (z * mNumCols), store the samples in world space
+	mHeightfield.Initialize(mNumRows, mNumCols, mCellSize * mWorldScale);
+	for (uint32_t z = 0; z < mNumRows; ++z)
+	{
+		for (uint32_t x = 0; x < mNumCols; ++x)
+			mHeightfield.SetHeight(z, x, mMesh.vertices[x + (z * mNumCols)].position.y * mWorldScale);
+	}
+}
\ No newline at end of file
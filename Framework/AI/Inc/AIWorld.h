@@ -28,6 +28,10 @@ namespace Angazi::AI
 		EntityList GetEntities(const Math::Circle& range, uint32_t typeId);
 		AgentList GetNeighborhood(const Math::Circle & range, uint32_t typeId);
 
+		// Fill a caller owned list, e.g. one backed by a ScratchScope, instead of allocating
+		void GetEntities(const Math::Circle& range, uint32_t typeId, Core::ArenaVector<Entity*>& entities);
+		void GetNeighborhood(const Math::Circle& range, uint32_t typeId, Core::ArenaVector<Agent*>& neighbors);
+
 		const Obstacles& GetObstacles() const { return mObstacles; }
 		const Walls& GetWalls() const {return  mWalls; }
 
@@ -22,6 +22,11 @@ namespace Angazi::AI::NEAT
 		void Initialize(const Genome& genome, const NeuralNetConfig& netConfig);
 		std::vector<double> Evaluate(const std::vector<double>& input) ;
 
+		// Writes one value per output node, 'outputs' must have room for GetOutputCount values
+		void Evaluate(const std::vector<double>& input, double* outputs);
+
+		size_t GetOutputCount() const { return mOutputNodes.size(); }
+
 	private:
 		std::vector<Neuron> mNodes;
 		std::vector<size_t> mInputNodes;
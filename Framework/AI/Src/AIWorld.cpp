@@ -7,10 +7,10 @@ using namespace Angazi::Graphics;
 
 namespace
 {
-	template<class Element>
-	std::vector<Element*> GetElements(const PartitionGrid<Entity>& grid, const Math::Circle& range, float cellSize, uint32_t typeId)
+	template<class Element, class Container>
+	void GetElements(const PartitionGrid<Entity>& grid, const Math::Circle& range, float cellSize, uint32_t typeId, Container& elements)
 	{
-		std::vector<Element*> elements;
+		elements.clear();
 
 		int minX = static_cast<int>((range.center.x - range.radius) / cellSize);
 		int maxX = static_cast<int>((range.center.x + range.radius) / cellSize);
@@ -34,8 +34,6 @@ namespace
 				}
 			}
 		}
-
-		return elements;
 	}
 }
 
@@ -96,6 +94,7 @@ void AIWorld::Initialize(const Settings& settings)
 
 void AIWorld::Update()
 {
+	PROFILE_FUNCTION();
 	mPartitionGrid.ClearCells();
 	for (auto entity : mEntities)
 	{
@@ -138,10 +137,24 @@ void AIWorld::AddWall(const Math::LineSegment & wall)
 
 EntityList AIWorld::GetEntities(const Math::Circle & range, uint32_t typeId)
 {
-	return GetElements<Entity>(mPartitionGrid, range, mSettings.partitionGridSize, typeId);
+	EntityList entities;
+	GetElements<Entity>(mPartitionGrid, range, mSettings.partitionGridSize, typeId, entities);
+	return entities;
 }
 
 AgentList AIWorld::GetNeighborhood(const Math::Circle & range, uint32_t typeId)
 {
-	return GetElements<Agent>(mPartitionGrid, range, mSettings.partitionGridSize, typeId);
+	AgentList neighbors;
+	GetElements<Agent>(mPartitionGrid, range, mSettings.partitionGridSize, typeId, neighbors);
+	return neighbors;
+}
+
+void AIWorld::GetEntities(const Math::Circle& range, uint32_t typeId, Core::ArenaVector<Entity*>& entities)
+{
+	GetElements<Entity>(mPartitionGrid, range, mSettings.partitionGridSize, typeId, entities);
+}
+
+void AIWorld::GetNeighborhood(const Math::Circle& range, uint32_t typeId, Core::ArenaVector<Agent*>& neighbors)
+{
+	GetElements<Agent>(mPartitionGrid, range, mSettings.partitionGridSize, typeId, neighbors);
 }
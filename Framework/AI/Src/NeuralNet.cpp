@@ -70,6 +70,13 @@ void Angazi::AI::NEAT::NeuralNet::Initialize(const Genome & genome, const Neural
 }
 
 std::vector<double> NeuralNet::Evaluate(const std::vector<double>& input)
+{
+	std::vector<double> outputs(mOutputNodes.size());
+	Evaluate(input, outputs.data());
+	return outputs;
+}
+
+void NeuralNet::Evaluate(const std::vector<double>& input, double* outputs)
 {
 	// Reset all nodes
 	for (auto& node : mNodes)
@@ -94,7 +101,8 @@ std::vector<double> NeuralNet::Evaluate(const std::vector<double>& input)
 	}
 
 	// Start evaluating from the output nodes
-	std::stack<size_t> s;
+	Core::ScratchScope scratch;
+	std::stack<size_t, Core::ArenaVector<size_t>> s(Core::ArenaVector<size_t>(scratch.GetArena()));
 	for (auto outputNodesIndex : mOutputNodes)
 		s.push(outputNodesIndex);
 
@@ -125,8 +133,6 @@ std::vector<double> NeuralNet::Evaluate(const std::vector<double>& input)
 	}
 
 	// Extract results from output nodes
-	std::vector<double> outputs;
-	for (auto outputNodeIndex : mOutputNodes)
-		outputs.push_back(mNodes[outputNodeIndex].value);
-	return outputs;
+	for (size_t i = 0; i < mOutputNodes.size(); ++i)
+		outputs[i] = mNodes[mOutputNodes[i]].value;
 }
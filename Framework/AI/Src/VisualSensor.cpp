@@ -8,18 +8,25 @@ using namespace Angazi::AI;
 
 void VisualSensor::Update(Agent & agent, MemoryRecords & memory, float deltaTime)
 {
-	auto neighbors = agent.world.GetNeighborhood({ agent.position, neighborhoodRadius },agent.threat->GetTypeId());
+	// Built once, the key is too long for the small string buffer
+	static const std::string kLastSeenPosition = "lastSeenPosition";
+
+	Core::ScratchScope scratch;
+	Core::ArenaVector<Agent*> neighbors(scratch.GetArena());
+	agent.world.GetNeighborhood({ agent.position, neighborhoodRadius }, agent.threat->GetTypeId(), neighbors);
+
+	const float cosViewAngle = cosf(Math::Constants::DegToRad * viewAngle);
 	for (auto &neighbor : neighbors)
 	{
 		if (Math::Distance(neighbor->position, agent.position) > viewRange)
 			continue;
-		if (Math::Dot(Math::Normalize(neighbor->position-agent.position),agent.heading) < cosf(Math::Constants::DegToRad*viewAngle))
+		if (Math::Dot(Math::Normalize(neighbor->position-agent.position),agent.heading) < cosViewAngle)
 			continue;
 		if (!agent.world.HasLineOfSite(agent.position,neighbor->position))
 			continue;
 
 		MemoryRecord& record = FindOrCreate(memory, neighbor->GetUniqueId());
-		record.properties["lastSeenPosition"] = neighbor->position;
+		record.properties[kLastSeenPosition] = neighbor->position;
 		//std::get<X::Math::Vector2>(record.properties["lastSeenPosition"]) = neighbor->position;
 		record.lastRecordTime = Core::TimeUtil::GetTime();
 	}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Angazi::Core
+{
+	// Destination for binary data. Values are written in native byte order.
+	class BinaryWriter
+	{
+	public:
+		virtual ~BinaryWriter() = default;
+
+		virtual void Write(const void* data, size_t size) = 0;
+
+		template <class T>
+		void Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter -- Can only write trivially copyable types.");
+			Write(&value, sizeof(T));
+		}
+	};
+
+	// Source of binary data. Read returns false once the source runs dry.
+	class BinaryReader
+	{
+	public:
+		virtual ~BinaryReader() = default;
+
+		virtual bool Read(void* data, size_t size) = 0;
+
+		template <class T>
+		bool Read(T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "BinaryReader -- Can only read trivially copyable types.");
+			return Read(&value, sizeof(T));
+		}
+	};
+
+	class MemoryWriter : public BinaryWriter
+	{
+	public:
+		using BinaryWriter::Write;
+		void Write(const void* data, size_t size) override;
+
+		void Clear() { mData.clear(); }
+		const uint8_t* GetData() const { return mData.data(); }
+		size_t GetSize() const { return mData.size(); }
+
+	private:
+		std::vector<uint8_t> mData;
+	};
+
+	// Reads from memory owned by someone else
+	class MemoryReader : public BinaryReader
+	{
+	public:
+		MemoryReader(const void* data, size_t size);
+
+		using BinaryReader::Read;
+		bool Read(void* data, size_t size) override;
+
+		size_t GetRemaining() const { return mSize - mHead; }
+
+	private:
+		const uint8_t* mData;
+		size_t mSize;
+		size_t mHead = 0;
+	};
+
+	class FileWriter : public BinaryWriter
+	{
+	public:
+		FileWriter(const std::filesystem::path& path);
+
+		using BinaryWriter::Write;
+		void Write(const void* data, size_t size) override;
+
+		bool IsOpen() const { return mFile.is_open(); }
+		bool IsGood() const { return mFile.good(); }
+
+	private:
+		std::ofstream mFile;
+	};
+
+	class FileReader : public BinaryReader
+	{
+	public:
+		FileReader(const std::filesystem::path& path);
+
+		using BinaryReader::Read;
+		bool Read(void* data, size_t size) override;
+
+		bool IsOpen() const { return mFile.is_open(); }
+
+	private:
+		std::ifstream mFile;
+	};
+}
@@ -6,15 +6,25 @@
 #define ENABLE_DIRECTX11
 //#define ENABLE_OPENGL
 
+#define ENABLE_PROFILER
+#define ENABLE_MEMORY_TRACKER
+
 //Win32 headers
+#if defined(_WIN32)
 #include <objbase.h>
 #include <Windows.h>
+#include <commdlg.h>
+#else
+#include <csignal>
+#endif
 
 //Standard headers
 #include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
 #include <cstdint>
@@ -25,15 +35,15 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
-#include "commdlg.h"
-
 // External Headers
 #include <RapidJSON/Inc/document.h>
 #include <RapidJSON/Inc/filereadstream.h>
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Angazi::Core
+{
+	// Thread safe, growable variant of BlockAllocator. Free blocks store the free list link
+	// inside themselves, and storage grows one page of blocks at a time. Every thread keeps a
+	// small cache of free blocks, so most Allocate/Free calls never take the lock, which is
+	// only needed to move a batch of blocks between a thread cache and the shared free list.
+	class ConcurrentBlockAllocator
+	{
+	public:
+		struct Stats
+		{
+			size_t liveCount = 0;		// blocks currently handed out
+			size_t highWaterMark = 0;	// most blocks ever handed out at once
+			size_t pageCount = 0;
+			size_t capacity = 0;		// blocks in all pages
+		};
+
+		// 'maxPages' of 0 means no limit, otherwise Allocate returns nullptr once all pages are used
+		ConcurrentBlockAllocator(size_t blockSize, size_t blocksPerPage = 256, size_t alignment = alignof(std::max_align_t), size_t maxPages = 0);
+		~ConcurrentBlockAllocator();
+
+		ConcurrentBlockAllocator(const ConcurrentBlockAllocator&) = delete;
+		ConcurrentBlockAllocator& operator=(const ConcurrentBlockAllocator&) = delete;
+
+		ConcurrentBlockAllocator(ConcurrentBlockAllocator&&) = delete;
+		ConcurrentBlockAllocator& operator=(ConcurrentBlockAllocator&&) = delete;
+
+		void* Allocate();
+		void Free(void* ptr);
+
+		// Returns the calling thread's cached blocks to the shared free list
+		void FlushThreadCache();
+
+		Stats GetStats() const;
+		size_t GetBlockSize() const { return mBlockStride; }
+		size_t GetAlignment() const { return mAlignment; }
+
+	private:
+		struct FreeBlock;
+		struct Depot;
+		struct ThreadCache;
+
+		ThreadCache& GetThreadCache();
+		void Refill(ThreadCache& cache);
+
+		std::shared_ptr<Depot> mDepot; // shared with thread caches that outlive the allocator
+		std::atomic<size_t> mLiveCount{ 0 };
+		std::atomic<size_t> mHighWaterMark{ 0 };
+		size_t mBlockStride;
+		size_t mAlignment;
+		uint64_t mId;
+	};
+}
@@ -3,22 +3,38 @@
 #include "Common.h"
 
 // Event headers
+#include "EventBus.h"
 #include "EventHandler.h"
 
 // Memory headers
 #include "BlockAllocator.h"
+#include "ConcurrentBlockAllocator.h"
+#include "DenseHandlePool.h"
+#include "FrameAllocator.h"
 #include "Handle.h"
 #include "HandlePool.h"
+#include "LinearAllocator.h"
+#include "MemoryTracker.h"
 #include "TypedAllocator.h"
+#include "WideHandle.h"
 
 // Meta Headers
 #include "Meta.h"
 #include "MetaRegistration.h"
 
+// Threading headers
+#include "JobSystem.h"
+
 // Platform headers
+#if defined(_WIN32)
 #include "Window.h"
 #include "WindowsMessageHandler.h"
+#endif
 
 // Util headers
+#include "BinaryStream.h"
 #include "DebugUtil.h"
+#include "Hash.h"
+#include "Logger.h"
+#include "Profiler.h"
 #include "TimeUtil.h"
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EventHandler.h"
+#include "Logger.h"
 #include "TimeUtil.h"
 
 namespace Angazi::Core
@@ -13,21 +14,28 @@ namespace Angazi::Core
 #define BEGIN_MACRO do {
 #define END_MACRO } while (false)
 
+#if defined(_WIN32)
+#define DEBUG_BREAK() DebugBreak()
+#else
+#define DEBUG_BREAK() raise(SIGTRAP)
+#endif
+
 #if defined(_DEBUG)
+// Queued to the async Logger, each call site is rate limited separately
 #define LOG(format, ...)\
 	BEGIN_MACRO\
-		char _buffer[4096];\
-		int _res = _snprintf_s(_buffer, std::size(_buffer), _TRUNCATE, "[%.3f]: "##format##"\n", Angazi::Core::TimeUtil::GetTime(), __VA_ARGS__);\
-		OutputDebugStringA(_buffer);\
-		Angazi::Core::OnDebugLog(_buffer);\
+		static Angazi::Core::LogRateLimit _rateLimit;\
+		Angazi::Core::LogWrite(&_rateLimit, format, ##__VA_ARGS__);\
 	END_MACRO
 
+// Never rate limited, and flushed so the message is out before we break
 #define ASSERT(condition, format, ...)\
 	BEGIN_MACRO\
 		if (!(condition))\
 		{\
-			LOG("%s(%d) "##format, __FILE__, __LINE__, __VA_ARGS__);\
-			DebugBreak();\
+			Angazi::Core::LogWrite(nullptr, "%s(%d) " format, __FILE__, __LINE__, ##__VA_ARGS__);\
+			Angazi::Core::LogFlush();\
+			DEBUG_BREAK();\
 		}\
 	END_MACRO
 #else
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Common.h"
+#include "DebugUtil.h"
+
+namespace Angazi::Core
+{
+	template<class DataType>
+	class WideHandle;
+
+	// Growable handle pool that keeps its live instances packed in one array. Handles index a
+	// sparse slot, the slot points into the dense array, and removal moves the last instance
+	// into the hole, so Register, Unregister and Get are all O(1) and iteration is linear.
+	//
+	// While locked, Unregister leaves a nullptr in the dense array instead of moving anything,
+	// so a loop over the pool can destroy objects safely. Unlock fills the holes.
+	template <class DataType>
+	class DenseHandlePool
+	{
+	public:
+		using HandleType = WideHandle<DataType>;
+		using Instances = std::vector<DataType*>;
+
+		DenseHandlePool(size_t capacity = 0)
+		{
+			ASSERT(HandleType::sPool == nullptr, "DenseHandlePool -- Cannot have more than one pool of this type!");
+			HandleType::sPool = this;
+
+			mSlots.reserve(capacity + 1);
+			mSlots.emplace_back();							// slot 0 is never handed out
+			mInstances.reserve(capacity);
+			mDenseToSlot.reserve(capacity);
+		}
+		~DenseHandlePool()
+		{
+			ASSERT(HandleType::sPool == this, "DenseHandlePool -- Something is wrong...");
+			HandleType::sPool = nullptr;
+		}
+
+		HandleType Register(DataType* instance)
+		{
+			ASSERT(instance != nullptr, "DenseHandlePool -- Invalid instance.");
+
+			uint32_t slotIndex;
+			if (mFreeSlots.empty())
+			{
+				ASSERT(mSlots.size() < std::numeric_limits<uint32_t>::max(), "DenseHandlePool -- No more free slots available.");
+				slotIndex = static_cast<uint32_t>(mSlots.size());
+				mSlots.emplace_back();
+			}
+			else
+			{
+				slotIndex = mFreeSlots.back();
+				mFreeSlots.pop_back();
+			}
+
+			mSlots[slotIndex].denseIndex = static_cast<uint32_t>(mInstances.size());
+			mInstances.push_back(instance);
+			mDenseToSlot.push_back(slotIndex);
+
+			HandleType handle;
+			handle.mIndex = slotIndex;
+			handle.mGeneration = mSlots[slotIndex].generation;
+			return handle;
+		}
+		void Unregister(HandleType handle)
+		{
+			if (!IsValid(handle))
+				return;
+
+			Slot& slot = mSlots[handle.mIndex];
+			slot.generation++; // this invalidates all existing handles to this slot
+			mFreeSlots.push_back(handle.mIndex);
+
+			if (mLockCount > 0)
+			{
+				mInstances[slot.denseIndex] = nullptr;
+				mHoles.push_back(slot.denseIndex);
+			}
+			else
+			{
+				RemoveDense(slot.denseIndex);
+			}
+		}
+		void Flush()
+		{
+			for (auto& slot : mSlots)
+				slot.generation++; // invalidates all existing handles
+			mFreeSlots.clear();
+			for (size_t i = mSlots.size() - 1; i > 0; --i)
+				mFreeSlots.push_back(static_cast<uint32_t>(i));
+			mInstances.clear();
+			mDenseToSlot.clear();
+			mHoles.clear();
+		}
+
+		bool IsValid(HandleType handle) const
+		{
+			return handle.mIndex != 0 && handle.mIndex < mSlots.size() && mSlots[handle.mIndex].generation == handle.mGeneration;
+		}
+		DataType* Get(HandleType handle) const
+		{
+			return IsValid(handle) ? mInstances[mSlots[handle.mIndex].denseIndex] : nullptr;
+		}
+
+		void Lock()
+		{
+			++mLockCount;
+		}
+		void Unlock()
+		{
+			ASSERT(mLockCount > 0, "DenseHandlePool -- Pool is not locked.");
+			if (--mLockCount > 0)
+				return;
+
+			// Back to front, so the last instance is never a hole we have yet to fill
+			std::sort(mHoles.begin(), mHoles.end(), std::greater<uint32_t>());
+			for (auto hole : mHoles)
+				RemoveDense(hole);
+			mHoles.clear();
+		}
+
+		// Live instances, in no particular order. Contains nullptr holes while locked.
+		size_t Size() const { return mInstances.size(); }
+		DataType* operator[](size_t index) const { return mInstances[index]; }
+		typename Instances::const_iterator begin() const { return mInstances.begin(); }
+		typename Instances::const_iterator end() const { return mInstances.end(); }
+
+	private:
+		struct Slot
+		{
+			uint32_t generation = 0;
+			uint32_t denseIndex = 0;
+		};
+
+		void RemoveDense(uint32_t denseIndex)
+		{
+			const uint32_t last = static_cast<uint32_t>(mInstances.size() - 1);
+			if (denseIndex != last)
+			{
+				mInstances[denseIndex] = mInstances[last];
+				mDenseToSlot[denseIndex] = mDenseToSlot[last];
+				mSlots[mDenseToSlot[denseIndex]].denseIndex = denseIndex;
+			}
+			mInstances.pop_back();
+			mDenseToSlot.pop_back();
+		}
+
+		std::vector<Slot> mSlots;
+		std::vector<uint32_t> mFreeSlots;
+		Instances mInstances;
+		std::vector<uint32_t> mDenseToSlot;
+		std::vector<uint32_t> mHoles;
+		int mLockCount = 0;
+	};
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "DebugUtil.h"
+
+namespace Angazi::Core
+{
+	namespace Detail
+	{
+		uint32_t NextEventTypeIndex();
+		EventHandlerId NextEventBusHandlerId();
+
+		template <class EventType>
+		uint32_t GetEventTypeIndex()
+		{
+			static const uint32_t sIndex = NextEventTypeIndex();
+			return sIndex;
+		}
+
+		template <class Method>
+		struct MethodTraits;
+
+		template <class Class, class Arg>
+		struct MethodTraits<void(Class::*)(const Arg&)>
+		{
+			using ClassType = Class;
+			using EventType = Arg;
+		};
+
+		class EventChannelBase
+		{
+		public:
+			virtual ~EventChannelBase() = default;
+			virtual void Dispatch() = 0;
+		};
+	}
+
+	// One queue and one handler list per event type. Post can be called from any thread, the
+	// events are held until Dispatch delivers them in a batch on the dispatching thread.
+	//
+	// Handlers are a plain function pointer plus context in a contiguous array. The array is
+	// copy on write, so handlers can subscribe and unsubscribe while an event is being delivered.
+	// A change made during delivery takes effect from the next event.
+	template <class EventType>
+	class EventChannel final : public Detail::EventChannelBase
+	{
+	public:
+		using HandlerFunc = void(*)(void* context, const EventType& event);
+
+		void Post(EventType event)
+		{
+			std::lock_guard<std::mutex> lock(mQueueMutex);
+			mQueue.push_back(std::move(event));
+		}
+
+		// Delivers right away on the calling thread, skipping the queue
+		void Publish(const EventType& event) const
+		{
+			auto handlers = GetHandlers();
+			for (auto& handler : *handlers)
+				handler.func(handler.context, event);
+		}
+
+		// Events posted while dispatching are held for the next Dispatch
+		void Dispatch() override
+		{
+			ASSERT(!mDispatching, "EventChannel -- Dispatch is not reentrant.");
+			{
+				std::lock_guard<std::mutex> lock(mQueueMutex);
+				mDispatchQueue.swap(mQueue);
+			}
+			if (mDispatchQueue.empty())
+				return;
+
+			mDispatching = true;
+			for (auto& event : mDispatchQueue)
+			{
+				// Fresh snapshot per event, so a handler removed by an earlier event is not called again
+				auto handlers = GetHandlers();
+				for (auto& handler : *handlers)
+					handler.func(handler.context, event);
+			}
+			mDispatchQueue.clear();
+			mDispatching = false;
+		}
+
+		// 'owner' keeps the context alive for as long as the handler is subscribed
+		EventHandlerId Subscribe(HandlerFunc func, void* context, std::shared_ptr<void> owner = nullptr)
+		{
+			const EventHandlerId id = Detail::NextEventBusHandlerId();
+			std::lock_guard<std::mutex> lock(mHandlerMutex);
+			auto handlers = std::make_shared<HandlerList>(*mHandlers);
+			handlers->push_back({ func, context, id, std::move(owner) });
+			mHandlers = std::move(handlers);
+			return id;
+		}
+
+		bool Unsubscribe(EventHandlerId id)
+		{
+			std::lock_guard<std::mutex> lock(mHandlerMutex);
+			auto iter = std::find_if(mHandlers->begin(), mHandlers->end(), [id](const Handler& handler)
+			{
+				return handler.id == id;
+			});
+			if (iter == mHandlers->end())
+				return false;
+
+			auto handlers = std::make_shared<HandlerList>(*mHandlers);
+			handlers->erase(handlers->begin() + (iter - mHandlers->begin()));
+			mHandlers = std::move(handlers);
+			return true;
+		}
+
+		size_t GetPendingCount() const
+		{
+			std::lock_guard<std::mutex> lock(mQueueMutex);
+			return mQueue.size();
+		}
+
+		size_t GetHandlerCount() const
+		{
+			return GetHandlers()->size();
+		}
+
+	private:
+		struct Handler
+		{
+			HandlerFunc func;
+			void* context;
+			EventHandlerId id;
+			std::shared_ptr<void> owner;
+		};
+		using HandlerList = std::vector<Handler>;
+
+		std::shared_ptr<const HandlerList> GetHandlers() const
+		{
+			std::lock_guard<std::mutex> lock(mHandlerMutex);
+			return mHandlers;
+		}
+
+		mutable std::mutex mQueueMutex;
+		std::vector<EventType> mQueue;
+		std::vector<EventType> mDispatchQueue;		// dispatching thread only, keeps its capacity
+		bool mDispatching = false;
+
+		mutable std::mutex mHandlerMutex;
+		std::shared_ptr<const HandlerList> mHandlers = std::make_shared<const HandlerList>();
+	};
+
+	// Typed publish/subscribe hub. Any copyable struct can be an event:
+	//
+	//	struct HitEvent { GameObjectHandle target; float damage; };
+	//	bus.Subscribe<&Health::OnHit>(this);	// void Health::OnHit(const HitEvent&)
+	//	bus.Post(HitEvent{ handle, 10.0f });	// from any thread
+	//	bus.Dispatch();							// once per frame, on the main thread
+	class EventBus
+	{
+	public:
+		static void StaticInitialize();
+		static void StaticTerminate();
+		static EventBus* Get();
+
+	public:
+		static constexpr uint32_t kMaxEventTypes = 256;
+
+		EventBus() = default;
+		~EventBus();
+
+		EventBus(const EventBus&) = delete;
+		EventBus& operator=(const EventBus&) = delete;
+
+		template <class EventType>
+		void Post(EventType event)
+		{
+			GetChannel<EventType>().Post(std::move(event));
+		}
+
+		template <class EventType>
+		void Publish(const EventType& event)
+		{
+			GetChannel<EventType>().Publish(event);
+		}
+
+		// Member function, the instance must outlive the subscription
+		template <auto Method>
+		EventHandlerId Subscribe(typename Detail::MethodTraits<decltype(Method)>::ClassType* instance)
+		{
+			using Traits = Detail::MethodTraits<decltype(Method)>;
+			using EventType = typename Traits::EventType;
+			return GetChannel<EventType>().Subscribe([](void* context, const EventType& event)
+			{
+				(static_cast<typename Traits::ClassType*>(context)->*Method)(event);
+			}, instance);
+		}
+
+		// Any callable, stored once and invoked through a plain function pointer
+		template <class EventType, class Callable>
+		EventHandlerId Subscribe(Callable&& callable)
+		{
+			using CallableType = std::decay_t<Callable>;
+			auto owner = std::make_shared<CallableType>(std::forward<Callable>(callable));
+			void* context = owner.get();
+			return GetChannel<EventType>().Subscribe([](void* context, const EventType& event)
+			{
+				(*static_cast<CallableType*>(context))(event);
+			}, context, std::move(owner));
+		}
+
+		template <class EventType>
+		bool Unsubscribe(EventHandlerId id)
+		{
+			return GetChannel<EventType>().Unsubscribe(id);
+		}
+
+		// Delivers everything posted since the last call, one event type at a time
+		void Dispatch();
+
+		template <class EventType>
+		EventChannel<EventType>& GetChannel()
+		{
+			const uint32_t index = Detail::GetEventTypeIndex<EventType>();
+			ASSERT(index < kMaxEventTypes, "EventBus -- Too many event types.");
+
+			auto channel = mChannels[index].load(std::memory_order_acquire);
+			if (channel == nullptr)
+			{
+				// First use of this type, if another thread beats us we use theirs
+				auto newChannel = new EventChannel<EventType>();
+				if (mChannels[index].compare_exchange_strong(channel, newChannel, std::memory_order_acq_rel))
+					channel = newChannel;
+				else
+					delete newChannel;
+			}
+			return *static_cast<EventChannel<EventType>*>(channel);
+		}
+
+	private:
+		std::array<std::atomic<Detail::EventChannelBase*>, kMaxEventTypes> mChannels{};
+	};
+}
@@ -42,37 +42,47 @@ namespace Angazi::Core
 	template <class... Args>
 	std::atomic_uint EventHandler<Args...>::sNextHandlerId = 0;
 
+	// Handlers live in a contiguous array that is copied on write, so a handler can add or
+	// remove handlers while the event is being notified. Main thread only, use EventBus to
+	// raise events from other threads.
 	template <class... Args>
 	class Event
 	{
 	public:
 		using HandlerType = EventHandler<Args...>;
 		using HandlerFunc = typename HandlerType::EventHandlerFunc;
-		using HandlerList = std::list<HandlerType>;
+		using HandlerList = std::vector<HandlerType>;
 
 		EventHandlerId Add(HandlerFunc handlerFunc)
 		{
-			auto& handler = mHandlerList.emplace_back(std::move(handlerFunc));
-			return handler.GetId();
+			auto handlerList = std::make_shared<HandlerList>(*mHandlerList);
+			auto& handler = handlerList->emplace_back(std::move(handlerFunc));
+			const EventHandlerId handlerId = handler.GetId();
+			mHandlerList = std::move(handlerList);
+			return handlerId;
 		}
 
 		bool Remove(const EventHandlerId& handlerId)
 		{
-			auto iter = std::find_if(mHandlerList.begin(), mHandlerList.end(), [handlerId](const HandlerType& handler)
+			auto iter = std::find_if(mHandlerList->begin(), mHandlerList->end(), [handlerId](const HandlerType& handler)
 			{
 				return handler.GetId() == handlerId;
 			});
 
-			if (iter == mHandlerList.end())
+			if (iter == mHandlerList->end())
 				return false;
 
-			mHandlerList.erase(iter);
+			auto handlerList = std::make_shared<HandlerList>(*mHandlerList);
+			handlerList->erase(handlerList->begin() + (iter - mHandlerList->begin()));
+			mHandlerList = std::move(handlerList);
 			return true;
 		}
 
 		void Notify(Args... params) const
 		{
-			for (const auto& handler : mHandlerList)
+			// Hold on to this version of the list in case a handler changes it
+			auto handlerList = mHandlerList;
+			for (const auto& handler : *handlerList)
 				handler(params...);
 		}
 
@@ -82,6 +92,6 @@ namespace Angazi::Core
 		void operator()(Args... params) const { Notify(params...); }
 
 	private:
-		HandlerList mHandlerList;
+		std::shared_ptr<const HandlerList> mHandlerList = std::make_shared<const HandlerList>();
 	};
 }
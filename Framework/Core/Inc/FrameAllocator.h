@@ -0,0 +1,57 @@
+#pragma once
+
+#include "LinearAllocator.h"
+
+namespace Angazi::Core
+{
+	// Memory that lives for one or two frames. The App calls EndFrame once per frame, which
+	// rewinds the frame arena and flips the double buffered arenas. Main thread only, jobs
+	// should use a ScratchScope instead.
+	class FrameAllocator
+	{
+	public:
+		static void StaticInitialize(size_t capacity = 1024 * 1024);
+		static void StaticTerminate();
+		static FrameAllocator* Get();
+
+	public:
+		explicit FrameAllocator(size_t capacity);
+
+		// Valid until the end of this frame
+		LinearAllocator& GetFrameArena() { return mFrameArena; }
+
+		// Valid until the end of the next frame, for results that are read one frame later
+		LinearAllocator& GetDoubleBufferedArena() { return mCurrentBuffer == 0 ? mBuffer0 : mBuffer1; }
+
+		void EndFrame();
+
+	private:
+		LinearAllocator mFrameArena;
+		LinearAllocator mBuffer0;
+		LinearAllocator mBuffer1;
+		int mCurrentBuffer = 0;
+	};
+
+	// Each thread owns a scratch stack. A scope hands out memory from the top of the stack
+	// and rewinds it on destruction, so scopes must be destroyed in reverse order.
+	//
+	//	ScratchScope scratch;
+	//	ArenaVector<int> values(scratch.GetArena());
+	class ScratchScope
+	{
+	public:
+		ScratchScope();
+		~ScratchScope();
+
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+
+		LinearAllocator& GetArena() { return mArena; }
+
+	private:
+		LinearAllocator& mArena;
+		LinearAllocator::Marker mMarker;
+	};
+
+	LinearAllocator& GetScratchAllocator();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Angazi::Core
+{
+	// FNV-1a, usable at compile time
+	constexpr uint32_t kFnvOffsetBasis = 2166136261u;
+	constexpr uint32_t kFnvPrime = 16777619u;
+
+	constexpr uint32_t HashFnv1a(const char* str, uint32_t hash = kFnvOffsetBasis)
+	{
+		while (*str)
+		{
+			hash ^= static_cast<uint8_t>(*str++);
+			hash *= kFnvPrime;
+		}
+		return hash;
+	}
+
+	inline uint32_t HashFnv1a(const void* data, size_t size, uint32_t hash = kFnvOffsetBasis)
+	{
+		auto bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= kFnvPrime;
+		}
+		return hash;
+	}
+}
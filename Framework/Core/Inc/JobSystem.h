@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Angazi::Core
+{
+	class JobSystem;
+
+	// Tracks a group of jobs, the group is done when the counter drops back to zero.
+	// Jobs can be scheduled to start once a counter is done, see JobSystem::RunAfter.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool IsDone() const { return mCount.load(std::memory_order_acquire) == 0; }
+		int GetValue() const { return mCount.load(std::memory_order_acquire); }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<int> mCount{ 0 };
+		mutable std::mutex mContinuationMutex;
+		std::vector<std::pair<std::function<void()>, JobCounter*>> mContinuations;
+	};
+
+	// Work stealing job scheduler. Every worker owns a deque, it pushes and pops its own jobs
+	// at the back and steals from the front of other deques when it runs dry. Threads that
+	// are not workers (e.g. the main thread) share deque 0. Waiting on a counter runs pending
+	// jobs instead of blocking, so waiting from inside a job never deadlocks the pool.
+	class JobSystem
+	{
+	public:
+		static void StaticInitialize(uint32_t workerCount = 0); // 0 = one worker per hardware thread, minus the caller
+		static void StaticTerminate();
+		static JobSystem* Get();
+		static bool IsInitialized(); // for code that can run with or without the system, e.g. Math::Batch
+
+	public:
+		JobSystem() = default;
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		void Initialize(uint32_t workerCount);
+		void Terminate();
+
+		// Queues a job, 'counter' is incremented now and decremented when the job finishes
+		void Run(std::function<void()> job, JobCounter* counter = nullptr);
+
+		// Queues a job once 'dependency' is done, or right away if it already is
+		void RunAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter = nullptr);
+
+		// Runs other jobs on the calling thread until 'counter' is done
+		void Wait(const JobCounter& counter);
+
+		// Calls 'body(begin, end)' over [0, count) split into chunks, and waits for all of them.
+		// A grain size of 0 picks one that gives every thread a few chunks to balance load.
+		void ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body, size_t grainSize = 0);
+
+		// Worker threads plus the calling thread
+		uint32_t GetThreadCount() const { return static_cast<uint32_t>(mWorkers.size()) + 1; }
+
+	private:
+		struct Job
+		{
+			std::function<void()> task;
+			JobCounter* counter = nullptr;
+		};
+
+		struct WorkQueue
+		{
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+		void Push(Job job);
+		bool TryPop(Job& job);
+		void Execute(Job& job);
+		void WorkerLoop(uint32_t queueIndex);
+
+		std::vector<std::unique_ptr<WorkQueue>> mQueues;
+		std::vector<std::thread> mWorkers;
+		std::mutex mWakeMutex;
+		std::condition_variable mWakeCondition;
+		std::atomic<int> mPendingJobs{ 0 };
+		std::atomic<bool> mRunning{ false };
+	};
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Angazi::Core
+{
+	// Bump allocator for short lived data. Allocations are never freed one by one, the whole
+	// allocator is rewound with Reset or RewindTo. When a chunk runs out another one is added,
+	// and the next full Reset merges them into a single chunk, so after a few warm up frames
+	// the allocator stops touching the heap. Not thread safe.
+	class LinearAllocator
+	{
+	public:
+		struct Marker
+		{
+			size_t chunk = 0;
+			size_t offset = 0;
+		};
+
+		explicit LinearAllocator(size_t capacity);
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		LinearAllocator(LinearAllocator&&) = delete;
+		LinearAllocator& operator=(LinearAllocator&&) = delete;
+
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		// Only gives the memory back if 'ptr' was the last allocation, which lets containers
+		// grow in place at the top of the allocator
+		void Free(void* ptr, size_t size);
+
+		template <class T>
+		T* Allocate(size_t count)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		Marker GetMarker() const { return { mCurrentChunk, mOffset }; }
+		void RewindTo(Marker marker);
+		void Reset();
+
+		size_t GetUsed() const;
+		size_t GetCapacity() const;
+		size_t GetHighWaterMark() const { return mHighWaterMark; }
+
+	private:
+		struct Chunk
+		{
+			uint8_t* data = nullptr;
+			size_t size = 0;
+		};
+
+		std::vector<Chunk> mChunks;
+		size_t mCurrentChunk = 0;
+		size_t mOffset = 0;
+		size_t mHighWaterMark = 0;
+	};
+
+	// STL allocator that draws from a LinearAllocator. Memory is only reclaimed when the
+	// LinearAllocator is rewound, so the container must not outlive that.
+	template <class T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator(LinearAllocator& arena) noexcept
+			: mArena(&arena)
+		{}
+
+		template <class U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+			: mArena(other.GetArena())
+		{}
+
+		T* allocate(size_t count)
+		{
+			return mArena->Allocate<T>(count);
+		}
+
+		void deallocate(T* ptr, size_t count) noexcept
+		{
+			mArena->Free(ptr, sizeof(T) * count);
+		}
+
+		LinearAllocator* GetArena() const noexcept { return mArena; }
+
+		template <class U>
+		bool operator==(const ArenaAllocator<U>& other) const noexcept { return mArena == other.GetArena(); }
+		template <class U>
+		bool operator!=(const ArenaAllocator<U>& other) const noexcept { return mArena != other.GetArena(); }
+
+	private:
+		LinearAllocator* mArena;
+	};
+
+	template <class T>
+	using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
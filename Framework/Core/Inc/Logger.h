@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Angazi::Core
+{
+	// Per call site state for rate limiting, LOG declares one of these as a local static
+	struct LogRateLimit
+	{
+		std::atomic<uint32_t> window{ 0 };
+		std::atomic<uint32_t> count{ 0 };
+	};
+
+	// Asynchronous backend for LOG and ASSERT. Callers format straight into a slot of a bounded
+	// lock-free ring and return. A background thread stamps the time and writes the records to
+	// the sinks. When the ring is full the record is dropped and counted rather than blocking.
+	//
+	// The editor sink does not call into the editor from the logger thread. Lines are queued and
+	// DispatchEvents fires Core::OnDebugLog for them on the main thread.
+	class Logger
+	{
+	public:
+		struct Settings
+		{
+			uint32_t capacity = 4096;				// records, rounded up to a power of two
+			uint32_t maxPerSitePerSecond = 100;		// 0 disables rate limiting
+			bool debuggerSink = true;				// OutputDebugString, stderr on other platforms
+			bool consoleSink = false;				// stdout
+			bool editorSink = true;					// Core::OnDebugLog
+			std::filesystem::path filePath;			// empty disables the file sink
+		};
+
+		static void StaticInitialize(const Settings& settings);
+		static void StaticTerminate();
+		static Logger* Get();
+
+	public:
+		static constexpr size_t kMaxMessageLength = 496;	// longer messages are truncated
+
+		explicit Logger(const Settings& settings);
+		~Logger();
+
+		Logger(const Logger&) = delete;
+		Logger& operator=(const Logger&) = delete;
+
+		// Formats and queues one message. Returns false if it was dropped or rate limited.
+		bool Write(LogRateLimit* rateLimit, const char* format, va_list args);
+
+		// Blocks until everything queued so far has reached the sinks
+		void Flush();
+
+		// Fires OnDebugLog for lines queued by the editor sink, call once per frame on the main thread
+		void DispatchEvents();
+
+		uint64_t GetDroppedCount() const { return mDroppedCount.load(std::memory_order_relaxed); }
+		uint64_t GetRateLimitedCount() const { return mRateLimitedCount.load(std::memory_order_relaxed); }
+
+	private:
+		struct Record
+		{
+			std::atomic<size_t> sequence;
+			float time;
+			uint32_t length;
+			char text[kMaxMessageLength];
+		};
+
+		void Run();
+		bool Consume();
+		void WriteLine(float time, const char* text, size_t length);
+
+		const Settings mSettings;
+
+		std::unique_ptr<Record[]> mRecords;
+		size_t mMask = 0;
+		alignas(64) std::atomic<size_t> mEnqueuePos{ 0 };
+		alignas(64) std::atomic<size_t> mDequeuePos{ 0 };	// written by the logger thread only
+
+		std::atomic<uint64_t> mDroppedCount{ 0 };
+		std::atomic<uint64_t> mRateLimitedCount{ 0 };
+		uint64_t mReportedCount = 0;
+
+		std::thread mThread;
+		std::mutex mMutex;
+		std::condition_variable mWakeUp;
+		std::condition_variable mFlushed;
+		size_t mFlushTarget = 0;
+		bool mRunning = true;
+
+		FILE* mFile = nullptr;
+
+		std::mutex mEventMutex;
+		std::vector<std::string> mPendingEvents;
+		std::vector<std::string> mDispatchEvents;
+	};
+
+	// Used by LOG and ASSERT. Before the logger is initialized these write synchronously.
+	void LogWrite(LogRateLimit* rateLimit, const char* format, ...);
+	void LogFlush();
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Common.h"
+
+// Memory tracking. Owners report what they allocate and free against a category, the tracker
+// keeps live bytes, peak and allocation counts per category and per frame. Budgets flag a
+// category once its live bytes go over, and a snapshot can be exported as JSON so two builds
+// can be diffed. All functions are thread safe.
+//
+// Call sites use the TRACK_ macros so the tracking compiles out without ENABLE_MEMORY_TRACKER.
+
+namespace Angazi::Core
+{
+	enum class MemoryCategory : uint8_t
+	{
+		General,
+		Allocator,		// backing storage of the Core allocators
+		Container,		// STL containers using TrackingAllocator
+		Texture,		// GPU memory, estimated from the texture description
+		Model,			// CPU side model data
+		MeshBuffer,		// GPU vertex and index buffers
+		Count
+	};
+}
+
+namespace Angazi::Core::MemoryTracker
+{
+	struct CategoryStats
+	{
+		int64_t liveBytes = 0;
+		int64_t peakBytes = 0;
+		int64_t liveCount = 0;
+		uint64_t totalCount = 0;		// allocations since the last reset
+		uint64_t frameCount = 0;		// allocations during the last completed frame
+		uint64_t budget = 0;			// bytes, 0 means no budget
+	};
+
+	struct CallstackSample
+	{
+		static constexpr size_t kMaxFrames = 16;
+
+		std::array<void*, kMaxFrames> frames{};
+		uint32_t frameCount = 0;
+		MemoryCategory category = MemoryCategory::General;
+		size_t size = 0;
+		uint64_t frameIndex = 0;
+	};
+
+	constexpr size_t kMaxCallstackSamples = 1024;
+
+	const char* GetCategoryName(MemoryCategory category);
+
+	void RecordAllocation(MemoryCategory category, size_t size);
+	void RecordFree(MemoryCategory category, size_t size);
+
+	// Closes the allocation counts of this frame and logs categories that just went over
+	// budget. The App calls this once per frame.
+	void EndFrame();
+
+	CategoryStats GetStats(MemoryCategory category);
+
+	// 0 removes the budget
+	void SetBudget(MemoryCategory category, size_t bytes);
+
+	// Adds the categories that are over budget right now, returns how many were added
+	size_t CheckBudgets(std::vector<MemoryCategory>& overBudget);
+
+	// Captures the callstack of every Nth allocation, 0 turns sampling off. Only the most
+	// recent kMaxCallstackSamples are kept.
+	void SetCallstackSampling(uint32_t interval);
+	void CollectCallstackSamples(std::vector<CallstackSample>& samples);
+
+	bool ExportJson(const std::filesystem::path& path);
+
+	// Clears the counts and samples and restarts the peak from the live bytes. Live bytes and
+	// budgets are kept, since the memory they describe is still out there.
+	void Reset();
+}
+
+#if defined(ENABLE_MEMORY_TRACKER)
+#define TRACK_ALLOCATION(category, size) Angazi::Core::MemoryTracker::RecordAllocation(category, size)
+#define TRACK_FREE(category, size) Angazi::Core::MemoryTracker::RecordFree(category, size)
+#else
+#define TRACK_ALLOCATION(category, size) ((void)0)
+#define TRACK_FREE(category, size) ((void)0)
+#endif
+
+namespace Angazi::Core
+{
+	// STL allocator that reports to the tracker, for containers worth watching:
+	//	std::vector<Particle, TrackingAllocator<Particle>> particles;
+	template <class T, MemoryCategory Category = MemoryCategory::Container>
+	class TrackingAllocator
+	{
+	public:
+		using value_type = T;
+
+		template <class U>
+		struct rebind { using other = TrackingAllocator<U, Category>; };
+
+		TrackingAllocator() = default;
+		template <class U>
+		TrackingAllocator(const TrackingAllocator<U, Category>&) {}
+
+		T* allocate(size_t count)
+		{
+			TRACK_ALLOCATION(Category, count * sizeof(T));
+			return static_cast<T*>(::operator new(count * sizeof(T)));
+		}
+
+		void deallocate(T* ptr, size_t count)
+		{
+			TRACK_FREE(Category, count * sizeof(T));
+			::operator delete(ptr);
+		}
+
+		template <class U>
+		bool operator==(const TrackingAllocator<U, Category>&) const { return true; }
+		template <class U>
+		bool operator!=(const TrackingAllocator<U, Category>&) const { return false; }
+	};
+
+	template <class T, MemoryCategory Category = MemoryCategory::Container>
+	using TrackedVector = std::vector<T, TrackingAllocator<T, Category>>;
+}
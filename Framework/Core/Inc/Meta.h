@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Hash.h"
 #include "MetaArray.h"
+#include "MetaBinary.h"
 #include "MetaClass.h"
 #include "MetaField.h"
 #include "MetaPointer.h"
@@ -20,14 +22,18 @@
 		static const Angazi::Core::Meta::MetaType sMetaType(\
 			Angazi::Core::Meta::MetaType::Category::Primitive,#Name, sizeof(Type),\
 			Angazi::Core::Meta::Deserialize<Type>,\
-			Angazi::Core::Meta::Serialize<Type>);\
+			Angazi::Core::Meta::Serialize<Type>,\
+			Angazi::Core::Meta::DeserializeBinary<Type>,\
+			Angazi::Core::Meta::SerializeBinary<Type>,\
+			std::is_trivially_copyable_v<Type>);\
 		return &sMetaType;\
 	}
 
 // -------------------------------------------------------------------------------------------------------------------
 
 ////////////////////////////// Meta Class Macros /////////////////////////////
-#define META_CLASS_DECLARE\
+#define META_CLASS_DECLARE(ClassType)\
+	static constexpr uint32_t StaticGetTypeId() { return Angazi::Core::HashFnv1a(#ClassType); }\
 	static const Angazi::Core::Meta::MetaClass* StaticGetMetaClass();\
 	virtual const Angazi::Core::Meta::MetaClass* GetMetaClass() const { return StaticGetMetaClass(); }
 
@@ -46,6 +52,7 @@
 	}\
 	const Angazi::Core::Meta::MetaClass* ClassType::StaticGetMetaClass()\
 	{\
+		static_assert(ClassType::StaticGetTypeId() == Angazi::Core::HashFnv1a(#ClassType), "META_CLASS_DECLARE and META_CLASS_BEGIN must use the same class name.");\
 		using Class = ClassType;\
 		const char* className = #ClassType;
 
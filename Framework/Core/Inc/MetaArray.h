@@ -7,11 +7,27 @@ namespace Angazi::Core::Meta
 	class MetaArray : public MetaType
 	{
 	public:
-		MetaArray(const MetaType* elementType);
+		using GetCountFunc = std::function<size_t(const void* instance)>;
+		using ResizeFunc = std::function<void(void* instance, size_t count)>;
+		using GetDataFunc = std::function<void*(void* instance)>;
+
+		MetaArray(const MetaType* elementType, GetCountFunc getCount, ResizeFunc resize, GetDataFunc getData);
 
 		const MetaType* GetElementType() const { return mElementType; }
 
+		size_t GetCount(const void* instance) const { return mGetCount(instance); }
+		void Resize(void* instance, size_t count) const { mResize(instance, count); }
+		void* GetData(void* instance) const { return mGetData(instance); }
+		const void* GetData(const void* instance) const { return mGetData(const_cast<void*>(instance)); }
+
+		// Element count followed by the elements, copied in one go if they are trivially copyable
+		bool DeserializeBinary(void* instance, BinaryReader& reader) const override;
+		void SerializeBinary(const void* instance, BinaryWriter& writer) const override;
+
 	private:
 		const MetaType* const mElementType;
+		const GetCountFunc mGetCount;
+		const ResizeFunc mResize;
+		const GetDataFunc mGetData;
 	};
 }
@@ -0,0 +1,37 @@
+#pragma once
+
+namespace Angazi::Core
+{
+	class BinaryReader;
+	class BinaryWriter;
+}
+
+namespace Angazi::Core::Meta
+{
+	class MetaType;
+
+	template <class DataType>
+	const MetaType* GetMetaType();
+
+	// Hash of the type names, field names and primitive sizes that make up the binary form
+	// of a type. Saved data carries it so loading can reject data from another version.
+	uint32_t GetSchemaHash(const MetaType* metaType);
+
+	// Schema hash followed by the instance
+	void SaveBinary(const MetaType* metaType, const void* instance, BinaryWriter& writer);
+
+	// Returns false if the schema hash does not match or the data ends early
+	bool LoadBinary(const MetaType* metaType, void* instance, BinaryReader& reader);
+
+	template <class DataType>
+	void SaveBinary(const DataType& instance, BinaryWriter& writer)
+	{
+		SaveBinary(GetMetaType<DataType>(), &instance, writer);
+	}
+
+	template <class DataType>
+	bool LoadBinary(DataType& instance, BinaryReader& reader)
+	{
+		return LoadBinary(GetMetaType<DataType>(), &instance, reader);
+	}
+}
@@ -11,8 +11,19 @@ namespace Angazi::Core::Meta
 	public:
 		using CreateFunc = std::function<void*()>;
 
+		// Part of an instance in binary form. Runs without a type are raw bytes, adjacent
+		// trivially copyable fields (including those of parents and nested classes) share one run.
+		struct BinaryRun
+		{
+			size_t offset;
+			size_t size;
+			const MetaType* type;
+		};
+
 		MetaClass(const char* name, size_t size, const MetaClass* parent, std::vector<MetaField> fields, CreateFunc create);
 
+		// FNV-1a hash of the name, same as StaticGetTypeId of the class
+		uint32_t GetTypeId() const { return mTypeId; }
 		const MetaClass* GetParent() const;
 		const MetaField* FindField(const char* name) const;
 		const MetaField* GetField(size_t index) const;
@@ -22,11 +33,19 @@ namespace Angazi::Core::Meta
 		void Deserialize(void* classInstance, const rapidjson::Value& jsonValue) const;
 		void Serialize(const void* classInstance, rapidjson::Value& jsonValue, rapidjson::Document& document) const;
 
+		bool DeserializeBinary(void* classInstance, BinaryReader& reader) const override;
+		void SerializeBinary(const void* classInstance, BinaryWriter& writer) const override;
+
+		const std::vector<BinaryRun>& GetBinaryRuns() const { return mBinaryRuns; }
+
 	private:
 		size_t GetParentFieldCount() const;
+		void AddBinaryRun(size_t offset, size_t size, const MetaType* type);
 
+		const uint32_t mTypeId;
 		const MetaClass* mParent;
 		const std::vector<MetaField> mFields;
+		std::vector<BinaryRun> mBinaryRuns;
 
 		const CreateFunc mCreate;
 	};
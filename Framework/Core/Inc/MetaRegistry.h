@@ -10,7 +10,11 @@ namespace Angazi::Core::Meta
 	// Look up meta class by name
 	const MetaClass* FindMetaClass(const char* className);
 
-	const std::map<std::string, const Meta::MetaClass*> GetAllMetaClasses();
+	// Look up meta class by type id, returns nullptr if it is not registered
+	const MetaClass* FindMetaClass(uint32_t typeId);
+
+	// All registered meta classes, sorted by name
+	const std::vector<const MetaClass*>& GetAllMetaClasses();
 }
 
 #define META_REGISTER(Class)\
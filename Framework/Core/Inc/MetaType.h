@@ -1,5 +1,11 @@
 #pragma once
 
+namespace Angazi::Core
+{
+	class BinaryReader;
+	class BinaryWriter;
+}
+
 namespace Angazi::Core::Meta
 {
 	class MetaArray;
@@ -11,6 +17,8 @@ namespace Angazi::Core::Meta
 	public:
 		using DeserializeFunc = std::function<void(void* instance, const rapidjson::Value& jsonValue)>;
 		using SerializeFunc = std::function<void(const void* instance, rapidjson::Value& jsonValue, rapidjson::Document& document)>;
+		using DeserializeBinaryFunc = std::function<bool(void* instance, BinaryReader& reader)>;
+		using SerializeBinaryFunc = std::function<void(const void* instance, BinaryWriter& writer)>;
 
 		enum class Category
 		{
@@ -20,7 +28,8 @@ namespace Angazi::Core::Meta
 			Pointer
 		};
 
-		MetaType(Category category, const char* name, size_t size, DeserializeFunc deserialize = nullptr, SerializeFunc serialize = nullptr);
+		MetaType(Category category, const char* name, size_t size, DeserializeFunc deserialize = nullptr, SerializeFunc serialize = nullptr,
+			DeserializeBinaryFunc deserializeBinary = nullptr, SerializeBinaryFunc serializeBinary = nullptr, bool triviallyCopyable = false);
 
 		const MetaArray* AsMetaArray() const;
 		const MetaClass* AsMetaClass() const;
@@ -30,14 +39,23 @@ namespace Angazi::Core::Meta
 		const char* GetName() const { return mName.c_str(); }
 		size_t GetSize() const { return mSize; }
 
+		// True if the binary form is just the bytes of the instance
+		bool IsTriviallyCopyable() const { return mTriviallyCopyable; }
+
 		virtual void Deserialize(void* instance, const rapidjson::Value& jsonValue) const;
 		virtual void Serialize(const void* instance, rapidjson::Value& jsonValue, rapidjson::Document& document) const;
 
+		virtual bool DeserializeBinary(void* instance, BinaryReader& reader) const;
+		virtual void SerializeBinary(const void* instance, BinaryWriter& writer) const;
+
 	private:
 		const Category mCategory;
 		const std::string mName;
 		const size_t mSize;
 		const DeserializeFunc mDeserialize;
 		const SerializeFunc mSerialize;
+		const DeserializeBinaryFunc mDeserializeBinary;
+		const SerializeBinaryFunc mSerializeBinary;
+		const bool mTriviallyCopyable;
 	};
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "BinaryStream.h"
+
 namespace Angazi::Core::Meta
 {
 	class MetaType;
@@ -7,15 +9,30 @@ namespace Angazi::Core::Meta
 	template <class DataType>
 	const MetaType* GetMetaType();
 
+	// The asserts depend on DataType so only an instantiation fires them
 	template< class DataType>
 	void Deserialize(void* instance, const rapidjson::Value& value)
 	{
-		static_assert(false, "No specialization found for deserializing this type.");
+		static_assert(sizeof(DataType) == 0, "No specialization found for deserializing this type.");
 	}
 	template< class DataType>
 	void Serialize(const void* instance, rapidjson::Value& value, rapidjson::Document& document)
 	{
-		static_assert(false, "No specialization found for serializing this type.");
+		static_assert(sizeof(DataType) == 0, "No specialization found for serializing this type.");
+	}
+
+	// Trivially copyable types are written as raw bytes, anything else needs a specialization
+	template <class DataType>
+	bool DeserializeBinary(void* instance, BinaryReader& reader)
+	{
+		static_assert(std::is_trivially_copyable_v<DataType>, "No specialization found for binary deserializing this type.");
+		return reader.Read(instance, sizeof(DataType));
+	}
+	template <class DataType>
+	void SerializeBinary(const void* instance, BinaryWriter& writer)
+	{
+		static_assert(std::is_trivially_copyable_v<DataType>, "No specialization found for binary serializing this type.");
+		writer.Write(instance, sizeof(DataType));
 	}
 
 	namespace Detail
@@ -36,7 +53,11 @@ namespace Angazi::Core::Meta
 		template < class DataType>
 		inline const MetaType* GetMetaTypeImpl(std::vector<DataType>*)
 		{
-			static const MetaArray sMetaAarray(GetMetaType<DataType>());
+			using ArrayType = std::vector<DataType>;
+			static const MetaArray sMetaAarray(GetMetaType<DataType>(),
+				[](const void* instance) { return static_cast<const ArrayType*>(instance)->size(); },
+				[](void* instance, size_t count) { static_cast<ArrayType*>(instance)->resize(count); },
+				[](void* instance) -> void* { return static_cast<ArrayType*>(instance)->data(); });
 			return &sMetaAarray;
 		}
 	}
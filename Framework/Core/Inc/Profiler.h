@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Common.h"
+
+// CPU profiler. Every thread records into its own fixed size ring buffer without locking, so
+// the buffers always hold the most recent events. When a thread exits its buffer is reused by
+// the next new thread once its events have been collected. Export writes them as Chrome trace JSON,
+// open the file in chrome://tracing or ui.perfetto.dev to see a per-thread timeline.
+//
+// Names are stored by pointer and must outlive the capture, use string literals.
+
+namespace Angazi::Core::Profiler
+{
+	enum class EventType : uint8_t
+	{
+		Scope,
+		Counter,
+		Frame
+	};
+
+	struct Event
+	{
+		const char* name = nullptr;
+		uint64_t timestamp = 0;		// ns since the profiler started
+		uint64_t duration = 0;		// ns, scopes only
+		double value = 0.0;			// counters only
+		EventType type = EventType::Scope;
+	};
+
+	constexpr size_t kEventsPerThread = 64 * 1024;
+
+	// Nanoseconds since the first profiler call
+	uint64_t GetTimestamp();
+
+	void SetEnabled(bool enabled);
+	bool IsEnabled();
+
+	// Shows up as the track name in the trace, call once per thread
+	void SetThreadName(const char* name);
+
+	void RecordScope(const char* name, uint64_t start, uint64_t end);
+	void RecordCounter(const char* name, double value);
+	void MarkFrame();
+	uint64_t GetFrameIndex();
+
+	// Copies the events of every thread, oldest first, 'threadIndex' tells them apart. Events
+	// of threads that have exited are returned once.
+	void CollectEvents(std::vector<std::pair<uint32_t, Event>>& events);
+
+	// Ring buffers allocated so far, live threads plus the ones waiting for reuse
+	size_t GetThreadBufferCount();
+
+	bool ExportChromeTrace(const std::filesystem::path& path);
+	void Clear();
+
+	class ScopedEvent
+	{
+	public:
+		explicit ScopedEvent(const char* name)
+			: mName(name)
+			, mActive(IsEnabled())
+			, mStart(mActive ? GetTimestamp() : 0)
+		{}
+
+		~ScopedEvent()
+		{
+			if (mActive)
+				RecordScope(mName, mStart, GetTimestamp());
+		}
+
+		ScopedEvent(const ScopedEvent&) = delete;
+		ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+	private:
+		const char* mName;
+		bool mActive;
+		uint64_t mStart;
+	};
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if defined(ENABLE_PROFILER)
+#define PROFILE_SCOPE(name) Angazi::Core::Profiler::ScopedEvent PROFILE_CONCAT(_profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_FRAME() Angazi::Core::Profiler::MarkFrame()
+#define PROFILE_COUNTER(name, value) Angazi::Core::Profiler::RecordCounter(name, static_cast<double>(value))
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_FRAME()
+#define PROFILE_COUNTER(name, value)
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BlockAllocator.h"
+#include "ConcurrentBlockAllocator.h"
 
 namespace Angazi::Core
 {
@@ -31,4 +32,34 @@ namespace Angazi::Core
 			Free(ptr);
 		}
 	};
+
+	template <class DataType>
+	class ConcurrentTypedAllocator : private ConcurrentBlockAllocator
+	{
+	public:
+		ConcurrentTypedAllocator(size_t blocksPerPage = 256, size_t maxPages = 0)
+			:ConcurrentBlockAllocator(sizeof(DataType), blocksPerPage, alignof(DataType), maxPages)
+		{
+		}
+
+		template <class... Args>
+		DataType* New(Args&&... args)
+		{
+			void* ptr = Allocate();
+			if (ptr == nullptr)
+				return nullptr;
+			return new(ptr) DataType(std::forward<Args>(args)...);
+		}
+
+		void Delete(DataType* ptr)
+		{
+			if (ptr == nullptr)
+				return;
+			ptr->~DataType();
+			Free(ptr);
+		}
+
+		using ConcurrentBlockAllocator::FlushThreadCache;
+		using ConcurrentBlockAllocator::GetStats;
+	};
 }
\ No newline at end of file
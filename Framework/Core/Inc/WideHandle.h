@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Common.h"
+
+namespace Angazi::Core
+{
+	template <class DataType>
+	class DenseHandlePool;
+
+	// Handle with a full 32 bit index and generation, for pools that outgrow the 16 bit Handle
+	template <class DataType>
+	class WideHandle
+	{
+	public:
+		WideHandle() = default; // index 0 is never used, so this is an invalid handle
+
+		bool IsValid() const
+		{
+			return sPool && sPool->IsValid(*this);
+		}
+		void Invalidate()
+		{
+			*this = WideHandle();
+		}
+
+		DataType* Get() const
+		{
+			return sPool ? sPool->Get(*this) : nullptr;
+		}
+		DataType* operator->() const
+		{
+			return sPool ? sPool->Get(*this) : nullptr;
+		}
+		DataType& operator*() const
+		{
+			return *(sPool->Get(*this));
+		}
+
+		bool operator==(WideHandle rhs) const { return mIndex == rhs.mIndex && mGeneration == rhs.mGeneration; }
+		bool operator!=(WideHandle rhs) const { return !(*this == rhs); }
+
+	private:
+		friend class DenseHandlePool<DataType>;
+		static DenseHandlePool<DataType>* sPool;
+
+		uint32_t mIndex = 0;
+		uint32_t mGeneration = 0;
+	};
+
+	template <class DataType>
+	DenseHandlePool<DataType>* WideHandle<DataType>::sPool = nullptr;
+}
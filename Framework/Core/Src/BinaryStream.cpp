@@ -0,0 +1,47 @@
+#include "Precompiled.h"
+#include "BinaryStream.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+void MemoryWriter::Write(const void* data, size_t size)
+{
+	auto bytes = static_cast<const uint8_t*>(data);
+	mData.insert(mData.end(), bytes, bytes + size);
+}
+
+MemoryReader::MemoryReader(const void* data, size_t size)
+	: mData(static_cast<const uint8_t*>(data))
+	, mSize(size)
+{
+}
+
+bool MemoryReader::Read(void* data, size_t size)
+{
+	if (size > mSize - mHead)
+		return false;
+	memcpy(data, mData + mHead, size);
+	mHead += size;
+	return true;
+}
+
+FileWriter::FileWriter(const std::filesystem::path& path)
+	: mFile(path, std::ios::binary)
+{
+}
+
+void FileWriter::Write(const void* data, size_t size)
+{
+	mFile.write(static_cast<const char*>(data), size);
+}
+
+FileReader::FileReader(const std::filesystem::path& path)
+	: mFile(path, std::ios::binary)
+{
+}
+
+bool FileReader::Read(void* data, size_t size)
+{
+	mFile.read(static_cast<char*>(data), size);
+	return static_cast<size_t>(mFile.gcount()) == size;
+}
@@ -2,6 +2,7 @@
 #include "BlockAllocator.h"
 
 #include "DebugUtil.h"
+#include "MemoryTracker.h"
 
 using namespace Angazi;
 using namespace Angazi::Core;
@@ -12,6 +13,7 @@ BlockAllocator::BlockAllocator(size_t blockSize, size_t capacity)
 	ASSERT(capacity > 0, "BlockAllocator -- Invalid capacity.");
 
 	mData = malloc(blockSize* capacity);
+	TRACK_ALLOCATION(MemoryCategory::Allocator, blockSize * capacity);
 	mFreeSlots.resize(capacity);
 	for (size_t i = 0; i < capacity; ++i)
 		mFreeSlots[i] = i;
@@ -20,6 +22,7 @@ BlockAllocator::BlockAllocator(size_t blockSize, size_t capacity)
 BlockAllocator::~BlockAllocator()
 {
 	free(mData);
+	TRACK_FREE(MemoryCategory::Allocator, mBlockSize * mCapacity);
 	mData = nullptr;
 }
 
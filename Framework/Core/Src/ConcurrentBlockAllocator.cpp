@@ -0,0 +1,248 @@
+#include "Precompiled.h"
+#include "ConcurrentBlockAllocator.h"
+
+#include "DebugUtil.h"
+#include "MemoryTracker.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+namespace
+{
+	// Blocks a thread may hold before half of them go back to the shared list. Refills move
+	// half this many at once, so a thread that allocates and frees in bursts stays lock free.
+	constexpr size_t kThreadCacheSize = 64;
+	constexpr size_t kBatchSize = kThreadCacheSize / 2;
+
+	std::atomic<uint64_t> sNextAllocatorId{ 1 };
+}
+
+struct ConcurrentBlockAllocator::FreeBlock
+{
+	FreeBlock* next;
+};
+
+struct ConcurrentBlockAllocator::Depot
+{
+	std::mutex mutex;
+	std::vector<void*> pages;
+	FreeBlock* freeList = nullptr;
+	size_t blockStride = 0;
+	size_t blocksPerPage = 0;
+	size_t alignment = 0;
+	size_t maxPages = 0;
+
+	~Depot()
+	{
+		for (auto page : pages)
+		{
+			::operator delete(page, std::align_val_t(alignment));
+			TRACK_FREE(MemoryCategory::Allocator, blockStride * blocksPerPage);
+		}
+	}
+
+	// Caller holds the lock
+	bool Grow()
+	{
+		if (maxPages != 0 && pages.size() >= maxPages)
+			return false;
+
+		auto page = static_cast<uint8_t*>(::operator new(blockStride * blocksPerPage, std::align_val_t(alignment)));
+		pages.push_back(page);
+		TRACK_ALLOCATION(MemoryCategory::Allocator, blockStride * blocksPerPage);
+
+		// Link back to front so the page is handed out in address order
+		for (size_t i = blocksPerPage; i-- > 0;)
+		{
+			auto block = reinterpret_cast<FreeBlock*>(page + i * blockStride);
+			block->next = freeList;
+			freeList = block;
+		}
+		return true;
+	}
+
+	// Caller holds the lock
+	void Give(FreeBlock* head, FreeBlock* tail)
+	{
+		tail->next = freeList;
+		freeList = head;
+	}
+};
+
+struct ConcurrentBlockAllocator::ThreadCache
+{
+	uint64_t allocatorId = 0;
+	std::weak_ptr<Depot> depot;
+	FreeBlock* head = nullptr;
+	size_t count = 0;
+
+	// Returns every cached block to the depot, if it is still alive
+	void Release()
+	{
+		if (head == nullptr)
+			return;
+		if (auto shared = depot.lock())
+		{
+			FreeBlock* tail = head;
+			while (tail->next)
+				tail = tail->next;
+			std::lock_guard<std::mutex> lock(shared->mutex);
+			shared->Give(head, tail);
+		}
+		head = nullptr;
+		count = 0;
+	}
+};
+
+ConcurrentBlockAllocator::ConcurrentBlockAllocator(size_t blockSize, size_t blocksPerPage, size_t alignment, size_t maxPages)
+	: mDepot(std::make_shared<Depot>())
+	, mAlignment(std::max(alignment, alignof(FreeBlock)))
+	, mId(sNextAllocatorId.fetch_add(1))
+{
+	ASSERT(blockSize > 0, "ConcurrentBlockAllocator -- Invalid block size.");
+	ASSERT(blocksPerPage > 0, "ConcurrentBlockAllocator -- Invalid page size.");
+	ASSERT((alignment & (alignment - 1)) == 0, "ConcurrentBlockAllocator -- Alignment must be a power of two.");
+
+	// Every block must hold the free list link and start on an aligned address
+	const size_t size = std::max(blockSize, sizeof(FreeBlock));
+	mBlockStride = (size + mAlignment - 1) & ~(mAlignment - 1);
+
+	mDepot->blockStride = mBlockStride;
+	mDepot->blocksPerPage = blocksPerPage;
+	mDepot->alignment = mAlignment;
+	mDepot->maxPages = maxPages;
+}
+
+ConcurrentBlockAllocator::~ConcurrentBlockAllocator()
+{
+	// Blocks cached by other threads die with the pages, their stale cache entries are
+	// dropped the next time those threads look up a cache
+	GetThreadCache().head = nullptr;
+}
+
+void* ConcurrentBlockAllocator::Allocate()
+{
+	ThreadCache& cache = GetThreadCache();
+	if (cache.head == nullptr)
+	{
+		Refill(cache);
+		if (cache.head == nullptr)
+			return nullptr;
+	}
+
+	FreeBlock* block = cache.head;
+	cache.head = block->next;
+	--cache.count;
+
+	const size_t live = mLiveCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	size_t highWaterMark = mHighWaterMark.load(std::memory_order_relaxed);
+	while (live > highWaterMark && !mHighWaterMark.compare_exchange_weak(highWaterMark, live, std::memory_order_relaxed))
+	{
+	}
+	return block;
+}
+
+void ConcurrentBlockAllocator::Free(void* ptr)
+{
+	if (ptr == nullptr)
+		return;
+	ASSERT((reinterpret_cast<uintptr_t>(ptr) & (mAlignment - 1)) == 0, "ConcurrentBlockAllocator -- Pointer was not allocated here.");
+
+	ThreadCache& cache = GetThreadCache();
+	auto block = static_cast<FreeBlock*>(ptr);
+	block->next = cache.head;
+	cache.head = block;
+	++cache.count;
+	mLiveCount.fetch_sub(1, std::memory_order_relaxed);
+
+	// Keep the newest half, they are the most likely to still be in cache
+	if (cache.count > kThreadCacheSize)
+	{
+		FreeBlock* tail = cache.head;
+		for (size_t i = 1; i < kBatchSize; ++i)
+			tail = tail->next;
+		FreeBlock* first = tail->next;
+		FreeBlock* last = first;
+		size_t moved = 1;
+		while (last->next)
+		{
+			last = last->next;
+			++moved;
+		}
+		tail->next = nullptr;
+		cache.count -= moved;
+
+		std::lock_guard<std::mutex> lock(mDepot->mutex);
+		mDepot->Give(first, last);
+	}
+}
+
+void ConcurrentBlockAllocator::FlushThreadCache()
+{
+	GetThreadCache().Release();
+}
+
+ConcurrentBlockAllocator::Stats ConcurrentBlockAllocator::GetStats() const
+{
+	Stats stats;
+	stats.liveCount = mLiveCount.load(std::memory_order_relaxed);
+	stats.highWaterMark = mHighWaterMark.load(std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> lock(mDepot->mutex);
+	stats.pageCount = mDepot->pages.size();
+	stats.capacity = stats.pageCount * mDepot->blocksPerPage;
+	return stats;
+}
+
+ConcurrentBlockAllocator::ThreadCache& ConcurrentBlockAllocator::GetThreadCache()
+{
+	// Returns cached blocks on thread exit so they are not lost to the allocator
+	struct ThreadCaches
+	{
+		std::vector<ThreadCache> caches;
+		~ThreadCaches()
+		{
+			for (auto& cache : caches)
+				cache.Release();
+		}
+	};
+	thread_local ThreadCaches tCaches;
+
+	auto& caches = tCaches.caches;
+	for (auto& cache : caches)
+	{
+		if (cache.allocatorId == mId)
+			return cache;
+	}
+
+	// First use from this thread, drop entries of allocators that no longer exist
+	caches.erase(std::remove_if(caches.begin(), caches.end(), [](const ThreadCache& cache)
+	{
+		return cache.depot.expired();
+	}), caches.end());
+
+	ThreadCache& cache = caches.emplace_back();
+	cache.allocatorId = mId;
+	cache.depot = mDepot;
+	return cache;
+}
+
+void ConcurrentBlockAllocator::Refill(ThreadCache& cache)
+{
+	std::lock_guard<std::mutex> lock(mDepot->mutex);
+	if (mDepot->freeList == nullptr && !mDepot->Grow())
+		return;
+
+	FreeBlock* head = mDepot->freeList;
+	FreeBlock* tail = head;
+	size_t taken = 1;
+	while (taken < kBatchSize && tail->next)
+	{
+		tail = tail->next;
+		++taken;
+	}
+	mDepot->freeList = tail->next;
+	tail->next = cache.head;
+	cache.head = head;
+	cache.count += taken;
+}
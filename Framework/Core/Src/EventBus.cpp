@@ -0,0 +1,58 @@
+#include "Precompiled.h"
+#include "EventBus.h"
+
+#include "DebugUtil.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+namespace
+{
+	std::unique_ptr<EventBus> sEventBus;
+
+	std::atomic<uint32_t> sNextEventTypeIndex = 0;
+	std::atomic<EventHandlerId> sNextHandlerId = 0;
+}
+
+uint32_t Detail::NextEventTypeIndex()
+{
+	return sNextEventTypeIndex++;
+}
+
+EventHandlerId Detail::NextEventBusHandlerId()
+{
+	return ++sNextHandlerId;
+}
+
+void EventBus::StaticInitialize()
+{
+	ASSERT(sEventBus == nullptr, "EventBus -- EventBus already initialized!");
+	sEventBus = std::make_unique<EventBus>();
+}
+
+void EventBus::StaticTerminate()
+{
+	sEventBus.reset();
+}
+
+EventBus* EventBus::Get()
+{
+	ASSERT(sEventBus != nullptr, "EventBus -- No instance registered.");
+	return sEventBus.get();
+}
+
+EventBus::~EventBus()
+{
+	for (auto& channel : mChannels)
+		delete channel.load();
+}
+
+void EventBus::Dispatch()
+{
+	const uint32_t count = std::min(sNextEventTypeIndex.load(), kMaxEventTypes);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (auto channel = mChannels[i].load(std::memory_order_acquire))
+			channel->Dispatch();
+	}
+}
@@ -0,0 +1,68 @@
+#include "Precompiled.h"
+#include "FrameAllocator.h"
+
+#include "DebugUtil.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+namespace
+{
+	constexpr size_t kScratchCapacity = 256 * 1024;
+
+	std::unique_ptr<FrameAllocator> sFrameAllocator;
+}
+
+void FrameAllocator::StaticInitialize(size_t capacity)
+{
+	ASSERT(sFrameAllocator == nullptr, "FrameAllocator -- FrameAllocator already initialized!");
+	sFrameAllocator = std::make_unique<FrameAllocator>(capacity);
+}
+
+void FrameAllocator::StaticTerminate()
+{
+	sFrameAllocator.reset();
+}
+
+FrameAllocator* FrameAllocator::Get()
+{
+	ASSERT(sFrameAllocator != nullptr, "FrameAllocator -- No instance registered.");
+	return sFrameAllocator.get();
+}
+
+FrameAllocator::FrameAllocator(size_t capacity)
+	: mFrameArena(capacity)
+	, mBuffer0(capacity)
+	, mBuffer1(capacity)
+{
+}
+
+void FrameAllocator::EndFrame()
+{
+	mFrameArena.Reset();
+
+	// The buffer we switch to was written two frames ago, nobody reads it any more
+	mCurrentBuffer = 1 - mCurrentBuffer;
+	GetDoubleBufferedArena().Reset();
+}
+
+ScratchScope::ScratchScope()
+	: mArena(GetScratchAllocator())
+	, mMarker(mArena.GetMarker())
+{
+}
+
+ScratchScope::~ScratchScope()
+{
+	mArena.RewindTo(mMarker);
+
+	// Outermost scope, fold any overflow chunks back into one
+	if (mMarker.chunk == 0 && mMarker.offset == 0)
+		mArena.Reset();
+}
+
+LinearAllocator& Core::GetScratchAllocator()
+{
+	thread_local LinearAllocator tScratch(kScratchCapacity);
+	return tScratch;
+}
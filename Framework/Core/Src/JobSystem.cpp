@@ -0,0 +1,245 @@
+#include "Precompiled.h"
+#include "JobSystem.h"
+
+#include "DebugUtil.h"
+#include "Profiler.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+namespace
+{
+	std::unique_ptr<JobSystem> sJobSystem;
+
+	// Which deque the current thread pushes to and pops from. Threads that are not
+	// workers of the job system they talk to use the shared deque 0.
+	thread_local const JobSystem* tOwner = nullptr;
+	thread_local uint32_t tQueueIndex = 0;
+}
+
+void JobSystem::StaticInitialize(uint32_t workerCount)
+{
+	ASSERT(sJobSystem == nullptr, "JobSystem -- System already initialized!");
+	if (workerCount == 0)
+	{
+		const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+	sJobSystem = std::make_unique<JobSystem>();
+	sJobSystem->Initialize(workerCount);
+}
+
+void JobSystem::StaticTerminate()
+{
+	if (sJobSystem != nullptr)
+	{
+		sJobSystem->Terminate();
+		sJobSystem.reset();
+	}
+}
+
+JobSystem* JobSystem::Get()
+{
+	ASSERT(sJobSystem != nullptr, "JobSystem -- No system registered.");
+	return sJobSystem.get();
+}
+
+bool JobSystem::IsInitialized()
+{
+	return sJobSystem != nullptr;
+}
+
+JobSystem::~JobSystem()
+{
+	ASSERT(!mRunning, "JobSystem -- Terminate() must be called to clean up.");
+}
+
+void JobSystem::Initialize(uint32_t workerCount)
+{
+	ASSERT(!mRunning, "JobSystem -- Already initialized.");
+
+	mQueues.clear();
+	for (uint32_t i = 0; i <= workerCount; ++i)
+		mQueues.push_back(std::make_unique<WorkQueue>());
+
+	mRunning = true;
+	mWorkers.reserve(workerCount);
+	for (uint32_t i = 1; i <= workerCount; ++i)
+		mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+void JobSystem::Terminate()
+{
+	if (!mRunning)
+		return;
+
+	mRunning = false;
+	mWakeCondition.notify_all();
+	for (auto& worker : mWorkers)
+		worker.join();
+	mWorkers.clear();
+
+	// Anything still queued runs here so no counter is left waiting forever
+	Job job;
+	while (TryPop(job))
+		Execute(job);
+	mQueues.clear();
+}
+
+void JobSystem::Run(std::function<void()> job, JobCounter* counter)
+{
+	if (counter)
+		counter->mCount.fetch_add(1, std::memory_order_relaxed);
+	Push({ std::move(job), counter });
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter)
+{
+	if (counter)
+		counter->mCount.fetch_add(1, std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> lock(dependency.mContinuationMutex);
+		if (dependency.mCount.load(std::memory_order_acquire) > 0)
+		{
+			dependency.mContinuations.emplace_back(std::move(job), counter);
+			return;
+		}
+	}
+	Push({ std::move(job), counter });
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+	while (!counter.IsDone())
+	{
+		Job job;
+		if (TryPop(job))
+			Execute(job);
+		else
+			std::this_thread::yield();
+	}
+
+	// The last job may still be releasing the counter, the caller is free to destroy it after this
+	std::lock_guard<std::mutex> lock(counter.mContinuationMutex);
+}
+
+void JobSystem::ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body, size_t grainSize)
+{
+	if (count == 0)
+		return;
+
+	// A few chunks per thread lets fast threads pick up the slack of slow ones
+	if (grainSize == 0)
+		grainSize = std::max<size_t>(1, count / (GetThreadCount() * 4));
+	if (grainSize >= count || mWorkers.empty())
+	{
+		body(0, count);
+		return;
+	}
+
+	JobCounter counter;
+	for (size_t begin = grainSize; begin < count; begin += grainSize)
+	{
+		const size_t end = std::min(begin + grainSize, count);
+		Run([&body, begin, end]() { body(begin, end); }, &counter);
+	}
+
+	// The caller takes the first chunk itself, then helps with the rest
+	body(0, grainSize);
+	Wait(counter);
+}
+
+void JobSystem::Push(Job job)
+{
+	ASSERT(!mQueues.empty(), "JobSystem -- Not initialized.");
+	const uint32_t queueIndex = tOwner == this ? tQueueIndex : 0;
+	{
+		auto& queue = *mQueues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(std::move(job));
+	}
+	mPendingJobs.fetch_add(1, std::memory_order_release);
+	mWakeCondition.notify_one();
+}
+
+bool JobSystem::TryPop(Job& job)
+{
+	const uint32_t queueCount = static_cast<uint32_t>(mQueues.size());
+	const uint32_t queueIndex = tOwner == this ? tQueueIndex : 0;
+
+	// Newest job from our own deque first, it is the most likely to still be in cache
+	{
+		auto& queue = *mQueues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			mPendingJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// Otherwise steal the oldest job from someone else, those tend to be the biggest
+	for (uint32_t i = 1; i < queueCount; ++i)
+	{
+		auto& queue = *mQueues[(queueIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			mPendingJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::Execute(Job& job)
+{
+	job.task();
+
+	JobCounter* counter = job.counter;
+	if (counter == nullptr)
+		return;
+
+	// Decrement under the lock so a concurrent RunAfter either sees the counter busy and
+	// queues a continuation we pick up here, or sees it done and runs the job itself
+	std::vector<std::pair<std::function<void()>, JobCounter*>> continuations;
+	{
+		std::lock_guard<std::mutex> lock(counter->mContinuationMutex);
+		if (counter->mCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			continuations.swap(counter->mContinuations);
+	}
+	for (auto& [task, continuationCounter] : continuations)
+		Push({ std::move(task), continuationCounter });
+}
+
+void JobSystem::WorkerLoop(uint32_t queueIndex)
+{
+	tOwner = this;
+	tQueueIndex = queueIndex;
+	Profiler::SetThreadName(("Worker " + std::to_string(queueIndex)).c_str());
+
+	while (mRunning)
+	{
+		Job job;
+		if (TryPop(job))
+		{
+			Execute(job);
+			continue;
+		}
+
+		// Sleep until work shows up. The timeout covers a push that lands between the
+		// predicate check and the wait, which is cheaper than locking on every push.
+		std::unique_lock<std::mutex> lock(mWakeMutex);
+		mWakeCondition.wait_for(lock, std::chrono::milliseconds(1), [this]()
+		{
+			return mPendingJobs.load(std::memory_order_acquire) > 0 || !mRunning;
+		});
+	}
+
+	tOwner = nullptr;
+}
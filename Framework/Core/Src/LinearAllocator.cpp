@@ -0,0 +1,107 @@
+#include "Precompiled.h"
+#include "LinearAllocator.h"
+
+#include "DebugUtil.h"
+#include "MemoryTracker.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+namespace
+{
+	uint8_t* AllocateChunk(size_t size)
+	{
+		TRACK_ALLOCATION(MemoryCategory::Allocator, size);
+		return static_cast<uint8_t*>(::operator new(size));
+	}
+
+	void FreeChunk(uint8_t* data, size_t size)
+	{
+		::operator delete(data);
+		TRACK_FREE(MemoryCategory::Allocator, size);
+	}
+}
+
+LinearAllocator::LinearAllocator(size_t capacity)
+{
+	ASSERT(capacity > 0, "LinearAllocator -- Invalid capacity.");
+	mChunks.push_back({ AllocateChunk(capacity), capacity });
+}
+
+LinearAllocator::~LinearAllocator()
+{
+	for (auto& chunk : mChunks)
+		FreeChunk(chunk.data, chunk.size);
+}
+
+void* LinearAllocator::Allocate(size_t size, size_t alignment)
+{
+	ASSERT((alignment & (alignment - 1)) == 0, "LinearAllocator -- Alignment must be a power of two.");
+
+	while (true)
+	{
+		const Chunk& chunk = mChunks[mCurrentChunk];
+		const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data);
+		const uintptr_t aligned = (base + mOffset + alignment - 1) & ~(alignment - 1);
+		if (aligned + size <= base + chunk.size)
+		{
+			mOffset = aligned + size - base;
+			mHighWaterMark = std::max(mHighWaterMark, GetUsed());
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		// Move on to the next chunk, adding one if we have run out. Reset folds them back
+		// into one chunk, so this only happens while the allocator is still warming up.
+		if (mCurrentChunk + 1 == mChunks.size())
+		{
+			const size_t chunkSize = std::max(mChunks.back().size, size + alignment);
+			mChunks.push_back({ AllocateChunk(chunkSize), chunkSize });
+		}
+		++mCurrentChunk;
+		mOffset = 0;
+	}
+}
+
+void LinearAllocator::Free(void* ptr, size_t size)
+{
+	uint8_t* top = mChunks[mCurrentChunk].data + mOffset;
+	if (static_cast<uint8_t*>(ptr) + size == top)
+		mOffset -= size;
+}
+
+void LinearAllocator::RewindTo(Marker marker)
+{
+	ASSERT(marker.chunk < mCurrentChunk || (marker.chunk == mCurrentChunk && marker.offset <= mOffset), "LinearAllocator -- Marker is ahead of the allocator.");
+	mCurrentChunk = marker.chunk;
+	mOffset = marker.offset;
+}
+
+void LinearAllocator::Reset()
+{
+	if (mChunks.size() > 1)
+	{
+		const size_t capacity = GetCapacity();
+		for (auto& chunk : mChunks)
+			FreeChunk(chunk.data, chunk.size);
+		mChunks.clear();
+		mChunks.push_back({ AllocateChunk(capacity), capacity });
+	}
+	mCurrentChunk = 0;
+	mOffset = 0;
+}
+
+size_t LinearAllocator::GetUsed() const
+{
+	size_t used = mOffset;
+	for (size_t i = 0; i < mCurrentChunk; ++i)
+		used += mChunks[i].size;
+	return used;
+}
+
+size_t LinearAllocator::GetCapacity() const
+{
+	size_t capacity = 0;
+	for (auto& chunk : mChunks)
+		capacity += chunk.size;
+	return capacity;
+}
@@ -0,0 +1,262 @@
+#include "Precompiled.h"
+#include "Logger.h"
+
+#include "DebugUtil.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+namespace
+{
+	std::unique_ptr<Logger> sLogger;
+
+	constexpr size_t kMaxLineLength = Logger::kMaxMessageLength + 32;
+
+	void WriteToDebugger(const char* line)
+	{
+#if defined(_WIN32)
+		OutputDebugStringA(line);
+#else
+		fputs(line, stderr);
+#endif
+	}
+
+	FILE* OpenLogFile(const std::filesystem::path& path)
+	{
+		FILE* file = nullptr;
+#if defined(_WIN32)
+		_wfopen_s(&file, path.c_str(), L"w");
+#else
+		file = fopen(path.c_str(), "w");
+#endif
+		return file;
+	}
+
+	uint32_t GetCurrentSecond()
+	{
+		using namespace std::chrono;
+		return static_cast<uint32_t>(duration_cast<seconds>(steady_clock::now().time_since_epoch()).count());
+	}
+}
+
+void Logger::StaticInitialize(const Settings& settings)
+{
+	ASSERT(sLogger == nullptr, "Logger -- Logger already initialized!");
+	sLogger = std::make_unique<Logger>(settings);
+}
+
+void Logger::StaticTerminate()
+{
+	sLogger.reset();
+}
+
+Logger* Logger::Get()
+{
+	ASSERT(sLogger != nullptr, "Logger -- No instance registered.");
+	return sLogger.get();
+}
+
+Logger::Logger(const Settings& settings)
+	: mSettings(settings)
+{
+	size_t capacity = 2;
+	while (capacity < settings.capacity)
+		capacity <<= 1;
+
+	mRecords = std::make_unique<Record[]>(capacity);
+	for (size_t i = 0; i < capacity; ++i)
+		mRecords[i].sequence.store(i, std::memory_order_relaxed);
+	mMask = capacity - 1;
+
+	if (!settings.filePath.empty())
+	{
+		mFile = OpenLogFile(settings.filePath);
+		if (mFile == nullptr)
+			LOG("Logger -- Failed to open log file %s.", settings.filePath.u8string().c_str());
+	}
+
+	mThread = std::thread(&Logger::Run, this);
+}
+
+Logger::~Logger()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mRunning = false;
+	}
+	mWakeUp.notify_one();
+	mThread.join();
+
+	if (mFile)
+		fclose(mFile);
+}
+
+bool Logger::Write(LogRateLimit* rateLimit, const char* format, va_list args)
+{
+	if (rateLimit && mSettings.maxPerSitePerSecond > 0)
+	{
+		// Whoever sees the new second first resets the count, a few extra lines may slip through
+		const uint32_t second = GetCurrentSecond();
+		uint32_t window = rateLimit->window.load(std::memory_order_relaxed);
+		if (window != second && rateLimit->window.compare_exchange_strong(window, second, std::memory_order_relaxed))
+			rateLimit->count.store(0, std::memory_order_relaxed);
+		if (rateLimit->count.fetch_add(1, std::memory_order_relaxed) >= mSettings.maxPerSitePerSecond)
+		{
+			mRateLimitedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+	}
+
+	// Claim a slot, each slot's sequence tells us whether it is free for this lap of the ring
+	size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+	Record* record;
+	while (true)
+	{
+		record = &mRecords[pos & mMask];
+		const size_t sequence = record->sequence.load(std::memory_order_acquire);
+		const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+		if (diff == 0)
+		{
+			if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+		{
+			mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			pos = mEnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	record->time = TimeUtil::GetTime();
+	const int length = vsnprintf(record->text, kMaxMessageLength, format, args);
+	record->length = static_cast<uint32_t>(std::clamp(length, 0, static_cast<int>(kMaxMessageLength) - 1));
+	record->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+void Logger::Flush()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	const size_t target = mEnqueuePos.load(std::memory_order_relaxed);
+	mFlushTarget = std::max(mFlushTarget, target);
+	mWakeUp.notify_one();
+	mFlushed.wait(lock, [this, target]() { return mDequeuePos.load(std::memory_order_acquire) >= target; });
+}
+
+void Logger::DispatchEvents()
+{
+	{
+		std::lock_guard<std::mutex> lock(mEventMutex);
+		mDispatchEvents.swap(mPendingEvents);
+	}
+	for (auto& line : mDispatchEvents)
+		OnDebugLog(line);
+	mDispatchEvents.clear();
+}
+
+void Logger::Run()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (true)
+	{
+		// Producers never signal, so poll at a short interval unless someone is waiting on a flush
+		const bool running = mRunning;
+		const bool flushRequested = mFlushTarget > mDequeuePos.load(std::memory_order_relaxed);
+		if (running && !flushRequested)
+			mWakeUp.wait_for(lock, std::chrono::milliseconds(10));
+		lock.unlock();
+
+		bool consumed = false;
+		while (Consume())
+			consumed = true;
+
+		const uint64_t lostCount = GetDroppedCount() + GetRateLimitedCount();
+		if (lostCount != mReportedCount)
+		{
+			char text[128];
+			const int length = snprintf(text, std::size(text), "Logger -- %llu messages dropped, %llu rate limited.",
+				static_cast<unsigned long long>(GetDroppedCount()), static_cast<unsigned long long>(GetRateLimitedCount()));
+			WriteLine(TimeUtil::GetTime(), text, length);
+			mReportedCount = lostCount;
+			consumed = true;
+		}
+
+		if (consumed)
+		{
+			if (mFile)
+				fflush(mFile);
+			if (mSettings.consoleSink)
+				fflush(stdout);
+		}
+
+		lock.lock();
+		mFlushed.notify_all();
+		if (!running)
+			break;
+	}
+}
+
+bool Logger::Consume()
+{
+	const size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+	Record& record = mRecords[pos & mMask];
+	if (record.sequence.load(std::memory_order_acquire) != pos + 1)
+		return false;
+
+	WriteLine(record.time, record.text, record.length);
+
+	// Hand the slot back to producers for the next lap
+	record.sequence.store(pos + mMask + 1, std::memory_order_release);
+	mDequeuePos.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+void Logger::WriteLine(float time, const char* text, size_t length)
+{
+	char line[kMaxLineLength];
+	const int lineLength = snprintf(line, std::size(line), "[%.3f]: %.*s\n", time, static_cast<int>(length), text);
+
+	if (mSettings.debuggerSink)
+		WriteToDebugger(line);
+	if (mSettings.consoleSink)
+		fwrite(line, 1, lineLength, stdout);
+	if (mFile)
+		fwrite(line, 1, lineLength, mFile);
+	if (mSettings.editorSink)
+	{
+		std::lock_guard<std::mutex> lock(mEventMutex);
+		if (mPendingEvents.size() < mMask + 1)
+			mPendingEvents.emplace_back(line, lineLength);
+	}
+}
+
+void Core::LogWrite(LogRateLimit* rateLimit, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	if (sLogger)
+	{
+		sLogger->Write(rateLimit, format, args);
+	}
+	else
+	{
+		// Not initialized yet (or already gone), fall back to writing right away
+		char message[Logger::kMaxMessageLength];
+		vsnprintf(message, std::size(message), format, args);
+		char line[kMaxLineLength];
+		snprintf(line, std::size(line), "[%.3f]: %s\n", TimeUtil::GetTime(), message);
+		WriteToDebugger(line);
+		OnDebugLog(line);
+	}
+	va_end(args);
+}
+
+void Core::LogFlush()
+{
+	if (sLogger)
+		sLogger->Flush();
+}
@@ -0,0 +1,249 @@
+#include "Precompiled.h"
+#include "MemoryTracker.h"
+
+#include "DebugUtil.h"
+#include "Profiler.h"
+
+#if !defined(_WIN32)
+#include <execinfo.h>
+#endif
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+namespace
+{
+	constexpr size_t kCategoryCount = static_cast<size_t>(MemoryCategory::Count);
+
+	constexpr const char* kCategoryNames[kCategoryCount] =
+	{
+		"General",
+		"Allocator",
+		"Container",
+		"Texture",
+		"Model",
+		"MeshBuffer"
+	};
+
+	// Counter names for the profiler trace
+	constexpr const char* kCounterNames[kCategoryCount] =
+	{
+		"Memory/General",
+		"Memory/Allocator",
+		"Memory/Container",
+		"Memory/Texture",
+		"Memory/Model",
+		"Memory/MeshBuffer"
+	};
+
+	struct CategoryCounters
+	{
+		std::atomic<int64_t> liveBytes{ 0 };
+		std::atomic<int64_t> peakBytes{ 0 };
+		std::atomic<int64_t> liveCount{ 0 };
+		std::atomic<uint64_t> totalCount{ 0 };
+		std::atomic<uint64_t> currentFrameCount{ 0 };
+		std::atomic<uint64_t> lastFrameCount{ 0 };
+		std::atomic<uint64_t> budget{ 0 };
+		bool overBudget = false;	// EndFrame only
+	};
+
+	CategoryCounters sCounters[kCategoryCount];
+
+	std::atomic<uint32_t> sSampleInterval{ 0 };
+	std::atomic<uint64_t> sSampleCounter{ 0 };
+	std::mutex sSampleMutex;
+	std::vector<MemoryTracker::CallstackSample> sSamples;	// ring, oldest at sNextSample once full
+	size_t sNextSample = 0;
+
+	CategoryCounters& GetCounters(MemoryCategory category)
+	{
+		ASSERT(category < MemoryCategory::Count, "MemoryTracker -- Invalid category.");
+		return sCounters[static_cast<size_t>(category)];
+	}
+
+	void CaptureSample(MemoryCategory category, size_t size)
+	{
+		MemoryTracker::CallstackSample sample;
+#if defined(_WIN32)
+		sample.frameCount = CaptureStackBackTrace(2, static_cast<DWORD>(sample.frames.size()), sample.frames.data(), nullptr);
+#else
+		sample.frameCount = static_cast<uint32_t>(backtrace(sample.frames.data(), static_cast<int>(sample.frames.size())));
+#endif
+		sample.category = category;
+		sample.size = size;
+		sample.frameIndex = Profiler::GetFrameIndex();
+
+		std::lock_guard<std::mutex> lock(sSampleMutex);
+		if (sSamples.size() < MemoryTracker::kMaxCallstackSamples)
+		{
+			sSamples.push_back(sample);
+		}
+		else
+		{
+			sSamples[sNextSample] = sample;
+			sNextSample = (sNextSample + 1) % MemoryTracker::kMaxCallstackSamples;
+		}
+	}
+}
+
+const char* MemoryTracker::GetCategoryName(MemoryCategory category)
+{
+	return category < MemoryCategory::Count ? kCategoryNames[static_cast<size_t>(category)] : "Unknown";
+}
+
+void MemoryTracker::RecordAllocation(MemoryCategory category, size_t size)
+{
+	auto& counters = GetCounters(category);
+	const int64_t live = counters.liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+	int64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+	while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+	counters.liveCount.fetch_add(1, std::memory_order_relaxed);
+	counters.totalCount.fetch_add(1, std::memory_order_relaxed);
+	counters.currentFrameCount.fetch_add(1, std::memory_order_relaxed);
+
+	const uint32_t interval = sSampleInterval.load(std::memory_order_relaxed);
+	if (interval > 0 && sSampleCounter.fetch_add(1, std::memory_order_relaxed) % interval == 0)
+		CaptureSample(category, size);
+}
+
+void MemoryTracker::RecordFree(MemoryCategory category, size_t size)
+{
+	auto& counters = GetCounters(category);
+	counters.liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+	counters.liveCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::EndFrame()
+{
+	for (size_t i = 0; i < kCategoryCount; ++i)
+	{
+		auto& counters = sCounters[i];
+		counters.lastFrameCount.store(counters.currentFrameCount.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+		const int64_t live = counters.liveBytes.load(std::memory_order_relaxed);
+		const uint64_t budget = counters.budget.load(std::memory_order_relaxed);
+		const bool overBudget = budget > 0 && live > static_cast<int64_t>(budget);
+		if (overBudget && !counters.overBudget)
+			LOG("MemoryTracker -- %s is over budget, %lld of %llu bytes.", kCategoryNames[i], static_cast<long long>(live), static_cast<unsigned long long>(budget));
+		counters.overBudget = overBudget;
+
+		PROFILE_COUNTER(kCounterNames[i], live);
+	}
+}
+
+MemoryTracker::CategoryStats MemoryTracker::GetStats(MemoryCategory category)
+{
+	auto& counters = GetCounters(category);
+	CategoryStats stats;
+	stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+	stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+	stats.liveCount = counters.liveCount.load(std::memory_order_relaxed);
+	stats.totalCount = counters.totalCount.load(std::memory_order_relaxed);
+	stats.frameCount = counters.lastFrameCount.load(std::memory_order_relaxed);
+	stats.budget = counters.budget.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void MemoryTracker::SetBudget(MemoryCategory category, size_t bytes)
+{
+	GetCounters(category).budget.store(bytes, std::memory_order_relaxed);
+}
+
+size_t MemoryTracker::CheckBudgets(std::vector<MemoryCategory>& overBudget)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < kCategoryCount; ++i)
+	{
+		const auto category = static_cast<MemoryCategory>(i);
+		const auto stats = GetStats(category);
+		if (stats.budget > 0 && stats.liveBytes > static_cast<int64_t>(stats.budget))
+		{
+			overBudget.push_back(category);
+			++count;
+		}
+	}
+	return count;
+}
+
+void MemoryTracker::SetCallstackSampling(uint32_t interval)
+{
+	sSampleInterval.store(interval, std::memory_order_relaxed);
+}
+
+void MemoryTracker::CollectCallstackSamples(std::vector<CallstackSample>& samples)
+{
+	std::lock_guard<std::mutex> lock(sSampleMutex);
+	samples.insert(samples.end(), sSamples.begin() + sNextSample, sSamples.end());
+	samples.insert(samples.end(), sSamples.begin(), sSamples.begin() + sNextSample);
+}
+
+bool MemoryTracker::ExportJson(const std::filesystem::path& path)
+{
+	std::string json;
+	char line[256];
+
+	snprintf(line, std::size(line), "{\n\"frame\":%llu,\n\"categories\":[\n", static_cast<unsigned long long>(Profiler::GetFrameIndex()));
+	json += line;
+	for (size_t i = 0; i < kCategoryCount; ++i)
+	{
+		const auto stats = GetStats(static_cast<MemoryCategory>(i));
+		snprintf(line, std::size(line),
+			"{\"name\":\"%s\",\"liveBytes\":%lld,\"peakBytes\":%lld,\"liveCount\":%lld,\"totalCount\":%llu,\"frameCount\":%llu,\"budget\":%llu}%s\n",
+			kCategoryNames[i],
+			static_cast<long long>(stats.liveBytes),
+			static_cast<long long>(stats.peakBytes),
+			static_cast<long long>(stats.liveCount),
+			static_cast<unsigned long long>(stats.totalCount),
+			static_cast<unsigned long long>(stats.frameCount),
+			static_cast<unsigned long long>(stats.budget),
+			i + 1 < kCategoryCount ? "," : "");
+		json += line;
+	}
+	json += "],\n\"samples\":[\n";
+
+	// Raw return addresses, symbolize them against the matching build
+	std::vector<CallstackSample> samples;
+	CollectCallstackSamples(samples);
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		auto& sample = samples[i];
+		snprintf(line, std::size(line), "{\"category\":\"%s\",\"size\":%llu,\"frame\":%llu,\"callstack\":[",
+			GetCategoryName(sample.category),
+			static_cast<unsigned long long>(sample.size),
+			static_cast<unsigned long long>(sample.frameIndex));
+		json += line;
+		for (uint32_t f = 0; f < sample.frameCount; ++f)
+		{
+			snprintf(line, std::size(line), "%s\"0x%llx\"", f > 0 ? "," : "", static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(sample.frames[f])));
+			json += line;
+		}
+		json += i + 1 < samples.size() ? "]},\n" : "]}\n";
+	}
+	json += "]\n}\n";
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		LOG("MemoryTracker -- Failed to open %s for writing.", path.u8string().c_str());
+		return false;
+	}
+	file.write(json.data(), json.size());
+	return true;
+}
+
+void MemoryTracker::Reset()
+{
+	for (auto& counters : sCounters)
+	{
+		counters.peakBytes = counters.liveBytes.load();
+		counters.totalCount = 0;
+		counters.currentFrameCount = 0;
+		counters.lastFrameCount = 0;
+		counters.overBudget = false;
+	}
+
+	std::lock_guard<std::mutex> lock(sSampleMutex);
+	sSamples.clear();
+	sNextSample = 0;
+}
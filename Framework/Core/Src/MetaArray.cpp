@@ -1,9 +1,50 @@
 #include "Precompiled.h"
 #include "MetaArray.h"
 
+#include "BinaryStream.h"
+
+using namespace Angazi::Core;
 using namespace Angazi::Core::Meta;
 
-Angazi::Core::Meta::MetaArray::MetaArray(const MetaType * elementType)
+Angazi::Core::Meta::MetaArray::MetaArray(const MetaType * elementType, GetCountFunc getCount, ResizeFunc resize, GetDataFunc getData)
 	:MetaType(MetaType::Category::Array, "Array", sizeof(std::vector<int>)), mElementType(elementType)
+	, mGetCount(std::move(getCount)), mResize(std::move(resize)), mGetData(std::move(getData))
+{
+}
+
+bool MetaArray::DeserializeBinary(void* instance, BinaryReader& reader) const
 {
+	uint32_t count = 0;
+	if (!reader.Read(count))
+		return false;
+
+	Resize(instance, count);
+	auto elements = static_cast<uint8_t*>(GetData(instance));
+	const size_t stride = mElementType->GetSize();
+	if (mElementType->IsTriviallyCopyable())
+		return reader.Read(elements, stride * count);
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (!mElementType->DeserializeBinary(elements + i * stride, reader))
+			return false;
+	}
+	return true;
+}
+
+void MetaArray::SerializeBinary(const void* instance, BinaryWriter& writer) const
+{
+	const uint32_t count = static_cast<uint32_t>(GetCount(instance));
+	writer.Write(count);
+
+	auto elements = static_cast<const uint8_t*>(GetData(instance));
+	const size_t stride = mElementType->GetSize();
+	if (mElementType->IsTriviallyCopyable())
+	{
+		writer.Write(elements, stride * count);
+		return;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+		mElementType->SerializeBinary(elements + i * stride, writer);
 }
@@ -0,0 +1,71 @@
+#include "Precompiled.h"
+#include "MetaBinary.h"
+
+#include "BinaryStream.h"
+#include "Hash.h"
+#include "MetaArray.h"
+#include "MetaClass.h"
+#include "MetaField.h"
+#include "MetaPointer.h"
+
+using namespace Angazi::Core;
+using namespace Angazi::Core::Meta;
+
+namespace
+{
+	uint32_t HashType(const MetaType* metaType, uint32_t hash)
+	{
+		hash = HashFnv1a(metaType->GetName(), hash);
+		switch (metaType->GetCategory())
+		{
+		case MetaType::Category::Primitive:
+		{
+			// Only raw bytes depend on the size, a string is written the same on every platform
+			if (metaType->IsTriviallyCopyable())
+			{
+				const uint32_t size = static_cast<uint32_t>(metaType->GetSize());
+				hash = HashFnv1a(&size, sizeof(size), hash);
+			}
+			break;
+		}
+		case MetaType::Category::Class:
+		{
+			auto metaClass = metaType->AsMetaClass();
+			for (size_t i = 0; i < metaClass->GetFieldCount(); ++i)
+			{
+				auto metaField = metaClass->GetField(i);
+				hash = HashFnv1a(metaField->GetName(), hash);
+				hash = HashType(metaField->GetMetaType(), hash);
+			}
+			break;
+		}
+		case MetaType::Category::Array:
+			hash = HashType(metaType->AsMetaArray()->GetElementType(), hash);
+			break;
+		case MetaType::Category::Pointer:
+			// Name only, pointers may refer back to the class that holds them
+			hash = HashFnv1a(metaType->AsMetaPointer()->GetPointerType()->GetName(), hash);
+			break;
+		}
+		return hash;
+	}
+}
+
+uint32_t Meta::GetSchemaHash(const MetaType* metaType)
+{
+	return HashType(metaType, kFnvOffsetBasis);
+}
+
+void Meta::SaveBinary(const MetaType* metaType, const void* instance, BinaryWriter& writer)
+{
+	writer.Write(GetSchemaHash(metaType));
+	metaType->SerializeBinary(instance, writer);
+}
+
+bool Meta::LoadBinary(const MetaType* metaType, void* instance, BinaryReader& reader)
+{
+	uint32_t schemaHash = 0;
+	if (!reader.Read(schemaHash) || schemaHash != GetSchemaHash(metaType))
+		return false;
+	return metaType->DeserializeBinary(instance, reader);
+}
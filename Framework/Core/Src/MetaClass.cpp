@@ -1,14 +1,36 @@
 #include "Precompiled.h"
 #include "MetaClass.h"
 
+#include "BinaryStream.h"
 #include "DebugUtil.h"
+#include "Hash.h"
 #include "MetaField.h"
 
+using namespace Angazi::Core;
 using namespace Angazi::Core::Meta;
 
 MetaClass::MetaClass(const char * name, size_t size, const MetaClass * parent, std::vector<MetaField> fields, CreateFunc create)
-	:MetaType(MetaType::Category::Class, name, size), mParent(parent), mFields(std::move(fields)), mCreate(std::move(create))
+	:MetaType(MetaType::Category::Class, name, size), mTypeId(HashFnv1a(name)), mParent(parent), mFields(std::move(fields)), mCreate(std::move(create))
 {
+	// Flatten parent and nested class fields so the binary form is a handful of copies
+	if (mParent != nullptr)
+	{
+		for (auto& run : mParent->GetBinaryRuns())
+			AddBinaryRun(run.offset, run.size, run.type);
+	}
+	for (auto& field : mFields)
+	{
+		auto metaType = field.GetMetaType();
+		if (metaType->GetCategory() == Category::Class)
+		{
+			for (auto& run : metaType->AsMetaClass()->GetBinaryRuns())
+				AddBinaryRun(field.GetOffset() + run.offset, run.size, run.type);
+		}
+		else
+		{
+			AddBinaryRun(field.GetOffset(), metaType->GetSize(), metaType->IsTriviallyCopyable() ? nullptr : metaType);
+		}
+	}
 }
 
 const MetaClass * MetaClass::GetParent() const
@@ -50,6 +72,20 @@ size_t MetaClass::GetParentFieldCount() const
 	return mParent ? mParent->GetFieldCount() : 0u;
 }
 
+void MetaClass::AddBinaryRun(size_t offset, size_t size, const MetaType* type)
+{
+	if (type == nullptr && !mBinaryRuns.empty())
+	{
+		auto& last = mBinaryRuns.back();
+		if (last.type == nullptr && last.offset + last.size == offset)
+		{
+			last.size += size;
+			return;
+		}
+	}
+	mBinaryRuns.push_back({ offset, size, type });
+}
+
 void* MetaClass::Create() const
 {
 	ASSERT(mCreate, "MetaClass -- no create callable registered for %s.",GetName());
@@ -81,3 +117,29 @@ void MetaClass::Serialize(const void* classInstance, rapidjson::Value& jsonValue
 		jsonValue.AddMember(fieldName, fieldProperties,document.GetAllocator());
 	}
 }
+
+bool MetaClass::DeserializeBinary(void* classInstance, BinaryReader& reader) const
+{
+	auto instance = static_cast<uint8_t*>(classInstance);
+	for (auto& run : mBinaryRuns)
+	{
+		const bool read = run.type ?
+			run.type->DeserializeBinary(instance + run.offset, reader) :
+			reader.Read(instance + run.offset, run.size);
+		if (!read)
+			return false;
+	}
+	return true;
+}
+
+void MetaClass::SerializeBinary(const void* classInstance, BinaryWriter& writer) const
+{
+	auto instance = static_cast<const uint8_t*>(classInstance);
+	for (auto& run : mBinaryRuns)
+	{
+		if (run.type)
+			run.type->SerializeBinary(instance + run.offset, writer);
+		else
+			writer.Write(instance + run.offset, run.size);
+	}
+}
@@ -68,6 +68,43 @@ namespace Angazi::Core::Meta
 	}
 }
 
+namespace Angazi::Core::Meta
+{
+	// Binary, length prefixed
+	template<>
+	bool DeserializeBinary<std::string>(void* instance, BinaryReader& reader)
+	{
+		uint32_t length = 0;
+		if (!reader.Read(length))
+			return false;
+		auto& str = *(std::string*)(instance);
+		str.resize(length);
+		return reader.Read(str.data(), length);
+	}
+	template<>
+	bool DeserializeBinary<std::filesystem::path>(void* instance, BinaryReader& reader)
+	{
+		std::string str;
+		if (!DeserializeBinary<std::string>(&str, reader))
+			return false;
+		*(std::filesystem::path*)(instance) = std::filesystem::u8path(str);
+		return true;
+	}
+	template<>
+	void SerializeBinary<std::string>(const void* instance, BinaryWriter& writer)
+	{
+		auto& str = *(const std::string*)(instance);
+		writer.Write(static_cast<uint32_t>(str.size()));
+		writer.Write(str.data(), str.size());
+	}
+	template<>
+	void SerializeBinary<std::filesystem::path>(const void* instance, BinaryWriter& writer)
+	{
+		const std::string str = (*(const std::filesystem::path*)(instance)).u8string();
+		SerializeBinary<std::string>(&str, writer);
+	}
+}
+
 // Primitive Type Declarations
 META_TYPE_DEFINE(int, Integer)
 META_TYPE_DEFINE(float, Number)
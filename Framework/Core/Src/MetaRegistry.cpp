@@ -2,33 +2,81 @@
 #include "MetaRegistry.h"
 
 #include "DebugUtil.h"
+#include "Hash.h"
 #include "MetaClass.h"
 
 using namespace Angazi::Core;
 
 namespace
 {
+	// Open addressing on the type id, kept at most half full so probes stay short
+	struct Registry
+	{
+		std::vector<const Meta::MetaClass*> slots = std::vector<const Meta::MetaClass*>(64, nullptr);
+		std::vector<const Meta::MetaClass*> sorted;
+	};
+
 	inline auto& GetRegistry()
 	{
-		using MetaClassMap = std::map<std::string, const Meta::MetaClass*>;
-		static MetaClassMap sMetaClassMap;
-		return sMetaClassMap;
+		static Registry sRegistry;
+		return sRegistry;
+	}
+
+	void Insert(std::vector<const Meta::MetaClass*>& slots, const Meta::MetaClass* metaClass)
+	{
+		const size_t mask = slots.size() - 1;
+		size_t index = metaClass->GetTypeId() & mask;
+		while (slots[index] != nullptr)
+			index = (index + 1) & mask;
+		slots[index] = metaClass;
 	}
 }
 
 void Meta::Register(const MetaClass * metaClass)
 {
-	GetRegistry().emplace(metaClass->GetName(),metaClass);
+	if (auto existing = FindMetaClass(metaClass->GetTypeId()))
+	{
+		ASSERT(strcmp(existing->GetName(), metaClass->GetName()) == 0, "MetaRegistry -- Type id of %s collides with %s.", metaClass->GetName(), existing->GetName());
+		return;
+	}
+
+	auto& registry = GetRegistry();
+	if ((registry.sorted.size() + 1) * 2 > registry.slots.size())
+	{
+		std::vector<const MetaClass*> slots(registry.slots.size() * 2, nullptr);
+		for (auto entry : registry.sorted)
+			Insert(slots, entry);
+		registry.slots = std::move(slots);
+	}
+	Insert(registry.slots, metaClass);
+
+	auto iter = std::lower_bound(registry.sorted.begin(), registry.sorted.end(), metaClass, [](auto a, auto b)
+	{
+		return strcmp(a->GetName(), b->GetName()) < 0;
+	});
+	registry.sorted.insert(iter, metaClass);
 }
 
 const Meta::MetaClass * Meta::FindMetaClass(const char* className)
 {
-	auto iter = GetRegistry().find(className);
-	ASSERT(iter != GetRegistry().end(), "MetaRegistry -- Meta class for %s not found.",className);
-	return iter->second;
+	auto metaClass = FindMetaClass(HashFnv1a(className));
+	ASSERT(metaClass != nullptr && strcmp(metaClass->GetName(), className) == 0, "MetaRegistry -- Meta class for %s not found.",className);
+	return metaClass;
+}
+
+const Meta::MetaClass* Meta::FindMetaClass(uint32_t typeId)
+{
+	auto& slots = GetRegistry().slots;
+	const size_t mask = slots.size() - 1;
+	for (size_t index = typeId & mask; slots[index] != nullptr; index = (index + 1) & mask)
+	{
+		if (slots[index]->GetTypeId() == typeId)
+			return slots[index];
+	}
+	return nullptr;
 }
 
-const std::map<std::string, const Meta::MetaClass*> Angazi::Core::Meta::GetAllMetaClasses()
+const std::vector<const Meta::MetaClass*>& Angazi::Core::Meta::GetAllMetaClasses()
 {
-	return GetRegistry();
+	return GetRegistry().sorted;
 }
@@ -8,8 +8,10 @@
 
 using namespace Angazi::Core::Meta;
 
-MetaType::MetaType(Category category, const char * name, size_t size, DeserializeFunc deserialize, SerializeFunc serialize)
+MetaType::MetaType(Category category, const char * name, size_t size, DeserializeFunc deserialize, SerializeFunc serialize,
+	DeserializeBinaryFunc deserializeBinary, SerializeBinaryFunc serializeBinary, bool triviallyCopyable)
 	:mCategory(category), mName(name), mSize(size), mDeserialize(std::move(deserialize)), mSerialize(std::move(serialize))
+	, mDeserializeBinary(std::move(deserializeBinary)), mSerializeBinary(std::move(serializeBinary)), mTriviallyCopyable(triviallyCopyable)
 {
 }
 
@@ -42,3 +44,15 @@ void MetaType::Serialize(const void* instance, rapidjson::Value& jsonValue, rapi
 	ASSERT(mSerialize, "MetaType -- no serialize callable registered for '%s'.", GetName());
 	mSerialize(instance, jsonValue,document);
 }
+
+bool MetaType::DeserializeBinary(void* instance, BinaryReader& reader) const
+{
+	ASSERT(mDeserializeBinary, "MetaType -- no binary deserialize callable registered for '%s'.", GetName());
+	return mDeserializeBinary(instance, reader);
+}
+
+void MetaType::SerializeBinary(const void* instance, BinaryWriter& writer) const
+{
+	ASSERT(mSerializeBinary, "MetaType -- no binary serialize callable registered for '%s'.", GetName());
+	mSerializeBinary(instance, writer);
+}
@@ -0,0 +1,295 @@
+#include "Precompiled.h"
+#include "Profiler.h"
+
+#include "DebugUtil.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+namespace
+{
+	// Each slot is a seqlock: the owner marks it busy (odd) while writing and stamps it with
+	// 2 * (write + 1) when done, so a reader can tell a finished event of the lap it wants
+	// from one being overwritten. The fields are atomics to keep the torn reads well defined.
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence{ 0 };
+		std::atomic<const char*> name{ nullptr };
+		std::atomic<uint64_t> timestamp{ 0 };
+		std::atomic<uint64_t> duration{ 0 };
+		std::atomic<double> value{ 0.0 };
+		std::atomic<Profiler::EventType> type{ Profiler::EventType::Scope };
+	};
+
+	// Only the owning thread writes 'slots' and 'writeCount'
+	struct ThreadBuffer
+	{
+		std::unique_ptr<Slot[]> slots = std::make_unique<Slot[]>(Profiler::kEventsPerThread);
+		std::atomic<uint64_t> writeCount{ 0 };
+		std::atomic<uint64_t> readStart{ 0 }; // events before this were cleared
+		std::string name;
+		uint32_t index = 0;
+		bool exited = false; // owner is gone, free once its events are collected
+	};
+
+	std::mutex sRegistryMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> sThreadBuffers;
+	std::vector<std::unique_ptr<ThreadBuffer>> sFreeBuffers; // left by exited threads, handed to new ones
+	size_t sBufferCount = 0;
+	uint32_t sNextThreadIndex = 0;
+	std::atomic<bool> sEnabled{ true };
+	std::atomic<uint64_t> sFrameIndex{ 0 };
+
+	void ReleaseExitedBuffers()
+	{
+		auto exited = std::stable_partition(sThreadBuffers.begin(), sThreadBuffers.end(), [](auto& buffer) { return !buffer->exited; });
+		std::move(exited, sThreadBuffers.end(), std::back_inserter(sFreeBuffers));
+		sThreadBuffers.erase(exited, sThreadBuffers.end());
+	}
+
+	class BufferOwner
+	{
+	public:
+		BufferOwner()
+		{
+			std::lock_guard<std::mutex> lock(sRegistryMutex);
+			std::unique_ptr<ThreadBuffer> buffer;
+			if (sFreeBuffers.empty())
+			{
+				buffer = std::make_unique<ThreadBuffer>();
+				++sBufferCount;
+			}
+			else
+			{
+				// Keep counting where the last owner stopped so the old slots never look current
+				buffer = std::move(sFreeBuffers.back());
+				sFreeBuffers.pop_back();
+				buffer->readStart.store(buffer->writeCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				buffer->exited = false;
+			}
+			buffer->index = sNextThreadIndex++;
+			buffer->name = "Thread " + std::to_string(buffer->index);
+			mBuffer = buffer.get();
+			sThreadBuffers.push_back(std::move(buffer));
+		}
+
+		~BufferOwner()
+		{
+			std::lock_guard<std::mutex> lock(sRegistryMutex);
+			mBuffer->exited = true;
+		}
+
+		ThreadBuffer& Get() { return *mBuffer; }
+
+	private:
+		ThreadBuffer* mBuffer = nullptr;
+	};
+
+	ThreadBuffer& GetThreadBuffer()
+	{
+		thread_local BufferOwner tOwner;
+		return tOwner.Get();
+	}
+
+	void Push(const Profiler::Event& event)
+	{
+		auto& buffer = GetThreadBuffer();
+		const uint64_t write = buffer.writeCount.load(std::memory_order_relaxed);
+		Slot& slot = buffer.slots[write % Profiler::kEventsPerThread];
+		slot.sequence.store(2 * write + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.name.store(event.name, std::memory_order_relaxed);
+		slot.timestamp.store(event.timestamp, std::memory_order_relaxed);
+		slot.duration.store(event.duration, std::memory_order_relaxed);
+		slot.value.store(event.value, std::memory_order_relaxed);
+		slot.type.store(event.type, std::memory_order_relaxed);
+		slot.sequence.store(2 * write + 2, std::memory_order_release);
+		buffer.writeCount.store(write + 1, std::memory_order_release);
+	}
+
+	// False if the owner has moved past event 'index' or is rewriting its slot
+	bool Read(const ThreadBuffer& buffer, uint64_t index, Profiler::Event& event)
+	{
+		const Slot& slot = buffer.slots[index % Profiler::kEventsPerThread];
+		const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != 2 * index + 2)
+			return false;
+
+		event.name = slot.name.load(std::memory_order_relaxed);
+		event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+		event.duration = slot.duration.load(std::memory_order_relaxed);
+		event.value = slot.value.load(std::memory_order_relaxed);
+		event.type = slot.type.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return slot.sequence.load(std::memory_order_relaxed) == sequence;
+	}
+
+	void AppendEscaped(std::string& out, const char* text)
+	{
+		for (const char* c = text; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+				out += '\\';
+			out += *c;
+		}
+	}
+}
+
+uint64_t Profiler::GetTimestamp()
+{
+	static const auto startTime = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void Profiler::SetEnabled(bool enabled)
+{
+	sEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled()
+{
+	return sEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+	auto& buffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(sRegistryMutex);
+	buffer.name = name;
+}
+
+void Profiler::RecordScope(const char* name, uint64_t start, uint64_t end)
+{
+	Event event;
+	event.name = name;
+	event.timestamp = start;
+	event.duration = end - start;
+	event.type = EventType::Scope;
+	Push(event);
+}
+
+void Profiler::RecordCounter(const char* name, double value)
+{
+	if (!IsEnabled())
+		return;
+
+	Event event;
+	event.name = name;
+	event.timestamp = GetTimestamp();
+	event.value = value;
+	event.type = EventType::Counter;
+	Push(event);
+}
+
+void Profiler::MarkFrame()
+{
+	const uint64_t frameIndex = sFrameIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+	if (!IsEnabled())
+		return;
+
+	Event event;
+	event.name = "Frame";
+	event.timestamp = GetTimestamp();
+	event.value = static_cast<double>(frameIndex);
+	event.type = EventType::Frame;
+	Push(event);
+}
+
+uint64_t Profiler::GetFrameIndex()
+{
+	return sFrameIndex.load(std::memory_order_relaxed);
+}
+
+void Profiler::CollectEvents(std::vector<std::pair<uint32_t, Event>>& events)
+{
+	std::lock_guard<std::mutex> lock(sRegistryMutex);
+	for (auto& buffer : sThreadBuffers)
+	{
+		const uint64_t end = buffer->writeCount.load(std::memory_order_acquire);
+		const uint64_t oldest = end > kEventsPerThread ? end - kEventsPerThread : 0;
+		const uint64_t begin = std::max(oldest, buffer->readStart.load(std::memory_order_relaxed));
+
+		// Anything the owner overwrote while we read is dropped
+		Event event;
+		for (uint64_t i = begin; i < end; ++i)
+		{
+			if (Read(*buffer, i, event))
+				events.emplace_back(buffer->index, event);
+		}
+	}
+
+	// Exited threads are done writing, hand their buffers on now that we have the events
+	ReleaseExitedBuffers();
+}
+
+size_t Profiler::GetThreadBufferCount()
+{
+	std::lock_guard<std::mutex> lock(sRegistryMutex);
+	return sBufferCount;
+}
+
+bool Profiler::ExportChromeTrace(const std::filesystem::path& path)
+{
+	// Names first, collecting frees the buffers of exited threads
+	std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	char line[256];
+	{
+		std::lock_guard<std::mutex> lock(sRegistryMutex);
+		for (auto& buffer : sThreadBuffers)
+		{
+			snprintf(line, std::size(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"", buffer->index);
+			json += line;
+			AppendEscaped(json, buffer->name.c_str());
+			json += "\"}},\n";
+		}
+	}
+
+	std::vector<std::pair<uint32_t, Event>> events;
+	CollectEvents(events);
+	json.reserve(json.size() + events.size() * 96 + 16);
+
+	// Chrome trace timestamps are in microseconds
+	for (auto& [threadIndex, event] : events)
+	{
+		json += "{\"name\":\"";
+		AppendEscaped(json, event.name);
+		switch (event.type)
+		{
+		case EventType::Scope:
+			snprintf(line, std::size(line), "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n",
+				threadIndex, event.timestamp / 1000.0, event.duration / 1000.0);
+			break;
+		case EventType::Counter:
+			snprintf(line, std::size(line), "\",\"ph\":\"C\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%.17g}},\n",
+				threadIndex, event.timestamp / 1000.0, event.value);
+			break;
+		case EventType::Frame:
+			snprintf(line, std::size(line), "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"args\":{\"frame\":%.0f}},\n",
+				threadIndex, event.timestamp / 1000.0, event.value);
+			break;
+		}
+		json += line;
+	}
+
+	// Drop the trailing comma
+	if (json.size() >= 2 && json[json.size() - 2] == ',')
+		json.erase(json.size() - 2, 1);
+	json += "]}\n";
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		LOG("Profiler -- Failed to open %s for writing.", path.u8string().c_str());
+		return false;
+	}
+	file.write(json.data(), json.size());
+	return file.good();
+}
+
+void Profiler::Clear()
+{
+	std::lock_guard<std::mutex> lock(sRegistryMutex);
+	for (auto& buffer : sThreadBuffers)
+		buffer->readStart.store(buffer->writeCount.load(std::memory_order_acquire), std::memory_order_relaxed);
+	ReleaseExitedBuffers();
+}
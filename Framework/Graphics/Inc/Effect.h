@@ -7,7 +7,7 @@ namespace Angazi::Graphics
 	class Effect
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(Effect);
 
 		enum class EffectType
 		{
@@ -8,7 +8,7 @@ namespace Angazi::Graphics
 	class HdrEffect : public Effect
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(HdrEffect);
 
 		HdrEffect() : Effect(EffectType::PbrType) {}
 		~HdrEffect() = default;
@@ -6,7 +6,7 @@ namespace Angazi::Graphics
 {
 	struct Material
 	{
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(Material);
 		float padding[1]{};
 		float power = 0.0f;
 		Color ambient;
@@ -47,5 +47,8 @@ namespace Angazi::Graphics
 		std::vector<MaterialData> materialData;
 		Skeleton skeleton;
 		AnimationSet animationSet;
+
+	private:
+		size_t mTrackedBytes = 0;
 	};
 }
\ No newline at end of file
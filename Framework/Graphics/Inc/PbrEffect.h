@@ -9,7 +9,7 @@ namespace Angazi::Graphics
 	class PbrEffect : public Effect
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(PbrEffect);
 		PbrEffect() : Effect(EffectType::StandardType) {};
 		~PbrEffect() = default;
 
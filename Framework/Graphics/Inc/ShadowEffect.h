@@ -8,7 +8,7 @@ namespace Angazi::Graphics
 	class ShadowEffect : public Effect
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(ShadowEffect);
 
 		ShadowEffect():Effect(EffectType::ShadowType) {};
 		~ShadowEffect() = default;
@@ -9,7 +9,7 @@ namespace Angazi::Graphics
 	class StandardEffect : public Effect
 	{
 	public:
-		META_CLASS_DECLARE;
+		META_CLASS_DECLARE(StandardEffect);
 
 		StandardEffect() :Effect(EffectType::StandardType) {};
 		~StandardEffect() = default;
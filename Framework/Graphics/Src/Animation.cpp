@@ -53,7 +53,7 @@ Math::Quaternion Animation::GetRotation(float time) const
 	float timeFrameDuration = time - mRotationKeyframes[i - 1].time;
 	float totalFrameDuration = mRotationKeyframes[i].time - mRotationKeyframes[i - 1].time;
 	float t = timeFrameDuration / totalFrameDuration;
-	return Normalize(Slerp(mRotationKeyframes[i - 1].key, mRotationKeyframes[i].key, t));
+	return FastSlerp(mRotationKeyframes[i - 1].key, mRotationKeyframes[i].key, t);
 }
 
 Math::Vector3 Animation::GetScale(float time) const
@@ -145,3 +145,8 @@ Math::Matrix4 Camera::GetOrthographicMatrix(float width, float height) const
 		0.0f     , 0.0f    , zn / (zn - zf), 1.0f
 	};
 }
+
+Math::Frustum Camera::GetViewFrustum() const
+{
+	return Math::Frustum::FromViewProjection(GetViewMatrix() * GetPerspectiveMatrix());
+}
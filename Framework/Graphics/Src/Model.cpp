@@ -117,10 +117,24 @@ void Model::Initialize(const std::filesystem::path& fileName)
 	ModelLoader::LoadModel(fileName, *this);
 	ModelLoader::LoadSkeleton(fileName, skeleton);
 	ModelLoader::LoadAnimationSet(fileName,animationSet);
+
+	// CPU copies of the meshes, the GPU side is tracked by the mesh buffers
+	mTrackedBytes = 0;
+	for (auto& data : meshData)
+	{
+		mTrackedBytes += data.mesh.vertices.capacity() * sizeof(data.mesh.vertices[0]);
+		mTrackedBytes += data.mesh.indices.capacity() * sizeof(data.mesh.indices[0]);
+	}
+	if (mTrackedBytes > 0)
+		TRACK_ALLOCATION(Core::MemoryCategory::Model, mTrackedBytes);
 }
 
 void Model::Terminate()
 {
+	if (mTrackedBytes > 0)
+		TRACK_FREE(Core::MemoryCategory::Model, mTrackedBytes);
+	mTrackedBytes = 0;
+
 	for (auto& data : meshData)
 		data.meshBuffer.Terminate();
 	for (auto& data : materialData)
@@ -18,6 +18,7 @@ void ParticleEmitter::Initialize(const std::filesystem::path& imagePath, uint32_
 	mConstantBuffer.Initialize(sizeof(Math::Matrix4));
 	mDepthStencilState.Initialize(true, false);
 	mMaxParticles = maxParticles;
+	mParticles.reserve(maxParticles);
 }
 
 void ParticleEmitter::Terminate()
@@ -47,6 +48,10 @@ void ParticleEmitter::Update(float deltaTime)
 	// Spawn new particles
 	mEmitCount += mEmitRate * deltaTime;
 	int count = static_cast<int>(mEmitCount);
+	mEmitCount -= count;
+
+	// Never grow past the reserved pool, Draw could not show the extra particles anyway
+	count = Math::Min(count, mMaxParticles - static_cast<int>(mParticles.size()));
 	for (int i = 0; i < count; ++i)
 	{
 		Particle p;
@@ -64,7 +69,6 @@ void ParticleEmitter::Update(float deltaTime)
 		p.textureIndex = Math::RandomInt(0,4);
 		mParticles.emplace_back(p);
 	}
-	mEmitCount -= count;
 
 	// Update and prune existing particles
 	for (auto&p : mParticles)
@@ -86,7 +90,10 @@ void ParticleEmitter::Draw(const Camera & camera)
 	mVertexShader.Bind();
 	mPixelShader.Bind();
 
-	std::vector<VertexPCX> vertices;
+	const size_t drawCount = Math::Min(size_t(mMaxParticles), mParticles.size());
+	Core::ScratchScope scratch;
+	Core::ArenaVector<VertexPCX> vertices(scratch.GetArena());
+	vertices.reserve(drawCount * 6);
 	Math::Vector2 uv[] = { {0.0f, 0.0f}, {0.5f, 0.0f}, {0.0f, 0.5f}, {0.5f, 0.5f} };
 
 	Math::Vector3 cameraDir = camera.GetDirection();
@@ -99,7 +106,7 @@ void ParticleEmitter::Draw(const Camera & camera)
 
 	Math::Vector3 cameraPos = camera.GetPosition();
 	Math::Vector3 up = Math::GetUp(matView);
-	for (size_t i = 0; i < size_t(mMaxParticles) && i < mParticles.size(); ++i)
+	for (size_t i = 0; i < drawCount; ++i)
 	{
 		auto &p = mParticles[i];
 		auto dirToCam = Math::Normalize(cameraPos - p.position);
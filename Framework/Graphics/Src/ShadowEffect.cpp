@@ -99,10 +99,7 @@ void ShadowEffect::SetLightDirection(const Math::Vector3 & direction, const Came
 	auto defaultMatView = mCurrentCamera.GetViewMatrix();
 	auto defaultMatProj = mCurrentCamera.GetPerspectiveMatrix();
 	auto invViewProj = Math::Inverse(defaultMatView * defaultMatProj);
-	for (auto& vertex : mViewFrustumVertices)
-	{
-		vertex = TransformCoord(vertex, invViewProj);
-	}
+	Math::Batch::TransformCoord(mViewFrustumVertices.data(), mViewFrustumVertices.data(), mViewFrustumVertices.size(), invViewProj);
 
 	auto lightLook = mLightCamera.GetDirection();
 	auto lightSide = Math::Normalize(Cross(Math::Vector3::YAxis, lightLook));
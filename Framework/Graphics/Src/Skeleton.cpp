@@ -67,7 +67,7 @@ void Angazi::Graphics::UpdateBoneMatrices(Bone* bone, std::vector<Math::Matrix4>
 	if (clipFrom.GetTransformTuple(time, bone->index, tupleFrom) && (clipTo.GetTransformTuple(time, bone->index, tupleTo)))
 	{
 		Math::Vector3 position = Lerp(std::get<0>(tupleFrom), std::get<0>(tupleTo), blendWeight);
-		Math::Quaternion rotation = Slerp(std::get<1>(tupleFrom), std::get<1>(tupleTo), blendWeight);
+		Math::Quaternion rotation = FastSlerp(std::get<1>(tupleFrom), std::get<1>(tupleTo), blendWeight);
 		Math::Vector3 scale = Lerp(std::get<2>(tupleFrom), std::get<2>(tupleTo), blendWeight);
 		auto matTrans = Math::Matrix4::Translation({ position });
 		auto matRot = Math::Matrix4::RotationQuaternion(rotation);
@@ -54,6 +54,7 @@ namespace Angazi::Graphics
 		int mVertexCount = 0;
 		int mVertexSize = 0;
 		int mIndexCount = 0;
+		size_t mTrackedBytes = 0;
 	};
 
 }
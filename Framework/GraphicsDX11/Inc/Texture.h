@@ -39,9 +39,12 @@ namespace Angazi::Graphics
 	private:
 		friend class SpriteRenderer;
 
+		void TrackMemory();
+
 		ID3D11ShaderResourceView* mShaderResourceView = nullptr;
 		uint32_t mWidth = 0;
 		uint32_t mHeight = 0;
+		size_t mTrackedBytes = 0;
 	};
 
 } // namespace Angazi::Graphics
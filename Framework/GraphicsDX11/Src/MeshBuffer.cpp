@@ -43,6 +43,9 @@ void MeshBuffer::InitializeInternal(const void * vertices, int vertexSize, int v
 		hr = device->CreateBuffer(&bufferDesc, &initData, &mIndexBuffer);
 		ASSERT(SUCCEEDED(hr), "Failed to create index buffer.");
 	}
+
+	mTrackedBytes = static_cast<size_t>(vertexCount) * vertexSize + (mIndexBuffer ? static_cast<size_t>(indexCount) * sizeof(uint32_t) : 0);
+	TRACK_ALLOCATION(Core::MemoryCategory::MeshBuffer, mTrackedBytes);
 	//auto context = GetContext();
 	//context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
@@ -55,6 +58,10 @@ MeshBuffer::~MeshBuffer()
 
 void MeshBuffer::Terminate()
 {
+	if (mVertexBuffer)
+		TRACK_FREE(Core::MemoryCategory::MeshBuffer, mTrackedBytes);
+	mTrackedBytes = 0;
+
 	SafeRelease(mIndexBuffer);
 	SafeRelease(mVertexBuffer);
 }
@@ -36,6 +36,7 @@ void Texture::Initialize(const std::filesystem::path& fileName, bool gammaCorrec
 
 	mWidth = desc.Width;
 	mHeight = desc.Height;
+	TrackMemory();
 }
 
 void Texture::Initialize(const std::vector<std::filesystem::path>& cubeSides, bool gammaCorrection)
@@ -111,6 +112,7 @@ void Texture::Initialize(const std::vector<std::filesystem::path>& cubeSides, bo
 
 	hr = GetDevice()->CreateShaderResourceView(texArray, &viewDesc, &mShaderResourceView);
 	ASSERT(SUCCEEDED(hr), "[Texture] Failed to create cube texture");
+	TrackMemory();
 }
 
 void Texture::InitializeHdrCube(const std::filesystem::path & filePath, const std::filesystem::path & shaderFilePath, uint32_t cubeLength)
@@ -138,6 +140,7 @@ void Texture::InitializeHdrCube(const std::filesystem::path & filePath, const st
 
 	mWidth = desc.Width;
 	mHeight = desc.Height;
+	TrackMemory();
 }
 
 void Texture::InitializeCubeMap(Texture & texture, const std::filesystem::path & shaderFilePath, uint32_t cubeLength, CubeMapType type)
@@ -165,13 +168,45 @@ void Texture::InitializeCubeMap(Texture & texture, const std::filesystem::path &
 
 	mWidth = desc.Width;
 	mHeight = desc.Height;
+	TrackMemory();
 }
 
 void Texture::Terminate()
 {
+	if (mShaderResourceView)
+		TRACK_FREE(Core::MemoryCategory::Texture, mTrackedBytes);
+	mTrackedBytes = 0;
+
 	SafeRelease(mShaderResourceView);
 }
 
+void Texture::TrackMemory()
+{
+	ID3D11Resource* resource = nullptr;
+	mShaderResourceView->GetResource(&resource);
+	D3D11_TEXTURE2D_DESC desc{};
+	static_cast<ID3D11Texture2D*>(resource)->GetDesc(&desc);
+	SafeRelease(resource);
+
+	// Sum the mip chain, ComputePitch knows the bits per pixel and the BC block sizes.
+	// Close enough for a budget, the driver may pad.
+	size_t bytes = 0;
+	for (uint32_t mip = 0; mip < desc.MipLevels; ++mip)
+	{
+		const size_t width = Math::Max(desc.Width >> mip, 1u);
+		const size_t height = Math::Max(desc.Height >> mip, 1u);
+		size_t rowPitch = 0;
+		size_t slicePitch = 0;
+		if (FAILED(DirectX::ComputePitch(desc.Format, width, height, rowPitch, slicePitch)))
+			slicePitch = width * height * 4;
+		bytes += slicePitch;
+	}
+	bytes *= desc.ArraySize;
+
+	mTrackedBytes = bytes;
+	TRACK_ALLOCATION(Core::MemoryCategory::Texture, mTrackedBytes);
+}
+
 void Texture::BindVS(uint32_t slot) const
 {
 	GetContext()->VSSetShaderResources(slot, 1, &mShaderResourceView);
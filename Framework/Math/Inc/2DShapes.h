@@ -34,4 +34,22 @@ namespace Angazi::Math
 		Circle(const Vector2& center, float radius) : radius(radius), center(center) {}
 		Circle(float x , float y, float radius) : radius(radius), center(x,y) {}
 	};
+
+	struct Ray2D
+	{
+		Vector2 origin = Vector2::Zero;
+		Vector2 direction = Vector2::XAxis;
+	};
+
+	// Nearest hit of a 2D ray cast against a shape set, 'distance' is in units of the ray direction
+	struct RayHit2D
+	{
+		static constexpr uint32_t kNone = UINT32_MAX;
+
+		uint32_t index = kNone;
+		float distance = std::numeric_limits<float>::max();
+		Vector2 normal = Vector2::Zero;
+
+		bool IsHit() const { return index != kNone; }
+	};
 }
\ No newline at end of file
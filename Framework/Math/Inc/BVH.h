@@ -0,0 +1,377 @@
+#pragma once
+
+namespace Angazi::Math
+{
+	// Bounding volume hierarchy over primitive bounds. Primitives are identified by index, e.g.
+	// their position in an array or ShapeSoA set, and the tree only keeps their bounds. Queries
+	// call back with every primitive whose bounds pass the test, exact tests are up to the
+	// caller (Batch::Raycast does them for shape sets).
+	//
+	// Build splits nodes with binned SAH and hands large subtrees to the JobSystem. Refit and
+	// Update keep the tree shape and only move bounds, which suits objects that move a little
+	// each frame. Insert and Remove change the shape in place, rebuild when queries slow down.
+	class BVH
+	{
+	public:
+		// 32 bytes, both children of a node are stored next to each other
+		struct Node
+		{
+			Vector3 min;
+			uint32_t child = 0;	// first child, or first slot in the index list for leaves
+			Vector3 max;
+			uint32_t count = 0;	// primitives in a leaf, 0 for inner nodes
+
+			bool IsLeaf() const { return count != 0; }
+		};
+
+		static constexpr uint32_t kInvalid = UINT32_MAX;
+		static constexpr uint32_t kMaxLeafSize = 4;
+		static constexpr size_t kParallelBuildThreshold = 16 * 1024;
+
+		// Primitive i gets index i
+		void Build(const AABB* bounds, size_t count);
+		void Build(const SphereSoA& spheres);
+		void Build(const AABBSoA& aabbs);
+		void Build(const OBBSoA& obbs);
+		template <class Primitive>
+		void Build(const Primitive* primitives, size_t count);
+		void Clear();
+
+		// 'bounds' is indexed by primitive, entries for primitives not in the tree are skipped
+		void Refit(const AABB* bounds);
+		void Update(uint32_t primitive, const AABB& bounds);
+
+		void Insert(uint32_t primitive, const AABB& bounds);
+		void Remove(uint32_t primitive);
+		bool Contains(uint32_t primitive) const { return primitive < mLeaves.size() && mLeaves[primitive] != kInvalid; }
+
+		// 'visit(primitive)' for every primitive whose bounds overlap the shape
+		template <class Visit> void Query(const AABB& aabb, Visit&& visit) const;
+		template <class Visit> void Query(const Sphere& sphere, Visit&& visit) const;
+		template <class Visit> void Query(const Frustum& frustum, Visit&& visit) const;
+
+		// Nearest hit. 'hitTest(primitive, distance, normal)' is called for primitives whose bounds
+		// the ray enters, it returns true and overwrites 'distance' and 'normal' when it hits the
+		// primitive within 'distance'. Ties go to the lower index, as in Batch::Raycast.
+		template <class HitTest>
+		RayHit Raycast(const Ray& ray, HitTest&& hitTest, float maxDistance = std::numeric_limits<float>::max()) const;
+
+		// Leaves the ray enters within 'maxDistance', nearer leaves first. 'visit(primitives,
+		// count, maxDistance)' may lower 'maxDistance' to skip leaves behind a hit.
+		template <class Visit>
+		void TraverseRay(const Ray& ray, float maxDistance, Visit&& visit) const;
+
+		size_t Size() const { return mCount; }
+		bool Empty() const { return mCount == 0; }
+		AABB GetTreeBounds() const;
+		const std::vector<Node>& GetNodes() const { return mNodes; }
+
+		// Expected cost of a random query relative to testing every primitive, lower is better
+		float GetCost() const;
+
+	private:
+		// Small fixed stack that spills to the heap, trees that grew by Insert can get deep
+		template <class T>
+		class Stack
+		{
+		public:
+			void Push(const T& value)
+			{
+				if (mSize < std::size(mLocal))
+					mLocal[mSize] = value;
+				else
+					mSpill.push_back(value);
+				++mSize;
+			}
+			T Pop()
+			{
+				--mSize;
+				if (mSize < std::size(mLocal))
+					return mLocal[mSize];
+				T value = mSpill.back();
+				mSpill.pop_back();
+				return value;
+			}
+			bool Empty() const { return mSize == 0; }
+
+		private:
+			T mLocal[64];
+			std::vector<T> mSpill;
+			size_t mSize = 0;
+		};
+
+		struct Box
+		{
+			Vector3 min;
+			Vector3 max;
+		};
+
+		struct BuildContext;
+		void BuildNode(BuildContext& context, uint32_t nodeIndex, uint32_t begin, uint32_t end);
+		void BuildFromBoxes();
+
+		uint32_t AllocatePair();
+		void MoveNode(uint32_t from, uint32_t to);
+		void FitLeaf(uint32_t nodeIndex);
+		void FitParents(uint32_t nodeIndex);
+
+		template <class Visit> void VisitSubtree(uint32_t nodeIndex, Visit&& visit) const;
+
+		std::vector<Node> mNodes;			// root at 0, child pairs from 1
+		std::vector<uint32_t> mParents;		// per node
+		std::vector<uint32_t> mIndices;		// leaves point into this
+		std::vector<Box> mBoxes;			// per primitive
+		std::vector<uint32_t> mLeaves;		// per primitive, kInvalid when not in the tree
+		std::vector<uint32_t> mFreePairs;
+		size_t mCount = 0;
+	};
+
+	template <class Primitive>
+	void BVH::Build(const Primitive* primitives, size_t count)
+	{
+		std::vector<AABB> bounds(count);
+		for (size_t i = 0; i < count; ++i)
+			bounds[i] = GetBounds(primitives[i]);
+		Build(bounds.data(), count);
+	}
+
+	template <class Visit>
+	void BVH::VisitSubtree(uint32_t nodeIndex, Visit&& visit) const
+	{
+		Stack<uint32_t> stack;
+		stack.Push(nodeIndex);
+		while (!stack.Empty())
+		{
+			const Node& node = mNodes[stack.Pop()];
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = 0; i < node.count; ++i)
+					visit(mIndices[node.child + i]);
+			}
+			else
+			{
+				stack.Push(node.child + 1);
+				stack.Push(node.child);
+			}
+		}
+	}
+
+	template <class Visit>
+	void BVH::Query(const AABB& aabb, Visit&& visit) const
+	{
+		if (mNodes.empty())
+			return;
+
+		const Vector3 min = aabb.Min(), max = aabb.Max();
+		const auto overlaps = [&min, &max](const Vector3& boxMin, const Vector3& boxMax)
+		{
+			return boxMin.x <= max.x && boxMax.x >= min.x &&
+				boxMin.y <= max.y && boxMax.y >= min.y &&
+				boxMin.z <= max.z && boxMax.z >= min.z;
+		};
+
+		Stack<uint32_t> stack;
+		stack.Push(0);
+		while (!stack.Empty())
+		{
+			const Node& node = mNodes[stack.Pop()];
+			if (!overlaps(node.min, node.max))
+				continue;
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = 0; i < node.count; ++i)
+				{
+					const uint32_t primitive = mIndices[node.child + i];
+					if (node.count == 1 || overlaps(mBoxes[primitive].min, mBoxes[primitive].max))
+						visit(primitive);
+				}
+			}
+			else
+			{
+				stack.Push(node.child + 1);
+				stack.Push(node.child);
+			}
+		}
+	}
+
+	template <class Visit>
+	void BVH::Query(const Sphere& sphere, Visit&& visit) const
+	{
+		if (mNodes.empty())
+			return;
+
+		const float radiusSqr = sphere.radius * sphere.radius;
+		const auto overlaps = [&sphere, radiusSqr](const Vector3& min, const Vector3& max)
+		{
+			float distanceSqr = 0.0f;
+			for (size_t axis = 0; axis < 3; ++axis)
+			{
+				const float c = sphere.center.v[axis];
+				const float d = c < min.v[axis] ? min.v[axis] - c : (c > max.v[axis] ? c - max.v[axis] : 0.0f);
+				distanceSqr += d * d;
+			}
+			return distanceSqr <= radiusSqr;
+		};
+
+		Stack<uint32_t> stack;
+		stack.Push(0);
+		while (!stack.Empty())
+		{
+			const Node& node = mNodes[stack.Pop()];
+			if (!overlaps(node.min, node.max))
+				continue;
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = 0; i < node.count; ++i)
+				{
+					const uint32_t primitive = mIndices[node.child + i];
+					if (node.count == 1 || overlaps(mBoxes[primitive].min, mBoxes[primitive].max))
+						visit(primitive);
+				}
+			}
+			else
+			{
+				stack.Push(node.child + 1);
+				stack.Push(node.child);
+			}
+		}
+	}
+
+	template <class Visit>
+	void BVH::Query(const Frustum& frustum, Visit&& visit) const
+	{
+		if (mNodes.empty())
+			return;
+
+		// Bit i of 'planes' is set while plane i still has to be tested. Once a node is inside
+		// every plane its whole subtree is visited without further tests. The math functions in
+		// EngineMath.h are declared after this header, hence fabsf and the spelled out dot.
+		constexpr uint32_t kAllPlanes = (1u << Frustum::Count) - 1;
+		const auto classify = [&frustum](const Vector3& min, const Vector3& max, uint32_t& planes)
+		{
+			const Vector3 center = (min + max) * 0.5f;
+			const Vector3 extend = (max - min) * 0.5f;
+			for (uint32_t i = 0; i < Frustum::Count; ++i)
+			{
+				if ((planes & (1u << i)) == 0)
+					continue;
+				const Plane& plane = frustum.planes[i];
+				const float radius = fabsf(plane.n.x) * extend.x + fabsf(plane.n.y) * extend.y + fabsf(plane.n.z) * extend.z;
+				const float distance = center.x * plane.n.x + center.y * plane.n.y + center.z * plane.n.z - plane.d;
+				if (distance < -radius)
+					return false;
+				if (distance >= radius)
+					planes &= ~(1u << i);
+			}
+			return true;
+		};
+
+		Stack<std::pair<uint32_t, uint32_t>> stack;
+		stack.Push({ 0, kAllPlanes });
+		while (!stack.Empty())
+		{
+			auto [nodeIndex, planes] = stack.Pop();
+			const Node& node = mNodes[nodeIndex];
+			if (!classify(node.min, node.max, planes))
+				continue;
+			if (planes == 0)
+			{
+				VisitSubtree(nodeIndex, visit);
+			}
+			else if (node.IsLeaf())
+			{
+				for (uint32_t i = 0; i < node.count; ++i)
+				{
+					const uint32_t primitive = mIndices[node.child + i];
+					uint32_t primitivePlanes = planes;
+					if (node.count == 1 || classify(mBoxes[primitive].min, mBoxes[primitive].max, primitivePlanes))
+						visit(primitive);
+				}
+			}
+			else
+			{
+				stack.Push({ node.child + 1, planes });
+				stack.Push({ node.child, planes });
+			}
+		}
+	}
+
+	template <class Visit>
+	void BVH::TraverseRay(const Ray& ray, float maxDistance, Visit&& visit) const
+	{
+		if (mNodes.empty())
+			return;
+
+		const Vector3 invDirection{ 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+		const auto entry = [&ray, &invDirection](const Node& node, float limit)
+		{
+			float tNear = 0.0f, tFar = limit;
+			for (size_t axis = 0; axis < 3; ++axis)
+			{
+				const float t0 = (node.min.v[axis] - ray.origin.v[axis]) * invDirection.v[axis];
+				const float t1 = (node.max.v[axis] - ray.origin.v[axis]) * invDirection.v[axis];
+				tNear = std::max(tNear, std::min(t0, t1));
+				tFar = std::min(tFar, std::max(t0, t1));
+			}
+			return tNear <= tFar ? tNear : std::numeric_limits<float>::infinity();
+		};
+
+		// Nodes are pushed with their entry distance, which is checked again when popped since
+		// a hit found in between may have lowered the limit
+		Stack<std::pair<uint32_t, float>> stack;
+		const float rootEntry = entry(mNodes[0], maxDistance);
+		if (rootEntry <= maxDistance)
+			stack.Push({ 0, rootEntry });
+		while (!stack.Empty())
+		{
+			const auto [nodeIndex, nodeEntry] = stack.Pop();
+			if (nodeEntry > maxDistance)
+				continue;
+			const Node& node = mNodes[nodeIndex];
+			if (node.IsLeaf())
+			{
+				visit(mIndices.data() + node.child, node.count, maxDistance);
+				continue;
+			}
+
+			float nearEntry = entry(mNodes[node.child], maxDistance);
+			float farEntry = entry(mNodes[node.child + 1], maxDistance);
+			uint32_t nearIndex = node.child, farIndex = node.child + 1;
+			if (farEntry < nearEntry)
+			{
+				std::swap(nearEntry, farEntry);
+				std::swap(nearIndex, farIndex);
+			}
+			if (farEntry <= maxDistance)
+				stack.Push({ farIndex, farEntry });
+			if (nearEntry <= maxDistance)
+				stack.Push({ nearIndex, nearEntry });
+		}
+	}
+
+	template <class HitTest>
+	RayHit BVH::Raycast(const Ray& ray, HitTest&& hitTest, float maxDistance) const
+	{
+		RayHit hit;
+		float best = maxDistance;
+		TraverseRay(ray, maxDistance, [&](const uint32_t* primitives, uint32_t count, float& limit)
+		{
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				float distance = limit;
+				Vector3 normal;
+				if (!hitTest(primitives[i], distance, normal))
+					continue;
+				if (distance < best || (distance == best && primitives[i] < hit.index))
+				{
+					best = distance;
+					hit.index = primitives[i];
+					hit.distance = distance;
+					hit.normal = normal;
+					limit = distance;
+				}
+			}
+		});
+		return hit;
+	}
+}
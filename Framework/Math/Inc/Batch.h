@@ -0,0 +1,152 @@
+#pragma once
+
+namespace Angazi::Math
+{
+	// Structure of arrays view over 'count' vectors, one float array per component. Input and
+	// output views may point at the same arrays to work in place.
+	struct Vector3SoA
+	{
+		float* x = nullptr;
+		float* y = nullptr;
+		float* z = nullptr;
+	};
+	struct Vector4SoA
+	{
+		float* x = nullptr;
+		float* y = nullptr;
+		float* z = nullptr;
+		float* w = nullptr;
+	};
+}
+
+// Array versions of the vector functions in EngineMath.h. Each element gives the same result
+// as the single vector function, four elements are processed per SIMD register and spans of
+// at least kParallelThreshold elements are split across the JobSystem when it is running.
+//
+// 'matrixIndices' selects a matrix per element from 'matrices', e.g. the bone or instance
+// a vertex belongs to. Input and output may be the same array.
+namespace Angazi::Math::Batch
+{
+	constexpr size_t kParallelThreshold = 16 * 1024;
+
+	// AoS
+	void TransformCoord(const Vector3* in, Vector3* out, size_t count, const Matrix4& m);
+	void TransformCoord(const Vector3* in, Vector3* out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices);
+	void TransformNormal(const Vector3* in, Vector3* out, size_t count, const Matrix4& m);
+	void TransformNormal(const Vector3* in, Vector3* out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices);
+	void Transform(const Vector4* in, Vector4* out, size_t count, const Matrix4& m);
+	void Transform(const Vector4* in, Vector4* out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices);
+
+	void Dot(const Vector3* a, const Vector3* b, float* out, size_t count);
+	void Cross(const Vector3* a, const Vector3* b, Vector3* out, size_t count);
+	void Magnitude(const Vector3* in, float* out, size_t count);
+	void Normalize(const Vector3* in, Vector3* out, size_t count);
+
+	// SoA
+	void TransformCoord(const Vector3SoA& in, const Vector3SoA& out, size_t count, const Matrix4& m);
+	void TransformCoord(const Vector3SoA& in, const Vector3SoA& out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices);
+	void TransformNormal(const Vector3SoA& in, const Vector3SoA& out, size_t count, const Matrix4& m);
+	void TransformNormal(const Vector3SoA& in, const Vector3SoA& out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices);
+	void Transform(const Vector4SoA& in, const Vector4SoA& out, size_t count, const Matrix4& m);
+
+	void Dot(const Vector3SoA& a, const Vector3SoA& b, float* out, size_t count);
+	void Cross(const Vector3SoA& a, const Vector3SoA& b, const Vector3SoA& out, size_t count);
+	void Magnitude(const Vector3SoA& in, float* out, size_t count);
+	void Normalize(const Vector3SoA& in, const Vector3SoA& out, size_t count);
+
+	// Quaternion interpolation along the shorter arc, out[i] blends a[i] into b[i] by t[i] or by
+	// the same 't' for all. Same results as FastSlerp and Nlerp, see EngineMath.h for the error.
+	void Slerp(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t count);
+	void Slerp(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count);
+	void Nlerp(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t count);
+	void Nlerp(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count);
+
+	// Quantization, same bits as the single value functions in EngineMath.h. Input and output
+	// must not overlap.
+	void FloatToHalf(const float* in, uint16_t* out, size_t count);
+	void HalfToFloat(const uint16_t* in, float* out, size_t count);
+	void EncodeOctahedral(const Vector3* in, uint32_t* out, size_t count);
+	void DecodeOctahedral(const uint32_t* in, Vector3* out, size_t count);
+	void EncodeQuaternion(const Quaternion* in, uint32_t* out, size_t count);
+	void DecodeQuaternion(const uint32_t* in, Quaternion* out, size_t count);
+
+	void ToUNorm8(const float* in, uint8_t* out, size_t count);
+	void ToSNorm8(const float* in, int8_t* out, size_t count);
+	void ToUNorm16(const float* in, uint16_t* out, size_t count);
+	void ToSNorm16(const float* in, int16_t* out, size_t count);
+	void FromUNorm8(const uint8_t* in, float* out, size_t count);
+	void FromSNorm8(const int8_t* in, float* out, size_t count);
+	void FromUNorm16(const uint16_t* in, float* out, size_t count);
+	void FromSNorm16(const int16_t* in, float* out, size_t count);
+
+	// Frustum culling. Bit (i % 32) of visibleMask[i / 32] is set when object i is at least
+	// partially inside, the mask needs (count + 31) / 32 words and all of them are written.
+	//
+	// 'planeCache' is optional, one byte per object holding the plane that rejected it last
+	// time. Objects rarely change sides between frames, so that plane is tested first. Keep
+	// the array with the objects and fill it with 0 when they are added.
+	void Cull(const Frustum& frustum, const Sphere* spheres, size_t count, uint32_t* visibleMask, uint8_t* planeCache = nullptr);
+	void Cull(const Frustum& frustum, const AABB* aabbs, size_t count, uint32_t* visibleMask, uint8_t* planeCache = nullptr);
+	void Cull(const Frustum& frustum, const OBB* obbs, size_t count, uint32_t* visibleMask, uint8_t* planeCache = nullptr);
+
+	// Random numbers from 'seed'. Block i of kRandomBlockSize values comes from
+	// RandomStream(seed, i), so the output is the same whether or not the JobSystem runs.
+	constexpr size_t kRandomBlockSize = 4096;
+
+	void RandomUniform(uint64_t seed, float* out, size_t count, float min = 0.0f, float max = 1.0f);
+	void RandomNormal(uint64_t seed, float* out, size_t count, float mean = 0.0f, float standardDeviation = 1.0f);
+
+	// Ray casts against shape sets, returning the nearest hit within 'maxDistance'. Ties go to
+	// the lower index. A ray starting inside a sphere, AABB or OBB hits it at distance 0 with
+	// the normal facing back along the ray. Planes are hit from either side.
+	//
+	// The single ray versions test four shapes per register and two registers per loop. The
+	// array versions test packets of four rays against one shape at a time, so each shape is
+	// read once per packet, and split the rays across the JobSystem.
+	RayHit Raycast(const Ray& ray, const SphereSoA& spheres, float maxDistance = std::numeric_limits<float>::max());
+	RayHit Raycast(const Ray& ray, const AABBSoA& aabbs, float maxDistance = std::numeric_limits<float>::max());
+	RayHit Raycast(const Ray& ray, const OBBSoA& obbs, float maxDistance = std::numeric_limits<float>::max());
+	RayHit Raycast(const Ray& ray, const PlaneSoA& planes, float maxDistance = std::numeric_limits<float>::max());
+
+	void Raycast(const Ray* rays, size_t rayCount, const SphereSoA& spheres, RayHit* hits, float maxDistance = std::numeric_limits<float>::max());
+	void Raycast(const Ray* rays, size_t rayCount, const AABBSoA& aabbs, RayHit* hits, float maxDistance = std::numeric_limits<float>::max());
+	void Raycast(const Ray* rays, size_t rayCount, const OBBSoA& obbs, RayHit* hits, float maxDistance = std::numeric_limits<float>::max());
+	void Raycast(const Ray* rays, size_t rayCount, const PlaneSoA& planes, RayHit* hits, float maxDistance = std::numeric_limits<float>::max());
+
+	// One ray against a shape set through a BVH built from it, with the same results as the
+	// versions above. Planes are unbounded and have no BVH version.
+	RayHit Raycast(const Ray& ray, const BVH& bvh, const SphereSoA& spheres, float maxDistance = std::numeric_limits<float>::max());
+	RayHit Raycast(const Ray& ray, const BVH& bvh, const AABBSoA& aabbs, float maxDistance = std::numeric_limits<float>::max());
+	RayHit Raycast(const Ray& ray, const BVH& bvh, const OBBSoA& obbs, float maxDistance = std::numeric_limits<float>::max());
+
+	// 2D ray casts against segment and circle sets, e.g. walls and obstacles, with the same
+	// rules and layout as the 3D versions. Segments are hit from either side including their
+	// end points, a segment lying along the ray is hit where the ray first touches it. The
+	// normal faces back along the ray. 'radius' sweeps a circle of that radius along the ray,
+	// for moving circles against circles.
+	//
+	// The segment query versions cast from 'from' to 'to', 'distance' is then the fraction of
+	// the way along it. Packets of segment queries are rays with maxDistance 1.
+	RayHit2D Raycast(const Ray2D& ray, const LineSegmentSoA& segments, float maxDistance = std::numeric_limits<float>::max());
+	RayHit2D Raycast(const Ray2D& ray, const CircleSoA& circles, float maxDistance = std::numeric_limits<float>::max(), float radius = 0.0f);
+	RayHit2D Raycast(const LineSegment& segment, const LineSegmentSoA& segments);
+	RayHit2D Raycast(const LineSegment& segment, const CircleSoA& circles, float radius = 0.0f);
+
+	void Raycast(const Ray2D* rays, size_t rayCount, const LineSegmentSoA& segments, RayHit2D* hits, float maxDistance = std::numeric_limits<float>::max());
+	void Raycast(const Ray2D* rays, size_t rayCount, const CircleSoA& circles, RayHit2D* hits, float maxDistance = std::numeric_limits<float>::max(), float radius = 0.0f);
+
+	// Early out versions of the 2D ray casts for visibility checks, true as soon as any shape
+	// is hit. Bit (i % 32) of hitMask[i / 32] is set when ray i hits, the mask needs
+	// (rayCount + 31) / 32 words and all of them are written.
+	bool AnyHit(const Ray2D& ray, const LineSegmentSoA& segments, float maxDistance = std::numeric_limits<float>::max());
+	bool AnyHit(const Ray2D& ray, const CircleSoA& circles, float maxDistance = std::numeric_limits<float>::max(), float radius = 0.0f);
+	bool AnyHit(const LineSegment& segment, const LineSegmentSoA& segments);
+	bool AnyHit(const LineSegment& segment, const CircleSoA& circles, float radius = 0.0f);
+
+	void AnyHit(const Ray2D* rays, size_t rayCount, const LineSegmentSoA& segments, uint32_t* hitMask, float maxDistance = std::numeric_limits<float>::max());
+	void AnyHit(const Ray2D* rays, size_t rayCount, const CircleSoA& circles, uint32_t* hitMask, float maxDistance = std::numeric_limits<float>::max(), float radius = 0.0f);
+
+	// True when the circle overlaps any shape in the set, same test as Intersect in EngineMath.h
+	bool Intersect(const Circle& circle, const CircleSoA& circles);
+	bool Intersect(const Circle& circle, const LineSegmentSoA& segments);
+}
@@ -3,6 +3,8 @@
 #include "Common.h"
 
 #include "Constants.h"
+#include "SIMD.h"
+#include "Random.h"
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
@@ -16,6 +18,11 @@
 #include "Plane.h"
 #include "Sphere.h"
 #include "Ray.h"
+#include "Frustum.h"
+#include "ShapeSoA.h"
+#include "BVH.h"
+
+#include "Batch.h"
 
 #include "MetaRegistration.h"
 
@@ -117,6 +124,14 @@ namespace Angazi::Math
 	inline Quaternion Lerp(const Quaternion& q1, const Quaternion& q2, float t)	{ return q1 * (1.0f - t) + (q2 *t); }
 	Quaternion Slerp( const Quaternion& q1, const Quaternion& q2, float t);
 
+	// Slerp along the shorter arc without trig, within 1.5e-6 of the exact result per component
+	Quaternion FastSlerp(const Quaternion& q1, const Quaternion& q2, float t);
+
+	// Normalised lerp along the shorter arc. Same end points as Slerp but the speed is not constant,
+	// the rotation it gives is off from Slerp by at most 0.034 degrees for rotations 30 degrees
+	// apart, 0.27 at 60, 0.92 at 90 and 8.2 at 180.
+	Quaternion Nlerp(const Quaternion& q1, const Quaternion& q2, float t);
+
 	constexpr float Determinant(const Matrix3& m)
 	{
 		float det = 0.0f;
@@ -186,11 +201,55 @@ namespace Angazi::Math
 		const float invDet = 1.0f / determinant;
 		return Adjoint(m) * invDet;
 	}
+	namespace Scalar
+	{
+		constexpr Matrix4 Inverse(const Matrix4 &m)
+		{
+			float determinant = Determinant(m);
+			float inverseDet = 1.0f / determinant;
+			return Adjoint(m) * inverseDet;
+		}
+		constexpr Matrix4 InverseAffine(const Matrix4& m)
+		{
+			const Matrix3 inverse = Inverse(Matrix3{ m._11, m._12, m._13, m._21, m._22, m._23, m._31, m._32, m._33 });
+			return
+			{
+				inverse._11, inverse._12, inverse._13, 0.0f,
+				inverse._21, inverse._22, inverse._23, 0.0f,
+				inverse._31, inverse._32, inverse._33, 0.0f,
+				-(m._41 * inverse._11 + m._42 * inverse._21 + m._43 * inverse._31),
+				-(m._41 * inverse._12 + m._42 * inverse._22 + m._43 * inverse._32),
+				-(m._41 * inverse._13 + m._42 * inverse._23 + m._43 * inverse._33),
+				1.0f
+			};
+		}
+	}
+
 	constexpr Matrix4 Inverse(const Matrix4 &m)
 	{
-		float determinant = Determinant(m);
-		float inverseDet = 1.0f / determinant;
-		return Adjoint(m) * inverseDet;
+#if defined(MATH_SIMD_ENABLED)
+		if (!MATH_IS_CONSTANT_EVALUATED())
+		{
+			Matrix4 result;
+			SIMD::Matrix4Inverse(m.v.data(), result.v.data());
+			return result;
+		}
+#endif
+		return Scalar::Inverse(m);
+	}
+	// Faster inverse for matrices built from scale, rotation and translation only, the last
+	// column must be (0, 0, 0, 1)
+	constexpr Matrix4 InverseAffine(const Matrix4& m)
+	{
+#if defined(MATH_SIMD_ENABLED)
+		if (!MATH_IS_CONSTANT_EVALUATED())
+		{
+			Matrix4 result;
+			SIMD::Matrix4InverseAffine(m.v.data(), result.v.data());
+			return result;
+		}
+#endif
+		return Scalar::InverseAffine(m);
 	}
 
 	constexpr Matrix3 Transpose(const Matrix3& m)
@@ -222,16 +281,6 @@ namespace Angazi::Math
 			v.x * m._12 + v.y * m._22 + m._32/w
 		);
 	}
-	constexpr Vector3 TransformCoord(const Vector3& v , const Matrix4 &m)
-	{
-		const float w = (v.x * m._14) + (v.y * m._24) + (v.z * m._34) + m._44;
-		return 
-		{ 
-			((v.x * m._11) + (v.y * m._21) + (v.z * m._31) + m._41)/w ,
-			((v.x * m._12) + (v.y * m._22) + (v.z * m._32) + m._42)/w ,
-			((v.x * m._13) + (v.y * m._23) + (v.z * m._33) + m._43)/w 
-		};
-	}
 
 	constexpr Vector2 TransformNormal(const Vector2& v, const Matrix3& m)
 	{
@@ -241,14 +290,70 @@ namespace Angazi::Math
 			v.x * m._12 + v.y * m._22
 		);
 	}
-	constexpr Vector3 TransformNormal(const Vector3& v, const Matrix4 &m)
+	namespace Scalar
 	{
-		return
+		constexpr Vector3 TransformCoord(const Vector3& v , const Matrix4 &m)
 		{
-			(v.x * m._11) + (v.y * m._21) + (v.z * m._31),
-			(v.x * m._12) + (v.y * m._22) + (v.z * m._32),
-			(v.x * m._13) + (v.y * m._23) + (v.z * m._33)
-		};
+			const float w = (v.x * m._14) + (v.y * m._24) + (v.z * m._34) + m._44;
+			return 
+			{ 
+				((v.x * m._11) + (v.y * m._21) + (v.z * m._31) + m._41)/w ,
+				((v.x * m._12) + (v.y * m._22) + (v.z * m._32) + m._42)/w ,
+				((v.x * m._13) + (v.y * m._23) + (v.z * m._33) + m._43)/w 
+			};
+		}
+		constexpr Vector3 TransformNormal(const Vector3& v, const Matrix4 &m)
+		{
+			return
+			{
+				(v.x * m._11) + (v.y * m._21) + (v.z * m._31),
+				(v.x * m._12) + (v.y * m._22) + (v.z * m._32),
+				(v.x * m._13) + (v.y * m._23) + (v.z * m._33)
+			};
+		}
+		constexpr Vector4 Transform(const Vector4& v, const Matrix4& m)
+		{
+			return
+			{
+				(v.x * m._11) + (v.y * m._21) + (v.z * m._31) + (v.w * m._41),
+				(v.x * m._12) + (v.y * m._22) + (v.z * m._32) + (v.w * m._42),
+				(v.x * m._13) + (v.y * m._23) + (v.z * m._33) + (v.w * m._43),
+				(v.x * m._14) + (v.y * m._24) + (v.z * m._34) + (v.w * m._44)
+			};
+		}
+	}
+
+	constexpr Vector3 TransformCoord(const Vector3& v, const Matrix4& m)
+	{
+#if defined(MATH_SIMD_ENABLED)
+		if (!MATH_IS_CONSTANT_EVALUATED())
+		{
+			Vector3 result;
+			SIMD::TransformCoord(&v.x, m.v.data(), &result.x);
+			return result;
+		}
+#endif
+		return Scalar::TransformCoord(v, m);
+	}
+	constexpr Vector3 TransformNormal(const Vector3& v, const Matrix4& m)
+	{
+#if defined(MATH_SIMD_ENABLED)
+		if (!MATH_IS_CONSTANT_EVALUATED())
+		{
+			Vector3 result;
+			SIMD::TransformNormal(&v.x, m.v.data(), &result.x);
+			return result;
+		}
+#endif
+		return Scalar::TransformNormal(v, m);
+	}
+	constexpr Vector4 Transform(const Vector4& v, const Matrix4& m)
+	{
+#if defined(MATH_SIMD_ENABLED)
+		if (!MATH_IS_CONSTANT_EVALUATED())
+			return Vector4::FromSIMD(SIMD::Transform(v.ToSIMD(), m.v.data()));
+#endif
+		return Scalar::Transform(v, m);
 	}
 
 	constexpr Vector3 GetTranslation(const Matrix4& m)	{ return { m._41 , m._42, m._43 }; }
@@ -275,6 +380,38 @@ namespace Angazi::Math
 		};
 	}
 
+	// Smallest AABB around the shape, e.g. for BVH::Build
+	inline AABB GetBounds(const AABB& aabb) { return aabb; }
+	AABB GetBounds(const Sphere& sphere);
+	AABB GetBounds(const OBB& obb);
+
+	// Quantization for storage and transport. Every function runs the SIMD lane code that the
+	// Batch versions use, so a value encodes to the same bits either way.
+
+	// IEEE half precision, round to nearest even. Overflow goes to infinity, NaN stays NaN.
+	uint16_t FloatToHalf(float value);
+	float HalfToFloat(uint16_t half);
+
+	// Unit vector as two 16 bit octahedral coordinates, within 0.004 degrees after decoding
+	uint32_t EncodeOctahedral(const Vector3& normal);
+	Vector3 DecodeOctahedral(uint32_t bits);
+
+	// Unit quaternion in 32 bits with the smallest three method. The decoded quaternion is unit
+	// length, components are within 0.002 and the rotation within 0.25 degrees. The sign may flip,
+	// q and -q are the same rotation.
+	uint32_t EncodeQuaternion(const Quaternion& q);
+	Quaternion DecodeQuaternion(uint32_t bits);
+
+	// Normalised fixed point. Values are clamped to [0, 1] or [-1, 1] and rounded to nearest.
+	uint8_t ToUNorm8(float value);
+	int8_t ToSNorm8(float value);
+	uint16_t ToUNorm16(float value);
+	int16_t ToSNorm16(float value);
+	float FromUNorm8(uint8_t value);
+	float FromSNorm8(int8_t value);
+	float FromUNorm16(uint16_t value);
+	float FromSNorm16(int16_t value);
+
 	// 3D Collision Checks
 	bool Intersect(const Ray& ray, const Plane& plane, float& distance);
 
@@ -283,6 +420,15 @@ namespace Angazi::Math
 
 	bool GetContactPoint(const Ray& ray, const OBB& obb, Vector3& point, Vector3& normal);
 
+	// True when the shape is at least partially inside, conservative near the frustum corners
+	bool Intersect(const Frustum& frustum, const Sphere& sphere);
+	bool Intersect(const Frustum& frustum, const AABB& aabb);
+	bool Intersect(const Frustum& frustum, const OBB& obb);
+
+	// Swept sphere checks, 'toi' is the fraction of 'displacement' travelled before first contact
+	bool GetTimeOfImpact(const Sphere& sphere, const Vector3& displacement, const Plane& plane, float& toi);
+	bool GetTimeOfImpact(const Sphere& sphere, const Vector3& displacement, const OBB& obb, float& toi, Vector3& normal);
+
 	// 2D Collision Checks
 	bool PointInRect(const Vector2& point, const Rect& rect);
 	bool PointInCircle(const Vector2& point, const Circle& circle);
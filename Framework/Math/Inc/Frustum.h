@@ -0,0 +1,15 @@
+#pragma once
+
+namespace Angazi::Math
+{
+	// Six planes with normals pointing inwards, a point p is inside when Dot(p, n) >= d for all
+	struct Frustum
+	{
+		enum Side { Left, Right, Bottom, Top, Near, Far, Count };
+
+		std::array<Plane, Count> planes;
+
+		// Works for any row vector view * projection with clip space z in [0, w]
+		static Frustum FromViewProjection(const Matrix4& viewProjection);
+	};
+}
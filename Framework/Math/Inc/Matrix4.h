@@ -67,31 +67,7 @@ namespace Angazi::Math
 			};
 		}
 
-		constexpr Matrix4 operator*(const Matrix4 &m) const
-		{
-			return
-			{
-				(_11 * m._11) + (_12 * m._21) + (_13 * m._31) + (_14 * m._41),
-				(_11 * m._12) + (_12 * m._22) + (_13 * m._32) + (_14 * m._42),
-				(_11 * m._13) + (_12 * m._23) + (_13 * m._33) + (_14 * m._43),
-				(_11 * m._14) + (_12 * m._24) + (_13 * m._34) + (_14 * m._44),
-
-				(_21 * m._11) + (_22 * m._21) + (_23 * m._31) + (_24 * m._41),
-				(_21 * m._12) + (_22 * m._22) + (_23 * m._32) + (_24 * m._42),
-				(_21 * m._13) + (_22 * m._23) + (_23 * m._33) + (_24 * m._43),
-				(_21 * m._14) + (_22 * m._24) + (_23 * m._34) + (_24 * m._44),
-
-				(_31 * m._11) + (_32 * m._21) + (_33 * m._31) + (_34 * m._41),
-				(_31 * m._12) + (_32 * m._22) + (_33 * m._32) + (_34 * m._42),
-				(_31 * m._13) + (_32 * m._23) + (_33 * m._33) + (_34 * m._43),
-				(_31 * m._14) + (_32 * m._24) + (_33 * m._34) + (_34 * m._44),
-
-				(_41 * m._11) + (_42 * m._21) + (_43 * m._31) + (_44 * m._41),
-				(_41 * m._12) + (_42 * m._22) + (_43 * m._32) + (_44 * m._42),
-				(_41 * m._13) + (_42 * m._23) + (_43 * m._33) + (_44 * m._43),
-				(_41 * m._14) + (_42 * m._24) + (_43 * m._34) + (_44 * m._44)
-			};
-		}
+		constexpr Matrix4 operator*(const Matrix4 &m) const;
 		constexpr Matrix4 operator*(float f) const
 		{
 			return Matrix4
@@ -202,4 +178,46 @@ namespace Angazi::Math
 		static Matrix4 RotationQuaternion(const Quaternion& q);
 	};
 
+	namespace Scalar
+	{
+		// Reference implementations, used in constant expressions and when SIMD is off
+		constexpr Matrix4 Multiply(const Matrix4& a, const Matrix4& m)
+		{
+			return
+			{
+				(a._11 * m._11) + (a._12 * m._21) + (a._13 * m._31) + (a._14 * m._41),
+				(a._11 * m._12) + (a._12 * m._22) + (a._13 * m._32) + (a._14 * m._42),
+				(a._11 * m._13) + (a._12 * m._23) + (a._13 * m._33) + (a._14 * m._43),
+				(a._11 * m._14) + (a._12 * m._24) + (a._13 * m._34) + (a._14 * m._44),
+
+				(a._21 * m._11) + (a._22 * m._21) + (a._23 * m._31) + (a._24 * m._41),
+				(a._21 * m._12) + (a._22 * m._22) + (a._23 * m._32) + (a._24 * m._42),
+				(a._21 * m._13) + (a._22 * m._23) + (a._23 * m._33) + (a._24 * m._43),
+				(a._21 * m._14) + (a._22 * m._24) + (a._23 * m._34) + (a._24 * m._44),
+
+				(a._31 * m._11) + (a._32 * m._21) + (a._33 * m._31) + (a._34 * m._41),
+				(a._31 * m._12) + (a._32 * m._22) + (a._33 * m._32) + (a._34 * m._42),
+				(a._31 * m._13) + (a._32 * m._23) + (a._33 * m._33) + (a._34 * m._43),
+				(a._31 * m._14) + (a._32 * m._24) + (a._33 * m._34) + (a._34 * m._44),
+
+				(a._41 * m._11) + (a._42 * m._21) + (a._43 * m._31) + (a._44 * m._41),
+				(a._41 * m._12) + (a._42 * m._22) + (a._43 * m._32) + (a._44 * m._42),
+				(a._41 * m._13) + (a._42 * m._23) + (a._43 * m._33) + (a._44 * m._43),
+				(a._41 * m._14) + (a._42 * m._24) + (a._43 * m._34) + (a._44 * m._44)
+			};
+		}
+	}
+
+	constexpr Matrix4 Matrix4::operator*(const Matrix4& m) const
+	{
+#if defined(MATH_SIMD_ENABLED)
+		if (!MATH_IS_CONSTANT_EVALUATED())
+		{
+			Matrix4 result;
+			SIMD::Matrix4Multiply(v.data(), m.v.data(), result.v.data());
+			return result;
+		}
+#endif
+		return Scalar::Multiply(*this, m);
+	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SIMD.h"
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
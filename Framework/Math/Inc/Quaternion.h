@@ -24,16 +24,7 @@ namespace Angazi::Math
 		const Quaternion operator-(const Quaternion &rhs) const { return Quaternion(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w); }
 		const Quaternion operator*(float value) const			{ return Quaternion(x * value, y * value, z * value, w * value); }
 		const Quaternion operator/(float value) const			{ return Quaternion(x / value, y / value, z / value, w / value); }
-		const Quaternion operator*(const Quaternion &q) const
-		{
-			return Quaternion
-			(
-				w * q.x + x * q.w + y * q.z - z * q.y,
-				w * q.y - x * q.z + y * q.w + z * q.x,
-				w * q.z + x * q.y - y * q.x + z * q.w,
-				w * q.w - x * q.x - y * q.y - z * q.z
-			);
-		}
+		const Quaternion operator*(const Quaternion &q) const;
 
 		const bool operator==(const Quaternion& q) const { return (x == q.x && y == q.y && z == q.z && w == q.w); }
 
@@ -43,4 +34,29 @@ namespace Angazi::Math
 		static Quaternion RotationLookAt(const Vector3& look, const Vector3& up = Vector3::YAxis);
 		static Quaternion RotationFromTo(const Vector3& from, const Vector3& to);
 	};
+
+	namespace Scalar
+	{
+		constexpr Quaternion Multiply(const Quaternion& a, const Quaternion& b)
+		{
+			return Quaternion
+			(
+				a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+				a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+				a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+				a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+			);
+		}
+	}
+
+	inline const Quaternion Quaternion::operator*(const Quaternion& q) const
+	{
+#if defined(MATH_SIMD_ENABLED)
+		Quaternion result;
+		SIMD::Store(result.v.data(), SIMD::QuaternionMultiply(SIMD::Load(v.data()), SIMD::Load(q.v.data())));
+		return result;
+#else
+		return Scalar::Multiply(*this, q);
+#endif
+	}
 }
\ No newline at end of file
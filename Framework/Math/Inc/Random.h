@@ -0,0 +1,45 @@
+#pragma once
+
+namespace Angazi::Math
+{
+	// xoshiro128+ generator. Each stream is fully described by its seed and stream id, so two
+	// streams built from the same pair give the same numbers on every machine and thread.
+	// Floats come from the top 24 bits, the low bits of xoshiro128+ are weak.
+	//
+	// A stream is not thread safe, give each thread or job its own. ThreadRandomStream() is the
+	// one behind RandomFloat() and friends.
+	class RandomStream
+	{
+	public:
+		explicit RandomStream(uint64_t seed = 0, uint64_t streamId = 0) { Seed(seed, streamId); }
+
+		void Seed(uint64_t seed, uint64_t streamId = 0);
+
+		uint32_t NextUInt();
+		float NextFloat();									// [0, 1)
+		float NextFloat(float min, float max);				// [min, max)
+		int NextInt(int min, int max);						// [min, max]
+		double NextDouble();								// [0, 1)
+		double NextDouble(double min, double max);			// [min, max)
+		float NextNormal();									// Mean 0, standard deviation 1
+		float NextNormal(float mean, float standardDeviation);
+
+		// Bulk versions, four lanes per SIMD register. The lanes are seeded from this stream,
+		// so the output only depends on its state, not on the SIMD backend for uniforms.
+		void FillUniform(float* out, size_t count, float min = 0.0f, float max = 1.0f);
+		void FillNormal(float* out, size_t count, float mean = 0.0f, float standardDeviation = 1.0f);
+
+	private:
+		uint32_t mState[4];
+		float mSpareNormal = 0.0f;
+		bool mHasSpareNormal = false;
+	};
+
+	// Stream used by RandomFloat(), RandomInt() and RandomDouble() on the calling thread. Every
+	// thread gets its own, seeded from the global seed and the order threads first ask for one.
+	RandomStream& ThreadRandomStream();
+
+	// Reseeds every thread's default stream, each one picks the new seed up on its next call.
+	// Until this is called the global seed comes from std::random_device.
+	void SeedRandom(uint64_t seed);
+}
@@ -7,4 +7,16 @@ namespace Angazi::Math
 		Vector3 origin = Vector3::Zero;
 		Vector3 direction = Vector3::ZAxis;
 	};
-}
\ No newline at end of file
+
+	// Nearest hit of a ray cast against a shape set, 'distance' is in units of the ray direction
+	struct RayHit
+	{
+		static constexpr uint32_t kNone = UINT32_MAX;
+
+		uint32_t index = kNone;
+		float distance = std::numeric_limits<float>::max();
+		Vector3 normal = Vector3::Zero;
+
+		bool IsHit() const { return index != kNone; }
+	};
+}
@@ -0,0 +1,722 @@
+#pragma once
+
+// SIMD backend, picked at compile time from the target architecture:
+//
+//	MATH_SIMD_AVX2		x64 built with /arch:AVX2 (also defines MATH_SIMD_SSE)
+//	MATH_SIMD_SSE		x86/x64, SSE2 is always there on x64
+//	MATH_SIMD_NEON		ARM64
+//	MATH_SIMD_SCALAR	anything else, or when MATH_SIMD_FORCE_SCALAR is defined
+//
+// The kernels below work on plain float pointers with unaligned loads, so Matrix4, Vector4 and
+// Quaternion keep their layout. The public math functions stay constexpr and only call into
+// here at runtime, see MATH_IS_CONSTANT_EVALUATED.
+
+#if defined(MATH_SIMD_FORCE_SCALAR)
+	#define MATH_SIMD_SCALAR
+#elif defined(__AVX2__)
+	#define MATH_SIMD_AVX2
+	#define MATH_SIMD_SSE
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define MATH_SIMD_SSE
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#define MATH_SIMD_NEON
+#else
+	#define MATH_SIMD_SCALAR
+#endif
+
+#if !defined(MATH_SIMD_SCALAR)
+	#define MATH_SIMD_ENABLED
+#endif
+
+// MSVC implies FMA with /arch:AVX2, gcc and clang want -mfma as well
+#if defined(MATH_SIMD_AVX2) && (defined(__FMA__) || (defined(_MSC_VER) && !defined(__clang__)))
+	#define MATH_SIMD_FMA
+#endif
+
+#if defined(MATH_SIMD_AVX2)
+	#include <immintrin.h>
+#elif defined(MATH_SIMD_SSE)
+	#include <emmintrin.h>
+#elif defined(MATH_SIMD_NEON)
+	#include <arm_neon.h>
+#endif
+
+// True while a constexpr function is being evaluated by the compiler. Without the builtin we
+// cannot tell, so we always take the scalar path.
+#if defined(_MSC_VER) && !defined(__clang__)
+	#if _MSC_VER >= 1925
+		#define MATH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#endif
+#elif defined(__clang__)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define MATH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+	#define MATH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#if !defined(MATH_IS_CONSTANT_EVALUATED)
+	#define MATH_IS_CONSTANT_EVALUATED() true
+#endif
+
+namespace Angazi::Math::SIMD
+{
+	// Four float lanes: x, y, z, w
+#if defined(MATH_SIMD_SSE)
+	using Float4 = __m128;
+
+	inline Float4 Load(const float* p)							{ return _mm_loadu_ps(p); }
+	inline void Store(float* p, Float4 v)						{ _mm_storeu_ps(p, v); }
+	inline Float4 Set(float x, float y, float z, float w)		{ return _mm_setr_ps(x, y, z, w); }
+	inline Float4 Splat(float f)								{ return _mm_set1_ps(f); }
+	inline Float4 Zero()										{ return _mm_setzero_ps(); }
+	inline float GetX(Float4 v)									{ return _mm_cvtss_f32(v); }
+
+	inline Float4 Add(Float4 a, Float4 b)						{ return _mm_add_ps(a, b); }
+	inline Float4 Sub(Float4 a, Float4 b)						{ return _mm_sub_ps(a, b); }
+	inline Float4 Mul(Float4 a, Float4 b)						{ return _mm_mul_ps(a, b); }
+	inline Float4 Div(Float4 a, Float4 b)						{ return _mm_div_ps(a, b); }
+	inline Float4 Min(Float4 a, Float4 b)						{ return _mm_min_ps(a, b); }
+	inline Float4 Max(Float4 a, Float4 b)						{ return _mm_max_ps(a, b); }
+	inline Float4 Sqrt(Float4 v)								{ return _mm_sqrt_ps(v); }
+	inline Float4 Abs(Float4 v)									{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+#if defined(MATH_SIMD_FMA)
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)			{ return _mm_fmadd_ps(a, b, c); }
+#else
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)			{ return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#endif
+
+	// (a[X], a[Y], b[Z], b[W]), same as _mm_shuffle_ps
+	template <int X, int Y, int Z, int W>
+	inline Float4 Shuffle(Float4 a, Float4 b)					{ return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+
+	// Comparisons return a mask with every bit of a lane set where true
+	inline Float4 Less(Float4 a, Float4 b)						{ return _mm_cmplt_ps(a, b); }
+	inline Float4 LessEqual(Float4 a, Float4 b)					{ return _mm_cmple_ps(a, b); }
+	inline Float4 Greater(Float4 a, Float4 b)					{ return _mm_cmpgt_ps(a, b); }
+	inline Float4 GreaterEqual(Float4 a, Float4 b)				{ return _mm_cmpge_ps(a, b); }
+	inline Float4 And(Float4 a, Float4 b)						{ return _mm_and_ps(a, b); }
+	inline Float4 Or(Float4 a, Float4 b)						{ return _mm_or_ps(a, b); }
+	inline Float4 Select(Float4 mask, Float4 a, Float4 b)		{ return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	inline int MoveMask(Float4 mask)							{ return _mm_movemask_ps(mask); }
+
+	// Four uint32 lanes
+	using UInt4 = __m128i;
+
+	inline UInt4 LoadUInt(const uint32_t* p)					{ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+	inline void StoreUInt(uint32_t* p, UInt4 v)					{ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+	inline uint32_t GetX(UInt4 v)								{ return static_cast<uint32_t>(_mm_cvtsi128_si32(v)); }
+	inline UInt4 SplatUInt(uint32_t u)							{ return _mm_set1_epi32(static_cast<int>(u)); }
+	inline UInt4 Add(UInt4 a, UInt4 b)							{ return _mm_add_epi32(a, b); }
+	inline UInt4 Sub(UInt4 a, UInt4 b)							{ return _mm_sub_epi32(a, b); }
+	inline UInt4 And(UInt4 a, UInt4 b)							{ return _mm_and_si128(a, b); }
+	inline UInt4 Or(UInt4 a, UInt4 b)							{ return _mm_or_si128(a, b); }
+	inline UInt4 Xor(UInt4 a, UInt4 b)							{ return _mm_xor_si128(a, b); }
+	template <int N>
+	inline UInt4 ShiftLeft(UInt4 v)								{ return _mm_slli_epi32(v, N); }
+	template <int N>
+	inline UInt4 ShiftRight(UInt4 v)							{ return _mm_srli_epi32(v, N); }
+	inline Float4 ConvertToFloat(UInt4 v)						{ return _mm_cvtepi32_ps(v); }	// Lanes must be below 2^31
+	inline UInt4 ConvertToUInt(Float4 v)						{ return _mm_cvttps_epi32(v); }	// Truncates, lanes must be in [0, 2^31)
+	inline UInt4 Greater(UInt4 a, UInt4 b)						{ return _mm_cmpgt_epi32(a, b); }	// Lanes must be below 2^31
+	inline UInt4 Select(UInt4 mask, UInt4 a, UInt4 b)			{ return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+	inline UInt4 AsUInt(Float4 v)								{ return _mm_castps_si128(v); }
+	inline Float4 AsFloat(UInt4 v)								{ return _mm_castsi128_ps(v); }
+
+#elif defined(MATH_SIMD_NEON)
+	using Float4 = float32x4_t;
+
+	inline Float4 Load(const float* p)							{ return vld1q_f32(p); }
+	inline void Store(float* p, Float4 v)						{ vst1q_f32(p, v); }
+	inline Float4 Set(float x, float y, float z, float w)		{ const float f[4] = { x, y, z, w }; return vld1q_f32(f); }
+	inline Float4 Splat(float f)								{ return vdupq_n_f32(f); }
+	inline Float4 Zero()										{ return vdupq_n_f32(0.0f); }
+	inline float GetX(Float4 v)									{ return vgetq_lane_f32(v, 0); }
+
+	inline Float4 Add(Float4 a, Float4 b)						{ return vaddq_f32(a, b); }
+	inline Float4 Sub(Float4 a, Float4 b)						{ return vsubq_f32(a, b); }
+	inline Float4 Mul(Float4 a, Float4 b)						{ return vmulq_f32(a, b); }
+	inline Float4 Div(Float4 a, Float4 b)						{ return vdivq_f32(a, b); }
+	inline Float4 Min(Float4 a, Float4 b)						{ return vminq_f32(a, b); }
+	inline Float4 Max(Float4 a, Float4 b)						{ return vmaxq_f32(a, b); }
+	inline Float4 Sqrt(Float4 v)								{ return vsqrtq_f32(v); }
+	inline Float4 Abs(Float4 v)									{ return vabsq_f32(v); }
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)			{ return vfmaq_f32(c, a, b); }
+
+	template <int X, int Y, int Z, int W>
+	inline Float4 Shuffle(Float4 a, Float4 b)
+	{
+		Float4 result = vdupq_n_f32(vgetq_lane_f32(a, X));
+		result = vsetq_lane_f32(vgetq_lane_f32(a, Y), result, 1);
+		result = vsetq_lane_f32(vgetq_lane_f32(b, Z), result, 2);
+		return vsetq_lane_f32(vgetq_lane_f32(b, W), result, 3);
+	}
+
+	inline Float4 Less(Float4 a, Float4 b)						{ return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+	inline Float4 LessEqual(Float4 a, Float4 b)					{ return vreinterpretq_f32_u32(vcleq_f32(a, b)); }
+	inline Float4 Greater(Float4 a, Float4 b)					{ return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+	inline Float4 GreaterEqual(Float4 a, Float4 b)				{ return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+	inline Float4 And(Float4 a, Float4 b)						{ return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+	inline Float4 Or(Float4 a, Float4 b)						{ return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+	inline Float4 Select(Float4 mask, Float4 a, Float4 b)		{ return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+	inline int MoveMask(Float4 mask)
+	{
+		const uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+		return static_cast<int>(vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+	}
+
+	using UInt4 = uint32x4_t;
+
+	inline UInt4 LoadUInt(const uint32_t* p)					{ return vld1q_u32(p); }
+	inline void StoreUInt(uint32_t* p, UInt4 v)					{ vst1q_u32(p, v); }
+	inline uint32_t GetX(UInt4 v)								{ return vgetq_lane_u32(v, 0); }
+	inline UInt4 SplatUInt(uint32_t u)							{ return vdupq_n_u32(u); }
+	inline UInt4 Add(UInt4 a, UInt4 b)							{ return vaddq_u32(a, b); }
+	inline UInt4 Sub(UInt4 a, UInt4 b)							{ return vsubq_u32(a, b); }
+	inline UInt4 And(UInt4 a, UInt4 b)							{ return vandq_u32(a, b); }
+	inline UInt4 Or(UInt4 a, UInt4 b)							{ return vorrq_u32(a, b); }
+	inline UInt4 Xor(UInt4 a, UInt4 b)							{ return veorq_u32(a, b); }
+	template <int N>
+	inline UInt4 ShiftLeft(UInt4 v)								{ return vshlq_n_u32(v, N); }
+	template <int N>
+	inline UInt4 ShiftRight(UInt4 v)							{ return vshrq_n_u32(v, N); }
+	inline Float4 ConvertToFloat(UInt4 v)						{ return vcvtq_f32_u32(v); }
+	inline UInt4 ConvertToUInt(Float4 v)						{ return vcvtq_u32_f32(v); }
+	inline UInt4 Greater(UInt4 a, UInt4 b)						{ return vcgtq_u32(a, b); }
+	inline UInt4 Select(UInt4 mask, UInt4 a, UInt4 b)			{ return vbslq_u32(mask, a, b); }
+	inline UInt4 AsUInt(Float4 v)								{ return vreinterpretq_u32_f32(v); }
+	inline Float4 AsFloat(UInt4 v)								{ return vreinterpretq_f32_u32(v); }
+
+#else
+	struct Float4 { float f[4]; };
+
+	inline Float4 Load(const float* p)							{ return { p[0], p[1], p[2], p[3] }; }
+	inline void Store(float* p, Float4 v)						{ p[0] = v.f[0]; p[1] = v.f[1]; p[2] = v.f[2]; p[3] = v.f[3]; }
+	inline Float4 Set(float x, float y, float z, float w)		{ return { x, y, z, w }; }
+	inline Float4 Splat(float f)								{ return { f, f, f, f }; }
+	inline Float4 Zero()										{ return { 0.0f, 0.0f, 0.0f, 0.0f }; }
+	inline float GetX(Float4 v)									{ return v.f[0]; }
+
+	inline Float4 Add(Float4 a, Float4 b)						{ return { a.f[0] + b.f[0], a.f[1] + b.f[1], a.f[2] + b.f[2], a.f[3] + b.f[3] }; }
+	inline Float4 Sub(Float4 a, Float4 b)						{ return { a.f[0] - b.f[0], a.f[1] - b.f[1], a.f[2] - b.f[2], a.f[3] - b.f[3] }; }
+	inline Float4 Mul(Float4 a, Float4 b)						{ return { a.f[0] * b.f[0], a.f[1] * b.f[1], a.f[2] * b.f[2], a.f[3] * b.f[3] }; }
+	inline Float4 Div(Float4 a, Float4 b)						{ return { a.f[0] / b.f[0], a.f[1] / b.f[1], a.f[2] / b.f[2], a.f[3] / b.f[3] }; }
+	inline Float4 Min(Float4 a, Float4 b)						{ return { std::min(a.f[0], b.f[0]), std::min(a.f[1], b.f[1]), std::min(a.f[2], b.f[2]), std::min(a.f[3], b.f[3]) }; }
+	inline Float4 Max(Float4 a, Float4 b)						{ return { std::max(a.f[0], b.f[0]), std::max(a.f[1], b.f[1]), std::max(a.f[2], b.f[2]), std::max(a.f[3], b.f[3]) }; }
+	inline Float4 Sqrt(Float4 v)								{ return { sqrtf(v.f[0]), sqrtf(v.f[1]), sqrtf(v.f[2]), sqrtf(v.f[3]) }; }
+	inline Float4 Abs(Float4 v)									{ return { fabsf(v.f[0]), fabsf(v.f[1]), fabsf(v.f[2]), fabsf(v.f[3]) }; }
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)			{ return Add(Mul(a, b), c); }
+
+	template <int X, int Y, int Z, int W>
+	inline Float4 Shuffle(Float4 a, Float4 b)					{ return { a.f[X], a.f[Y], b.f[Z], b.f[W] }; }
+
+	// Masks hold 1 or 0 per lane
+	inline Float4 Less(Float4 a, Float4 b)						{ return { float(a.f[0] < b.f[0]), float(a.f[1] < b.f[1]), float(a.f[2] < b.f[2]), float(a.f[3] < b.f[3]) }; }
+	inline Float4 LessEqual(Float4 a, Float4 b)					{ return { float(a.f[0] <= b.f[0]), float(a.f[1] <= b.f[1]), float(a.f[2] <= b.f[2]), float(a.f[3] <= b.f[3]) }; }
+	inline Float4 Greater(Float4 a, Float4 b)					{ return Less(b, a); }
+	inline Float4 GreaterEqual(Float4 a, Float4 b)				{ return LessEqual(b, a); }
+	inline Float4 And(Float4 a, Float4 b)						{ return Mul(a, b); }
+	inline Float4 Or(Float4 a, Float4 b)						{ return Max(a, b); }
+	inline Float4 Select(Float4 mask, Float4 a, Float4 b)		{ return { mask.f[0] != 0.0f ? a.f[0] : b.f[0], mask.f[1] != 0.0f ? a.f[1] : b.f[1], mask.f[2] != 0.0f ? a.f[2] : b.f[2], mask.f[3] != 0.0f ? a.f[3] : b.f[3] }; }
+	inline int MoveMask(Float4 mask)							{ return int(mask.f[0] != 0.0f) | (int(mask.f[1] != 0.0f) << 1) | (int(mask.f[2] != 0.0f) << 2) | (int(mask.f[3] != 0.0f) << 3); }
+
+	struct UInt4 { uint32_t u[4]; };
+
+	inline UInt4 LoadUInt(const uint32_t* p)					{ return { p[0], p[1], p[2], p[3] }; }
+	inline void StoreUInt(uint32_t* p, UInt4 v)					{ p[0] = v.u[0]; p[1] = v.u[1]; p[2] = v.u[2]; p[3] = v.u[3]; }
+	inline uint32_t GetX(UInt4 v)								{ return v.u[0]; }
+	inline UInt4 SplatUInt(uint32_t u)							{ return { u, u, u, u }; }
+	inline UInt4 Add(UInt4 a, UInt4 b)							{ return { a.u[0] + b.u[0], a.u[1] + b.u[1], a.u[2] + b.u[2], a.u[3] + b.u[3] }; }
+	inline UInt4 Sub(UInt4 a, UInt4 b)							{ return { a.u[0] - b.u[0], a.u[1] - b.u[1], a.u[2] - b.u[2], a.u[3] - b.u[3] }; }
+	inline UInt4 And(UInt4 a, UInt4 b)							{ return { a.u[0] & b.u[0], a.u[1] & b.u[1], a.u[2] & b.u[2], a.u[3] & b.u[3] }; }
+	inline UInt4 Or(UInt4 a, UInt4 b)							{ return { a.u[0] | b.u[0], a.u[1] | b.u[1], a.u[2] | b.u[2], a.u[3] | b.u[3] }; }
+	inline UInt4 Xor(UInt4 a, UInt4 b)							{ return { a.u[0] ^ b.u[0], a.u[1] ^ b.u[1], a.u[2] ^ b.u[2], a.u[3] ^ b.u[3] }; }
+	template <int N>
+	inline UInt4 ShiftLeft(UInt4 v)								{ return { v.u[0] << N, v.u[1] << N, v.u[2] << N, v.u[3] << N }; }
+	template <int N>
+	inline UInt4 ShiftRight(UInt4 v)							{ return { v.u[0] >> N, v.u[1] >> N, v.u[2] >> N, v.u[3] >> N }; }
+	inline Float4 ConvertToFloat(UInt4 v)						{ return { float(v.u[0]), float(v.u[1]), float(v.u[2]), float(v.u[3]) }; }
+	inline UInt4 ConvertToUInt(Float4 v)						{ return { uint32_t(v.f[0]), uint32_t(v.f[1]), uint32_t(v.f[2]), uint32_t(v.f[3]) }; }
+	inline UInt4 Greater(UInt4 a, UInt4 b)						{ return { a.u[0] > b.u[0] ? ~0u : 0u, a.u[1] > b.u[1] ? ~0u : 0u, a.u[2] > b.u[2] ? ~0u : 0u, a.u[3] > b.u[3] ? ~0u : 0u }; }
+	inline UInt4 Select(UInt4 mask, UInt4 a, UInt4 b)			{ return { mask.u[0] ? a.u[0] : b.u[0], mask.u[1] ? a.u[1] : b.u[1], mask.u[2] ? a.u[2] : b.u[2], mask.u[3] ? a.u[3] : b.u[3] }; }
+	inline UInt4 AsUInt(Float4 v)								{ UInt4 r; memcpy(&r, &v, sizeof(r)); return r; }
+	inline Float4 AsFloat(UInt4 v)								{ Float4 r; memcpy(&r, &v, sizeof(r)); return r; }
+#endif
+
+	// (v[X], v[Y], v[Z], v[W])
+	template <int X, int Y, int Z, int W>
+	inline Float4 Swizzle(Float4 v)								{ return Shuffle<X, Y, Z, W>(v, v); }
+	template <int I>
+	inline Float4 SplatLane(Float4 v)							{ return Shuffle<I, I, I, I>(v, v); }
+
+	// Sum of all lanes, in every lane
+	inline Float4 HorizontalSum(Float4 v)
+	{
+		v = Add(v, Swizzle<1, 0, 3, 2>(v));
+		return Add(v, Swizzle<2, 3, 0, 1>(v));
+	}
+	inline Float4 Dot4(Float4 a, Float4 b)						{ return HorizontalSum(Mul(a, b)); }
+
+	// Cross product of xyz, w is 0 when both w are equal
+	inline Float4 Cross3(Float4 a, Float4 b)
+	{
+		return Sub(
+			Mul(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b)),
+			Mul(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b)));
+	}
+
+	// Rows to columns
+	inline void Transpose(Float4& a, Float4& b, Float4& c, Float4& d)
+	{
+		const Float4 ab01 = Shuffle<0, 1, 0, 1>(a, b);
+		const Float4 cd01 = Shuffle<0, 1, 0, 1>(c, d);
+		const Float4 ab23 = Shuffle<2, 3, 2, 3>(a, b);
+		const Float4 cd23 = Shuffle<2, 3, 2, 3>(c, d);
+		a = Shuffle<0, 2, 0, 2>(ab01, cd01);
+		b = Shuffle<1, 3, 1, 3>(ab01, cd01);
+		c = Shuffle<0, 2, 0, 2>(ab23, cd23);
+		d = Shuffle<1, 3, 1, 3>(ab23, cd23);
+	}
+
+	// Natural log of positive normal lanes, Cephes polynomial with about 1e-7 relative error
+	inline Float4 Log(Float4 x)
+	{
+		// x = m * 2^e with m in [0.5, 1), then m in [sqrt(0.5), sqrt(2)) - 1 for the polynomial
+		const UInt4 bits = AsUInt(x);
+		Float4 e = Sub(ConvertToFloat(ShiftRight<23>(bits)), Splat(126.0f));
+		Float4 m = AsFloat(Or(And(bits, SplatUInt(0x007FFFFF)), SplatUInt(0x3F000000)));
+		const Float4 small = Less(m, Splat(0.707106781f));
+		e = Select(small, Sub(e, Splat(1.0f)), e);
+		m = Sub(Select(small, Add(m, m), m), Splat(1.0f));
+
+		const Float4 z = Mul(m, m);
+		Float4 y = Splat(7.0376836292e-2f);
+		y = MulAdd(y, m, Splat(-1.1514610310e-1f));
+		y = MulAdd(y, m, Splat(1.1676998740e-1f));
+		y = MulAdd(y, m, Splat(-1.2420140846e-1f));
+		y = MulAdd(y, m, Splat(1.4249322787e-1f));
+		y = MulAdd(y, m, Splat(-1.6668057665e-1f));
+		y = MulAdd(y, m, Splat(2.0000714765e-1f));
+		y = MulAdd(y, m, Splat(-2.4999993993e-1f));
+		y = MulAdd(y, m, Splat(3.3333331174e-1f));
+		y = Mul(Mul(y, m), z);
+		y = MulAdd(e, Splat(-2.12194440e-4f), y);
+		y = MulAdd(z, Splat(-0.5f), y);
+		return MulAdd(e, Splat(0.693359375f), Add(m, y));
+	}
+
+	// Sine and cosine of lanes in [-Pi, Pi], Taylor series after folding into [-Pi/2, Pi/2],
+	// about 2e-7 absolute error
+	inline void SinCos(Float4 x, Float4& sin, Float4& cos)
+	{
+		// sin(x) = sin(Pi - x) and cos(x) = -cos(Pi - x)
+		const Float4 halfPi = Splat(1.57079632679f);
+		const Float4 above = Greater(x, halfPi);
+		const Float4 below = Less(x, Sub(Zero(), halfPi));
+		x = Select(above, Sub(Splat(3.14159265359f), x), Select(below, Sub(Splat(-3.14159265359f), x), x));
+		const Float4 x2 = Mul(x, x);
+
+		Float4 s = Splat(-2.5052108e-8f);
+		s = MulAdd(s, x2, Splat(2.7557319e-6f));
+		s = MulAdd(s, x2, Splat(-1.9841270e-4f));
+		s = MulAdd(s, x2, Splat(8.3333333e-3f));
+		s = MulAdd(s, x2, Splat(-1.6666667e-1f));
+		sin = MulAdd(Mul(s, x2), x, x);
+
+		Float4 c = Splat(2.0876757e-9f);
+		c = MulAdd(c, x2, Splat(-2.7557319e-7f));
+		c = MulAdd(c, x2, Splat(2.4801587e-5f));
+		c = MulAdd(c, x2, Splat(-1.3888889e-3f));
+		c = MulAdd(c, x2, Splat(4.1666667e-2f));
+		c = MulAdd(c, x2, Splat(-0.5f));
+		c = MulAdd(c, x2, Splat(1.0f));
+		cos = Select(Or(above, below), Sub(Zero(), c), c);
+	}
+
+	// sin(t * theta) / sin(theta) for t in [0, 1] and cos(theta) in [0, 1], the slerp weights
+	// without trig. Eberly's polynomial from "A Fast and Accurate Algorithm for Computing SLERP"
+	// with 12 terms, the last one scaled so the error stays below 8e-7 over the whole range.
+	inline Float4 SlerpWeight(Float4 t, Float4 cosTheta)
+	{
+		// u[i] = 1 / (i * (2i + 1)) and v[i] = i / (2i + 1) for i = 1..12
+		constexpr float u[] =
+		{
+			0.333333333f, 0.1f, 0.0476190476f, 0.0277777778f, 0.0181818182f, 0.0128205128f,
+			0.00952380952f, 0.00735294118f, 0.00584795322f, 0.00476190476f, 0.00395256917f, 0.00631238543f
+		};
+		constexpr float v[] =
+		{
+			0.333333333f, 0.4f, 0.428571429f, 0.444444444f, 0.454545455f, 0.461538462f,
+			0.466666667f, 0.470588235f, 0.473684211f, 0.476190476f, 0.47826087f, 0.908983501f
+		};
+		const Float4 one = Splat(1.0f);
+		const Float4 xm1 = Sub(cosTheta, one);
+		const Float4 t2 = Mul(t, t);
+		Float4 c = one;
+		for (int i = 11; i >= 0; --i)
+			c = MulAdd(Mul(MulAdd(Splat(u[i]), t2, Splat(-v[i])), xm1), c, one);
+		return Mul(t, c);
+	}
+
+	// Fixed point with scale steps over [0, 1], e.g. 255 for 8 bits. Clamps and rounds to nearest.
+	inline UInt4 ToUNorm(Float4 v, float scale)
+	{
+		const Float4 clamped = Min(Max(v, Zero()), Splat(1.0f));
+		return ConvertToUInt(Add(Mul(clamped, Splat(scale)), Splat(0.5f)));
+	}
+	inline Float4 FromUNorm(UInt4 v, float scale)				{ return Mul(ConvertToFloat(v), Splat(1.0f / scale)); }
+
+	// Fixed point with scale steps each side of zero, e.g. 127 for 8 bits. The result is two's
+	// complement in the low bits, the offset keeps the conversion on positive values.
+	inline UInt4 ToSNorm(Float4 v, float scale)
+	{
+		const Float4 clamped = Min(Max(v, Splat(-1.0f)), Splat(1.0f));
+		const float offset = scale + 1.0f;
+		return Xor(ConvertToUInt(Add(Mul(clamped, Splat(scale)), Splat(offset + 0.5f))), SplatUInt(static_cast<uint32_t>(offset)));
+	}
+	inline Float4 FromSNorm(UInt4 v, float scale)
+	{
+		const float offset = scale + 1.0f;
+		const Float4 value = Sub(ConvertToFloat(Xor(v, SplatUInt(static_cast<uint32_t>(offset)))), Splat(offset));
+		return Max(Mul(value, Splat(1.0f / scale)), Splat(-1.0f));
+	}
+
+	// IEEE half precision in the low 16 bits, round to nearest even. Overflow goes to infinity
+	// and NaN stays a (quiet) NaN. After Fabian Giesen's float_to_half_fast3_rtne.
+	inline UInt4 FloatToHalf(Float4 f)
+	{
+		const UInt4 denormMagic = SplatUInt(((127 - 15) + (23 - 10) + 1) << 23);
+		const UInt4 bits = AsUInt(f);
+		const UInt4 sign = And(bits, SplatUInt(0x80000000));
+		const UInt4 a = Xor(bits, sign);
+
+		// Results below the smallest normal half line the mantissa up at the bottom with an add
+		const UInt4 subnormal = Sub(AsUInt(Add(AsFloat(a), AsFloat(denormMagic))), denormMagic);
+		// Rebias the exponent and round the 13 dropped bits to nearest even
+		const UInt4 odd = And(ShiftRight<13>(a), SplatUInt(1));
+		const UInt4 normal = ShiftRight<13>(Add(Add(a, SplatUInt(0xC8000FFF)), odd));
+		const UInt4 infOrNaN = Select(Greater(a, SplatUInt(0x7F800000)), SplatUInt(0x7E00), SplatUInt(0x7C00));
+
+		UInt4 half = Select(Greater(SplatUInt(113 << 23), a), subnormal, normal);
+		half = Select(Greater(a, SplatUInt(((127 + 16) << 23) - 1)), infOrNaN, half);
+		return Or(half, ShiftRight<16>(sign));
+	}
+
+	// Exact, every half has a float
+	inline Float4 HalfToFloat(UInt4 h)
+	{
+		const UInt4 shiftedExponent = SplatUInt(0x7C00 << 13);
+		UInt4 bits = ShiftLeft<13>(And(h, SplatUInt(0x7FFF)));
+		const UInt4 exponent = And(bits, shiftedExponent);
+		bits = Add(bits, SplatUInt((127 - 15) << 23));
+
+		const UInt4 infOrNaN = Add(bits, SplatUInt((128 - 16) << 23));
+		const UInt4 subnormal = AsUInt(Sub(AsFloat(Add(bits, SplatUInt(1 << 23))), AsFloat(SplatUInt(113 << 23))));
+		bits = Select(Greater(exponent, Sub(shiftedExponent, SplatUInt(1))), infOrNaN, bits);
+		bits = Select(Greater(SplatUInt(1 << 23), exponent), subnormal, bits);
+		return AsFloat(Or(bits, ShiftLeft<16>(And(h, SplatUInt(0x8000)))));
+	}
+
+	// Unit vectors folded onto an octahedron, x in the low 16 bits and y in the high 16 bits as
+	// snorms. Zero length lanes give garbage.
+	inline UInt4 EncodeOctahedral(Float4 x, Float4 y, Float4 z)
+	{
+		const Float4 zero = Zero();
+		const Float4 one = Splat(1.0f);
+		const Float4 minusOne = Splat(-1.0f);
+		const Float4 invLength = Div(one, Add(Add(Abs(x), Abs(y)), Abs(z)));
+		Float4 u = Mul(x, invLength);
+		Float4 v = Mul(y, invLength);
+
+		// The lower half folds over the diagonals
+		const Float4 foldU = Mul(Sub(one, Abs(v)), Select(GreaterEqual(u, zero), one, minusOne));
+		const Float4 foldV = Mul(Sub(one, Abs(u)), Select(GreaterEqual(v, zero), one, minusOne));
+		const Float4 lower = Less(z, zero);
+		u = Select(lower, foldU, u);
+		v = Select(lower, foldV, v);
+		return Or(ToSNorm(u, 32767.0f), ShiftLeft<16>(ToSNorm(v, 32767.0f)));
+	}
+
+	inline void DecodeOctahedral(UInt4 bits, Float4& x, Float4& y, Float4& z)
+	{
+		const Float4 zero = Zero();
+		const Float4 u = FromSNorm(And(bits, SplatUInt(0xFFFF)), 32767.0f);
+		const Float4 v = FromSNorm(ShiftRight<16>(bits), 32767.0f);
+		z = Sub(Sub(Splat(1.0f), Abs(u)), Abs(v));
+
+		// Unfold the lower half, t is how far past the diagonal the point is
+		const Float4 t = Max(Sub(zero, z), zero);
+		x = Add(u, Select(GreaterEqual(u, zero), Sub(zero, t), t));
+		y = Add(v, Select(GreaterEqual(v, zero), Sub(zero, t), t));
+
+		const Float4 invLength = Div(Splat(1.0f), Sqrt(MulAdd(x, x, MulAdd(y, y, Mul(z, z)))));
+		x = Mul(x, invLength);
+		y = Mul(y, invLength);
+		z = Mul(z, invLength);
+	}
+
+	// Smallest three: the index of the largest component in the top two bits, then the other
+	// three in order as 10 bit snorms of [-1/sqrt2, 1/sqrt2]. The largest is made positive, which
+	// keeps the rotation, so decoding can rebuild it from the unit length.
+	inline UInt4 EncodeQuaternion(Float4 x, Float4 y, Float4 z, Float4 w)
+	{
+		const Float4 zero = Zero();
+		Float4 largest = x;
+		Float4 index = zero;
+		Float4 greater = Greater(Abs(y), Abs(largest));
+		largest = Select(greater, y, largest);
+		index = Select(greater, Splat(1.0f), index);
+		greater = Greater(Abs(z), Abs(largest));
+		largest = Select(greater, z, largest);
+		index = Select(greater, Splat(2.0f), index);
+		greater = Greater(Abs(w), Abs(largest));
+		largest = Select(greater, w, largest);
+		index = Select(greater, Splat(3.0f), index);
+
+		// Scaled by sqrt2 into [-1, 1], negated along with the largest
+		const Float4 scale = Select(Less(largest, zero), Splat(-1.41421356f), Splat(1.41421356f));
+		const Float4 a = Mul(Select(Less(index, Splat(0.5f)), y, x), scale);
+		const Float4 b = Mul(Select(Less(index, Splat(1.5f)), z, y), scale);
+		const Float4 c = Mul(Select(Greater(index, Splat(2.5f)), z, w), scale);
+
+		UInt4 bits = ShiftLeft<30>(ConvertToUInt(index));
+		bits = Or(bits, ShiftLeft<20>(ToSNorm(a, 511.0f)));
+		bits = Or(bits, ShiftLeft<10>(ToSNorm(b, 511.0f)));
+		return Or(bits, ToSNorm(c, 511.0f));
+	}
+
+	inline void DecodeQuaternion(UInt4 bits, Float4& x, Float4& y, Float4& z, Float4& w)
+	{
+		const UInt4 mask = SplatUInt(0x3FF);
+		const Float4 scale = Splat(0.707106781f);
+		const Float4 a = Mul(FromSNorm(And(ShiftRight<20>(bits), mask), 511.0f), scale);
+		const Float4 b = Mul(FromSNorm(And(ShiftRight<10>(bits), mask), 511.0f), scale);
+		const Float4 c = Mul(FromSNorm(And(bits, mask), 511.0f), scale);
+		const Float4 d = Sqrt(Max(Sub(Splat(1.0f), MulAdd(a, a, MulAdd(b, b, Mul(c, c)))), Zero()));
+
+		const Float4 index = ConvertToFloat(ShiftRight<30>(bits));
+		const Float4 is0 = Less(index, Splat(0.5f));
+		const Float4 is1 = And(Greater(index, Splat(0.5f)), Less(index, Splat(1.5f)));
+		const Float4 is2 = And(Greater(index, Splat(1.5f)), Less(index, Splat(2.5f)));
+		const Float4 is3 = Greater(index, Splat(2.5f));
+		x = Select(is0, d, a);
+		y = Select(is0, a, Select(is1, d, b));
+		z = Select(Less(index, Splat(1.5f)), b, Select(is2, d, c));
+		w = Select(is3, d, c);
+	}
+
+	// Four packed Vector3 (12 floats) to and from one register per component
+	inline void LoadVector3x4(const float* p, Float4& x, Float4& y, Float4& z)
+	{
+		const Float4 a = Load(p + 0);	// x0 y0 z0 x1
+		const Float4 b = Load(p + 4);	// y1 z1 x2 y2
+		const Float4 c = Load(p + 8);	// z2 x3 y3 z3
+		x = Shuffle<0, 3, 0, 2>(a, Shuffle<2, 2, 1, 1>(b, c));
+		y = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 0, 0>(a, b), Shuffle<3, 3, 2, 2>(b, c));
+		z = Shuffle<0, 2, 0, 3>(Shuffle<2, 2, 1, 1>(a, b), c);
+	}
+	inline void StoreVector3x4(float* p, Float4 x, Float4 y, Float4 z)
+	{
+		Store(p + 0, Shuffle<0, 2, 0, 2>(Shuffle<0, 0, 0, 0>(x, y), Shuffle<0, 0, 1, 1>(z, x)));
+		Store(p + 4, Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 1, 1>(y, z), Shuffle<2, 2, 2, 2>(x, y)));
+		Store(p + 8, Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 3, 3>(z, x), Shuffle<3, 3, 3, 3>(y, z)));
+	}
+
+	// Kernels, matrices are 16 floats in row major order and multiply row vectors
+	inline void Matrix4Multiply(const float* a, const float* b, float* out)
+	{
+#if defined(MATH_SIMD_AVX2)
+		// Two result rows per register, each 128 bit half works on its own row of a
+		const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 0));
+		const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+		const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+		const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+		const auto multiplyRows = [&](const float* rows)
+		{
+			const __m256 r = _mm256_loadu_ps(rows);
+			__m256 result = _mm256_mul_ps(_mm256_shuffle_ps(r, r, 0x00), b0);
+#if defined(MATH_SIMD_FMA)
+			result = _mm256_fmadd_ps(_mm256_shuffle_ps(r, r, 0x55), b1, result);
+			result = _mm256_fmadd_ps(_mm256_shuffle_ps(r, r, 0xAA), b2, result);
+			return _mm256_fmadd_ps(_mm256_shuffle_ps(r, r, 0xFF), b3, result);
+#else
+			result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(r, r, 0x55), b1));
+			result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(r, r, 0xAA), b2));
+			return _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(r, r, 0xFF), b3));
+#endif
+		};
+
+		const __m256 r01 = multiplyRows(a + 0);
+		const __m256 r23 = multiplyRows(a + 8);
+		_mm256_storeu_ps(out + 0, r01);
+		_mm256_storeu_ps(out + 8, r23);
+#else
+		const Float4 b0 = Load(b + 0);
+		const Float4 b1 = Load(b + 4);
+		const Float4 b2 = Load(b + 8);
+		const Float4 b3 = Load(b + 12);
+		const auto multiplyRow = [&](const float* row)
+		{
+			const Float4 r = Load(row);
+			Float4 result = Mul(SplatLane<0>(r), b0);
+			result = MulAdd(SplatLane<1>(r), b1, result);
+			result = MulAdd(SplatLane<2>(r), b2, result);
+			return MulAdd(SplatLane<3>(r), b3, result);
+		};
+
+		// All four rows before any store, so out may alias a or b
+		const Float4 r0 = multiplyRow(a + 0);
+		const Float4 r1 = multiplyRow(a + 4);
+		const Float4 r2 = multiplyRow(a + 8);
+		const Float4 r3 = multiplyRow(a + 12);
+		Store(out + 0, r0);
+		Store(out + 4, r1);
+		Store(out + 8, r2);
+		Store(out + 12, r3);
+#endif
+	}
+
+	namespace Detail
+	{
+		// 2x2 matrices packed as (_11, _12, _21, _22)
+		inline Float4 Mat2Mul(Float4 a, Float4 b)
+		{
+			return Add(Mul(a, Swizzle<0, 3, 0, 3>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+		// adjugate(a) * b
+		inline Float4 Mat2AdjMul(Float4 a, Float4 b)
+		{
+			return Sub(Mul(Swizzle<3, 3, 0, 0>(a), b), Mul(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+		}
+		// a * adjugate(b)
+		inline Float4 Mat2MulAdj(Float4 a, Float4 b)
+		{
+			return Sub(Mul(a, Swizzle<3, 0, 3, 0>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+	}
+
+	// General inverse through 2x2 blocks, [A B; C D]
+	inline void Matrix4Inverse(const float* m, float* out)
+	{
+		using namespace Detail;
+
+		const Float4 r0 = Load(m + 0);
+		const Float4 r1 = Load(m + 4);
+		const Float4 r2 = Load(m + 8);
+		const Float4 r3 = Load(m + 12);
+
+		const Float4 A = Shuffle<0, 1, 0, 1>(r0, r1);
+		const Float4 B = Shuffle<2, 3, 2, 3>(r0, r1);
+		const Float4 C = Shuffle<0, 1, 0, 1>(r2, r3);
+		const Float4 D = Shuffle<2, 3, 2, 3>(r2, r3);
+
+		// Determinants of A, B, C and D
+		const Float4 detSub = Sub(
+			Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+			Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+		const Float4 detA = SplatLane<0>(detSub);
+		const Float4 detB = SplatLane<1>(detSub);
+		const Float4 detC = SplatLane<2>(detSub);
+		const Float4 detD = SplatLane<3>(detSub);
+
+		const Float4 DC = Mat2AdjMul(D, C);
+		const Float4 AB = Mat2AdjMul(A, B);
+
+		Float4 X = Sub(Mul(detD, A), Mat2Mul(B, DC));
+		Float4 W = Sub(Mul(detA, D), Mat2Mul(C, AB));
+		Float4 Y = Sub(Mul(detB, C), Mat2MulAdj(D, AB));
+		Float4 Z = Sub(Mul(detC, B), Mat2MulAdj(A, DC));
+
+		const Float4 trace = HorizontalSum(Mul(AB, Swizzle<0, 2, 1, 3>(DC)));
+		const Float4 detM = Sub(Add(Mul(detA, detD), Mul(detB, detC)), trace);
+		const Float4 invDetM = Div(Set(1.0f, -1.0f, -1.0f, 1.0f), detM);
+
+		X = Mul(X, invDetM);
+		Y = Mul(Y, invDetM);
+		Z = Mul(Z, invDetM);
+		W = Mul(W, invDetM);
+
+		Store(out + 0, Shuffle<3, 1, 3, 1>(X, Y));
+		Store(out + 4, Shuffle<2, 0, 2, 0>(X, Y));
+		Store(out + 8, Shuffle<3, 1, 3, 1>(Z, W));
+		Store(out + 12, Shuffle<2, 0, 2, 0>(Z, W));
+	}
+
+	// Inverse of a matrix whose last column is (0, 0, 0, 1), i.e. rotation, scale and translation
+	inline void Matrix4InverseAffine(const float* m, float* out)
+	{
+		const Float4 r0 = Load(m + 0);
+		const Float4 r1 = Load(m + 4);
+		const Float4 r2 = Load(m + 8);
+		const Float4 t = Load(m + 12);
+
+		// The columns of the inverse 3x3 are the cross products of the rows
+		const Float4 c0 = Cross3(r1, r2);
+		const Float4 c1 = Cross3(r2, r0);
+		const Float4 c2 = Cross3(r0, r1);
+		const Float4 invDet = Div(Splat(1.0f), Dot4(r0, c0));
+
+		const Float4 zero = Zero();
+		const Float4 t0 = Shuffle<0, 1, 0, 1>(c0, c1);
+		const Float4 t1 = Shuffle<2, 3, 2, 3>(c0, c1);
+		const Float4 t2 = Shuffle<0, 1, 0, 1>(c2, zero);
+		const Float4 t3 = Shuffle<2, 3, 2, 3>(c2, zero);
+		const Float4 i0 = Mul(Shuffle<0, 2, 0, 2>(t0, t2), invDet);
+		const Float4 i1 = Mul(Shuffle<1, 3, 1, 3>(t0, t2), invDet);
+		const Float4 i2 = Mul(Shuffle<0, 2, 0, 2>(t1, t3), invDet);
+
+		Float4 translation = Mul(SplatLane<0>(t), i0);
+		translation = MulAdd(SplatLane<1>(t), i1, translation);
+		translation = MulAdd(SplatLane<2>(t), i2, translation);
+
+		Store(out + 0, i0);
+		Store(out + 4, i1);
+		Store(out + 8, i2);
+		Store(out + 12, Sub(Set(0.0f, 0.0f, 0.0f, 1.0f), translation));
+	}
+
+	// v * m for a 4 component vector
+	inline Float4 Transform(Float4 v, const float* m)
+	{
+		Float4 result = Mul(SplatLane<0>(v), Load(m + 0));
+		result = MulAdd(SplatLane<1>(v), Load(m + 4), result);
+		result = MulAdd(SplatLane<2>(v), Load(m + 8), result);
+		return MulAdd(SplatLane<3>(v), Load(m + 12), result);
+	}
+
+	// Point transform with perspective divide, v and out hold 3 floats
+	inline void TransformCoord(const float* v, const float* m, float* out)
+	{
+		Float4 result = MulAdd(Splat(v[0]), Load(m + 0), Load(m + 12));
+		result = MulAdd(Splat(v[1]), Load(m + 4), result);
+		result = MulAdd(Splat(v[2]), Load(m + 8), result);
+		result = Div(result, SplatLane<3>(result));
+
+		float f[4];
+		Store(f, result);
+		out[0] = f[0]; out[1] = f[1]; out[2] = f[2];
+	}
+
+	// Direction transform, ignores translation, v and out hold 3 floats
+	inline void TransformNormal(const float* v, const float* m, float* out)
+	{
+		Float4 result = Mul(Splat(v[0]), Load(m + 0));
+		result = MulAdd(Splat(v[1]), Load(m + 4), result);
+		result = MulAdd(Splat(v[2]), Load(m + 8), result);
+
+		float f[4];
+		Store(f, result);
+		out[0] = f[0]; out[1] = f[1]; out[2] = f[2];
+	}
+
+	// Hamilton product, quaternions stored as (x, y, z, w)
+	inline Float4 QuaternionMultiply(Float4 a, Float4 b)
+	{
+		const Float4 sign = Set(1.0f, 1.0f, 1.0f, -1.0f);
+		const Float4 term1 = Mul(SplatLane<3>(a), b);
+		const Float4 term2 = Mul(Swizzle<0, 1, 2, 0>(a), Swizzle<3, 3, 3, 0>(b));
+		const Float4 term3 = Mul(Swizzle<1, 2, 0, 1>(a), Swizzle<2, 0, 1, 1>(b));
+		const Float4 term4 = Mul(Swizzle<2, 0, 1, 2>(a), Swizzle<1, 2, 0, 2>(b));
+		return Sub(MulAdd(Add(term2, term3), sign, term1), term4);
+	}
+}
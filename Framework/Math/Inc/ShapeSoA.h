@@ -0,0 +1,118 @@
+#pragma once
+
+namespace Angazi::Math
+{
+	// Shape sets stored as one float array per component, so SIMD kernels can load four or
+	// eight shapes at once. The arrays are zero padded to a multiple of kPadding, kernels mask
+	// the padding out with Size().
+	template <size_t ComponentCount>
+	class ShapeSoA
+	{
+	public:
+		static constexpr size_t kPadding = 8;
+
+		void Reserve(size_t count)
+		{
+			for (auto& component : mComponents)
+				component.reserve((count + kPadding - 1) / kPadding * kPadding);
+		}
+		void Clear()
+		{
+			for (auto& component : mComponents)
+				component.clear();
+			mCount = 0;
+		}
+
+		size_t Size() const { return mCount; }
+		bool Empty() const { return mCount == 0; }
+
+		const float* Component(size_t component) const { return mComponents[component].data(); }
+
+	protected:
+		uint32_t Append()
+		{
+			if (mCount % kPadding == 0)
+			{
+				for (auto& component : mComponents)
+					component.resize(mCount + kPadding, 0.0f);
+			}
+			return static_cast<uint32_t>(mCount++);
+		}
+
+		float& At(size_t component, uint32_t index) { return mComponents[component][index]; }
+		float At(size_t component, uint32_t index) const { return mComponents[component][index]; }
+
+		std::array<std::vector<float>, ComponentCount> mComponents;
+		size_t mCount = 0;
+	};
+
+	class SphereSoA : public ShapeSoA<4>
+	{
+	public:
+		enum Components { CenterX, CenterY, CenterZ, Radius };
+
+		uint32_t Add(const Sphere& sphere);
+		void Set(uint32_t index, const Sphere& sphere);
+		Sphere Get(uint32_t index) const;
+	};
+
+	// Stored as min and max corners for the slab test
+	class AABBSoA : public ShapeSoA<6>
+	{
+	public:
+		enum Components { MinX, MinY, MinZ, MaxX, MaxY, MaxZ };
+
+		uint32_t Add(const AABB& aabb);
+		void Set(uint32_t index, const AABB& aabb);
+		AABB Get(uint32_t index) const;
+	};
+
+	// Keeps the world space axes next to the rotation so queries skip the quaternion math
+	class OBBSoA : public ShapeSoA<19>
+	{
+	public:
+		enum Components
+		{
+			CenterX, CenterY, CenterZ,
+			ExtendX, ExtendY, ExtendZ,
+			RotationX, RotationY, RotationZ, RotationW,
+			RightX, RightY, RightZ,
+			UpX, UpY, UpZ,
+			LookX, LookY, LookZ
+		};
+
+		uint32_t Add(const OBB& obb);
+		void Set(uint32_t index, const OBB& obb);
+		OBB Get(uint32_t index) const;
+	};
+
+	class PlaneSoA : public ShapeSoA<4>
+	{
+	public:
+		enum Components { NormalX, NormalY, NormalZ, Distance };
+
+		uint32_t Add(const Plane& plane);
+		void Set(uint32_t index, const Plane& plane);
+		Plane Get(uint32_t index) const;
+	};
+
+	class LineSegmentSoA : public ShapeSoA<4>
+	{
+	public:
+		enum Components { FromX, FromY, ToX, ToY };
+
+		uint32_t Add(const LineSegment& segment);
+		void Set(uint32_t index, const LineSegment& segment);
+		LineSegment Get(uint32_t index) const;
+	};
+
+	class CircleSoA : public ShapeSoA<3>
+	{
+	public:
+		enum Components { CenterX, CenterY, Radius };
+
+		uint32_t Add(const Circle& circle);
+		void Set(uint32_t index, const Circle& circle);
+		Circle Get(uint32_t index) const;
+	};
+}
@@ -24,15 +24,18 @@ namespace Angazi::Math
 		const static Vector4 WAxis;
 
 		Vector4 operator-() const { return Vector4(-x, -y, -z, -w); }
-		Vector4 operator+(const Vector4& rhs) const { return Vector4(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w); }
-		Vector4 operator-(const Vector4& rhs) const { return Vector4(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w); }
-		Vector4 operator*(float s) const { return Vector4(x * s, y * s, z * s, w * s); }
-		Vector4 operator/(float s) const { return Vector4(x / s, y / s, z / s, w / s); }
+		Vector4 operator+(const Vector4& rhs) const { return FromSIMD(SIMD::Add(ToSIMD(), rhs.ToSIMD())); }
+		Vector4 operator-(const Vector4& rhs) const { return FromSIMD(SIMD::Sub(ToSIMD(), rhs.ToSIMD())); }
+		Vector4 operator*(float s) const { return FromSIMD(SIMD::Mul(ToSIMD(), SIMD::Splat(s))); }
+		Vector4 operator/(float s) const { return FromSIMD(SIMD::Div(ToSIMD(), SIMD::Splat(s))); }
 
-		Vector4& operator+=(const Vector4& rhs) { x += rhs.x; y += rhs.y; z += rhs.z; w += rhs.w; return *this; }
-		Vector4& operator-=(const Vector4& rhs) { x -= rhs.x; y -= rhs.y; z -= rhs.z; w -= rhs.w; return *this; }
-		Vector4& operator*=(float s) { x *= s; y *= s; z *= s; w *= s; return *this; }
-		Vector4& operator/=(float s) { x /= s; y /= s; z /= s; w /= s; return *this; }
+		Vector4& operator+=(const Vector4& rhs) { return *this = *this + rhs; }
+		Vector4& operator-=(const Vector4& rhs) { return *this = *this - rhs; }
+		Vector4& operator*=(float s) { return *this = *this * s; }
+		Vector4& operator/=(float s) { return *this = *this / s; }
+
+		SIMD::Float4 ToSIMD() const { return SIMD::Load(v.data()); }
+		static Vector4 FromSIMD(SIMD::Float4 f) { Vector4 result; SIMD::Store(result.v.data(), f); return result; }
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,510 @@
+#include "Precompiled.h"
+#include "EngineMath.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+using namespace Angazi::Math;
+
+namespace
+{
+	constexpr uint32_t kBinCount = 16;
+
+	// Cost of visiting a node relative to testing one primitive
+	constexpr float kTraversalCost = 1.0f;
+
+	// Half the surface area, the SAH only compares areas
+	float Area(const Vector3& min, const Vector3& max)
+	{
+		const Vector3 d = max - min;
+		return d.x * d.y + d.y * d.z + d.z * d.x;
+	}
+
+	Vector3 Min3(const Vector3& a, const Vector3& b) { return { Min(a.x, b.x), Min(a.y, b.y), Min(a.z, b.z) }; }
+	Vector3 Max3(const Vector3& a, const Vector3& b) { return { Max(a.x, b.x), Max(a.y, b.y), Max(a.z, b.z) }; }
+
+	struct Bin
+	{
+		Vector3 min{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		Vector3 max{ -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+		uint32_t count = 0;
+
+		void Grow(const Vector3& boxMin, const Vector3& boxMax)
+		{
+			min = Min3(min, boxMin);
+			max = Max3(max, boxMax);
+		}
+		void Grow(const Bin& other)
+		{
+			Grow(other.min, other.max);
+			count += other.count;
+		}
+		float Area() const { return count > 0 ? ::Area(min, max) : 0.0f; }
+	};
+}
+
+struct BVH::BuildContext
+{
+	std::vector<Vector3> centroids;	// per primitive
+	std::atomic<uint32_t> nodeCount{ 1 };
+};
+
+void BVH::Build(const AABB* bounds, size_t count)
+{
+	ASSERT(count < kInvalid, "BVH -- Too many primitives.");
+	mBoxes.resize(count);
+	for (size_t i = 0; i < count; ++i)
+		mBoxes[i] = { bounds[i].Min(), bounds[i].Max() };
+	BuildFromBoxes();
+}
+
+void BVH::Build(const SphereSoA& spheres)
+{
+	mBoxes.resize(spheres.Size());
+	const float* x = spheres.Component(SphereSoA::CenterX);
+	const float* y = spheres.Component(SphereSoA::CenterY);
+	const float* z = spheres.Component(SphereSoA::CenterZ);
+	const float* radius = spheres.Component(SphereSoA::Radius);
+	for (size_t i = 0; i < mBoxes.size(); ++i)
+	{
+		const Vector3 center{ x[i], y[i], z[i] };
+		const Vector3 extend{ radius[i], radius[i], radius[i] };
+		mBoxes[i] = { center - extend, center + extend };
+	}
+	BuildFromBoxes();
+}
+
+void BVH::Build(const AABBSoA& aabbs)
+{
+	mBoxes.resize(aabbs.Size());
+	for (size_t i = 0; i < mBoxes.size(); ++i)
+	{
+		const auto get = [&aabbs, i](size_t component) { return aabbs.Component(component)[i]; };
+		mBoxes[i].min = { get(AABBSoA::MinX), get(AABBSoA::MinY), get(AABBSoA::MinZ) };
+		mBoxes[i].max = { get(AABBSoA::MaxX), get(AABBSoA::MaxY), get(AABBSoA::MaxZ) };
+	}
+	BuildFromBoxes();
+}
+
+void BVH::Build(const OBBSoA& obbs)
+{
+	mBoxes.resize(obbs.Size());
+	for (size_t i = 0; i < mBoxes.size(); ++i)
+	{
+		const auto get = [&obbs, i](size_t component) { return obbs.Component(component)[i]; };
+		const auto axis = [&get](size_t component) { return Vector3{ fabsf(get(component)), fabsf(get(component + 1)), fabsf(get(component + 2)) }; };
+		const Vector3 center{ get(OBBSoA::CenterX), get(OBBSoA::CenterY), get(OBBSoA::CenterZ) };
+		const Vector3 extend =
+			axis(OBBSoA::RightX) * get(OBBSoA::ExtendX) +
+			axis(OBBSoA::UpX) * get(OBBSoA::ExtendY) +
+			axis(OBBSoA::LookX) * get(OBBSoA::ExtendZ);
+		mBoxes[i] = { center - extend, center + extend };
+	}
+	BuildFromBoxes();
+}
+
+void BVH::Clear()
+{
+	mNodes.clear();
+	mParents.clear();
+	mIndices.clear();
+	mBoxes.clear();
+	mLeaves.clear();
+	mFreePairs.clear();
+	mCount = 0;
+}
+
+void BVH::BuildFromBoxes()
+{
+	const uint32_t count = static_cast<uint32_t>(mBoxes.size());
+	mCount = count;
+	mLeaves.assign(count, kInvalid);
+	mFreePairs.clear();
+	mIndices.resize(count);
+	std::iota(mIndices.begin(), mIndices.end(), 0u);
+	if (count == 0)
+	{
+		mNodes.clear();
+		mParents.clear();
+		return;
+	}
+
+	// At most one leaf per primitive, so 2 * count - 1 nodes
+	BuildContext context;
+	context.centroids.resize(count);
+	for (uint32_t i = 0; i < count; ++i)
+		context.centroids[i] = (mBoxes[i].min + mBoxes[i].max) * 0.5f;
+	mNodes.resize(2 * count);
+	mParents.resize(2 * count);
+	mParents[0] = kInvalid;
+
+	BuildNode(context, 0, 0, count);
+
+	const uint32_t nodeCount = context.nodeCount.load();
+	mNodes.resize(nodeCount);
+	mParents.resize(nodeCount);
+}
+
+void BVH::BuildNode(BuildContext& context, uint32_t nodeIndex, uint32_t begin, uint32_t end)
+{
+	Bin bounds, centroidBounds;
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const Box& box = mBoxes[mIndices[i]];
+		bounds.Grow(box.min, box.max);
+		centroidBounds.Grow(context.centroids[mIndices[i]], context.centroids[mIndices[i]]);
+	}
+	const uint32_t count = end - begin;
+	bounds.count = count;
+
+	Node& node = mNodes[nodeIndex];
+	node.min = bounds.min;
+	node.max = bounds.max;
+
+	// Bin the centroids along each axis and take the cheapest split between two bins
+	size_t bestAxis = 3;
+	uint32_t bestSplit = 0;
+	float bestCost = std::numeric_limits<float>::max();
+	if (count > 1)
+	{
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			const float origin = centroidBounds.min.v[axis];
+			const float extent = centroidBounds.max.v[axis] - origin;
+			if (extent <= 0.0f)
+				continue;
+
+			Bin bins[kBinCount];
+			const float scale = kBinCount / extent;
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				const uint32_t primitive = mIndices[i];
+				const uint32_t bin = Min(static_cast<uint32_t>((context.centroids[primitive].v[axis] - origin) * scale), kBinCount - 1);
+				bins[bin].Grow(mBoxes[primitive].min, mBoxes[primitive].max);
+				++bins[bin].count;
+			}
+
+			float rightCost[kBinCount];
+			Bin right;
+			for (uint32_t bin = kBinCount - 1; bin > 0; --bin)
+			{
+				right.Grow(bins[bin]);
+				rightCost[bin] = right.Area() * right.count;
+			}
+			Bin left;
+			for (uint32_t split = 1; split < kBinCount; ++split)
+			{
+				left.Grow(bins[split - 1]);
+				const float cost = left.Area() * left.count + rightCost[split];
+				if (left.count > 0 && left.count < count && cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+				}
+			}
+		}
+	}
+
+	const float area = bounds.Area();
+	const bool leafIsCheaper = bestAxis == 3 || area * count <= area * kTraversalCost + bestCost;
+	if (count <= kMaxLeafSize && leafIsCheaper)
+	{
+		node.child = begin;
+		node.count = count;
+		for (uint32_t i = begin; i < end; ++i)
+			mLeaves[mIndices[i]] = nodeIndex;
+		return;
+	}
+
+	uint32_t middle = begin + count / 2;
+	if (bestAxis != 3)
+	{
+		const float origin = centroidBounds.min.v[bestAxis];
+		const float scale = kBinCount / (centroidBounds.max.v[bestAxis] - origin);
+		const auto first = mIndices.begin();
+		middle = static_cast<uint32_t>(std::partition(first + begin, first + end, [&](uint32_t primitive)
+		{
+			return Min(static_cast<uint32_t>((context.centroids[primitive].v[bestAxis] - origin) * scale), kBinCount - 1) < bestSplit;
+		}) - first);
+	}
+
+	const uint32_t pair = context.nodeCount.fetch_add(2);
+	node.child = pair;
+	node.count = 0;
+	mParents[pair] = nodeIndex;
+	mParents[pair + 1] = nodeIndex;
+
+	if (count >= kParallelBuildThreshold && JobSystem::IsInitialized())
+	{
+		JobCounter counter;
+		JobSystem::Get()->Run([this, &context, pair, begin, middle]() { BuildNode(context, pair, begin, middle); }, &counter);
+		BuildNode(context, pair + 1, middle, end);
+		JobSystem::Get()->Wait(counter);
+	}
+	else
+	{
+		BuildNode(context, pair, begin, middle);
+		BuildNode(context, pair + 1, middle, end);
+	}
+}
+
+void BVH::Refit(const AABB* bounds)
+{
+	for (uint32_t i = 0; i < mLeaves.size(); ++i)
+	{
+		if (mLeaves[i] != kInvalid)
+			mBoxes[i] = { bounds[i].Min(), bounds[i].Max() };
+	}
+	if (mNodes.empty())
+		return;
+
+	// Parents come before their children in pre-order, so walking it backwards fits the
+	// children first
+	std::vector<uint32_t> order;
+	order.reserve(mNodes.size());
+	Stack<uint32_t> stack;
+	stack.Push(0);
+	while (!stack.Empty())
+	{
+		const uint32_t nodeIndex = stack.Pop();
+		order.push_back(nodeIndex);
+		if (!mNodes[nodeIndex].IsLeaf())
+		{
+			stack.Push(mNodes[nodeIndex].child);
+			stack.Push(mNodes[nodeIndex].child + 1);
+		}
+	}
+	for (auto it = order.rbegin(); it != order.rend(); ++it)
+	{
+		Node& node = mNodes[*it];
+		if (node.IsLeaf())
+		{
+			FitLeaf(*it);
+		}
+		else
+		{
+			node.min = Min3(mNodes[node.child].min, mNodes[node.child + 1].min);
+			node.max = Max3(mNodes[node.child].max, mNodes[node.child + 1].max);
+		}
+	}
+}
+
+void BVH::Update(uint32_t primitive, const AABB& bounds)
+{
+	ASSERT(Contains(primitive), "BVH -- Primitive is not in the tree.");
+	mBoxes[primitive] = { bounds.Min(), bounds.Max() };
+	FitLeaf(mLeaves[primitive]);
+	FitParents(mLeaves[primitive]);
+}
+
+void BVH::Insert(uint32_t primitive, const AABB& bounds)
+{
+	ASSERT(primitive != kInvalid && !Contains(primitive), "BVH -- Primitive is already in the tree.");
+	if (primitive >= mLeaves.size())
+	{
+		mLeaves.resize(primitive + 1, kInvalid);
+		mBoxes.resize(primitive + 1);
+	}
+
+	// Leaves of removed primitives leave holes in the index list, squeeze them out once
+	// they outnumber the primitives
+	if (mIndices.size() > 2 * mCount + 64)
+	{
+		std::vector<uint32_t> indices;
+		indices.reserve(mCount + 1);
+		Stack<uint32_t> stack;
+		stack.Push(0);
+		while (!stack.Empty())
+		{
+			Node& node = mNodes[stack.Pop()];
+			if (node.IsLeaf())
+			{
+				const uint32_t first = static_cast<uint32_t>(indices.size());
+				indices.insert(indices.end(), mIndices.begin() + node.child, mIndices.begin() + node.child + node.count);
+				node.child = first;
+			}
+			else
+			{
+				stack.Push(node.child);
+				stack.Push(node.child + 1);
+			}
+		}
+		mIndices = std::move(indices);
+	}
+
+	const Box box{ bounds.Min(), bounds.Max() };
+	mBoxes[primitive] = box;
+	++mCount;
+
+	Node leaf;
+	leaf.min = box.min;
+	leaf.max = box.max;
+	leaf.child = static_cast<uint32_t>(mIndices.size());
+	leaf.count = 1;
+	mIndices.push_back(primitive);
+
+	if (mNodes.empty())
+	{
+		mNodes.push_back(leaf);
+		mParents.push_back(kInvalid);
+		mLeaves[primitive] = 0;
+		return;
+	}
+
+	// Walk down to the sibling that grows the total area the least. Every node on the way
+	// grows to hold the new leaf, which is the cost inherited by the children.
+	uint32_t sibling = 0;
+	while (!mNodes[sibling].IsLeaf())
+	{
+		const Node& node = mNodes[sibling];
+		const float area = Area(node.min, node.max);
+		const float combinedArea = Area(Min3(node.min, box.min), Max3(node.max, box.max));
+		const float inheritedCost = combinedArea - area;
+		const auto descendCost = [&](uint32_t childIndex)
+		{
+			const Node& child = mNodes[childIndex];
+			const float grown = Area(Min3(child.min, box.min), Max3(child.max, box.max));
+			return (child.IsLeaf() ? grown : grown - Area(child.min, child.max)) + inheritedCost;
+		};
+		const float leftCost = descendCost(node.child);
+		const float rightCost = descendCost(node.child + 1);
+		if (combinedArea <= Min(leftCost, rightCost))
+			break;
+		sibling = leftCost <= rightCost ? node.child : node.child + 1;
+	}
+
+	// The sibling moves into a new pair with the leaf and its slot becomes their parent
+	const uint32_t pair = AllocatePair();
+	MoveNode(sibling, pair);
+	mNodes[pair + 1] = leaf;
+	mLeaves[primitive] = pair + 1;
+	mParents[pair] = sibling;
+	mParents[pair + 1] = sibling;
+
+	Node& parent = mNodes[sibling];
+	parent.min = Min3(mNodes[pair].min, box.min);
+	parent.max = Max3(mNodes[pair].max, box.max);
+	parent.child = pair;
+	parent.count = 0;
+	FitParents(sibling);
+}
+
+void BVH::Remove(uint32_t primitive)
+{
+	ASSERT(Contains(primitive), "BVH -- Primitive is not in the tree.");
+	const uint32_t leafIndex = mLeaves[primitive];
+	mLeaves[primitive] = kInvalid;
+	--mCount;
+
+	Node& leaf = mNodes[leafIndex];
+	const auto first = mIndices.begin() + leaf.child;
+	std::iter_swap(std::find(first, first + leaf.count, primitive), first + leaf.count - 1);
+	if (--leaf.count > 0)
+	{
+		FitLeaf(leafIndex);
+		FitParents(leafIndex);
+		return;
+	}
+
+	if (leafIndex == 0)
+	{
+		mNodes.clear();
+		mParents.clear();
+		mIndices.clear();
+		mFreePairs.clear();
+		return;
+	}
+
+	// The sibling takes over the parent slot and the pair is free again
+	const uint32_t parent = mParents[leafIndex];
+	const uint32_t pair = mNodes[parent].child;
+	MoveNode(leafIndex == pair ? pair + 1 : pair, parent);
+	mFreePairs.push_back(pair);
+	FitParents(parent);
+}
+
+AABB BVH::GetTreeBounds() const
+{
+	if (mNodes.empty())
+		return { Vector3::Zero, Vector3::Zero };
+	return { (mNodes[0].min + mNodes[0].max) * 0.5f, (mNodes[0].max - mNodes[0].min) * 0.5f };
+}
+
+float BVH::GetCost() const
+{
+	if (mNodes.empty())
+		return 0.0f;
+
+	// A node is visited with probability area / root area, visiting a leaf tests all of
+	// its primitives
+	float cost = 0.0f;
+	Stack<uint32_t> stack;
+	stack.Push(0);
+	while (!stack.Empty())
+	{
+		const Node& node = mNodes[stack.Pop()];
+		if (node.IsLeaf())
+		{
+			cost += Area(node.min, node.max) * node.count;
+		}
+		else
+		{
+			cost += Area(node.min, node.max) * kTraversalCost;
+			stack.Push(node.child);
+			stack.Push(node.child + 1);
+		}
+	}
+	const float rootArea = Area(mNodes[0].min, mNodes[0].max);
+	return rootArea > 0.0f ? cost / (rootArea * mCount) : 1.0f;
+}
+
+uint32_t BVH::AllocatePair()
+{
+	if (!mFreePairs.empty())
+	{
+		const uint32_t pair = mFreePairs.back();
+		mFreePairs.pop_back();
+		return pair;
+	}
+	const uint32_t pair = static_cast<uint32_t>(mNodes.size());
+	mNodes.resize(pair + 2);
+	mParents.resize(pair + 2);
+	return pair;
+}
+
+void BVH::MoveNode(uint32_t from, uint32_t to)
+{
+	const Node& node = mNodes[to] = mNodes[from];
+	if (node.IsLeaf())
+	{
+		for (uint32_t i = 0; i < node.count; ++i)
+			mLeaves[mIndices[node.child + i]] = to;
+	}
+	else
+	{
+		mParents[node.child] = to;
+		mParents[node.child + 1] = to;
+	}
+}
+
+void BVH::FitLeaf(uint32_t nodeIndex)
+{
+	Node& node = mNodes[nodeIndex];
+	node.min = mBoxes[mIndices[node.child]].min;
+	node.max = mBoxes[mIndices[node.child]].max;
+	for (uint32_t i = 1; i < node.count; ++i)
+	{
+		node.min = Min3(node.min, mBoxes[mIndices[node.child + i]].min);
+		node.max = Max3(node.max, mBoxes[mIndices[node.child + i]].max);
+	}
+}
+
+void BVH::FitParents(uint32_t nodeIndex)
+{
+	for (uint32_t i = mParents[nodeIndex]; i != kInvalid; i = mParents[i])
+	{
+		Node& node = mNodes[i];
+		node.min = Min3(mNodes[node.child].min, mNodes[node.child + 1].min);
+		node.max = Max3(mNodes[node.child].max, mNodes[node.child + 1].max);
+	}
+}
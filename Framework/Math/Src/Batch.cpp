@@ -0,0 +1,1446 @@
+#include "Precompiled.h"
+#include "EngineMath.h"
+
+using namespace Angazi;
+using namespace Angazi::Core;
+using namespace Angazi::Math;
+using namespace Angazi::Math::SIMD;
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Batch -- Vector3 arrays are read as packed floats.");
+static_assert(sizeof(Vector4) == 4 * sizeof(float), "Batch -- Vector4 arrays are read as packed floats.");
+static_assert(sizeof(Sphere) == 4 * sizeof(float), "Batch -- Sphere arrays are read as packed floats.");
+static_assert(sizeof(AABB) == 2 * sizeof(Vector3), "Batch -- AABB arrays are read as packed Vector3 pairs.");
+static_assert(sizeof(OBB) == 10 * sizeof(float), "Batch -- OBB arrays are read as packed floats.");
+
+namespace
+{
+	constexpr size_t kElementsPerJob = 4096;
+
+	// Calls 'body(begin, end)' over [0, count). Large spans go to the JobSystem in chunks that
+	// start on a multiple of 'groupSize', so only the last chunk has a scalar tail.
+	template <class Body>
+	void ForEachRange(size_t count, Body&& body, size_t groupSize = 4)
+	{
+		if (count < Batch::kParallelThreshold || !JobSystem::IsInitialized())
+		{
+			body(size_t(0), count);
+			return;
+		}
+
+		const size_t groups = (count + groupSize - 1) / groupSize;
+		JobSystem::Get()->ParallelFor(groups, [&body, count, groupSize](size_t begin, size_t end)
+		{
+			body(begin * groupSize, std::min(end * groupSize, count));
+		}, std::max<size_t>(kElementsPerJob / groupSize, 1));
+	}
+
+	// Every matrix element in all four lanes
+	struct MatrixLanes
+	{
+		explicit MatrixLanes(const Matrix4& m)
+		{
+			for (size_t i = 0; i < 16; ++i)
+				v[i] = Splat(m.v[i]);
+		}
+		Float4 v[16];
+	};
+
+	void TransformNormal4(const MatrixLanes& m, Float4& x, Float4& y, Float4& z)
+	{
+		const Float4 rx = MulAdd(x, m.v[0], MulAdd(y, m.v[4], Mul(z, m.v[8])));
+		const Float4 ry = MulAdd(x, m.v[1], MulAdd(y, m.v[5], Mul(z, m.v[9])));
+		const Float4 rz = MulAdd(x, m.v[2], MulAdd(y, m.v[6], Mul(z, m.v[10])));
+		x = rx; y = ry; z = rz;
+	}
+
+	void TransformCoord4(const MatrixLanes& m, Float4& x, Float4& y, Float4& z)
+	{
+		const Float4 rx = MulAdd(x, m.v[0], MulAdd(y, m.v[4], MulAdd(z, m.v[8], m.v[12])));
+		const Float4 ry = MulAdd(x, m.v[1], MulAdd(y, m.v[5], MulAdd(z, m.v[9], m.v[13])));
+		const Float4 rz = MulAdd(x, m.v[2], MulAdd(y, m.v[6], MulAdd(z, m.v[10], m.v[14])));
+		const Float4 rw = MulAdd(x, m.v[3], MulAdd(y, m.v[7], MulAdd(z, m.v[11], m.v[15])));
+		const Float4 invW = Div(Splat(1.0f), rw);
+		x = Mul(rx, invW); y = Mul(ry, invW); z = Mul(rz, invW);
+	}
+
+	void Transform4(const MatrixLanes& m, Float4& x, Float4& y, Float4& z, Float4& w)
+	{
+		const Float4 rx = MulAdd(x, m.v[0], MulAdd(y, m.v[4], MulAdd(z, m.v[8], Mul(w, m.v[12]))));
+		const Float4 ry = MulAdd(x, m.v[1], MulAdd(y, m.v[5], MulAdd(z, m.v[9], Mul(w, m.v[13]))));
+		const Float4 rz = MulAdd(x, m.v[2], MulAdd(y, m.v[6], MulAdd(z, m.v[10], Mul(w, m.v[14]))));
+		const Float4 rw = MulAdd(x, m.v[3], MulAdd(y, m.v[7], MulAdd(z, m.v[11], Mul(w, m.v[15]))));
+		x = rx; y = ry; z = rz; w = rw;
+	}
+
+	Float4 Dot4(Float4 ax, Float4 ay, Float4 az, Float4 bx, Float4 by, Float4 bz)
+	{
+		return MulAdd(ax, bx, MulAdd(ay, by, Mul(az, bz)));
+	}
+
+	void Normalize4(Float4& x, Float4& y, Float4& z)
+	{
+		// Zero length vectors pass through unchanged, same as Math::Normalize
+		const Float4 magnitude = SIMD::Sqrt(Dot4(x, y, z, x, y, z));
+		const Float4 valid = Greater(magnitude, Zero());
+		x = Select(valid, Div(x, magnitude), x);
+		y = Select(valid, Div(y, magnitude), y);
+		z = Select(valid, Div(z, magnitude), z);
+	}
+
+	// Runs 'kernel' on four AoS vectors at a time in place, 'scalar' on the tail
+	template <class Kernel, class ScalarKernel>
+	void ForEachVector3(const Vector3* in, Vector3* out, size_t count, Kernel&& kernel, ScalarKernel&& scalar)
+	{
+		ForEachRange(count, [&](size_t begin, size_t end)
+		{
+			size_t i = begin;
+			for (; i + 4 <= end; i += 4)
+			{
+				Float4 x, y, z;
+				LoadVector3x4(&in[i].x, x, y, z);
+				kernel(x, y, z);
+				StoreVector3x4(&out[i].x, x, y, z);
+			}
+			for (; i < end; ++i)
+				out[i] = scalar(in[i]);
+		});
+	}
+
+	template <class Kernel, class ScalarKernel>
+	void ForEachVector3(const Vector3SoA& in, const Vector3SoA& out, size_t count, Kernel&& kernel, ScalarKernel&& scalar)
+	{
+		ForEachRange(count, [&](size_t begin, size_t end)
+		{
+			size_t i = begin;
+			for (; i + 4 <= end; i += 4)
+			{
+				Float4 x = Load(in.x + i);
+				Float4 y = Load(in.y + i);
+				Float4 z = Load(in.z + i);
+				kernel(x, y, z);
+				Store(out.x + i, x);
+				Store(out.y + i, y);
+				Store(out.z + i, z);
+			}
+			for (; i < end; ++i)
+			{
+				const Vector3 v = scalar(Vector3{ in.x[i], in.y[i], in.z[i] });
+				out.x[i] = v.x;
+				out.y[i] = v.y;
+				out.z[i] = v.z;
+			}
+		});
+	}
+
+	template <class Fn>
+	void ForEachIndexed(const Vector3SoA& in, const Vector3SoA& out, size_t count, Fn&& fn)
+	{
+		ForEachRange(count, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Vector3 v = fn(Vector3{ in.x[i], in.y[i], in.z[i] }, i);
+				out.x[i] = v.x;
+				out.y[i] = v.y;
+				out.z[i] = v.z;
+			}
+		});
+	}
+
+	// Four quaternion pairs per loop, transposed so each register holds one component. 't' is
+	// null when every pair uses 'uniformT'.
+	template <bool Spherical>
+	void Interpolate(const Quaternion* a, const Quaternion* b, const float* t, float uniformT, Quaternion* out, size_t count)
+	{
+		ForEachRange(count, [=](size_t begin, size_t end)
+		{
+			const Float4 one = Splat(1.0f);
+			size_t i = begin;
+			for (; i + 4 <= end; i += 4)
+			{
+				Float4 ax = Load(a[i].v.data()), ay = Load(a[i + 1].v.data()), az = Load(a[i + 2].v.data()), aw = Load(a[i + 3].v.data());
+				Float4 bx = Load(b[i].v.data()), by = Load(b[i + 1].v.data()), bz = Load(b[i + 2].v.data()), bw = Load(b[i + 3].v.data());
+				Transpose(ax, ay, az, aw);
+				Transpose(bx, by, bz, bw);
+
+				const Float4 weight = t ? Load(t + i) : Splat(uniformT);
+				const Float4 dot = MulAdd(ax, bx, MulAdd(ay, by, MulAdd(az, bz, Mul(aw, bw))));
+				Float4 wa = Sub(one, weight), wb = weight;
+				if constexpr (Spherical)
+				{
+					const Float4 cosTheta = Min(SIMD::Abs(dot), one);
+					wa = SlerpWeight(wa, cosTheta);
+					wb = SlerpWeight(wb, cosTheta);
+				}
+				wb = Select(Less(dot, Zero()), Sub(Zero(), wb), wb);
+
+				Float4 x = MulAdd(bx, wb, Mul(ax, wa));
+				Float4 y = MulAdd(by, wb, Mul(ay, wa));
+				Float4 z = MulAdd(bz, wb, Mul(az, wa));
+				Float4 w = MulAdd(bw, wb, Mul(aw, wa));
+				if constexpr (!Spherical)
+				{
+					const Float4 invLength = Div(one, SIMD::Sqrt(MulAdd(x, x, MulAdd(y, y, MulAdd(z, z, Mul(w, w))))));
+					x = Mul(x, invLength);
+					y = Mul(y, invLength);
+					z = Mul(z, invLength);
+					w = Mul(w, invLength);
+				}
+
+				Transpose(x, y, z, w);
+				Store(out[i].v.data(), x);
+				Store(out[i + 1].v.data(), y);
+				Store(out[i + 2].v.data(), z);
+				Store(out[i + 3].v.data(), w);
+			}
+			for (; i < end; ++i)
+			{
+				const float weight = t ? t[i] : uniformT;
+				out[i] = Spherical ? Math::FastSlerp(a[i], b[i], weight) : Math::Nlerp(a[i], b[i], weight);
+			}
+		});
+	}
+
+	// Lanes of 8, 16 and 32 bit values, widened to 32 bits
+	template <class T>
+	UInt4 LoadLanes(const T* p)
+	{
+		using Unsigned = std::make_unsigned_t<T>;
+		const uint32_t lanes[4] = { static_cast<Unsigned>(p[0]), static_cast<Unsigned>(p[1]), static_cast<Unsigned>(p[2]), static_cast<Unsigned>(p[3]) };
+		return LoadUInt(lanes);
+	}
+	template <class T>
+	void StoreLanes(T* p, UInt4 v)
+	{
+		uint32_t lanes[4];
+		StoreUInt(lanes, v);
+		for (int i = 0; i < 4; ++i)
+			p[i] = static_cast<T>(lanes[i]);
+	}
+
+	// Calls 'kernel(in, out)' on four elements at a time. The tail is padded with copies of the
+	// last element and goes through the same kernel, so every element gets the same bits as the
+	// single value functions.
+	template <class In, class Out, class Kernel>
+	void ConvertLanes(const In* in, Out* out, size_t count, Kernel kernel)
+	{
+		ForEachRange(count, [=](size_t begin, size_t end)
+		{
+			size_t i = begin;
+			for (; i + 4 <= end; i += 4)
+				kernel(in + i, out + i);
+			if (i < end)
+			{
+				In paddedIn[4];
+				Out paddedOut[4];
+				std::fill(std::copy(in + i, in + end, paddedIn), paddedIn + 4, in[end - 1]);
+				kernel(paddedIn, paddedOut);
+				std::copy(paddedOut, paddedOut + (end - i), out + i);
+			}
+		});
+	}
+
+	template <class Out>
+	void ToNorm(const float* in, Out* out, size_t count)
+	{
+		constexpr float scale = static_cast<float>(std::numeric_limits<Out>::max());
+		ConvertLanes(in, out, count, [](const float* in, Out* out)
+		{
+			if constexpr (std::is_signed_v<Out>)
+				StoreLanes(out, ToSNorm(Load(in), scale));
+			else
+				StoreLanes(out, ToUNorm(Load(in), scale));
+		});
+	}
+
+	template <class In>
+	void FromNorm(const In* in, float* out, size_t count)
+	{
+		constexpr float scale = static_cast<float>(std::numeric_limits<In>::max());
+		ConvertLanes(in, out, count, [](const In* in, float* out)
+		{
+			if constexpr (std::is_signed_v<In>)
+				Store(out, FromSNorm(LoadLanes(in), scale));
+			else
+				Store(out, FromUNorm(LoadLanes(in), scale));
+		});
+	}
+
+	// Culling. A shape is outside a plane when Dot(center, n) - d < -radius, where radius is
+	// the extent of the shape along n.
+	float Separation(const Plane& plane, const Sphere& sphere)
+	{
+		return Math::Dot(sphere.center, plane.n) - plane.d + sphere.radius;
+	}
+	float Separation(const Plane& plane, const AABB& aabb)
+	{
+		const Vector3& e = aabb.extend;
+		return Math::Dot(aabb.center, plane.n) - plane.d + Abs(plane.n.x) * e.x + Abs(plane.n.y) * e.y + Abs(plane.n.z) * e.z;
+	}
+	float Separation(const Plane& plane, const OBB& obb)
+	{
+		const Matrix4 rotation = Matrix4::RotationQuaternion(obb.rot);
+		const float radius =
+			Abs(Math::Dot(plane.n, GetRight(rotation))) * obb.extend.x +
+			Abs(Math::Dot(plane.n, GetUp(rotation))) * obb.extend.y +
+			Abs(Math::Dot(plane.n, GetLook(rotation))) * obb.extend.z;
+		return Math::Dot(obb.center, plane.n) - plane.d + radius;
+	}
+
+	// Every plane value in all four lanes
+	struct PlaneLanes
+	{
+		Float4 nx, ny, nz, d;
+		Float4 absNx, absNy, absNz;
+	};
+
+	// Four shapes, one per lane
+	struct SphereLanes
+	{
+		void Load(const Sphere* spheres)
+		{
+			cx = SIMD::Load(&spheres[0].center.x);
+			cy = SIMD::Load(&spheres[1].center.x);
+			cz = SIMD::Load(&spheres[2].center.x);
+			radius = SIMD::Load(&spheres[3].center.x);
+			Transpose(cx, cy, cz, radius);
+		}
+		Float4 Radius(const PlaneLanes&) const { return radius; }
+
+		Float4 cx, cy, cz, radius;
+	};
+
+	struct AABBLanes
+	{
+		void Load(const AABB* aabbs)
+		{
+			// Four AABBs are eight packed Vector3, centers in the even lanes and extends in the odd
+			Float4 x0, y0, z0, x1, y1, z1;
+			LoadVector3x4(&aabbs[0].center.x, x0, y0, z0);
+			LoadVector3x4(&aabbs[2].center.x, x1, y1, z1);
+			cx = Shuffle<0, 2, 0, 2>(x0, x1);
+			cy = Shuffle<0, 2, 0, 2>(y0, y1);
+			cz = Shuffle<0, 2, 0, 2>(z0, z1);
+			ex = Shuffle<1, 3, 1, 3>(x0, x1);
+			ey = Shuffle<1, 3, 1, 3>(y0, y1);
+			ez = Shuffle<1, 3, 1, 3>(z0, z1);
+		}
+		Float4 Radius(const PlaneLanes& p) const
+		{
+			return MulAdd(p.absNx, ex, MulAdd(p.absNy, ey, Mul(p.absNz, ez)));
+		}
+
+		Float4 cx, cy, cz, ex, ey, ez;
+	};
+
+	struct OBBLanes
+	{
+		void Load(const OBB* obbs)
+		{
+			const auto gather = [obbs](size_t offset)
+			{
+				const auto element = [obbs, offset](size_t i) { return reinterpret_cast<const float*>(&obbs[i])[offset]; };
+				return Set(element(0), element(1), element(2), element(3));
+			};
+			cx = gather(0); cy = gather(1); cz = gather(2);
+			const Float4 ex = gather(3), ey = gather(4), ez = gather(5);
+			const Float4 qx = gather(6), qy = gather(7), qz = gather(8), qw = gather(9);
+
+			// Rows of Matrix4::RotationQuaternion, scaled by the extends
+			const Float4 one = Splat(1.0f), two = Splat(2.0f);
+			const Float4 xx = Mul(two, Mul(qx, qx)), yy = Mul(two, Mul(qy, qy)), zz = Mul(two, Mul(qz, qz));
+			const Float4 xy = Mul(two, Mul(qx, qy)), xz = Mul(two, Mul(qx, qz)), yz = Mul(two, Mul(qy, qz));
+			const Float4 xw = Mul(two, Mul(qx, qw)), yw = Mul(two, Mul(qy, qw)), zw = Mul(two, Mul(qz, qw));
+			axis[0] = Mul(Sub(Sub(one, yy), zz), ex); axis[1] = Mul(Add(xy, zw), ex); axis[2] = Mul(Sub(xz, yw), ex);
+			axis[3] = Mul(Sub(xy, zw), ey); axis[4] = Mul(Sub(Sub(one, xx), zz), ey); axis[5] = Mul(Add(yz, xw), ey);
+			axis[6] = Mul(Add(xz, yw), ez); axis[7] = Mul(Sub(yz, xw), ez); axis[8] = Mul(Sub(Sub(one, xx), yy), ez);
+		}
+		Float4 Radius(const PlaneLanes& p) const
+		{
+			const Float4 rx = SIMD::Abs(Dot4(p.nx, p.ny, p.nz, axis[0], axis[1], axis[2]));
+			const Float4 ry = SIMD::Abs(Dot4(p.nx, p.ny, p.nz, axis[3], axis[4], axis[5]));
+			const Float4 rz = SIMD::Abs(Dot4(p.nx, p.ny, p.nz, axis[6], axis[7], axis[8]));
+			return Add(rx, Add(ry, rz));
+		}
+
+		Float4 cx, cy, cz;
+		Float4 axis[9];
+	};
+
+	// Objects go four to a register and are tested against one plane at a time, stopping once
+	// all four are out. Parallel chunks are whole mask words so no two jobs share one.
+	template <class Lanes, class Shape>
+	void CullShapes(const Frustum& frustum, const Shape* shapes, size_t count, uint32_t* visibleMask, uint8_t* planeCache)
+	{
+		PlaneLanes planes[Frustum::Count];
+		for (size_t p = 0; p < Frustum::Count; ++p)
+		{
+			const Plane& plane = frustum.planes[p];
+			planes[p] = { Splat(plane.n.x), Splat(plane.n.y), Splat(plane.n.z), Splat(plane.d),
+				Splat(Abs(plane.n.x)), Splat(Abs(plane.n.y)), Splat(Abs(plane.n.z)) };
+		}
+
+		// The plane loops start at the cached plane and wrap around, so an object that is still
+		// out is rejected by the first test and a stale entry costs nothing. A group of four
+		// starts at the plane cached for its first object.
+		ForEachRange(count, [&](size_t begin, size_t end)
+		{
+			for (size_t word = begin; word < end; word += 32)
+			{
+				const size_t wordEnd = std::min(word + 32, end);
+				uint32_t visible = 0;
+				size_t i = word;
+				for (; i + 4 <= wordEnd; i += 4)
+				{
+					Lanes lanes;
+					lanes.Load(shapes + i);
+					const size_t first = planeCache ? planeCache[i] : 0;
+					Float4 outside = Zero();
+					Float4 rejectedBy = Splat(static_cast<float>(first));
+					for (size_t k = 0; k < Frustum::Count && MoveMask(outside) != 0xF; ++k)
+					{
+						const size_t p = first + k < Frustum::Count ? first + k : first + k - Frustum::Count;
+						const PlaneLanes& plane = planes[p];
+						const Float4 distance = Sub(Dot4(lanes.cx, lanes.cy, lanes.cz, plane.nx, plane.ny, plane.nz), plane.d);
+						const Float4 rejected = Less(distance, Sub(Zero(), lanes.Radius(plane)));
+						rejectedBy = Select(outside, rejectedBy, Select(rejected, Splat(static_cast<float>(p)), rejectedBy));
+						outside = Or(outside, rejected);
+					}
+					const int outsideBits = MoveMask(outside);
+					if (planeCache && outsideBits != 0)
+					{
+						float planeIndices[4];
+						Store(planeIndices, rejectedBy);
+						for (size_t lane = 0; lane < 4; ++lane)
+							planeCache[i + lane] = static_cast<uint8_t>(planeIndices[lane]);
+					}
+					visible |= static_cast<uint32_t>(~outsideBits & 0xF) << (i - word);
+				}
+				for (; i < wordEnd; ++i)
+				{
+					const size_t first = planeCache ? planeCache[i] : 0;
+					size_t k = 0;
+					while (k < Frustum::Count && Separation(frustum.planes[(first + k) % Frustum::Count], shapes[i]) >= 0.0f)
+						++k;
+					if (k == Frustum::Count)
+						visible |= 1u << (i - word);
+					else if (planeCache)
+						planeCache[i] = static_cast<uint8_t>((first + k) % Frustum::Count);
+				}
+				visibleMask[word / 32] = visible;
+			}
+		}, 32);
+	}
+
+	// Ray casts. RayLanes holds one ray per lane for packets, or the same ray in every lane
+	// when four shapes are tested at once. Kernels read shapes through 'fetch(component)',
+	// which either loads four consecutive shapes or splats one. The loops below take the lanes
+	// and hit type from the kernel, so the 2D kernels further down share them.
+	constexpr float kNoHit = std::numeric_limits<float>::max();
+
+	struct RayLanes
+	{
+		using Hit = RayHit;
+
+		RayLanes(const Ray* rays, size_t count, float maxDistance)
+		{
+			// Short packets repeat the last ray
+			const auto lane = [rays, count](size_t i) -> const Ray& { return rays[std::min(i, count - 1)]; };
+			const auto gather = [&lane](float Vector3::* component, bool direction)
+			{
+				const auto get = [&](size_t i) { return (direction ? lane(i).direction : lane(i).origin).*component; };
+				return Set(get(0), get(1), get(2), get(3));
+			};
+			ox = gather(&Vector3::x, false);
+			oy = gather(&Vector3::y, false);
+			oz = gather(&Vector3::z, false);
+			dx = gather(&Vector3::x, true);
+			dy = gather(&Vector3::y, true);
+			dz = gather(&Vector3::z, true);
+
+			const Float4 one = Splat(1.0f);
+			invDx = Div(one, dx);
+			invDy = Div(one, dy);
+			invDz = Div(one, dz);
+			lengthSqr = Dot4(dx, dy, dz, dx, dy, dz);
+			invLengthSqr = Div(one, lengthSqr);
+			this->maxDistance = Splat(maxDistance);
+		}
+
+		Float4 ox, oy, oz;
+		Float4 dx, dy, dz;
+		Float4 invDx, invDy, invDz;
+		Float4 lengthSqr, invLengthSqr;
+		Float4 maxDistance;
+	};
+
+	void Slab(Float4 origin, Float4 invDirection, Float4 min, Float4 max, Float4& tNear, Float4& tFar)
+	{
+		const Float4 t0 = Mul(Sub(min, origin), invDirection);
+		const Float4 t1 = Mul(Sub(max, origin), invDirection);
+		tNear = Max(tNear, Min(t0, t1));
+		tFar = Min(tFar, Max(t0, t1));
+	}
+
+	// Face normal where a ray enters a box, in the box space
+	Vector3 SlabNormal(const Vector3& origin, const Vector3& direction, const Vector3& min, const Vector3& max)
+	{
+		Vector3 normal = Vector3::Zero;
+		float entry = -kNoHit;
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			if (direction.v[axis] == 0.0f)
+				continue;
+			const float t = ((direction.v[axis] > 0.0f ? min.v[axis] : max.v[axis]) - origin.v[axis]) / direction.v[axis];
+			if (t > entry)
+			{
+				entry = t;
+				normal = Vector3::Zero;
+				normal.v[axis] = direction.v[axis] > 0.0f ? -1.0f : 1.0f;
+			}
+		}
+		return normal;
+	}
+
+	struct SphereKernel
+	{
+		using Shapes = SphereSoA;
+		using Lanes = RayLanes;
+
+		template <class Fetch>
+		static Float4 HitDistance(const RayLanes& r, Fetch&& fetch)
+		{
+			const Float4 px = Sub(r.ox, fetch(SphereSoA::CenterX));
+			const Float4 py = Sub(r.oy, fetch(SphereSoA::CenterY));
+			const Float4 pz = Sub(r.oz, fetch(SphereSoA::CenterZ));
+			const Float4 radius = fetch(SphereSoA::Radius);
+			const Float4 b = Dot4(px, py, pz, r.dx, r.dy, r.dz);
+			const Float4 c = Sub(Dot4(px, py, pz, px, py, pz), Mul(radius, radius));
+			const Float4 discriminant = Sub(Mul(b, b), Mul(r.lengthSqr, c));
+			Float4 t = Mul(Sub(Sub(Zero(), b), SIMD::Sqrt(Max(discriminant, Zero()))), r.invLengthSqr);
+			t = Select(LessEqual(c, Zero()), Zero(), t);
+			const Float4 hit = And(GreaterEqual(discriminant, Zero()), And(GreaterEqual(t, Zero()), LessEqual(t, r.maxDistance)));
+			return Select(hit, t, Splat(kNoHit));
+		}
+
+		static Vector3 Normal(const Ray& ray, const SphereSoA& spheres, uint32_t index, float distance)
+		{
+			if (distance <= 0.0f)
+				return -Math::Normalize(ray.direction);
+			return Math::Normalize(ray.origin + ray.direction * distance - spheres.Get(index).center);
+		}
+	};
+
+	struct AABBKernel
+	{
+		using Shapes = AABBSoA;
+		using Lanes = RayLanes;
+
+		template <class Fetch>
+		static Float4 HitDistance(const RayLanes& r, Fetch&& fetch)
+		{
+			Float4 tNear = Zero(), tFar = r.maxDistance;
+			Slab(r.ox, r.invDx, fetch(AABBSoA::MinX), fetch(AABBSoA::MaxX), tNear, tFar);
+			Slab(r.oy, r.invDy, fetch(AABBSoA::MinY), fetch(AABBSoA::MaxY), tNear, tFar);
+			Slab(r.oz, r.invDz, fetch(AABBSoA::MinZ), fetch(AABBSoA::MaxZ), tNear, tFar);
+			return Select(LessEqual(tNear, tFar), tNear, Splat(kNoHit));
+		}
+
+		static Vector3 Normal(const Ray& ray, const AABBSoA& aabbs, uint32_t index, float distance)
+		{
+			if (distance <= 0.0f)
+				return -Math::Normalize(ray.direction);
+			const AABB aabb = aabbs.Get(index);
+			return SlabNormal(ray.origin, ray.direction, aabb.Min(), aabb.Max());
+		}
+	};
+
+	struct OBBKernel
+	{
+		using Shapes = OBBSoA;
+		using Lanes = RayLanes;
+
+		template <class Fetch>
+		static Float4 HitDistance(const RayLanes& r, Fetch&& fetch)
+		{
+			const Float4 px = Sub(r.ox, fetch(OBBSoA::CenterX));
+			const Float4 py = Sub(r.oy, fetch(OBBSoA::CenterY));
+			const Float4 pz = Sub(r.oz, fetch(OBBSoA::CenterZ));
+			const Float4 one = Splat(1.0f);
+			Float4 tNear = Zero(), tFar = r.maxDistance;
+			const auto slab = [&](size_t axis, size_t extend)
+			{
+				// Ray projected onto the box axis, the box spans [-extend, extend] along it
+				const Float4 ax = fetch(axis), ay = fetch(axis + 1), az = fetch(axis + 2);
+				const Float4 origin = Dot4(px, py, pz, ax, ay, az);
+				const Float4 invDirection = Div(one, Dot4(r.dx, r.dy, r.dz, ax, ay, az));
+				const Float4 e = fetch(extend);
+				Slab(origin, invDirection, Sub(Zero(), e), e, tNear, tFar);
+			};
+			slab(OBBSoA::RightX, OBBSoA::ExtendX);
+			slab(OBBSoA::UpX, OBBSoA::ExtendY);
+			slab(OBBSoA::LookX, OBBSoA::ExtendZ);
+			return Select(LessEqual(tNear, tFar), tNear, Splat(kNoHit));
+		}
+
+		static Vector3 Normal(const Ray& ray, const OBBSoA& obbs, uint32_t index, float distance)
+		{
+			if (distance <= 0.0f)
+				return -Math::Normalize(ray.direction);
+			const auto axis = [&obbs, index](size_t component)
+			{
+				return Vector3{ obbs.Component(component)[index], obbs.Component(component + 1)[index], obbs.Component(component + 2)[index] };
+			};
+			const Vector3 right = axis(OBBSoA::RightX), up = axis(OBBSoA::UpX), look = axis(OBBSoA::LookX);
+			const Vector3 extend = axis(OBBSoA::ExtendX);
+			const Vector3 p = ray.origin - axis(OBBSoA::CenterX);
+			const Vector3 origin{ Math::Dot(p, right), Math::Dot(p, up), Math::Dot(p, look) };
+			const Vector3 direction{ Math::Dot(ray.direction, right), Math::Dot(ray.direction, up), Math::Dot(ray.direction, look) };
+			const Vector3 n = SlabNormal(origin, direction, -extend, extend);
+			return right * n.x + up * n.y + look * n.z;
+		}
+	};
+
+	struct PlaneKernel
+	{
+		using Shapes = PlaneSoA;
+		using Lanes = RayLanes;
+
+		template <class Fetch>
+		static Float4 HitDistance(const RayLanes& r, Fetch&& fetch)
+		{
+			const Float4 nx = fetch(PlaneSoA::NormalX), ny = fetch(PlaneSoA::NormalY), nz = fetch(PlaneSoA::NormalZ);
+			const Float4 denominator = Dot4(r.dx, r.dy, r.dz, nx, ny, nz);
+			const Float4 t = Div(Sub(fetch(PlaneSoA::Distance), Dot4(r.ox, r.oy, r.oz, nx, ny, nz)), denominator);
+			const Float4 hit = And(Greater(SIMD::Abs(denominator), Splat(1e-6f)), And(GreaterEqual(t, Zero()), LessEqual(t, r.maxDistance)));
+			return Select(hit, t, Splat(kNoHit));
+		}
+
+		static Vector3 Normal(const Ray& ray, const PlaneSoA& planes, uint32_t index, float)
+		{
+			const Vector3 n = planes.Get(index).n;
+			return Math::Dot(ray.direction, n) > 0.0f ? -n : n;
+		}
+	};
+
+	template <class Kernel, class RayType>
+	typename Kernel::Lanes::Hit MakeHit(const RayType& ray, const typename Kernel::Shapes& shapes, float distance, float index)
+	{
+		typename Kernel::Lanes::Hit hit;
+		if (distance == kNoHit)
+			return hit;
+		hit.index = static_cast<uint32_t>(index);
+		hit.distance = distance;
+		hit.normal = Kernel::Normal(ray, shapes, hit.index, distance);
+		return hit;
+	}
+
+	// One ray against four shapes per register, two registers per loop to hide the latency.
+	// Indices are tracked as floats, exact up to 2^24 shapes. 'laneArgs' go to the lanes after
+	// the ray, e.g. the sweep radius of 2D rays.
+	template <class Kernel, class RayType, class... LaneArgs>
+	typename Kernel::Lanes::Hit RaycastShapes(const RayType& ray, const typename Kernel::Shapes& shapes, float maxDistance, LaneArgs... laneArgs)
+	{
+		const size_t count = shapes.Size();
+		ASSERT(count <= (1u << 24), "Batch -- Too many shapes for a ray cast.");
+		static_assert(Kernel::Shapes::kPadding == 8, "Batch -- Ray casts read eight shapes per loop.");
+
+		const typename Kernel::Lanes r(&ray, 1, maxDistance, laneArgs...);
+		const Float4 laneIndex = Set(0.0f, 1.0f, 2.0f, 3.0f);
+		Float4 best[2] = { Splat(kNoHit), Splat(kNoHit) };
+		Float4 bestIndex[2] = { Zero(), Zero() };
+		for (size_t i = 0; i < count; i += 8)
+		{
+			for (size_t half = 0; half < 2; ++half)
+			{
+				const size_t first = i + half * 4;
+				Float4 t = Kernel::HitDistance(r, [&shapes, first](size_t component) { return Load(shapes.Component(component) + first); });
+				const Float4 index = Add(Splat(static_cast<float>(first)), laneIndex);
+				if (first + 4 > count)
+					t = Select(Less(index, Splat(static_cast<float>(count))), t, Splat(kNoHit));
+				const Float4 closer = Less(t, best[half]);
+				best[half] = Select(closer, t, best[half]);
+				bestIndex[half] = Select(closer, index, bestIndex[half]);
+			}
+		}
+
+		float distances[8], indices[8];
+		Store(distances, best[0]);
+		Store(distances + 4, best[1]);
+		Store(indices, bestIndex[0]);
+		Store(indices + 4, bestIndex[1]);
+		size_t nearest = 0;
+		for (size_t lane = 1; lane < 8; ++lane)
+		{
+			if (distances[lane] < distances[nearest] || (distances[lane] == distances[nearest] && indices[lane] < indices[nearest]))
+				nearest = lane;
+		}
+		return MakeHit<Kernel>(ray, shapes, distances[nearest], indices[nearest]);
+	}
+
+	// Packets of four rays against one shape at a time
+	template <class Kernel, class RayType, class... LaneArgs>
+	void RaycastPackets(const RayType* rays, size_t rayCount, const typename Kernel::Shapes& shapes, typename Kernel::Lanes::Hit* hits, float maxDistance, LaneArgs... laneArgs)
+	{
+		const size_t count = shapes.Size();
+		ASSERT(count <= (1u << 24), "Batch -- Too many shapes for a ray cast.");
+
+		ForEachRange(rayCount, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i += 4)
+			{
+				const size_t packetSize = std::min<size_t>(4, end - i);
+				const typename Kernel::Lanes r(rays + i, packetSize, maxDistance, laneArgs...);
+				Float4 best = Splat(kNoHit);
+				Float4 bestIndex = Zero();
+				for (size_t j = 0; j < count; ++j)
+				{
+					const Float4 t = Kernel::HitDistance(r, [&shapes, j](size_t component) { return Splat(shapes.Component(component)[j]); });
+					const Float4 closer = Less(t, best);
+					best = Select(closer, t, best);
+					bestIndex = Select(closer, Splat(static_cast<float>(j)), bestIndex);
+				}
+
+				float distances[4], indices[4];
+				Store(distances, best);
+				Store(indices, bestIndex);
+				for (size_t lane = 0; lane < packetSize; ++lane)
+					hits[i + lane] = MakeHit<Kernel>(rays[i + lane], shapes, distances[lane], indices[lane]);
+			}
+		});
+	}
+
+	// One ray against the leaves of a BVH built from 'shapes', a leaf fills one register
+	template <class Kernel>
+	RayHit RaycastTree(const Ray& ray, const BVH& bvh, const typename Kernel::Shapes& shapes, float maxDistance)
+	{
+		static_assert(BVH::kMaxLeafSize == 4, "Batch -- Ray casts read one BVH leaf per register.");
+
+		RayLanes r(&ray, 1, maxDistance);
+		float best = kNoHit;
+		uint32_t bestIndex = RayHit::kNone;
+		bvh.TraverseRay(ray, maxDistance, [&](const uint32_t* primitives, uint32_t count, float& limit)
+		{
+			// Short leaves repeat the last primitive
+			uint32_t indices[4];
+			for (uint32_t lane = 0; lane < 4; ++lane)
+				indices[lane] = primitives[std::min(lane, count - 1)];
+			r.maxDistance = Splat(limit);
+			const Float4 t = Kernel::HitDistance(r, [&shapes, &indices](size_t component)
+			{
+				const float* values = shapes.Component(component);
+				return Set(values[indices[0]], values[indices[1]], values[indices[2]], values[indices[3]]);
+			});
+
+			float distances[4];
+			Store(distances, t);
+			for (uint32_t lane = 0; lane < count; ++lane)
+			{
+				if (distances[lane] < best || (distances[lane] == best && distances[lane] != kNoHit && indices[lane] < bestIndex))
+				{
+					best = distances[lane];
+					bestIndex = indices[lane];
+					limit = best;
+				}
+			}
+		});
+
+		RayHit hit;
+		if (bestIndex == RayHit::kNone)
+			return hit;
+		hit.index = bestIndex;
+		hit.distance = best;
+		hit.normal = Kernel::Normal(ray, shapes, bestIndex, best);
+		return hit;
+	}
+
+	// True when 'overlaps(fetch)' sets the lane of any shape, four shapes per register
+	template <class Shapes, class Overlaps>
+	bool AnyOverlap(const Shapes& shapes, Overlaps&& overlaps)
+	{
+		const size_t count = shapes.Size();
+		for (size_t i = 0; i < count; i += 4)
+		{
+			int mask = MoveMask(overlaps([&shapes, i](size_t component) { return Load(shapes.Component(component) + i); }));
+			if (i + 4 > count)
+				mask &= (1 << (count - i)) - 1;
+			if (mask != 0)
+				return true;
+		}
+		return false;
+	}
+
+	template <class Kernel, class RayType, class... LaneArgs>
+	bool AnyHitShapes(const RayType& ray, const typename Kernel::Shapes& shapes, float maxDistance, LaneArgs... laneArgs)
+	{
+		const typename Kernel::Lanes r(&ray, 1, maxDistance, laneArgs...);
+		return AnyOverlap(shapes, [&r](auto&& fetch) { return Less(Kernel::HitDistance(r, fetch), Splat(kNoHit)); });
+	}
+
+	// Packets of four rays against one shape at a time until all four have hit. Parallel
+	// chunks are whole mask words so no two jobs share one.
+	template <class Kernel, class RayType, class... LaneArgs>
+	void AnyHitPackets(const RayType* rays, size_t rayCount, const typename Kernel::Shapes& shapes, uint32_t* hitMask, float maxDistance, LaneArgs... laneArgs)
+	{
+		const size_t count = shapes.Size();
+		ForEachRange(rayCount, [&](size_t begin, size_t end)
+		{
+			for (size_t word = begin; word < end; word += 32)
+			{
+				const size_t wordEnd = std::min(word + 32, end);
+				uint32_t hitBits = 0;
+				for (size_t i = word; i < wordEnd; i += 4)
+				{
+					const size_t packetSize = std::min<size_t>(4, wordEnd - i);
+					const int packetMask = (1 << packetSize) - 1;
+					const typename Kernel::Lanes r(rays + i, packetSize, maxDistance, laneArgs...);
+					int hit = 0;
+					for (size_t j = 0; j < count && (hit & packetMask) != packetMask; ++j)
+						hit |= MoveMask(Less(Kernel::HitDistance(r, [&shapes, j](size_t component) { return Splat(shapes.Component(component)[j]); }), Splat(kNoHit)));
+					hitBits |= static_cast<uint32_t>(hit & packetMask) << (i - word);
+				}
+				hitMask[word / 32] = hitBits;
+			}
+		}, 32);
+	}
+
+	// 2D rays, 'radius' is added to circle radii to sweep a circle along the ray
+	struct Ray2DLanes
+	{
+		using Hit = RayHit2D;
+
+		Ray2DLanes(const Ray2D* rays, size_t count, float maxDistance, float radius = 0.0f)
+		{
+			// Short packets repeat the last ray
+			const auto lane = [rays, count](size_t i) -> const Ray2D& { return rays[std::min(i, count - 1)]; };
+			ox = Set(lane(0).origin.x, lane(1).origin.x, lane(2).origin.x, lane(3).origin.x);
+			oy = Set(lane(0).origin.y, lane(1).origin.y, lane(2).origin.y, lane(3).origin.y);
+			dx = Set(lane(0).direction.x, lane(1).direction.x, lane(2).direction.x, lane(3).direction.x);
+			dy = Set(lane(0).direction.y, lane(1).direction.y, lane(2).direction.y, lane(3).direction.y);
+			lengthSqr = Add(Mul(dx, dx), Mul(dy, dy));
+			invLengthSqr = Div(Splat(1.0f), lengthSqr);
+			this->maxDistance = Splat(maxDistance);
+			this->radius = Splat(radius);
+		}
+
+		Float4 ox, oy;
+		Float4 dx, dy;
+		Float4 lengthSqr, invLengthSqr;
+		Float4 maxDistance;
+		Float4 radius;
+	};
+
+	Float4 Cross2(Float4 ax, Float4 ay, Float4 bx, Float4 by)
+	{
+		return Sub(Mul(ax, by), Mul(ay, bx));
+	}
+
+	struct LineSegmentKernel
+	{
+		using Shapes = LineSegmentSoA;
+		using Lanes = Ray2DLanes;
+
+		// Solves origin + direction * t = from + (to - from) * u
+		template <class Fetch>
+		static Float4 HitDistance(const Ray2DLanes& r, Fetch&& fetch)
+		{
+			const Float4 fromX = fetch(LineSegmentSoA::FromX), fromY = fetch(LineSegmentSoA::FromY);
+			const Float4 ex = Sub(fetch(LineSegmentSoA::ToX), fromX), ey = Sub(fetch(LineSegmentSoA::ToY), fromY);
+			const Float4 wx = Sub(fromX, r.ox), wy = Sub(fromY, r.oy);
+			const Float4 denominator = Cross2(r.dx, r.dy, ex, ey);
+			const Float4 offset = Cross2(wx, wy, r.dx, r.dy);
+			const Float4 invDenominator = Div(Splat(1.0f), denominator);
+			const Float4 t = Mul(Cross2(wx, wy, ex, ey), invDenominator);
+			const Float4 u = Mul(offset, invDenominator);
+			const Float4 parallel = LessEqual(SIMD::Abs(denominator), Zero());
+			const Float4 hit = And(And(GreaterEqual(t, Zero()), LessEqual(t, r.maxDistance)), And(GreaterEqual(u, Zero()), LessEqual(u, Splat(1.0f))));
+			const Float4 crossing = Select(parallel, Zero(), hit);
+			if (MoveMask(parallel) == 0)
+				return Select(crossing, t, Splat(kNoHit));
+
+			// Parallel segments with no offset lie along the ray, it enters at the nearer end.
+			// Rare outside axis aligned walls, so only computed when a lane needs it.
+			const Float4 t0 = Mul(Add(Mul(wx, r.dx), Mul(wy, r.dy)), r.invLengthSqr);
+			const Float4 t1 = Add(t0, Mul(Add(Mul(ex, r.dx), Mul(ey, r.dy)), r.invLengthSqr));
+			const Float4 entry = Max(Min(t0, t1), Zero());
+			const Float4 along = And(And(parallel, LessEqual(SIMD::Abs(offset), Zero())), And(GreaterEqual(Max(t0, t1), Zero()), LessEqual(entry, r.maxDistance)));
+			return Select(crossing, t, Select(along, entry, Splat(kNoHit)));
+		}
+
+		static Vector2 Normal(const Ray2D& ray, const LineSegmentSoA& segments, uint32_t index, float)
+		{
+			const LineSegment segment = segments.Get(index);
+			const Vector2 edge = segment.to - segment.from;
+			if (ray.direction.x * edge.y - ray.direction.y * edge.x == 0.0f)
+				return -Math::Normalize(ray.direction);
+			const Vector2 n = Math::Normalize(PerpendicularLH(edge));
+			return Math::Dot(ray.direction, n) > 0.0f ? -n : n;
+		}
+	};
+
+	struct CircleKernel
+	{
+		using Shapes = CircleSoA;
+		using Lanes = Ray2DLanes;
+
+		template <class Fetch>
+		static Float4 HitDistance(const Ray2DLanes& r, Fetch&& fetch)
+		{
+			const Float4 px = Sub(r.ox, fetch(CircleSoA::CenterX));
+			const Float4 py = Sub(r.oy, fetch(CircleSoA::CenterY));
+			const Float4 radius = Add(fetch(CircleSoA::Radius), r.radius);
+			const Float4 b = Add(Mul(px, r.dx), Mul(py, r.dy));
+			const Float4 c = Sub(Add(Mul(px, px), Mul(py, py)), Mul(radius, radius));
+			const Float4 discriminant = Sub(Mul(b, b), Mul(r.lengthSqr, c));
+			Float4 t = Mul(Sub(Sub(Zero(), b), SIMD::Sqrt(Max(discriminant, Zero()))), r.invLengthSqr);
+			t = Select(LessEqual(c, Zero()), Zero(), t);
+			const Float4 hit = And(GreaterEqual(discriminant, Zero()), And(GreaterEqual(t, Zero()), LessEqual(t, r.maxDistance)));
+			return Select(hit, t, Splat(kNoHit));
+		}
+
+		static Vector2 Normal(const Ray2D& ray, const CircleSoA& circles, uint32_t index, float distance)
+		{
+			if (distance <= 0.0f)
+				return -Math::Normalize(ray.direction);
+			return Math::Normalize(ray.origin + ray.direction * distance - circles.Get(index).center);
+		}
+	};
+
+	// Circle against four circles, same test as Intersect(Circle, Circle)
+	template <class Fetch>
+	Float4 CircleOverlap(const Circle& circle, Fetch&& fetch)
+	{
+		const Float4 px = Sub(Splat(circle.center.x), fetch(CircleSoA::CenterX));
+		const Float4 py = Sub(Splat(circle.center.y), fetch(CircleSoA::CenterY));
+		const Float4 radius = Add(Splat(circle.radius), fetch(CircleSoA::Radius));
+		return Less(Add(Mul(px, px), Mul(py, py)), Mul(radius, radius));
+	}
+
+	// Circle against the closest points of four segments
+	template <class Fetch>
+	Float4 LineSegmentOverlap(const Circle& circle, Fetch&& fetch)
+	{
+		const Float4 fromX = fetch(LineSegmentSoA::FromX), fromY = fetch(LineSegmentSoA::FromY);
+		const Float4 ex = Sub(fetch(LineSegmentSoA::ToX), fromX), ey = Sub(fetch(LineSegmentSoA::ToY), fromY);
+		const Float4 px = Sub(Splat(circle.center.x), fromX), py = Sub(Splat(circle.center.y), fromY);
+		const Float4 lengthSqr = Max(Add(Mul(ex, ex), Mul(ey, ey)), Splat(std::numeric_limits<float>::min()));
+		const Float4 t = Min(Max(Div(Add(Mul(px, ex), Mul(py, ey)), lengthSqr), Zero()), Splat(1.0f));
+		const Float4 qx = Sub(px, Mul(ex, t)), qy = Sub(py, Mul(ey, t));
+		return Less(Add(Mul(qx, qx), Mul(qy, qy)), Splat(circle.radius * circle.radius));
+	}
+}
+
+// AoS
+void Batch::TransformCoord(const Vector3* in, Vector3* out, size_t count, const Matrix4& m)
+{
+	// A single point already fills a register with x, y, z and w, transposing four of them
+	// to SoA costs more shuffles than it saves
+	ForEachRange(count, [=, &m](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			out[i] = Math::TransformCoord(in[i], m);
+	});
+}
+
+void Batch::TransformCoord(const Vector3* in, Vector3* out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices)
+{
+	ForEachRange(count, [=](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			out[i] = Math::TransformCoord(in[i], matrices[matrixIndices[i]]);
+	});
+}
+
+void Batch::TransformNormal(const Vector3* in, Vector3* out, size_t count, const Matrix4& m)
+{
+	ForEachRange(count, [=, &m](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			out[i] = Math::TransformNormal(in[i], m);
+	});
+}
+
+void Batch::TransformNormal(const Vector3* in, Vector3* out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices)
+{
+	ForEachRange(count, [=](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			out[i] = Math::TransformNormal(in[i], matrices[matrixIndices[i]]);
+	});
+}
+
+void Batch::Transform(const Vector4* in, Vector4* out, size_t count, const Matrix4& m)
+{
+	// One Vector4 already fills a register, no need to transpose
+	ForEachRange(count, [=, &m](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			Store(out[i].v.data(), SIMD::Transform(Load(in[i].v.data()), m.v.data()));
+	});
+}
+
+void Batch::Transform(const Vector4* in, Vector4* out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices)
+{
+	ForEachRange(count, [=](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			Store(out[i].v.data(), SIMD::Transform(Load(in[i].v.data()), matrices[matrixIndices[i]].v.data()));
+	});
+}
+
+void Batch::Dot(const Vector3* a, const Vector3* b, float* out, size_t count)
+{
+	ForEachRange(count, [=](size_t begin, size_t end)
+	{
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			Float4 ax, ay, az, bx, by, bz;
+			LoadVector3x4(&a[i].x, ax, ay, az);
+			LoadVector3x4(&b[i].x, bx, by, bz);
+			Store(out + i, Dot4(ax, ay, az, bx, by, bz));
+		}
+		for (; i < end; ++i)
+			out[i] = Math::Dot(a[i], b[i]);
+	});
+}
+
+void Batch::Cross(const Vector3* a, const Vector3* b, Vector3* out, size_t count)
+{
+	ForEachRange(count, [=](size_t begin, size_t end)
+	{
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			Float4 ax, ay, az, bx, by, bz;
+			LoadVector3x4(&a[i].x, ax, ay, az);
+			LoadVector3x4(&b[i].x, bx, by, bz);
+			const Float4 x = Sub(Mul(ay, bz), Mul(az, by));
+			const Float4 y = Sub(Mul(az, bx), Mul(ax, bz));
+			const Float4 z = Sub(Mul(ax, by), Mul(ay, bx));
+			StoreVector3x4(&out[i].x, x, y, z);
+		}
+		for (; i < end; ++i)
+			out[i] = Math::Cross(a[i], b[i]);
+	});
+}
+
+void Batch::Magnitude(const Vector3* in, float* out, size_t count)
+{
+	ForEachRange(count, [=](size_t begin, size_t end)
+	{
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			Float4 x, y, z;
+			LoadVector3x4(&in[i].x, x, y, z);
+			Store(out + i, SIMD::Sqrt(Dot4(x, y, z, x, y, z)));
+		}
+		for (; i < end; ++i)
+			out[i] = Math::Magnitude(in[i]);
+	});
+}
+
+void Batch::Normalize(const Vector3* in, Vector3* out, size_t count)
+{
+	ForEachVector3(in, out, count,
+		[](Float4& x, Float4& y, Float4& z) { Normalize4(x, y, z); },
+		[](const Vector3& v) { return Math::Normalize(v); });
+}
+
+// SoA
+void Batch::TransformCoord(const Vector3SoA& in, const Vector3SoA& out, size_t count, const Matrix4& m)
+{
+	const MatrixLanes lanes(m);
+	ForEachVector3(in, out, count,
+		[&lanes](Float4& x, Float4& y, Float4& z) { TransformCoord4(lanes, x, y, z); },
+		[&m](const Vector3& v) { return Math::TransformCoord(v, m); });
+}
+
+void Batch::TransformCoord(const Vector3SoA& in, const Vector3SoA& out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices)
+{
+	ForEachIndexed(in, out, count, [=](const Vector3& v, size_t i) { return Math::TransformCoord(v, matrices[matrixIndices[i]]); });
+}
+
+void Batch::TransformNormal(const Vector3SoA& in, const Vector3SoA& out, size_t count, const Matrix4& m)
+{
+	const MatrixLanes lanes(m);
+	ForEachVector3(in, out, count,
+		[&lanes](Float4& x, Float4& y, Float4& z) { TransformNormal4(lanes, x, y, z); },
+		[&m](const Vector3& v) { return Math::TransformNormal(v, m); });
+}
+
+void Batch::TransformNormal(const Vector3SoA& in, const Vector3SoA& out, size_t count, const Matrix4* matrices, const uint32_t* matrixIndices)
+{
+	ForEachIndexed(in, out, count, [=](const Vector3& v, size_t i) { return Math::TransformNormal(v, matrices[matrixIndices[i]]); });
+}
+
+void Batch::Transform(const Vector4SoA& in, const Vector4SoA& out, size_t count, const Matrix4& m)
+{
+	const MatrixLanes lanes(m);
+	ForEachRange(count, [&](size_t begin, size_t end)
+	{
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			Float4 x = Load(in.x + i);
+			Float4 y = Load(in.y + i);
+			Float4 z = Load(in.z + i);
+			Float4 w = Load(in.w + i);
+			Transform4(lanes, x, y, z, w);
+			Store(out.x + i, x);
+			Store(out.y + i, y);
+			Store(out.z + i, z);
+			Store(out.w + i, w);
+		}
+		for (; i < end; ++i)
+		{
+			const Vector4 v = Math::Transform(Vector4{ in.x[i], in.y[i], in.z[i], in.w[i] }, m);
+			out.x[i] = v.x;
+			out.y[i] = v.y;
+			out.z[i] = v.z;
+			out.w[i] = v.w;
+		}
+	});
+}
+
+void Batch::Dot(const Vector3SoA& a, const Vector3SoA& b, float* out, size_t count)
+{
+	ForEachRange(count, [&](size_t begin, size_t end)
+	{
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+			Store(out + i, Dot4(Load(a.x + i), Load(a.y + i), Load(a.z + i), Load(b.x + i), Load(b.y + i), Load(b.z + i)));
+		for (; i < end; ++i)
+			out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+	});
+}
+
+void Batch::Cross(const Vector3SoA& a, const Vector3SoA& b, const Vector3SoA& out, size_t count)
+{
+	ForEachRange(count, [&](size_t begin, size_t end)
+	{
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			const Float4 ax = Load(a.x + i), ay = Load(a.y + i), az = Load(a.z + i);
+			const Float4 bx = Load(b.x + i), by = Load(b.y + i), bz = Load(b.z + i);
+			Store(out.x + i, Sub(Mul(ay, bz), Mul(az, by)));
+			Store(out.y + i, Sub(Mul(az, bx), Mul(ax, bz)));
+			Store(out.z + i, Sub(Mul(ax, by), Mul(ay, bx)));
+		}
+		for (; i < end; ++i)
+		{
+			const Vector3 v = Math::Cross({ a.x[i], a.y[i], a.z[i] }, { b.x[i], b.y[i], b.z[i] });
+			out.x[i] = v.x;
+			out.y[i] = v.y;
+			out.z[i] = v.z;
+		}
+	});
+}
+
+void Batch::Magnitude(const Vector3SoA& in, float* out, size_t count)
+{
+	ForEachRange(count, [&](size_t begin, size_t end)
+	{
+		size_t i = begin;
+		for (; i + 4 <= end; i += 4)
+		{
+			const Float4 x = Load(in.x + i), y = Load(in.y + i), z = Load(in.z + i);
+			Store(out + i, SIMD::Sqrt(Dot4(x, y, z, x, y, z)));
+		}
+		for (; i < end; ++i)
+			out[i] = Math::Magnitude(Vector3{ in.x[i], in.y[i], in.z[i] });
+	});
+}
+
+void Batch::Normalize(const Vector3SoA& in, const Vector3SoA& out, size_t count)
+{
+	ForEachVector3(in, out, count,
+		[](Float4& x, Float4& y, Float4& z) { Normalize4(x, y, z); },
+		[](const Vector3& v) { return Math::Normalize(v); });
+}
+
+// Interpolation
+void Batch::Slerp(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t count)
+{
+	Interpolate<true>(a, b, t, 0.0f, out, count);
+}
+
+void Batch::Slerp(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count)
+{
+	Interpolate<true>(a, b, nullptr, t, out, count);
+}
+
+void Batch::Nlerp(const Quaternion* a, const Quaternion* b, const float* t, Quaternion* out, size_t count)
+{
+	Interpolate<false>(a, b, t, 0.0f, out, count);
+}
+
+void Batch::Nlerp(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count)
+{
+	Interpolate<false>(a, b, nullptr, t, out, count);
+}
+
+// Quantization
+void Batch::FloatToHalf(const float* in, uint16_t* out, size_t count)
+{
+	ConvertLanes(in, out, count, [](const float* in, uint16_t* out) { StoreLanes(out, SIMD::FloatToHalf(Load(in))); });
+}
+
+void Batch::HalfToFloat(const uint16_t* in, float* out, size_t count)
+{
+	ConvertLanes(in, out, count, [](const uint16_t* in, float* out) { Store(out, SIMD::HalfToFloat(LoadLanes(in))); });
+}
+
+void Batch::EncodeOctahedral(const Vector3* in, uint32_t* out, size_t count)
+{
+	ConvertLanes(in, out, count, [](const Vector3* in, uint32_t* out)
+	{
+		Float4 x, y, z;
+		LoadVector3x4(&in[0].x, x, y, z);
+		StoreUInt(out, SIMD::EncodeOctahedral(x, y, z));
+	});
+}
+
+void Batch::DecodeOctahedral(const uint32_t* in, Vector3* out, size_t count)
+{
+	ConvertLanes(in, out, count, [](const uint32_t* in, Vector3* out)
+	{
+		Float4 x, y, z;
+		SIMD::DecodeOctahedral(LoadUInt(in), x, y, z);
+		StoreVector3x4(&out[0].x, x, y, z);
+	});
+}
+
+void Batch::EncodeQuaternion(const Quaternion* in, uint32_t* out, size_t count)
+{
+	ConvertLanes(in, out, count, [](const Quaternion* in, uint32_t* out)
+	{
+		Float4 x = Load(in[0].v.data()), y = Load(in[1].v.data()), z = Load(in[2].v.data()), w = Load(in[3].v.data());
+		SIMD::Transpose(x, y, z, w);
+		StoreUInt(out, SIMD::EncodeQuaternion(x, y, z, w));
+	});
+}
+
+void Batch::DecodeQuaternion(const uint32_t* in, Quaternion* out, size_t count)
+{
+	ConvertLanes(in, out, count, [](const uint32_t* in, Quaternion* out)
+	{
+		Float4 x, y, z, w;
+		SIMD::DecodeQuaternion(LoadUInt(in), x, y, z, w);
+		SIMD::Transpose(x, y, z, w);
+		Store(out[0].v.data(), x);
+		Store(out[1].v.data(), y);
+		Store(out[2].v.data(), z);
+		Store(out[3].v.data(), w);
+	});
+}
+
+void Batch::ToUNorm8(const float* in, uint8_t* out, size_t count)
+{
+	ToNorm(in, out, count);
+}
+
+void Batch::ToSNorm8(const float* in, int8_t* out, size_t count)
+{
+	ToNorm(in, out, count);
+}
+
+void Batch::ToUNorm16(const float* in, uint16_t* out, size_t count)
+{
+	ToNorm(in, out, count);
+}
+
+void Batch::ToSNorm16(const float* in, int16_t* out, size_t count)
+{
+	ToNorm(in, out, count);
+}
+
+void Batch::FromUNorm8(const uint8_t* in, float* out, size_t count)
+{
+	FromNorm(in, out, count);
+}
+
+void Batch::FromSNorm8(const int8_t* in, float* out, size_t count)
+{
+	FromNorm(in, out, count);
+}
+
+void Batch::FromUNorm16(const uint16_t* in, float* out, size_t count)
+{
+	FromNorm(in, out, count);
+}
+
+void Batch::FromSNorm16(const int16_t* in, float* out, size_t count)
+{
+	FromNorm(in, out, count);
+}
+
+// Culling
+void Batch::Cull(const Frustum& frustum, const Sphere* spheres, size_t count, uint32_t* visibleMask, uint8_t* planeCache)
+{
+	CullShapes<SphereLanes>(frustum, spheres, count, visibleMask, planeCache);
+}
+
+void Batch::Cull(const Frustum& frustum, const AABB* aabbs, size_t count, uint32_t* visibleMask, uint8_t* planeCache)
+{
+	CullShapes<AABBLanes>(frustum, aabbs, count, visibleMask, planeCache);
+}
+
+void Batch::Cull(const Frustum& frustum, const OBB* obbs, size_t count, uint32_t* visibleMask, uint8_t* planeCache)
+{
+	CullShapes<OBBLanes>(frustum, obbs, count, visibleMask, planeCache);
+}
+
+// Random
+void Batch::RandomUniform(uint64_t seed, float* out, size_t count, float min, float max)
+{
+	ForEachRange(count, [=](size_t begin, size_t end)
+	{
+		for (size_t block = begin; block < end; block += kRandomBlockSize)
+		{
+			RandomStream stream(seed, block / kRandomBlockSize);
+			stream.FillUniform(out + block, std::min(kRandomBlockSize, end - block), min, max);
+		}
+	}, kRandomBlockSize);
+}
+
+void Batch::RandomNormal(uint64_t seed, float* out, size_t count, float mean, float standardDeviation)
+{
+	ForEachRange(count, [=](size_t begin, size_t end)
+	{
+		for (size_t block = begin; block < end; block += kRandomBlockSize)
+		{
+			RandomStream stream(seed, block / kRandomBlockSize);
+			stream.FillNormal(out + block, std::min(kRandomBlockSize, end - block), mean, standardDeviation);
+		}
+	}, kRandomBlockSize);
+}
+
+// Ray casts
+RayHit Batch::Raycast(const Ray& ray, const SphereSoA& spheres, float maxDistance)
+{
+	return RaycastShapes<SphereKernel>(ray, spheres, maxDistance);
+}
+
+RayHit Batch::Raycast(const Ray& ray, const AABBSoA& aabbs, float maxDistance)
+{
+	return RaycastShapes<AABBKernel>(ray, aabbs, maxDistance);
+}
+
+RayHit Batch::Raycast(const Ray& ray, const OBBSoA& obbs, float maxDistance)
+{
+	return RaycastShapes<OBBKernel>(ray, obbs, maxDistance);
+}
+
+RayHit Batch::Raycast(const Ray& ray, const PlaneSoA& planes, float maxDistance)
+{
+	return RaycastShapes<PlaneKernel>(ray, planes, maxDistance);
+}
+
+void Batch::Raycast(const Ray* rays, size_t rayCount, const SphereSoA& spheres, RayHit* hits, float maxDistance)
+{
+	RaycastPackets<SphereKernel>(rays, rayCount, spheres, hits, maxDistance);
+}
+
+void Batch::Raycast(const Ray* rays, size_t rayCount, const AABBSoA& aabbs, RayHit* hits, float maxDistance)
+{
+	RaycastPackets<AABBKernel>(rays, rayCount, aabbs, hits, maxDistance);
+}
+
+void Batch::Raycast(const Ray* rays, size_t rayCount, const OBBSoA& obbs, RayHit* hits, float maxDistance)
+{
+	RaycastPackets<OBBKernel>(rays, rayCount, obbs, hits, maxDistance);
+}
+
+void Batch::Raycast(const Ray* rays, size_t rayCount, const PlaneSoA& planes, RayHit* hits, float maxDistance)
+{
+	RaycastPackets<PlaneKernel>(rays, rayCount, planes, hits, maxDistance);
+}
+
+RayHit Batch::Raycast(const Ray& ray, const BVH& bvh, const SphereSoA& spheres, float maxDistance)
+{
+	return RaycastTree<SphereKernel>(ray, bvh, spheres, maxDistance);
+}
+
+RayHit Batch::Raycast(const Ray& ray, const BVH& bvh, const AABBSoA& aabbs, float maxDistance)
+{
+	return RaycastTree<AABBKernel>(ray, bvh, aabbs, maxDistance);
+}
+
+RayHit Batch::Raycast(const Ray& ray, const BVH& bvh, const OBBSoA& obbs, float maxDistance)
+{
+	return RaycastTree<OBBKernel>(ray, bvh, obbs, maxDistance);
+}
+
+// 2D ray casts
+RayHit2D Batch::Raycast(const Ray2D& ray, const LineSegmentSoA& segments, float maxDistance)
+{
+	return RaycastShapes<LineSegmentKernel>(ray, segments, maxDistance);
+}
+
+RayHit2D Batch::Raycast(const Ray2D& ray, const CircleSoA& circles, float maxDistance, float radius)
+{
+	return RaycastShapes<CircleKernel>(ray, circles, maxDistance, radius);
+}
+
+RayHit2D Batch::Raycast(const LineSegment& segment, const LineSegmentSoA& segments)
+{
+	return Raycast(Ray2D{ segment.from, segment.to - segment.from }, segments, 1.0f);
+}
+
+RayHit2D Batch::Raycast(const LineSegment& segment, const CircleSoA& circles, float radius)
+{
+	return Raycast(Ray2D{ segment.from, segment.to - segment.from }, circles, 1.0f, radius);
+}
+
+void Batch::Raycast(const Ray2D* rays, size_t rayCount, const LineSegmentSoA& segments, RayHit2D* hits, float maxDistance)
+{
+	RaycastPackets<LineSegmentKernel>(rays, rayCount, segments, hits, maxDistance);
+}
+
+void Batch::Raycast(const Ray2D* rays, size_t rayCount, const CircleSoA& circles, RayHit2D* hits, float maxDistance, float radius)
+{
+	RaycastPackets<CircleKernel>(rays, rayCount, circles, hits, maxDistance, radius);
+}
+
+bool Batch::AnyHit(const Ray2D& ray, const LineSegmentSoA& segments, float maxDistance)
+{
+	return AnyHitShapes<LineSegmentKernel>(ray, segments, maxDistance);
+}
+
+bool Batch::AnyHit(const Ray2D& ray, const CircleSoA& circles, float maxDistance, float radius)
+{
+	return AnyHitShapes<CircleKernel>(ray, circles, maxDistance, radius);
+}
+
+bool Batch::AnyHit(const LineSegment& segment, const LineSegmentSoA& segments)
+{
+	return AnyHit(Ray2D{ segment.from, segment.to - segment.from }, segments, 1.0f);
+}
+
+bool Batch::AnyHit(const LineSegment& segment, const CircleSoA& circles, float radius)
+{
+	return AnyHit(Ray2D{ segment.from, segment.to - segment.from }, circles, 1.0f, radius);
+}
+
+void Batch::AnyHit(const Ray2D* rays, size_t rayCount, const LineSegmentSoA& segments, uint32_t* hitMask, float maxDistance)
+{
+	AnyHitPackets<LineSegmentKernel>(rays, rayCount, segments, hitMask, maxDistance);
+}
+
+void Batch::AnyHit(const Ray2D* rays, size_t rayCount, const CircleSoA& circles, uint32_t* hitMask, float maxDistance, float radius)
+{
+	AnyHitPackets<CircleKernel>(rays, rayCount, circles, hitMask, maxDistance, radius);
+}
+
+bool Batch::Intersect(const Circle& circle, const CircleSoA& circles)
+{
+	return AnyOverlap(circles, [&circle](auto&& fetch) { return CircleOverlap(circle, fetch); });
+}
+
+bool Batch::Intersect(const Circle& circle, const LineSegmentSoA& segments)
+{
+	return AnyOverlap(segments, [&circle](auto&& fetch) { return LineSegmentOverlap(circle, fetch); });
+}
@@ -3,12 +3,6 @@
 
 using namespace Angazi::Math;
 
-namespace
-{
-	std::random_device myRandomDevice{};
-	std::mt19937 myRandomEngine{ myRandomDevice() };
-}
-
 // Vector2 Definition
 const Vector2 Vector2::Zero{ 0.0f };
 const Vector2 Vector2::One{ 1.0f };
@@ -51,29 +45,83 @@ const Matrix3 Matrix3::Identity
 
 float Angazi::Math::RandomFloat()
 {
-	return std::uniform_real_distribution<float>{ 0, 1.0f }(myRandomEngine);
+	return ThreadRandomStream().NextFloat();
 }
 float Angazi::Math::RandomFloat(float min, float max)
 {
-	return std::uniform_real_distribution<float>{ min, max }(myRandomEngine);
+	return ThreadRandomStream().NextFloat(min, max);
 }
 int Angazi::Math::RandomInt()
 {
-	return std::uniform_int_distribution<>{ 0, 1 }(myRandomEngine);
+	return ThreadRandomStream().NextInt(0, 1);
 }
 int Angazi::Math::RandomInt(int min, int max)
 {
-	return std::uniform_int_distribution<>{ min, max }(myRandomEngine);
+	return ThreadRandomStream().NextInt(min, max);
 }
 double Angazi::Math::RandomDouble()
 {
-	return std::uniform_real_distribution<>{ 0, 1 }(myRandomEngine);
+	return ThreadRandomStream().NextDouble();
 }
 double Angazi::Math::RandomDouble(double min, double max)
 {
-	return std::uniform_real_distribution<>{ min, max }(myRandomEngine);
+	return ThreadRandomStream().NextDouble(min, max);
+}
+
+AABB Angazi::Math::GetBounds(const Sphere& sphere)
+{
+	return { sphere.center, { sphere.radius, sphere.radius, sphere.radius } };
+}
+
+AABB Angazi::Math::GetBounds(const OBB& obb)
+{
+	const Matrix4 matRot = Matrix4::RotationQuaternion(obb.rot);
+	const auto absolute = [](const Vector3& v) { return Vector3{ Abs(v.x), Abs(v.y), Abs(v.z) }; };
+	const Vector3 extend =
+		absolute(GetRight(matRot)) * obb.extend.x +
+		absolute(GetUp(matRot)) * obb.extend.y +
+		absolute(GetLook(matRot)) * obb.extend.z;
+	return { obb.center, extend };
 }
 
+bool Angazi::Math::Intersect(const Frustum& frustum, const Sphere& sphere)
+{
+	for (auto& plane : frustum.planes)
+	{
+		if (Dot(sphere.center, plane.n) - plane.d < -sphere.radius)
+			return false;
+	}
+	return true;
+}
+
+bool Angazi::Math::Intersect(const Frustum& frustum, const AABB& aabb)
+{
+	for (auto& plane : frustum.planes)
+	{
+		const float radius = Abs(plane.n.x) * aabb.extend.x + Abs(plane.n.y) * aabb.extend.y + Abs(plane.n.z) * aabb.extend.z;
+		if (Dot(aabb.center, plane.n) - plane.d < -radius)
+			return false;
+	}
+	return true;
+}
+
+bool Angazi::Math::Intersect(const Frustum& frustum, const OBB& obb)
+{
+	const Matrix4 matRot = Matrix4::RotationQuaternion(obb.rot);
+	const Vector3 axisX = GetRight(matRot);
+	const Vector3 axisY = GetUp(matRot);
+	const Vector3 axisZ = GetLook(matRot);
+	for (auto& plane : frustum.planes)
+	{
+		const float radius =
+			Abs(Dot(plane.n, axisX)) * obb.extend.x +
+			Abs(Dot(plane.n, axisY)) * obb.extend.y +
+			Abs(Dot(plane.n, axisZ)) * obb.extend.z;
+		if (Dot(obb.center, plane.n) - plane.d < -radius)
+			return false;
+	}
+	return true;
+}
 
 bool Angazi::Math::GetContactPoint(const Ray& ray, const OBB& obb, Vector3& point, Vector3& normal)
 {
@@ -153,6 +201,100 @@ bool Angazi::Math::Intersect(const Ray& ray, const Plane& plane, float& distance
 	return true;
 }
 
+bool Angazi::Math::GetTimeOfImpact(const Sphere& sphere, const Vector3& displacement, const Plane& plane, float& toi)
+{
+	// Planes are one sided, only spheres approaching from the front can hit
+	const float startDistance = Dot(sphere.center, plane.n) - plane.d;
+	const float approach = Dot(displacement, plane.n);
+	if (approach >= 0.0f || startDistance < -sphere.radius)
+		return false;
+
+	// Already touching
+	if (startDistance <= sphere.radius)
+	{
+		toi = 0.0f;
+		return true;
+	}
+
+	const float t = (sphere.radius - startDistance) / approach;
+	if (t > 1.0f)
+		return false;
+
+	toi = t;
+	return true;
+}
+
+bool Angazi::Math::GetTimeOfImpact(const Sphere& sphere, const Vector3& displacement, const OBB& obb, float& toi, Vector3& normal)
+{
+	// Transform the sweep into the OBB's local space, the rotation is orthonormal so the transpose is its inverse
+	const Matrix4 matRot = Matrix4::RotationQuaternion(obb.rot);
+	const Matrix4 matRotInv = Transpose(matRot);
+	const Vector3 org = TransformNormal(sphere.center - obb.center, matRotInv);
+	const Vector3 dir = TransformNormal(displacement, matRotInv);
+
+	// Slab test against the box inflated by the sphere radius. This treats the edges and corners
+	// as square instead of rounded, which is conservative and cheap.
+	const Vector3 extend = obb.extend + Vector3(sphere.radius);
+	float tMin = 0.0f;
+	float tMax = 1.0f;
+	int hitAxis = -1;
+	float hitSign = 0.0f;
+	for (int i = 0; i < 3; ++i)
+	{
+		if (Abs(dir.v[i]) < 0.000001f)
+		{
+			if (Abs(org.v[i]) > extend.v[i])
+				return false;
+			continue;
+		}
+
+		const float invDir = 1.0f / dir.v[i];
+		float tNear = (-extend.v[i] - org.v[i]) * invDir;
+		float tFar = (extend.v[i] - org.v[i]) * invDir;
+		float sign = -1.0f;
+		if (tNear > tFar)
+		{
+			std::swap(tNear, tFar);
+			sign = 1.0f;
+		}
+		if (tNear > tMin)
+		{
+			tMin = tNear;
+			hitAxis = i;
+			hitSign = sign;
+		}
+		tMax = Min(tMax, tFar);
+		if (tMin > tMax)
+			return false;
+	}
+
+	Vector3 localNormal;
+	if (hitAxis == -1)
+	{
+		// Started inside, push out through the face with the least penetration
+		float minPenetration = std::numeric_limits<float>::max();
+		for (int i = 0; i < 3; ++i)
+		{
+			const float penetration = extend.v[i] - Abs(org.v[i]);
+			if (penetration < minPenetration)
+			{
+				minPenetration = penetration;
+				hitAxis = i;
+				hitSign = org.v[i] >= 0.0f ? 1.0f : -1.0f;
+			}
+		}
+	}
+	localNormal.v[hitAxis] = hitSign;
+
+	// Ignore spheres that are already leaving through this face
+	if (Dot(dir, localNormal) >= 0.0f)
+		return false;
+
+	toi = tMin;
+	normal = TransformNormal(localNormal, matRot);
+	return true;
+}
+
 bool Angazi::Math::IsContained(const Vector3& point, const AABB& aabb)
 {
 	auto min = aabb.Min();
@@ -300,6 +442,95 @@ Quaternion Angazi::Math::Slerp(const Quaternion& q1, const Quaternion& q2, float
 	float c2 = sinf(theta * t) / sinf(theta);
 	return q1 * c1 + newQ2 * c2;
 }
+
+Quaternion Angazi::Math::FastSlerp(const Quaternion& q1, const Quaternion& q2, float t)
+{
+	// Both weights in one register, negated for q2 to take the shorter arc
+	const float dot = Dot(q1, q2);
+	float weights[4];
+	SIMD::Store(weights, SIMD::SlerpWeight(SIMD::Set(1.0f - t, t, 0.0f, 0.0f), SIMD::Splat(Min(Abs(dot), 1.0f))));
+	return q1 * weights[0] + q2 * (dot < 0.0f ? -weights[1] : weights[1]);
+}
+
+Quaternion Angazi::Math::Nlerp(const Quaternion& q1, const Quaternion& q2, float t)
+{
+	return Normalize(q1 * (1.0f - t) + q2 * (Dot(q1, q2) < 0.0f ? -t : t));
+}
+
+uint16_t Angazi::Math::FloatToHalf(float value)
+{
+	return static_cast<uint16_t>(SIMD::GetX(SIMD::FloatToHalf(SIMD::Splat(value))));
+}
+
+float Angazi::Math::HalfToFloat(uint16_t half)
+{
+	return SIMD::GetX(SIMD::HalfToFloat(SIMD::SplatUInt(half)));
+}
+
+uint32_t Angazi::Math::EncodeOctahedral(const Vector3& normal)
+{
+	return SIMD::GetX(SIMD::EncodeOctahedral(SIMD::Splat(normal.x), SIMD::Splat(normal.y), SIMD::Splat(normal.z)));
+}
+
+Vector3 Angazi::Math::DecodeOctahedral(uint32_t bits)
+{
+	SIMD::Float4 x, y, z;
+	SIMD::DecodeOctahedral(SIMD::SplatUInt(bits), x, y, z);
+	return { SIMD::GetX(x), SIMD::GetX(y), SIMD::GetX(z) };
+}
+
+uint32_t Angazi::Math::EncodeQuaternion(const Quaternion& q)
+{
+	return SIMD::GetX(SIMD::EncodeQuaternion(SIMD::Splat(q.x), SIMD::Splat(q.y), SIMD::Splat(q.z), SIMD::Splat(q.w)));
+}
+
+Quaternion Angazi::Math::DecodeQuaternion(uint32_t bits)
+{
+	SIMD::Float4 x, y, z, w;
+	SIMD::DecodeQuaternion(SIMD::SplatUInt(bits), x, y, z, w);
+	return { SIMD::GetX(x), SIMD::GetX(y), SIMD::GetX(z), SIMD::GetX(w) };
+}
+
+uint8_t Angazi::Math::ToUNorm8(float value)
+{
+	return static_cast<uint8_t>(SIMD::GetX(SIMD::ToUNorm(SIMD::Splat(value), 255.0f)));
+}
+
+int8_t Angazi::Math::ToSNorm8(float value)
+{
+	return static_cast<int8_t>(SIMD::GetX(SIMD::ToSNorm(SIMD::Splat(value), 127.0f)));
+}
+
+uint16_t Angazi::Math::ToUNorm16(float value)
+{
+	return static_cast<uint16_t>(SIMD::GetX(SIMD::ToUNorm(SIMD::Splat(value), 65535.0f)));
+}
+
+int16_t Angazi::Math::ToSNorm16(float value)
+{
+	return static_cast<int16_t>(SIMD::GetX(SIMD::ToSNorm(SIMD::Splat(value), 32767.0f)));
+}
+
+float Angazi::Math::FromUNorm8(uint8_t value)
+{
+	return SIMD::GetX(SIMD::FromUNorm(SIMD::SplatUInt(value), 255.0f));
+}
+
+float Angazi::Math::FromSNorm8(int8_t value)
+{
+	return SIMD::GetX(SIMD::FromSNorm(SIMD::SplatUInt(static_cast<uint8_t>(value)), 127.0f));
+}
+
+float Angazi::Math::FromUNorm16(uint16_t value)
+{
+	return SIMD::GetX(SIMD::FromUNorm(SIMD::SplatUInt(value), 65535.0f));
+}
+
+float Angazi::Math::FromSNorm16(int16_t value)
+{
+	return SIMD::GetX(SIMD::FromSNorm(SIMD::SplatUInt(static_cast<uint16_t>(value)), 32767.0f));
+}
+
 Quaternion Quaternion::RotationAxis(const Vector3& axis, float radian)
 {
 	const Vector3 a = Normalize(axis);
@@ -400,6 +631,36 @@ Matrix4 Matrix4::RotationQuaternion(const Quaternion& q)
 		1.0f
 	};
 }
+
+Frustum Frustum::FromViewProjection(const Matrix4& m)
+{
+	// Clip space is p * m, so each clip coordinate is a column of m. A point is inside when
+	// -w <= x <= w, -w <= y <= w and 0 <= z <= w.
+	const Vector4 column1{ m._11, m._21, m._31, m._41 };
+	const Vector4 column2{ m._12, m._22, m._32, m._42 };
+	const Vector4 column3{ m._13, m._23, m._33, m._43 };
+	const Vector4 column4{ m._14, m._24, m._34, m._44 };
+	const Vector4 equations[Count] =
+	{
+		column4 + column1,	// Left
+		column4 - column1,	// Right
+		column4 + column2,	// Bottom
+		column4 - column2,	// Top
+		column3,			// Near
+		column4 - column3	// Far
+	};
+
+	// ax + by + cz + w >= 0 becomes Dot(p, n) >= d
+	Frustum frustum;
+	for (size_t i = 0; i < Count; ++i)
+	{
+		const Vector3 n{ equations[i].x, equations[i].y, equations[i].z };
+		const float length = Magnitude(n);
+		frustum.planes[i] = { n / length, -equations[i].w / length };
+	}
+	return frustum;
+}
+
 Matrix4 Matrix4::RotationAxis(const Vector3& axis, float radian)
 {
 	float cos = cosf(radian);
@@ -0,0 +1,237 @@
+#include "Precompiled.h"
+#include "EngineMath.h"
+
+using namespace Angazi;
+using namespace Angazi::Math;
+using namespace Angazi::Math::SIMD;
+
+namespace
+{
+	uint64_t SplitMix64(uint64_t& state)
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	uint32_t RotateLeft(uint32_t x, int k)
+	{
+		return (x << k) | (x >> (32 - k));
+	}
+
+	// Top 24 bits to [0, 1)
+	constexpr float kFloatScale = 1.0f / 16777216.0f;
+
+	// Four xoshiro128+ generators side by side, lane i of each register is generator i
+	struct RandomLanes
+	{
+		explicit RandomLanes(RandomStream& stream)
+		{
+			uint32_t state[4][4];
+			for (auto& word : state)
+				for (auto& lane : word)
+					lane = stream.NextUInt();
+			for (size_t i = 0; i < 4; ++i)
+				s[i] = LoadUInt(state[i]);
+		}
+
+		UInt4 Next()
+		{
+			const UInt4 result = Add(s[0], s[3]);
+			const UInt4 t = ShiftLeft<9>(s[1]);
+			s[2] = Xor(s[2], s[0]);
+			s[3] = Xor(s[3], s[1]);
+			s[1] = Xor(s[1], s[2]);
+			s[0] = Xor(s[0], s[3]);
+			s[2] = Xor(s[2], t);
+			s[3] = Or(ShiftLeft<11>(s[3]), ShiftRight<21>(s[3]));
+			return result;
+		}
+
+		// [0, 1)
+		Float4 NextFloat()
+		{
+			return Mul(ConvertToFloat(ShiftRight<8>(Next())), Splat(kFloatScale));
+		}
+
+		// Box-Muller, two independent normals per pair of uniforms
+		void NextNormal(Float4& z0, Float4& z1)
+		{
+			const Float4 u0 = Sub(Splat(1.0f), NextFloat());	// (0, 1], keeps Log finite
+			const Float4 u1 = NextFloat();
+			const Float4 radius = SIMD::Sqrt(Mul(Splat(-2.0f), SIMD::Log(u0)));
+			Float4 sin, cos;
+			SinCos(MulAdd(u1, Splat(Constants::TwoPi), Splat(-Constants::Pi)), sin, cos);
+			z0 = Mul(radius, cos);
+			z1 = Mul(radius, sin);
+		}
+
+		UInt4 s[4];
+	};
+
+	std::atomic<uint64_t> sGlobalSeed{ std::random_device{}() };
+	std::atomic<uint32_t> sSeedGeneration{ 0 };
+	std::atomic<uint32_t> sThreadCount{ 0 };
+}
+
+void RandomStream::Seed(uint64_t seed, uint64_t streamId)
+{
+	// Mix the stream id first so that nearby ids give unrelated states
+	uint64_t mixer = seed ^ SplitMix64(streamId);
+	do
+	{
+		const uint64_t a = SplitMix64(mixer);
+		const uint64_t b = SplitMix64(mixer);
+		mState[0] = static_cast<uint32_t>(a);
+		mState[1] = static_cast<uint32_t>(a >> 32);
+		mState[2] = static_cast<uint32_t>(b);
+		mState[3] = static_cast<uint32_t>(b >> 32);
+	} while ((mState[0] | mState[1] | mState[2] | mState[3]) == 0);
+	mHasSpareNormal = false;
+}
+
+uint32_t RandomStream::NextUInt()
+{
+	const uint32_t result = mState[0] + mState[3];
+	const uint32_t t = mState[1] << 9;
+	mState[2] ^= mState[0];
+	mState[3] ^= mState[1];
+	mState[1] ^= mState[2];
+	mState[0] ^= mState[3];
+	mState[2] ^= t;
+	mState[3] = RotateLeft(mState[3], 11);
+	return result;
+}
+
+float RandomStream::NextFloat()
+{
+	return (NextUInt() >> 8) * kFloatScale;
+}
+
+float RandomStream::NextFloat(float min, float max)
+{
+	return min + (max - min) * NextFloat();
+}
+
+int RandomStream::NextInt(int min, int max)
+{
+	ASSERT(min <= max, "RandomStream -- Invalid range.");
+	// Multiply instead of modulo so the result comes from the high bits
+	const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+	return static_cast<int>(min + static_cast<int64_t>((NextUInt() * range) >> 32));
+}
+
+double RandomStream::NextDouble()
+{
+	const uint64_t bits = (static_cast<uint64_t>(NextUInt() >> 5) << 26) | (NextUInt() >> 6);
+	return bits * (1.0 / 9007199254740992.0);
+}
+
+double RandomStream::NextDouble(double min, double max)
+{
+	return min + (max - min) * NextDouble();
+}
+
+float RandomStream::NextNormal()
+{
+	if (mHasSpareNormal)
+	{
+		mHasSpareNormal = false;
+		return mSpareNormal;
+	}
+
+	const float u0 = 1.0f - NextFloat();
+	const float u1 = NextFloat();
+	const float radius = sqrtf(-2.0f * logf(u0));
+	const float angle = Constants::TwoPi * u1;
+	mSpareNormal = radius * sinf(angle);
+	mHasSpareNormal = true;
+	return radius * cosf(angle);
+}
+
+float RandomStream::NextNormal(float mean, float standardDeviation)
+{
+	return mean + standardDeviation * NextNormal();
+}
+
+void RandomStream::FillUniform(float* out, size_t count, float min, float max)
+{
+	if (count < 16)
+	{
+		for (size_t i = 0; i < count; ++i)
+			out[i] = NextFloat(min, max);
+		return;
+	}
+
+	RandomLanes lanes(*this);
+	const Float4 offset = Splat(min);
+	const Float4 scale = Splat(max - min);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+		Store(out + i, MulAdd(lanes.NextFloat(), scale, offset));
+	if (i < count)
+	{
+		float tail[4];
+		Store(tail, MulAdd(lanes.NextFloat(), scale, offset));
+		for (size_t lane = 0; i < count; ++i, ++lane)
+			out[i] = tail[lane];
+	}
+}
+
+void RandomStream::FillNormal(float* out, size_t count, float mean, float standardDeviation)
+{
+	if (count < 16)
+	{
+		for (size_t i = 0; i < count; ++i)
+			out[i] = NextNormal(mean, standardDeviation);
+		return;
+	}
+
+	RandomLanes lanes(*this);
+	const Float4 offset = Splat(mean);
+	const Float4 scale = Splat(standardDeviation);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		Float4 z0, z1;
+		lanes.NextNormal(z0, z1);
+		Store(out + i, MulAdd(z0, scale, offset));
+		Store(out + i + 4, MulAdd(z1, scale, offset));
+	}
+	if (i < count)
+	{
+		float tail[8];
+		Float4 z0, z1;
+		lanes.NextNormal(z0, z1);
+		Store(tail, MulAdd(z0, scale, offset));
+		Store(tail + 4, MulAdd(z1, scale, offset));
+		for (size_t lane = 0; i < count; ++i, ++lane)
+			out[i] = tail[lane];
+	}
+}
+
+RandomStream& Angazi::Math::ThreadRandomStream()
+{
+	struct ThreadStream
+	{
+		RandomStream stream;
+		uint32_t threadIndex = sThreadCount.fetch_add(1);
+		uint32_t generation = ~0u;
+	};
+	thread_local ThreadStream threadStream;
+
+	const uint32_t generation = sSeedGeneration.load(std::memory_order_acquire);
+	if (threadStream.generation != generation)
+	{
+		threadStream.stream.Seed(sGlobalSeed.load(std::memory_order_relaxed), threadStream.threadIndex);
+		threadStream.generation = generation;
+	}
+	return threadStream.stream;
+}
+
+void Angazi::Math::SeedRandom(uint64_t seed)
+{
+	sGlobalSeed.store(seed, std::memory_order_relaxed);
+	sSeedGeneration.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,162 @@
+#include "Precompiled.h"
+#include "EngineMath.h"
+
+using namespace Angazi::Math;
+
+// SphereSoA
+uint32_t SphereSoA::Add(const Sphere& sphere)
+{
+	const uint32_t index = Append();
+	Set(index, sphere);
+	return index;
+}
+
+void SphereSoA::Set(uint32_t index, const Sphere& sphere)
+{
+	ASSERT(index < mCount, "SphereSoA -- Index out of range.");
+	At(CenterX, index) = sphere.center.x;
+	At(CenterY, index) = sphere.center.y;
+	At(CenterZ, index) = sphere.center.z;
+	At(Radius, index) = sphere.radius;
+}
+
+Sphere SphereSoA::Get(uint32_t index) const
+{
+	ASSERT(index < mCount, "SphereSoA -- Index out of range.");
+	return { At(CenterX, index), At(CenterY, index), At(CenterZ, index), At(Radius, index) };
+}
+
+// AABBSoA
+uint32_t AABBSoA::Add(const AABB& aabb)
+{
+	const uint32_t index = Append();
+	Set(index, aabb);
+	return index;
+}
+
+void AABBSoA::Set(uint32_t index, const AABB& aabb)
+{
+	ASSERT(index < mCount, "AABBSoA -- Index out of range.");
+	const Vector3 min = aabb.Min();
+	const Vector3 max = aabb.Max();
+	At(MinX, index) = min.x;
+	At(MinY, index) = min.y;
+	At(MinZ, index) = min.z;
+	At(MaxX, index) = max.x;
+	At(MaxY, index) = max.y;
+	At(MaxZ, index) = max.z;
+}
+
+AABB AABBSoA::Get(uint32_t index) const
+{
+	ASSERT(index < mCount, "AABBSoA -- Index out of range.");
+	const Vector3 min{ At(MinX, index), At(MinY, index), At(MinZ, index) };
+	const Vector3 max{ At(MaxX, index), At(MaxY, index), At(MaxZ, index) };
+	return { (min + max) * 0.5f, (max - min) * 0.5f };
+}
+
+// OBBSoA
+uint32_t OBBSoA::Add(const OBB& obb)
+{
+	const uint32_t index = Append();
+	Set(index, obb);
+	return index;
+}
+
+void OBBSoA::Set(uint32_t index, const OBB& obb)
+{
+	ASSERT(index < mCount, "OBBSoA -- Index out of range.");
+	const Matrix4 rotation = Matrix4::RotationQuaternion(obb.rot);
+	const Vector3 right = GetRight(rotation);
+	const Vector3 up = GetUp(rotation);
+	const Vector3 look = GetLook(rotation);
+	const float values[] =
+	{
+		obb.center.x, obb.center.y, obb.center.z,
+		obb.extend.x, obb.extend.y, obb.extend.z,
+		obb.rot.x, obb.rot.y, obb.rot.z, obb.rot.w,
+		right.x, right.y, right.z,
+		up.x, up.y, up.z,
+		look.x, look.y, look.z
+	};
+	for (size_t i = 0; i < std::size(values); ++i)
+		At(i, index) = values[i];
+}
+
+OBB OBBSoA::Get(uint32_t index) const
+{
+	ASSERT(index < mCount, "OBBSoA -- Index out of range.");
+	OBB obb;
+	obb.center = { At(CenterX, index), At(CenterY, index), At(CenterZ, index) };
+	obb.extend = { At(ExtendX, index), At(ExtendY, index), At(ExtendZ, index) };
+	obb.rot = { At(RotationX, index), At(RotationY, index), At(RotationZ, index), At(RotationW, index) };
+	return obb;
+}
+
+// PlaneSoA
+uint32_t PlaneSoA::Add(const Plane& plane)
+{
+	const uint32_t index = Append();
+	Set(index, plane);
+	return index;
+}
+
+void PlaneSoA::Set(uint32_t index, const Plane& plane)
+{
+	ASSERT(index < mCount, "PlaneSoA -- Index out of range.");
+	At(NormalX, index) = plane.n.x;
+	At(NormalY, index) = plane.n.y;
+	At(NormalZ, index) = plane.n.z;
+	At(Distance, index) = plane.d;
+}
+
+Plane PlaneSoA::Get(uint32_t index) const
+{
+	ASSERT(index < mCount, "PlaneSoA -- Index out of range.");
+	return { { At(NormalX, index), At(NormalY, index), At(NormalZ, index) }, At(Distance, index) };
+}
+
+// LineSegmentSoA
+uint32_t LineSegmentSoA::Add(const LineSegment& segment)
+{
+	const uint32_t index = Append();
+	Set(index, segment);
+	return index;
+}
+
+void LineSegmentSoA::Set(uint32_t index, const LineSegment& segment)
+{
+	ASSERT(index < mCount, "LineSegmentSoA -- Index out of range.");
+	At(FromX, index) = segment.from.x;
+	At(FromY, index) = segment.from.y;
+	At(ToX, index) = segment.to.x;
+	At(ToY, index) = segment.to.y;
+}
+
+LineSegment LineSegmentSoA::Get(uint32_t index) const
+{
+	ASSERT(index < mCount, "LineSegmentSoA -- Index out of range.");
+	return { At(FromX, index), At(FromY, index), At(ToX, index), At(ToY, index) };
+}
+
+// CircleSoA
+uint32_t CircleSoA::Add(const Circle& circle)
+{
+	const uint32_t index = Append();
+	Set(index, circle);
+	return index;
+}
+
+void CircleSoA::Set(uint32_t index, const Circle& circle)
+{
+	ASSERT(index < mCount, "CircleSoA -- Index out of range.");
+	At(CenterX, index) = circle.center.x;
+	At(CenterY, index) = circle.center.y;
+	At(Radius, index) = circle.radius;
+}
+
+Circle CircleSoA::Get(uint32_t index) const
+{
+	ASSERT(index < mCount, "CircleSoA -- Index out of range.");
+	return { At(CenterX, index), At(CenterY, index), At(Radius, index) };
+}
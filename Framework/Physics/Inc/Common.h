@@ -2,5 +2,9 @@
 
 // Engine headers
 #include <Core/Inc/Core.h>
+#include <Math/Inc/EngineMath.h>
+
+// PHYSICS_HEADLESS builds the simulation without Graphics, debug drawing compiles to nothing
+#if !defined(PHYSICS_HEADLESS)
 #include <Graphics/Inc/Graphics.h>
-#include <Math/Inc/EngineMath.h>
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -8,6 +8,8 @@ namespace Angazi::Physics
 	public:
 		virtual ~Constraint() = default;
 
+		// Called once per step before the solver iterations, for work that does not need repeating
+		virtual void BeginStep() {}
 		virtual void Apply() const = 0;
 		virtual void DebugDraw() const {};
 	};
@@ -40,4 +42,30 @@ namespace Angazi::Physics
 		Particle* mParticleB;
 		float mRestLength;
 	};
+
+	// Shape matching cluster, keeps its particles in their rest shape as one rigid body.
+	// The best fit rotation is found once per step by polar decomposition of the covariance
+	// between the rest and current shape, then every member is pulled towards its goal position.
+	class RigidCluster : public Constraint
+	{
+	public:
+		RigidCluster(std::vector<Particle*> particles, float stiffness = 1.0f);
+
+		void BeginStep() override;
+		void Apply() const override;
+		void DebugDraw() const override;
+
+		const Math::Quaternion& GetRotation() const { return mRotation; }
+
+	protected:
+		Math::Vector3 ComputeCenter() const;
+
+		std::vector<Particle*> mParticles;
+		std::vector<Math::Vector3> mRestOffsets; // from the rest centre of mass
+		std::vector<float> mMasses;
+		Math::Quaternion mRotation;
+		Math::Vector3 mRotationRows[3]; // cached rotation as basis images, goal = centre + rest * rows
+		float mInvTotalMass = 0.0f;
+		float mStiffness = 1.0f;
+	};
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include "Common.h"
+
+namespace Angazi::Physics
+{
+	// Regular grid of height samples on the XZ plane. Sample (row, column) sits at
+	// origin + (column * cellSize, height, row * cellSize).
+	class Heightfield
+	{
+	public:
+		void Initialize(uint32_t numRows, uint32_t numColumns, float cellSize, const Math::Vector3& origin = Math::Vector3::Zero);
+		void Terminate();
+
+		void SetHeight(uint32_t row, uint32_t column, float height);
+		float GetSample(uint32_t row, uint32_t column) const { return mHeights[column + (row * mNumColumns)]; }
+
+		// Bilinear queries, positions outside the grid are clamped to the border. Inside a cell
+		// that is not planar these differ from the triangles GetTimeOfImpact collides with.
+		float GetHeight(float x, float z) const;
+		Math::Vector3 GetNormal(float x, float z) const;
+		void GetHeights(const float* x, const float* z, float* heights, size_t count) const;
+
+		bool IsInside(float x, float z) const;
+
+		// Sweeps a sphere against the cells along its XZ path. Each cell is split into two
+		// triangles along its (0,1)-(1,0) diagonal, the same split Terrain renders, and the
+		// sphere is tested against their planes.
+		bool GetTimeOfImpact(const Math::Sphere& sphere, const Math::Vector3& displacement, float& toi, Math::Vector3& normal) const;
+
+		uint32_t GetNumRows() const { return mNumRows; }
+		uint32_t GetNumColumns() const { return mNumColumns; }
+		float GetCellSize() const { return mCellSize; }
+
+	private:
+		struct Cell
+		{
+			uint32_t index;	// index of the cell's lower left sample
+			float tx;		// fraction across the cell in x
+			float tz;		// fraction across the cell in z
+		};
+		Cell FindCell(float x, float z) const;
+		void SweepCell(const Math::Sphere& sphere, const Math::Vector3& displacement, int column, int row, bool& hit, float& toi, Math::Vector3& normal) const;
+
+		std::vector<float> mHeights;
+		Math::Vector3 mOrigin = Math::Vector3::Zero;
+		uint32_t mNumRows = 0;
+		uint32_t mNumColumns = 0;
+		float mCellSize = 1.0f;
+		float mInvCellSize = 1.0f;
+	};
+}
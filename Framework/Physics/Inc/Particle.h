@@ -7,6 +7,7 @@ namespace Angazi::Physics
 	{
 		Math::Vector3 position = Math::Vector3::Zero;
 		Math::Vector3 lastPosition = Math::Vector3::Zero;
+		Math::Vector3 previousPosition = Math::Vector3::Zero; // position at the start of the last step, for render interpolation
 		Math::Vector3 acceleration = Math::Vector3::Zero;
 		float radius = 1.0f;
 		float invMass = 1.0f;
@@ -17,6 +18,7 @@ namespace Angazi::Physics
 			// position = lastPosition = no motion
 			position = pos;
 			lastPosition = pos;
+			previousPosition = pos;
 		}
 
 		constexpr void SetVelocity(const Math::Vector3& vel)
@@ -24,9 +26,18 @@ namespace Angazi::Physics
 			lastPosition = position - vel;
 		}
 
-		void DebugDraw()
+		Math::Vector3 GetInterpolatedPosition(float alpha) const
 		{
-			Graphics::SimpleDraw::AddSphere(position, radius, Graphics::Colors::AliceBlue, false, 4, 4);
+			return Math::Lerp(previousPosition, position, alpha);
+		}
+
+		void DebugDraw(float alpha = 1.0f) const
+		{
+#if !defined(PHYSICS_HEADLESS)
+			Graphics::SimpleDraw::AddSphere(GetInterpolatedPosition(alpha), radius, Graphics::Colors::AliceBlue, false, 4, 4);
+#else
+			(void)alpha;
+#endif
 		}
 	};
 }
\ No newline at end of file
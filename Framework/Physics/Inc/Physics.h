@@ -1,5 +1,6 @@
 #pragma once
 
 #include "Constraints.h"
+#include "Heightfield.h"
 #include "Particle.h"
 #include "PhysicsWorld.h"
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "Particle.h"
 #include "Constraints.h"
+#include "Heightfield.h"
 
 namespace Angazi::Physics
 {
@@ -13,6 +14,8 @@ namespace Angazi::Physics
 			float timeStep = 1.0f / 60.0f;
 			float drag = 0.0f;
 			int iterations = 1;
+			int collisionIterations = 3;
+			int maxSubSteps = 5; // caps catch up steps per update, any time beyond that is dropped
 		};
 
 		void Initialize(const Settings& settings);
@@ -27,24 +30,36 @@ namespace Angazi::Physics
 		// For Environment
 		void AddStaticPlane(const Math::Plane& plane);
 		void AddStaticOBB(const Math::OBB& obb);
+		void AddStaticHeightfield(const Heightfield* heightfield); // not owned, must outlive the world
 		
 		void Clear(bool onlyDynamic = false);
 
 		void ShowParticles(bool show) { mShowParticles = show; }
 
 		Math::Vector3 GetParticlePosition(int index)  const { return mParticles[index]->position; }
+		Math::Vector3 GetInterpolatedParticlePosition(int index) const { return mParticles[index]->GetInterpolatedPosition(GetInterpolationAlpha()); }
+
+		// How far the accumulator is into the next step, in [0, 1). Render code blends the
+		// previous and current particle positions with it so motion stays smooth when the
+		// render rate differs from the physics rate.
+		float GetInterpolationAlpha() const { return mTimer / mSettings.timeStep; }
+		uint32_t GetDroppedStepCount() const { return mDroppedSteps; }
 	private:
 		void AccumulateForces();
 		void Integrate();
 		void SatisfyConstraints();
+		void ResolveCollisions(Particle& p) const;
+		bool SweepStaticGeometry(const Math::Sphere& sphere, const Math::Vector3& displacement, float& toi, Math::Vector3& normal) const;
 
 		std::vector<Particle*> mParticles;
 		std::vector<Constraint*> mConstraints;
 		std::vector<Math::Plane> mPlanes;
 		std::vector<Math::OBB> mOBBs;
+		std::vector<const Heightfield*> mHeightfields;
 
 		Settings mSettings;
 		float mTimer = 0.0f;
+		uint32_t mDroppedSteps = 0;
 		bool mShowParticles = true;
 	};
 }
\ No newline at end of file
@@ -22,7 +22,9 @@ void Spring::Apply() const
 
 void Spring::DebugDraw() const
 {
+#if !defined(PHYSICS_HEADLESS)
 	Graphics::SimpleDraw::AddLine(mParticleA->position, mParticleB->position, Graphics::Colors::AliceBlue);
+#endif
 }
 
 Fixed::Fixed(Particle* p)
@@ -43,10 +45,117 @@ void Fixed::Apply() const
 
 void Fixed::DebugDraw() const
 {
+#if !defined(PHYSICS_HEADLESS)
 	Graphics::SimpleDraw::AddAABB(mPosition, mParticle->radius, Graphics::Colors::Cyan);
+#endif
 }
 
 void Fixed::SetPosition(const Math::Vector3& position)
 {
 	mPosition = position;
-}
\ No newline at end of file
+}
+namespace
+{
+	// Pinned particles still take part in the fit, as very heavy members
+	constexpr float kPinnedMass = 1000.0f;
+	constexpr int kMaxRotationIterations = 20;
+
+	void GetRotationRows(const Math::Quaternion& q, Math::Vector3 rows[3])
+	{
+		const Math::Matrix4 m = Math::Matrix4::RotationQuaternion(q);
+		rows[0] = { m._11, m._12, m._13 };
+		rows[1] = { m._21, m._22, m._23 };
+		rows[2] = { m._31, m._32, m._33 };
+	}
+}
+
+RigidCluster::RigidCluster(std::vector<Particle*> particles, float stiffness)
+	: mParticles(std::move(particles))
+	, mStiffness(Math::Clamp(stiffness, 0.0f, 1.0f))
+{
+	ASSERT(mParticles.size() >= 2, "RigidCluster -- A cluster needs at least two particles.");
+
+	float totalMass = 0.0f;
+	mMasses.reserve(mParticles.size());
+	for (auto p : mParticles)
+	{
+		mMasses.push_back(p->invMass > 0.0f ? 1.0f / p->invMass : kPinnedMass);
+		totalMass += mMasses.back();
+	}
+	mInvTotalMass = 1.0f / totalMass;
+
+	const Math::Vector3 center = ComputeCenter();
+	mRestOffsets.reserve(mParticles.size());
+	for (auto p : mParticles)
+		mRestOffsets.push_back(p->position - center);
+
+	GetRotationRows(mRotation, mRotationRows);
+}
+
+void RigidCluster::BeginStep()
+{
+	// Covariance between the current and rest shape, column j is sum(m * (p - c) * rest.j)
+	const Math::Vector3 center = ComputeCenter();
+	Math::Vector3 covariance[3] = { Math::Vector3::Zero, Math::Vector3::Zero, Math::Vector3::Zero };
+	for (size_t i = 0; i < mParticles.size(); ++i)
+	{
+		const Math::Vector3 d = (mParticles[i]->position - center) * mMasses[i];
+		const Math::Vector3& rest = mRestOffsets[i];
+		covariance[0] += d * rest.x;
+		covariance[1] += d * rest.y;
+		covariance[2] += d * rest.z;
+	}
+
+	// Rotational part of the polar decomposition, found iteratively (Muller et al. 2016) and warm
+	// started from last step's rotation so it usually converges in one or two iterations. Unlike
+	// an SVD this stays stable for flat or degenerate clusters.
+	Math::Vector3 rows[3];
+	for (int n = 0; n < kMaxRotationIterations; ++n)
+	{
+		GetRotationRows(mRotation, rows);
+		const Math::Vector3 torque = Math::Cross(rows[0], covariance[0]) + Math::Cross(rows[1], covariance[1]) + Math::Cross(rows[2], covariance[2]);
+		const float scale = Math::Abs(Math::Dot(rows[0], covariance[0]) + Math::Dot(rows[1], covariance[1]) + Math::Dot(rows[2], covariance[2]));
+		const Math::Vector3 omega = torque / (scale + 1.0e-9f);
+		const float angle = Math::Magnitude(omega);
+		if (angle < 1.0e-6f)
+			break;
+		mRotation = Math::Normalize(Math::Quaternion::RotationAxis(omega / angle, angle) * mRotation);
+	}
+	GetRotationRows(mRotation, mRotationRows);
+}
+
+void RigidCluster::Apply() const
+{
+	// The rotation is fixed for the step, only the centre moves between iterations
+	const Math::Vector3 center = ComputeCenter();
+	const Math::Vector3 rowX = mRotationRows[0];
+	const Math::Vector3 rowY = mRotationRows[1];
+	const Math::Vector3 rowZ = mRotationRows[2];
+	const size_t count = mParticles.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		Particle* p = mParticles[i];
+		if (p->invMass <= 0.0f)
+			continue;
+		const Math::Vector3& rest = mRestOffsets[i];
+		const Math::Vector3 goal = center + rowX * rest.x + rowY * rest.y + rowZ * rest.z;
+		p->position += (goal - p->position) * mStiffness;
+	}
+}
+
+void RigidCluster::DebugDraw() const
+{
+#if !defined(PHYSICS_HEADLESS)
+	const Math::Vector3 center = ComputeCenter();
+	for (auto p : mParticles)
+		Graphics::SimpleDraw::AddLine(center, p->position, Graphics::Colors::DarkOrange);
+#endif
+}
+
+Math::Vector3 RigidCluster::ComputeCenter() const
+{
+	Math::Vector3 center = Math::Vector3::Zero;
+	for (size_t i = 0; i < mParticles.size(); ++i)
+		center += mParticles[i]->position * mMasses[i];
+	return center * mInvTotalMass;
+}
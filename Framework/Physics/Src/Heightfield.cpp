@@ -0,0 +1,217 @@
+#include "Precompiled.h"
+#include "Heightfield.h"
+
+using namespace Angazi;
+using namespace Angazi::Physics;
+
+namespace
+{
+	// Narrows [tMin, tMax] to where start + (dir * t) lies within [min, max]
+	bool ClipToRange(float start, float dir, float min, float max, float& tMin, float& tMax)
+	{
+		if (dir == 0.0f)
+			return start >= min && start <= max;
+
+		float tNear = (min - start) / dir;
+		float tFar = (max - start) / dir;
+		if (tNear > tFar)
+			std::swap(tNear, tFar);
+		tMin = Math::Max(tMin, tNear);
+		tMax = Math::Min(tMax, tFar);
+		return tMin <= tMax;
+	}
+}
+
+void Heightfield::Initialize(uint32_t numRows, uint32_t numColumns, float cellSize, const Math::Vector3& origin)
+{
+	ASSERT(numRows >= 2 && numColumns >= 2, "Heightfield -- Need at least 2x2 samples.");
+	ASSERT(cellSize > 0.0f, "Heightfield -- Invalid cell size.");
+
+	mNumRows = numRows;
+	mNumColumns = numColumns;
+	mCellSize = cellSize;
+	mInvCellSize = 1.0f / cellSize;
+	mOrigin = origin;
+	mHeights.assign(static_cast<size_t>(numRows) * numColumns, origin.y);
+}
+
+void Heightfield::Terminate()
+{
+	mHeights.clear();
+	mNumRows = 0;
+	mNumColumns = 0;
+}
+
+void Heightfield::SetHeight(uint32_t row, uint32_t column, float height)
+{
+	ASSERT(row < mNumRows && column < mNumColumns, "Heightfield -- Sample out of range.");
+	mHeights[column + (row * mNumColumns)] = mOrigin.y + height;
+}
+
+Heightfield::Cell Heightfield::FindCell(float x, float z) const
+{
+	const float maxX = static_cast<float>(mNumColumns - 1);
+	const float maxZ = static_cast<float>(mNumRows - 1);
+	const float fx = Math::Clamp((x - mOrigin.x) * mInvCellSize, 0.0f, maxX);
+	const float fz = Math::Clamp((z - mOrigin.z) * mInvCellSize, 0.0f, maxZ);
+
+	// Samples on the far border use the last cell with a fraction of 1
+	const uint32_t column = Math::Min(static_cast<uint32_t>(fx), mNumColumns - 2);
+	const uint32_t row = Math::Min(static_cast<uint32_t>(fz), mNumRows - 2);
+	return { column + (row * mNumColumns), fx - column, fz - row };
+}
+
+float Heightfield::GetHeight(float x, float z) const
+{
+	const Cell cell = FindCell(x, z);
+	const float* h = mHeights.data() + cell.index;
+	const float bottom = Math::Lerp(h[0], h[1], cell.tx);
+	const float top = Math::Lerp(h[mNumColumns], h[mNumColumns + 1], cell.tx);
+	return Math::Lerp(bottom, top, cell.tz);
+}
+
+Math::Vector3 Heightfield::GetNormal(float x, float z) const
+{
+	const Cell cell = FindCell(x, z);
+	const float* h = mHeights.data() + cell.index;
+	const float h00 = h[0];
+	const float h10 = h[1];
+	const float h01 = h[mNumColumns];
+	const float h11 = h[mNumColumns + 1];
+
+	// Partial derivatives of the bilinear patch
+	const float dhdx = ((h10 - h00) * (1.0f - cell.tz) + (h11 - h01) * cell.tz) * mInvCellSize;
+	const float dhdz = ((h01 - h00) * (1.0f - cell.tx) + (h11 - h10) * cell.tx) * mInvCellSize;
+	return Math::Normalize({ -dhdx, 1.0f, -dhdz });
+}
+
+void Heightfield::GetHeights(const float* x, const float* z, float* heights, size_t count) const
+{
+	const float maxX = static_cast<float>(mNumColumns - 1);
+	const float maxZ = static_cast<float>(mNumRows - 1);
+	const uint32_t lastColumn = mNumColumns - 2;
+	const uint32_t lastRow = mNumRows - 2;
+	const float* samples = mHeights.data();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const float fx = Math::Clamp((x[i] - mOrigin.x) * mInvCellSize, 0.0f, maxX);
+		const float fz = Math::Clamp((z[i] - mOrigin.z) * mInvCellSize, 0.0f, maxZ);
+		const uint32_t column = Math::Min(static_cast<uint32_t>(fx), lastColumn);
+		const uint32_t row = Math::Min(static_cast<uint32_t>(fz), lastRow);
+		const float tx = fx - column;
+		const float tz = fz - row;
+
+		const float* h = samples + column + (row * mNumColumns);
+		const float bottom = h[0] + (h[1] - h[0]) * tx;
+		const float top = h[mNumColumns] + (h[mNumColumns + 1] - h[mNumColumns]) * tx;
+		heights[i] = bottom + (top - bottom) * tz;
+	}
+}
+
+bool Heightfield::IsInside(float x, float z) const
+{
+	const float localX = x - mOrigin.x;
+	const float localZ = z - mOrigin.z;
+	return localX >= 0.0f && localX <= (mNumColumns - 1) * mCellSize
+		&& localZ >= 0.0f && localZ <= (mNumRows - 1) * mCellSize;
+}
+
+bool Heightfield::GetTimeOfImpact(const Math::Sphere& sphere, const Math::Vector3& displacement, float& toi, Math::Vector3& normal) const
+{
+	if (mHeights.empty())
+		return false;
+
+	// Path of the center in cell units, clipped to the grid padded by the sphere's reach
+	const int reach = static_cast<int>(std::ceil(sphere.radius * mInvCellSize));
+	const float startX = (sphere.center.x - mOrigin.x) * mInvCellSize;
+	const float startZ = (sphere.center.z - mOrigin.z) * mInvCellSize;
+	const float dirX = displacement.x * mInvCellSize;
+	const float dirZ = displacement.z * mInvCellSize;
+	float tMin = 0.0f;
+	float tMax = 1.0f;
+	if (!ClipToRange(startX, dirX, static_cast<float>(-reach), static_cast<float>(mNumColumns - 1 + reach), tMin, tMax) ||
+		!ClipToRange(startZ, dirZ, static_cast<float>(-reach), static_cast<float>(mNumRows - 1 + reach), tMin, tMax))
+		return false;
+
+	// Walk the crossed cells in order, testing the neighbours the sphere can reach as well
+	constexpr float never = std::numeric_limits<float>::max();
+	int column = static_cast<int>(std::floor(startX + (dirX * tMin)));
+	int row = static_cast<int>(std::floor(startZ + (dirZ * tMin)));
+	const int stepX = dirX > 0.0f ? 1 : -1;
+	const int stepZ = dirZ > 0.0f ? 1 : -1;
+	const float deltaX = dirX != 0.0f ? Math::Abs(1.0f / dirX) : never;
+	const float deltaZ = dirZ != 0.0f ? Math::Abs(1.0f / dirZ) : never;
+	float nextX = dirX != 0.0f ? (column + (dirX > 0.0f ? 1 : 0) - startX) / dirX : never;
+	float nextZ = dirZ != 0.0f ? (row + (dirZ > 0.0f ? 1 : 0) - startZ) / dirZ : never;
+
+	bool hit = false;
+	while (true)
+	{
+		for (int r = row - reach; r <= row + reach; ++r)
+			for (int c = column - reach; c <= column + reach; ++c)
+				SweepCell(sphere, displacement, c, r, hit, toi, normal);
+
+		// Cells further along cannot beat a hit found before entering them
+		const float next = Math::Min(nextX, nextZ);
+		if (next > tMax || (hit && toi < next))
+			break;
+
+		if (nextX < nextZ)
+		{
+			column += stepX;
+			nextX += deltaX;
+		}
+		else
+		{
+			row += stepZ;
+			nextZ += deltaZ;
+		}
+	}
+	return hit;
+}
+
+void Heightfield::SweepCell(const Math::Sphere& sphere, const Math::Vector3& displacement, int column, int row, bool& hit, float& toi, Math::Vector3& normal) const
+{
+	if (column < 0 || row < 0 || column > static_cast<int>(mNumColumns) - 2 || row > static_cast<int>(mNumRows) - 2)
+		return;
+
+	const float* h = mHeights.data() + column + (row * mNumColumns);
+	const float h00 = h[0];
+	const float h10 = h[1];
+	const float h01 = h[mNumColumns];
+	const float h11 = h[mNumColumns + 1];
+	const float cornerX = mOrigin.x + (column * mCellSize);
+	const float cornerZ = mOrigin.z + (row * mCellSize);
+
+	// Lower triangle (00, 10, 01) then upper triangle (10, 11, 01), as the plane's height at
+	// the (0, 0) corner and its slopes along x and z
+	const float planes[2][3] = { { h00, h10 - h00, h01 - h00 }, { h10 + h01 - h11, h11 - h01, h11 - h10 } };
+	for (int i = 0; i < 2; ++i)
+	{
+		const Math::Vector3 corner(cornerX, planes[i][0], cornerZ);
+		const Math::Vector3 n = Math::Normalize({ -planes[i][1] * mInvCellSize, 1.0f, -planes[i][2] * mInvCellSize });
+		const float startDistance = Math::Dot(sphere.center - corner, n);
+		const float approach = Math::Dot(displacement, n);
+		if (approach >= 0.0f || startDistance < -sphere.radius)
+			continue;
+
+		const float t = startDistance <= sphere.radius ? 0.0f : (sphere.radius - startDistance) / approach;
+		if (t > 1.0f || (hit && t >= toi))
+			continue;
+
+		// Only count it if the contact point lies on this triangle
+		const Math::Vector3 contact = sphere.center + (displacement * t) - (n * Math::Min(startDistance, sphere.radius));
+		const float tx = (contact.x - cornerX) * mInvCellSize;
+		const float tz = (contact.z - cornerZ) * mInvCellSize;
+		constexpr float epsilon = 0.0001f;
+		if (tx < -epsilon || tx > 1.0f + epsilon || tz < -epsilon || tz > 1.0f + epsilon)
+			continue;
+		if (i == 0 ? tx + tz > 1.0f + epsilon : tx + tz < 1.0f - epsilon)
+			continue;
+
+		toi = t;
+		normal = n;
+		hit = true;
+	}
+}
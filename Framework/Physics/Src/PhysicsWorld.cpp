@@ -11,26 +11,43 @@ void PhysicsWorld::Initialize(const Settings & settings)
 
 void PhysicsWorld::Update(float deltaTime)
 {
+	PROFILE_FUNCTION();
 	mTimer += deltaTime;
-	while (mTimer >= mSettings.timeStep)
+
+	int steps = 0;
+	while (mTimer >= mSettings.timeStep && steps < mSettings.maxSubSteps)
 	{
 		mTimer -= mSettings.timeStep;
+		++steps;
 
 		AccumulateForces();
 		Integrate();
 		SatisfyConstraints();
 	}
+
+	PROFILE_COUNTER("Physics Steps", steps);
+
+	// After a long hitch, drop the steps we could not catch up on instead of carrying them
+	// into the next frame and causing another hitch. Keep the remainder so alpha stays valid.
+	if (mTimer >= mSettings.timeStep)
+	{
+		const float dropped = std::floor(mTimer / mSettings.timeStep);
+		mDroppedSteps += static_cast<uint32_t>(dropped);
+		mTimer -= dropped * mSettings.timeStep;
+	}
 }
 
 void PhysicsWorld::DebugDraw() const
 {
+#if !defined(PHYSICS_HEADLESS)
 	if (mShowParticles)
 		for (auto p : mParticles)
-			p->DebugDraw();
+			p->DebugDraw(GetInterpolationAlpha());
 	for (auto c : mConstraints)
 		c->DebugDraw();
 	for (auto& obb : mOBBs)
 		Graphics::SimpleDraw::AddOBB(obb, Graphics::Colors::LightBlue);
+#endif
 }
 
 void PhysicsWorld::AddParticles(Particle * p)
@@ -53,6 +70,11 @@ void PhysicsWorld::AddStaticOBB(const Math::OBB & obb)
 	mOBBs.push_back(obb);
 }
 
+void PhysicsWorld::AddStaticHeightfield(const Heightfield* heightfield)
+{
+	mHeightfields.push_back(heightfield);
+}
+
 void PhysicsWorld::Clear(bool onlyDynamic)
 {
 	for (auto particle : mParticles)
@@ -67,6 +89,7 @@ void PhysicsWorld::Clear(bool onlyDynamic)
 	{
 		mPlanes.clear();
 		mOBBs.clear();
+		mHeightfields.clear();
 	}
 }
 
@@ -82,6 +105,7 @@ void PhysicsWorld::Integrate()
 	for (auto p : mParticles)
 	{
 		Math::Vector3 displacement = (p->position - p->lastPosition) + (p->acceleration * timeStepSqr);
+		p->previousPosition = p->position;
 		p->lastPosition = p->position;
 		p->position = p->position + displacement;
 	}
@@ -89,47 +113,96 @@ void PhysicsWorld::Integrate()
 
 void PhysicsWorld::SatisfyConstraints()
 {
+	for (auto c : mConstraints)
+		c->BeginStep();
+
 	for (int n = 0; n < mSettings.iterations; ++n)
 	{
 		for (auto c : mConstraints)
 			c->Apply();
 	}
 
-	for (auto plane : mPlanes)
+	for (auto p : mParticles)
+		ResolveCollisions(*p);
+}
+
+void PhysicsWorld::ResolveCollisions(Particle& p) const
+{
+	// Sweep the particle from its last position and resolve the earliest impact. The remaining
+	// motion is reflected and swept again, so fast particles cannot tunnel through thin geometry.
+	Math::Vector3 start = p.lastPosition;
+	Math::Vector3 velocity = p.position - p.lastPosition;
+	float remaining = 1.0f;
+	bool collided = false;
+	bool resolved = false;
+
+	for (int n = 0; n < mSettings.collisionIterations && remaining > 0.0f; ++n)
 	{
-		for (auto p : mParticles)
+		float toi = 1.0f;
+		Math::Vector3 normal;
+		if (!SweepStaticGeometry({ start, p.radius }, velocity * remaining, toi, normal))
 		{
-			if (Math::Dot(p->position, plane.n) <= plane.d && Math::Dot(p->lastPosition, plane.n) > plane.d)
-			{
-				auto velocity = p->position - p->lastPosition;
-				auto velocityPerpendicular = plane.n *Math::Dot(velocity, plane.n);
-				auto velocityParallel = velocity - velocityPerpendicular;
-				auto newVelocity = (velocityParallel * (1.0f - mSettings.drag)) - (velocityPerpendicular * p->bounce);
-				p->SetPosition(p->position - velocityPerpendicular);
-				p->SetVelocity(newVelocity);
-			}
+			resolved = true;
+			break;
 		}
+
+		start += velocity * (remaining * toi);
+		remaining *= 1.0f - toi;
+
+		auto velocityPerpendicular = normal * Math::Dot(velocity, normal);
+		auto velocityParallel = velocity - velocityPerpendicular;
+		velocity = (velocityParallel * (1.0f - mSettings.drag)) - (velocityPerpendicular * p.bounce);
+		collided = true;
 	}
 
-	for (auto obb : mOBBs)
+	// Out of iterations, e.g. wedged in a corner. The leftover motion was never swept, so stay
+	// at the last safe position instead of applying it and tunneling.
+	if (!resolved)
+		remaining = 0.0f;
+
+	// Keep previousPosition, resting and sliding particles collide every step and would lose
+	// their render interpolation
+	if (collided)
 	{
-		for (auto p : mParticles)
+		p.position = start + velocity * remaining;
+		p.SetVelocity(velocity);
+	}
+}
+
+bool PhysicsWorld::SweepStaticGeometry(const Math::Sphere& sphere, const Math::Vector3& displacement, float& toi, Math::Vector3& normal) const
+{
+	bool hit = false;
+	for (auto& plane : mPlanes)
+	{
+		float t = 0.0f;
+		if (Math::GetTimeOfImpact(sphere, displacement, plane, t) && (!hit || t < toi))
+		{
+			toi = t;
+			normal = plane.n;
+			hit = true;
+		}
+	}
+	for (auto& obb : mOBBs)
+	{
+		float t = 0.0f;
+		Math::Vector3 n;
+		if (Math::GetTimeOfImpact(sphere, displacement, obb, t, n) && (!hit || t < toi))
+		{
+			toi = t;
+			normal = n;
+			hit = true;
+		}
+	}
+	for (auto heightfield : mHeightfields)
+	{
+		float t = 0.0f;
+		Math::Vector3 n;
+		if (heightfield->GetTimeOfImpact(sphere, displacement, t, n) && (!hit || t < toi))
 		{
-			if (IsContained(p->position, obb))
-			{
-				auto velocity = p->position - p->lastPosition;
-				auto direction = Normalize(velocity);
-
-				Math::Ray ray{p->lastPosition,direction};
-				Math::Vector3 point, normal;
-				GetContactPoint(ray,obb,point,normal);
-
-				auto velocityPerpendicular = normal *Math::Dot(velocity, normal);
-				auto velocityParallel = velocity - velocityPerpendicular;
-				auto newVelocity = (velocityParallel * (1.0f - mSettings.drag)) - (velocityPerpendicular * p->bounce);
-				p->SetPosition(p->position - velocityPerpendicular);
-				p->SetVelocity(newVelocity);
-			}
+			toi = t;
+			normal = n;
+			hit = true;
 		}
 	}
+	return hit;
 }
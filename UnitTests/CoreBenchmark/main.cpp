@@ -0,0 +1,181 @@
+// Core benchmarks. Runs without a window or graphics device.
+//
+// JobSystem scaling: every workload runs with 1 to N threads (the caller plus N - 1 workers)
+// and reports the median time and the speedup over the single thread run.
+
+#include <Core/Inc/Core.h>
+
+#include <cmath>
+
+using namespace Angazi;
+using namespace Angazi::Core;
+
+struct Arguments
+{
+	uint32_t maxThreads = 0;
+	int repeats = 5;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+template <class Fn>
+double MedianMilliseconds(int repeats, Fn&& fn)
+{
+	std::vector<double> times;
+	for (int i = 0; i < repeats; ++i)
+	{
+		const auto start = Clock::now();
+		fn();
+		times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	}
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+// Compute bound loop, each element costs roughly the same
+void ParallelForHeavy(JobSystem& jobSystem, std::vector<float>& data)
+{
+	jobSystem.ParallelFor(data.size(), [&data](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			float x = static_cast<float>(i) * 0.001f;
+			for (int n = 0; n < 16; ++n)
+				x = std::sqrt(x * x + 1.0f) * std::sin(x);
+			data[i] = x;
+		}
+	});
+}
+
+// Memory bound loop, mostly measures bandwidth and chunking overhead
+void ParallelForLight(JobSystem& jobSystem, std::vector<float>& data)
+{
+	jobSystem.ParallelFor(data.size(), [&data](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			data[i] = data[i] * 0.5f + 1.0f;
+	});
+}
+
+// Many tiny jobs, measures scheduling overhead
+void ManySmallJobs(JobSystem& jobSystem, std::atomic<uint64_t>& sum)
+{
+	JobCounter counter;
+	for (uint64_t i = 0; i < 20000; ++i)
+		jobSystem.Run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+	jobSystem.Wait(counter);
+}
+
+// Stages of fan out work, each stage starts when the previous one is done
+void DependencyChain(JobSystem& jobSystem, std::vector<float>& data)
+{
+	constexpr int stages = 16;
+	constexpr size_t jobsPerStage = 64;
+	const size_t slice = data.size() / jobsPerStage;
+
+	std::vector<std::unique_ptr<JobCounter>> counters;
+	for (int s = 0; s < stages; ++s)
+		counters.push_back(std::make_unique<JobCounter>());
+
+	for (int s = 0; s < stages; ++s)
+	{
+		for (size_t j = 0; j < jobsPerStage; ++j)
+		{
+			auto job = [&data, slice, j]()
+			{
+				for (size_t i = j * slice; i < (j + 1) * slice; ++i)
+					data[i] = std::sqrt(data[i] * data[i] + 1.0f);
+			};
+			if (s == 0)
+				jobSystem.Run(job, counters[s].get());
+			else
+				jobSystem.RunAfter(*counters[s - 1], job, counters[s].get());
+		}
+	}
+	jobSystem.Wait(*counters.back());
+}
+
+void RunJobSystemScaling(const Arguments& args)
+{
+	const uint32_t maxThreads = args.maxThreads > 0 ? args.maxThreads : std::max(1u, std::thread::hardware_concurrency());
+
+	std::vector<float> heavy(1 << 20);
+	std::vector<float> light(1 << 24, 1.0f);
+	std::vector<float> chain(1 << 20, 1.0f);
+	std::atomic<uint64_t> sum = 0;
+
+	printf("== JobSystem scaling ==\n");
+	printf("%8s %16s %16s %16s %16s\n", "Threads", "HeavyFor ms", "LightFor ms", "SmallJobs ms", "DepChain ms");
+
+	double baseline[4] = {};
+	for (uint32_t threads = 1; threads <= maxThreads; ++threads)
+	{
+		JobSystem jobSystem;
+		jobSystem.Initialize(threads - 1);
+
+		const double times[4] =
+		{
+			MedianMilliseconds(args.repeats, [&]() { ParallelForHeavy(jobSystem, heavy); }),
+			MedianMilliseconds(args.repeats, [&]() { ParallelForLight(jobSystem, light); }),
+			MedianMilliseconds(args.repeats, [&]() { ManySmallJobs(jobSystem, sum); }),
+			MedianMilliseconds(args.repeats, [&]() { DependencyChain(jobSystem, chain); })
+		};
+		jobSystem.Terminate();
+
+		printf("%8u", threads);
+		for (int i = 0; i < 4; ++i)
+		{
+			if (threads == 1)
+				baseline[i] = times[i];
+			printf(" %9.2f (%4.1fx)", times[i], baseline[i] / times[i]);
+		}
+		printf("\n");
+	}
+}
+
+std::optional<Arguments> ParseArgs(int argc, char* argv[])
+{
+	Arguments args;
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "-threads") == 0 && hasValue)
+			args.maxThreads = static_cast<uint32_t>(atoi(argv[++i]));
+		else if (strcmp(argv[i], "-repeat") == 0 && hasValue)
+			args.repeats = atoi(argv[++i]);
+		else
+			return std::nullopt;
+	}
+	if (args.repeats <= 0)
+		return std::nullopt;
+	return args;
+}
+
+void PrintUsage()
+{
+	printf
+	(
+		"== CoreBenchmark Help ==\n"
+		"\n"
+		"Usage:\n"
+		"    CoreBenchmark.exe [Options]\n"
+		"\n"
+		"Options:\n"
+		"    -threads <n>    Highest thread count to measure (default all hardware threads).\n"
+		"    -repeat <n>     Runs per measurement, the median is reported (default 5).\n"
+		"\n"
+	);
+}
+
+int main(int argc, char* argv[])
+{
+	const auto argsOpt = ParseArgs(argc, argv);
+	if (!argsOpt.has_value())
+	{
+		PrintUsage();
+		return -1;
+	}
+
+	RunJobSystemScaling(argsOpt.value());
+	return 0;
+}
@@ -0,0 +1,156 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace CoreTest
+{
+	TEST_CLASS(ConcurrentBlockAllocatorTest)
+	{
+	public:
+
+		TEST_METHOD(GrowTest)
+		{
+			ConcurrentBlockAllocator allocator(16, 4);
+			std::vector<void*> ptrs;
+			for (int i = 0; i < 10; ++i)
+			{
+				ptrs.push_back(allocator.Allocate());
+				Assert::IsNotNull(ptrs.back());
+			}
+
+			auto stats = allocator.GetStats();
+			Assert::AreEqual(size_t(10), stats.liveCount);
+			Assert::AreEqual(size_t(3), stats.pageCount);
+			Assert::AreEqual(size_t(12), stats.capacity);
+
+			std::sort(ptrs.begin(), ptrs.end());
+			Assert::IsTrue(std::unique(ptrs.begin(), ptrs.end()) == ptrs.end());
+			for (auto ptr : ptrs)
+				allocator.Free(ptr);
+		}
+
+		TEST_METHOD(MaxPagesTest)
+		{
+			ConcurrentBlockAllocator allocator(16, 2, alignof(std::max_align_t), 1);
+			void* ptr1 = allocator.Allocate();
+			void* ptr2 = allocator.Allocate();
+			Assert::IsNotNull(ptr1);
+			Assert::IsNotNull(ptr2);
+			Assert::IsNull(allocator.Allocate());
+
+			allocator.Free(ptr1);
+			void* ptr3 = allocator.Allocate();
+			Assert::IsTrue(ptr1 == ptr3);
+			allocator.Free(ptr2);
+			allocator.Free(ptr3);
+		}
+
+		TEST_METHOD(AlignmentTest)
+		{
+			ConcurrentBlockAllocator allocator(24, 8, 64);
+			Assert::AreEqual(size_t(64), allocator.GetBlockSize());
+			for (int i = 0; i < 20; ++i)
+			{
+				void* ptr = allocator.Allocate();
+				Assert::IsTrue((reinterpret_cast<uintptr_t>(ptr) & 63) == 0);
+			}
+
+			// Tiny blocks still make room for the free list link
+			ConcurrentBlockAllocator tiny(1, 8, 1);
+			Assert::IsTrue(tiny.GetBlockSize() >= sizeof(void*));
+		}
+
+		TEST_METHOD(StatsTest)
+		{
+			ConcurrentBlockAllocator allocator(32, 16);
+			std::vector<void*> ptrs;
+			for (int i = 0; i < 40; ++i)
+				ptrs.push_back(allocator.Allocate());
+			for (int i = 0; i < 30; ++i)
+			{
+				allocator.Free(ptrs.back());
+				ptrs.pop_back();
+			}
+
+			auto stats = allocator.GetStats();
+			Assert::AreEqual(size_t(10), stats.liveCount);
+			Assert::AreEqual(size_t(40), stats.highWaterMark);
+			for (auto ptr : ptrs)
+				allocator.Free(ptr);
+			Assert::AreEqual(size_t(0), allocator.GetStats().liveCount);
+		}
+
+		TEST_METHOD(ThreadTest)
+		{
+			ConcurrentBlockAllocator allocator(sizeof(uint64_t), 64);
+			std::mutex handoffMutex;
+			std::vector<uint64_t*> handoff;
+
+			// Each thread keeps some blocks and hands others to be freed by another thread
+			auto work = [&](uint64_t seed)
+			{
+				std::vector<uint64_t*> mine;
+				for (uint64_t i = 0; i < 20000; ++i)
+				{
+					auto ptr = static_cast<uint64_t*>(allocator.Allocate());
+					*ptr = seed + i;
+					mine.push_back(ptr);
+					if (mine.size() > 100)
+					{
+						for (auto p : mine)
+						{
+							if ((*p & 3) == 0)
+							{
+								std::lock_guard<std::mutex> lock(handoffMutex);
+								handoff.push_back(p);
+							}
+							else
+							{
+								allocator.Free(p);
+							}
+						}
+						mine.clear();
+
+						std::lock_guard<std::mutex> lock(handoffMutex);
+						for (auto p : handoff)
+							allocator.Free(p);
+						handoff.clear();
+					}
+				}
+				for (auto p : mine)
+					allocator.Free(p);
+			};
+
+			std::vector<std::thread> threads;
+			for (uint64_t t = 0; t < 4; ++t)
+				threads.emplace_back(work, t << 32);
+			for (auto& thread : threads)
+				thread.join();
+			for (auto p : handoff)
+				allocator.Free(p);
+
+			Assert::AreEqual(size_t(0), allocator.GetStats().liveCount);
+		}
+
+		TEST_METHOD(TypedTest)
+		{
+			struct alignas(32) Foo
+			{
+				Foo(int a, std::string b) : a(a), b(std::move(b)) {}
+				int a;
+				std::string b;
+			};
+
+			ConcurrentTypedAllocator<Foo> allocator(4);
+			Foo* foo = allocator.New(7, "seven");
+			Assert::IsNotNull(foo);
+			Assert::AreEqual(7, foo->a);
+			Assert::AreEqual(std::string("seven"), foo->b);
+			Assert::IsTrue((reinterpret_cast<uintptr_t>(foo) & 31) == 0);
+			allocator.Delete(foo);
+			Assert::AreEqual(size_t(0), allocator.GetStats().liveCount);
+		}
+	};
+}
@@ -0,0 +1,128 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace CoreTest
+{
+	TEST_CLASS(DenseHandlePoolTest)
+	{
+	public:
+		class Bar
+		{
+		public:
+			int a = 4;
+		};
+
+		TEST_METHOD(TestDefaultHandle)
+		{
+			WideHandle<Bar> handle;
+			Assert::IsFalse(handle.IsValid());
+			Assert::IsNull(handle.Get());
+
+			DenseHandlePool<Bar> barPool;
+			Assert::IsFalse(barPool.IsValid(handle));
+		}
+
+		TEST_METHOD(TestRegisterUnregister)
+		{
+			DenseHandlePool<Bar> barPool(1);
+			Bar obj;
+
+			WideHandle<Bar> handle1 = barPool.Register(&obj);
+			WideHandle<Bar> handle2 = handle1;
+			Assert::IsTrue(handle1.IsValid());
+			Assert::IsTrue(&obj == handle2.Get());
+			Assert::AreEqual(size_t(1), barPool.Size());
+
+			barPool.Unregister(handle1);
+			Assert::IsFalse(handle1.IsValid());
+			Assert::IsFalse(handle2.IsValid());
+			Assert::AreEqual(size_t(0), barPool.Size());
+
+			// The slot is reused with a new generation
+			WideHandle<Bar> handle3 = barPool.Register(&obj);
+			Assert::IsTrue(handle3.IsValid());
+			Assert::IsFalse(handle1.IsValid());
+			Assert::IsTrue(handle1 != handle3);
+		}
+
+		TEST_METHOD(TestGrowPastSixteenBits)
+		{
+			DenseHandlePool<Bar> barPool;
+			std::vector<Bar> objects(100000);
+			std::vector<WideHandle<Bar>> handles;
+			for (auto& obj : objects)
+				handles.push_back(barPool.Register(&obj));
+
+			Assert::AreEqual(objects.size(), barPool.Size());
+			for (size_t i = 0; i < objects.size(); i += 997)
+				Assert::IsTrue(handles[i].Get() == &objects[i]);
+		}
+
+		TEST_METHOD(TestDenseIteration)
+		{
+			DenseHandlePool<Bar> barPool;
+			Bar objects[5];
+			WideHandle<Bar> handles[5];
+			for (int i = 0; i < 5; ++i)
+			{
+				objects[i].a = i;
+				handles[i] = barPool.Register(&objects[i]);
+			}
+
+			// Removing from the middle moves the last instance into the hole
+			barPool.Unregister(handles[1]);
+			Assert::AreEqual(size_t(4), barPool.Size());
+			Assert::IsTrue(barPool[1] == &objects[4]);
+			Assert::IsTrue(handles[4].Get() == &objects[4]);
+
+			int sum = 0;
+			for (auto bar : barPool)
+				sum += bar->a;
+			Assert::AreEqual(0 + 2 + 3 + 4, sum);
+		}
+
+		TEST_METHOD(TestLock)
+		{
+			DenseHandlePool<Bar> barPool;
+			Bar objects[6];
+			WideHandle<Bar> handles[6];
+			for (int i = 0; i < 6; ++i)
+				handles[i] = barPool.Register(&objects[i]);
+
+			barPool.Lock();
+			barPool.Unregister(handles[0]);
+			barPool.Unregister(handles[5]);
+			barPool.Unregister(handles[2]);
+			WideHandle<Bar> late = barPool.Register(&objects[0]);
+
+			// Nothing moved, removed entries are holes
+			Assert::AreEqual(size_t(7), barPool.Size());
+			Assert::IsNull(barPool[0]);
+			Assert::IsTrue(barPool[3] == &objects[3]);
+			Assert::IsFalse(handles[2].IsValid());
+			barPool.Unlock();
+
+			Assert::AreEqual(size_t(4), barPool.Size());
+			for (auto bar : barPool)
+				Assert::IsNotNull(bar);
+			Assert::IsTrue(late.Get() == &objects[0]);
+			Assert::IsTrue(handles[1].Get() == &objects[1]);
+			Assert::IsTrue(handles[3].Get() == &objects[3]);
+			Assert::IsTrue(handles[4].Get() == &objects[4]);
+		}
+
+		TEST_METHOD(TestFlush)
+		{
+			DenseHandlePool<Bar> barPool;
+			Bar obj;
+			WideHandle<Bar> handle = barPool.Register(&obj);
+			barPool.Flush();
+			Assert::IsFalse(handle.IsValid());
+			Assert::AreEqual(size_t(0), barPool.Size());
+			Assert::IsTrue(barPool.Register(&obj).IsValid());
+		}
+	};
+}
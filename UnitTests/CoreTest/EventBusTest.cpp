@@ -0,0 +1,130 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace
+{
+	struct DamageEvent
+	{
+		int target = 0;
+		int amount = 0;
+	};
+
+	struct HealEvent
+	{
+		int amount = 0;
+	};
+
+	class Health
+	{
+	public:
+		void OnDamage(const DamageEvent& event) { mValue -= event.amount; }
+		void OnHeal(const HealEvent& event) { mValue += event.amount; }
+
+		int mValue = 100;
+	};
+}
+
+namespace CoreTest
+{
+	TEST_CLASS(EventBusTest)
+	{
+	public:
+		TEST_METHOD(DeferredTest)
+		{
+			EventBus bus;
+			Health health;
+			bus.Subscribe<&Health::OnDamage>(&health);
+			bus.Subscribe<&Health::OnHeal>(&health);
+
+			bus.Post(DamageEvent{ 0, 30 });
+			bus.Post(HealEvent{ 5 });
+			Assert::AreEqual(100, health.mValue);
+
+			bus.Dispatch();
+			Assert::AreEqual(75, health.mValue);
+
+			bus.Publish(DamageEvent{ 0, 25 });
+			Assert::AreEqual(50, health.mValue);
+		}
+
+		TEST_METHOD(UnsubscribeTest)
+		{
+			EventBus bus;
+			int total = 0;
+			auto id = bus.Subscribe<DamageEvent>([&total](const DamageEvent& event) { total += event.amount; });
+			bus.Publish(DamageEvent{ 0, 1 });
+			Assert::IsTrue(bus.Unsubscribe<DamageEvent>(id));
+			Assert::IsFalse(bus.Unsubscribe<DamageEvent>(id));
+			bus.Publish(DamageEvent{ 0, 1 });
+			Assert::AreEqual(1, total);
+		}
+
+		TEST_METHOD(ChangeDuringDispatchTest)
+		{
+			EventBus bus;
+			int first = 0;
+			int late = 0;
+			EventHandlerId firstId = 0;
+			firstId = bus.Subscribe<HealEvent>([&](const HealEvent&)
+			{
+				++first;
+				bus.Unsubscribe<HealEvent>(firstId);
+				bus.Subscribe<HealEvent>([&late](const HealEvent&) { ++late; });
+				bus.Post(HealEvent{});
+			});
+
+			// The change made while handling the first event applies to the second one
+			bus.Post(HealEvent{});
+			bus.Post(HealEvent{});
+			bus.Dispatch();
+			Assert::AreEqual(1, first);
+			Assert::AreEqual(1, late);
+
+			// The event posted by the handler waits for the next batch
+			Assert::AreEqual(size_t(1), bus.GetChannel<HealEvent>().GetPendingCount());
+			bus.Dispatch();
+			Assert::AreEqual(1, first);
+			Assert::AreEqual(2, late);
+		}
+
+		TEST_METHOD(ConcurrentPostTest)
+		{
+			EventBus bus;
+			Health health;
+			health.mValue = 0;
+			bus.Subscribe<&Health::OnHeal>(&health);
+
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+			{
+				threads.emplace_back([&bus]()
+				{
+					for (int i = 0; i < 1000; ++i)
+						bus.Post(HealEvent{ 1 });
+				});
+			}
+			for (auto& thread : threads)
+				thread.join();
+
+			bus.Dispatch();
+			Assert::AreEqual(4000, health.mValue);
+		}
+
+		TEST_METHOD(EventRemoveDuringNotifyTest)
+		{
+			Event<int> event;
+			int calls = 0;
+			EventHandlerId id = 0;
+			id = event += [&](int) { ++calls; event -= id; };
+			event += [&](int) { ++calls; };
+
+			event(1);
+			Assert::AreEqual(2, calls);
+			event(1);
+			Assert::AreEqual(3, calls);
+		}
+	};
+}
@@ -0,0 +1,128 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace CoreTest
+{
+	TEST_CLASS(JobSystemTest)
+	{
+	public:
+
+		TEST_METHOD(RunTest)
+		{
+			JobSystem jobSystem;
+			jobSystem.Initialize(3);
+
+			std::atomic<int> sum = 0;
+			JobCounter counter;
+			for (int i = 1; i <= 100; ++i)
+				jobSystem.Run([&sum, i]() { sum += i; }, &counter);
+			jobSystem.Wait(counter);
+
+			Assert::IsTrue(counter.IsDone());
+			Assert::AreEqual(5050, sum.load());
+			jobSystem.Terminate();
+		}
+
+		TEST_METHOD(NoWorkerTest)
+		{
+			JobSystem jobSystem;
+			jobSystem.Initialize(0);
+
+			int sum = 0;
+			JobCounter counter;
+			for (int i = 1; i <= 10; ++i)
+				jobSystem.Run([&sum, i]() { sum += i; }, &counter);
+			jobSystem.Wait(counter);
+
+			Assert::AreEqual(55, sum);
+			jobSystem.Terminate();
+		}
+
+		TEST_METHOD(RunAfterTest)
+		{
+			JobSystem jobSystem;
+			jobSystem.Initialize(3);
+
+			std::atomic<int> firstDone = 0;
+			std::atomic<bool> orderKept = true;
+			JobCounter first;
+			JobCounter second;
+			for (int i = 0; i < 50; ++i)
+				jobSystem.Run([&firstDone]() { ++firstDone; }, &first);
+			for (int i = 0; i < 50; ++i)
+				jobSystem.RunAfter(first, [&]() { if (firstDone != 50) orderKept = false; }, &second);
+			jobSystem.Wait(second);
+
+			Assert::IsTrue(first.IsDone());
+			Assert::IsTrue(orderKept);
+			jobSystem.Terminate();
+		}
+
+		TEST_METHOD(RunAfterDoneTest)
+		{
+			JobSystem jobSystem;
+			jobSystem.Initialize(1);
+
+			bool ran = false;
+			JobCounter done;
+			JobCounter counter;
+			jobSystem.RunAfter(done, [&ran]() { ran = true; }, &counter);
+			jobSystem.Wait(counter);
+
+			Assert::IsTrue(ran);
+			jobSystem.Terminate();
+		}
+
+		TEST_METHOD(ParallelForTest)
+		{
+			JobSystem jobSystem;
+			jobSystem.Initialize(3);
+
+			std::vector<int> hits(10007, 0);
+			jobSystem.ParallelFor(hits.size(), [&hits](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					++hits[i];
+			});
+			for (int hit : hits)
+				Assert::AreEqual(1, hit);
+
+			std::vector<int> small(3, 0);
+			jobSystem.ParallelFor(small.size(), [&small](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+					++small[i];
+			}, 1);
+			for (int hit : small)
+				Assert::AreEqual(1, hit);
+			jobSystem.Terminate();
+		}
+
+		TEST_METHOD(NestedWaitTest)
+		{
+			JobSystem jobSystem;
+			jobSystem.Initialize(2);
+
+			// Every outer job waits on its own inner jobs, which only works if waiting helps
+			std::atomic<int> sum = 0;
+			JobCounter outer;
+			for (int i = 0; i < 8; ++i)
+			{
+				jobSystem.Run([&jobSystem, &sum]()
+				{
+					JobCounter inner;
+					for (int j = 0; j < 8; ++j)
+						jobSystem.Run([&sum]() { ++sum; }, &inner);
+					jobSystem.Wait(inner);
+				}, &outer);
+			}
+			jobSystem.Wait(outer);
+
+			Assert::AreEqual(64, sum.load());
+			jobSystem.Terminate();
+		}
+	};
+}
@@ -0,0 +1,114 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace CoreTest
+{
+	TEST_CLASS(LinearAllocatorTest)
+	{
+	public:
+
+		TEST_METHOD(AllocateTest)
+		{
+			LinearAllocator allocator(256);
+			auto a = allocator.Allocate<uint8_t>(3);
+			auto b = allocator.Allocate(16, 16);
+			auto c = allocator.Allocate<double>(4);
+			Assert::IsNotNull(a);
+			Assert::IsTrue((reinterpret_cast<uintptr_t>(b) & 15) == 0);
+			Assert::IsTrue((reinterpret_cast<uintptr_t>(c) & (alignof(double) - 1)) == 0);
+			Assert::IsTrue(static_cast<void*>(a) < b && b < static_cast<void*>(c));
+
+			allocator.Reset();
+			Assert::AreEqual(size_t(0), allocator.GetUsed());
+			Assert::IsTrue(allocator.Allocate<uint8_t>(3) == a);
+		}
+
+		TEST_METHOD(GrowTest)
+		{
+			LinearAllocator allocator(64);
+			for (int i = 0; i < 10; ++i)
+				Assert::IsNotNull(allocator.Allocate(32, 8));
+			Assert::IsNotNull(allocator.Allocate(1000, 8));
+			Assert::IsTrue(allocator.GetCapacity() >= 1320);
+			Assert::IsTrue(allocator.GetHighWaterMark() >= 1320);
+
+			// Reset folds the chunks into one that holds the whole frame
+			const size_t capacity = allocator.GetCapacity();
+			allocator.Reset();
+			Assert::AreEqual(capacity, allocator.GetCapacity());
+			Assert::IsNotNull(allocator.Allocate(capacity - 8, 8));
+			Assert::AreEqual(capacity, allocator.GetCapacity());
+		}
+
+		TEST_METHOD(MarkerTest)
+		{
+			LinearAllocator allocator(128);
+			allocator.Allocate(16);
+			auto marker = allocator.GetMarker();
+			auto first = allocator.Allocate(16);
+			allocator.Allocate(500);
+			allocator.RewindTo(marker);
+			Assert::AreEqual(size_t(16), allocator.GetUsed());
+			Assert::IsTrue(allocator.Allocate(16) == first);
+		}
+
+		TEST_METHOD(ArenaVectorTest)
+		{
+			LinearAllocator allocator(1024);
+			ArenaVector<int> values(allocator);
+			for (int i = 0; i < 100; ++i)
+				values.push_back(i);
+			Assert::AreEqual(99, values.back());
+
+			// The vector sits on top, so growth reuses the same space
+			Assert::IsTrue(allocator.GetUsed() <= 1024);
+			Assert::IsTrue(allocator.GetCapacity() == 1024);
+		}
+
+		TEST_METHOD(ScratchTest)
+		{
+			const size_t used = GetScratchAllocator().GetUsed();
+			{
+				ScratchScope outer;
+				ArenaVector<float> a(outer.GetArena());
+				a.resize(64);
+				{
+					ScratchScope inner;
+					ArenaVector<float> b(inner.GetArena());
+					b.resize(100000);
+				}
+				Assert::AreEqual(size_t(64), a.size());
+			}
+			Assert::AreEqual(used, GetScratchAllocator().GetUsed());
+
+			// Threads get their own stack
+			LinearAllocator* mine = &GetScratchAllocator();
+			LinearAllocator* theirs = nullptr;
+			std::thread worker([&theirs]() { theirs = &GetScratchAllocator(); });
+			worker.join();
+			Assert::IsTrue(mine != theirs);
+		}
+
+		TEST_METHOD(FrameTest)
+		{
+			FrameAllocator frames(256);
+			auto persistent = frames.GetDoubleBufferedArena().Allocate<int>(1);
+			*persistent = 42;
+			frames.GetFrameArena().Allocate(128);
+			frames.EndFrame();
+
+			// Frame memory is gone, double buffered memory survives one more frame
+			Assert::AreEqual(size_t(0), frames.GetFrameArena().GetUsed());
+			Assert::AreEqual(size_t(0), frames.GetDoubleBufferedArena().GetUsed());
+			frames.GetDoubleBufferedArena().Allocate(64);
+			Assert::AreEqual(42, *persistent);
+
+			frames.EndFrame();
+			Assert::AreEqual(size_t(0), frames.GetDoubleBufferedArena().GetUsed());
+			Assert::IsTrue(frames.GetDoubleBufferedArena().Allocate<int>(1) == persistent);
+		}
+	};
+}
@@ -0,0 +1,132 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace
+{
+	bool Write(Logger& logger, LogRateLimit* rateLimit, const char* format, ...)
+	{
+		va_list args;
+		va_start(args, format);
+		const bool written = logger.Write(rateLimit, format, args);
+		va_end(args);
+		return written;
+	}
+
+	std::vector<std::string> ReadLines(const std::filesystem::path& path)
+	{
+		std::vector<std::string> lines;
+		std::ifstream file(path);
+		for (std::string line; std::getline(file, line);)
+			lines.push_back(line);
+		return lines;
+	}
+
+	Logger::Settings FileOnlySettings(const std::filesystem::path& path)
+	{
+		Logger::Settings settings;
+		settings.debuggerSink = false;
+		settings.editorSink = false;
+		settings.filePath = path;
+		return settings;
+	}
+}
+
+namespace CoreTest
+{
+	TEST_CLASS(LoggerTest)
+	{
+	public:
+		TEST_METHOD(FlushTest)
+		{
+			const auto path = std::filesystem::temp_directory_path() / "LoggerTest_Flush.txt";
+			{
+				Logger logger(FileOnlySettings(path));
+				Assert::IsTrue(Write(logger, nullptr, "Hello %d", 42));
+				logger.Flush();
+
+				auto lines = ReadLines(path);
+				Assert::AreEqual(size_t(1), lines.size());
+				Assert::IsTrue(lines[0].find("]: Hello 42") != std::string::npos);
+			}
+			std::filesystem::remove(path);
+		}
+
+		TEST_METHOD(RateLimitTest)
+		{
+			const auto path = std::filesystem::temp_directory_path() / "LoggerTest_RateLimit.txt";
+			{
+				auto settings = FileOnlySettings(path);
+				settings.maxPerSitePerSecond = 5;
+				Logger logger(settings);
+
+				LogRateLimit spammySite;
+				LogRateLimit quietSite;
+				int written = 0;
+				for (int i = 0; i < 20; ++i)
+					written += Write(logger, &spammySite, "Spam %d", i) ? 1 : 0;
+				Assert::IsTrue(Write(logger, &quietSite, "Quiet"));
+
+				// The window may roll over once during the loop
+				Assert::IsTrue(written >= 5 && written <= 10);
+				Assert::AreEqual(uint64_t(20 - written), logger.GetRateLimitedCount());
+
+				logger.Flush();
+				auto lines = ReadLines(path);
+				Assert::IsTrue(lines.back().find("Logger --") != std::string::npos);
+			}
+			std::filesystem::remove(path);
+		}
+
+		TEST_METHOD(ConcurrentTest)
+		{
+			const auto path = std::filesystem::temp_directory_path() / "LoggerTest_Concurrent.txt";
+			constexpr int kThreads = 4;
+			constexpr int kPerThread = 2000;
+			uint64_t dropped = 0;
+			{
+				auto settings = FileOnlySettings(path);
+				settings.capacity = 256;
+				settings.maxPerSitePerSecond = 0;
+				Logger logger(settings);
+
+				std::vector<std::thread> threads;
+				for (int t = 0; t < kThreads; ++t)
+				{
+					threads.emplace_back([&logger, t]()
+					{
+						for (int i = 0; i < kPerThread; ++i)
+							Write(logger, nullptr, "Worker %d message %d", t, i);
+					});
+				}
+				for (auto& thread : threads)
+					thread.join();
+				logger.Flush();
+				dropped = logger.GetDroppedCount();
+			}
+
+			// Everything not dropped arrives intact, and in order for each thread
+			int lastMessage[kThreads] = { -1, -1, -1, -1 };
+			uint64_t received = 0;
+			for (auto& line : ReadLines(path))
+			{
+				auto text = line.find("Worker");
+				if (text == std::string::npos)
+					continue;
+
+				int t = 0, i = 0;
+				std::string word;
+				std::istringstream stream(line.substr(text));
+				stream >> word >> t >> word >> i;
+				Assert::IsTrue(t >= 0 && t < kThreads);
+				Assert::IsTrue(i > lastMessage[t]);
+				lastMessage[t] = i;
+				++received;
+			}
+			Assert::AreEqual(uint64_t(kThreads * kPerThread), received + dropped);
+			std::filesystem::remove(path);
+		}
+	};
+}
@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace CoreTest
+{
+	TEST_CLASS(MemoryTrackerTest)
+	{
+	public:
+		TEST_METHOD(RecordTest)
+		{
+			MemoryTracker::Reset();
+			const auto before = MemoryTracker::GetStats(MemoryCategory::General);
+
+			MemoryTracker::RecordAllocation(MemoryCategory::General, 100);
+			MemoryTracker::RecordAllocation(MemoryCategory::General, 100);
+			MemoryTracker::RecordAllocation(MemoryCategory::General, 100);
+			MemoryTracker::RecordFree(MemoryCategory::General, 100);
+
+			auto stats = MemoryTracker::GetStats(MemoryCategory::General);
+			Assert::AreEqual(before.liveBytes + 200, stats.liveBytes);
+			Assert::AreEqual(before.liveBytes + 300, stats.peakBytes);
+			Assert::AreEqual(before.liveCount + 2, stats.liveCount);
+			Assert::AreEqual(uint64_t(3), stats.totalCount);
+
+			MemoryTracker::EndFrame();
+			Assert::AreEqual(uint64_t(3), MemoryTracker::GetStats(MemoryCategory::General).frameCount);
+			MemoryTracker::EndFrame();
+			Assert::AreEqual(uint64_t(0), MemoryTracker::GetStats(MemoryCategory::General).frameCount);
+
+			MemoryTracker::RecordFree(MemoryCategory::General, 100);
+			MemoryTracker::RecordFree(MemoryCategory::General, 100);
+			Assert::AreEqual(before.liveBytes, MemoryTracker::GetStats(MemoryCategory::General).liveBytes);
+		}
+
+		TEST_METHOD(BudgetTest)
+		{
+			const auto live = MemoryTracker::GetStats(MemoryCategory::General).liveBytes;
+			MemoryTracker::SetBudget(MemoryCategory::General, live + 150);
+
+			std::vector<MemoryCategory> overBudget;
+			MemoryTracker::RecordAllocation(MemoryCategory::General, 100);
+			Assert::AreEqual(size_t(0), MemoryTracker::CheckBudgets(overBudget));
+
+			MemoryTracker::RecordAllocation(MemoryCategory::General, 100);
+			Assert::AreEqual(size_t(1), MemoryTracker::CheckBudgets(overBudget));
+			Assert::IsTrue(overBudget[0] == MemoryCategory::General);
+
+			MemoryTracker::RecordFree(MemoryCategory::General, 100);
+			MemoryTracker::RecordFree(MemoryCategory::General, 100);
+			MemoryTracker::SetBudget(MemoryCategory::General, 0);
+		}
+
+		TEST_METHOD(TrackingAllocatorTest)
+		{
+			const auto before = MemoryTracker::GetStats(MemoryCategory::Container).liveBytes;
+			{
+				TrackedVector<int> values;
+				values.reserve(100);
+				Assert::AreEqual(before + static_cast<int64_t>(100 * sizeof(int)), MemoryTracker::GetStats(MemoryCategory::Container).liveBytes);
+			}
+			Assert::AreEqual(before, MemoryTracker::GetStats(MemoryCategory::Container).liveBytes);
+		}
+
+		TEST_METHOD(CallstackTest)
+		{
+			MemoryTracker::Reset();
+			MemoryTracker::SetCallstackSampling(2);
+			for (int i = 0; i < 4; ++i)
+				MemoryTracker::RecordAllocation(MemoryCategory::General, 64);
+			MemoryTracker::SetCallstackSampling(0);
+			for (int i = 0; i < 4; ++i)
+				MemoryTracker::RecordFree(MemoryCategory::General, 64);
+
+			std::vector<MemoryTracker::CallstackSample> samples;
+			MemoryTracker::CollectCallstackSamples(samples);
+			Assert::AreEqual(size_t(2), samples.size());
+			Assert::IsTrue(samples[0].category == MemoryCategory::General);
+			Assert::AreEqual(size_t(64), samples[0].size);
+			Assert::IsTrue(samples[0].frameCount > 0);
+		}
+
+		TEST_METHOD(ExportTest)
+		{
+			const auto path = std::filesystem::temp_directory_path() / "MemoryTrackerTest.json";
+			Assert::IsTrue(MemoryTracker::ExportJson(path));
+
+			std::ifstream file(path);
+			std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			file.close();
+			Assert::IsTrue(json.find("\"name\":\"MeshBuffer\"") != std::string::npos);
+			Assert::IsTrue(json.find("\"samples\"") != std::string::npos);
+			std::filesystem::remove(path);
+		}
+	};
+}
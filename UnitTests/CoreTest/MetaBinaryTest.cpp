@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace
+{
+	struct Stats
+	{
+		META_CLASS_DECLARE(Stats)
+
+		Stats() = default;
+		Stats(int health, int armor, float speed) : health(health), armor(armor), speed(speed) {}
+
+		int health = 0;
+		int armor = 0;
+		float speed = 0.0f;
+	};
+
+	struct Unit
+	{
+		META_CLASS_DECLARE(Unit)
+
+		std::string name;
+		Stats stats;
+		bool alive = false;
+		std::vector<float> path;
+		std::vector<Stats> history;
+	};
+
+	struct Hero : public Unit
+	{
+		META_CLASS_DECLARE(Hero)
+
+		int level = 0;
+		std::filesystem::path portrait;
+	};
+}
+
+META_CLASS_BEGIN(Stats)
+	META_FIELD_BEGIN
+		META_FIELD(health, "Health")
+		META_FIELD(armor, "Armor")
+		META_FIELD(speed, "Speed")
+	META_FIELD_END
+META_CLASS_END
+
+META_CLASS_BEGIN(Unit)
+	META_FIELD_BEGIN
+		META_FIELD(name, "Name")
+		META_FIELD(stats, "Stats")
+		META_FIELD(alive, "Alive")
+		META_FIELD(path, "Path")
+		META_FIELD(history, "History")
+	META_FIELD_END
+META_CLASS_END
+
+META_DERIVED_BEGIN(Hero, Unit)
+	META_FIELD_BEGIN
+		META_FIELD(level, "Level")
+		META_FIELD(portrait, "Portrait")
+	META_FIELD_END
+META_CLASS_END
+
+namespace CoreTest
+{
+	TEST_CLASS(MetaBinaryTest)
+	{
+	public:
+		TEST_METHOD(TestBinaryRuns)
+		{
+			// All three fields are adjacent raw bytes, so they collapse into one copy
+			auto& runs = Stats::StaticGetMetaClass()->GetBinaryRuns();
+			Assert::AreEqual(size_t(1), runs.size());
+			Assert::IsNull(runs[0].type);
+			Assert::AreEqual(sizeof(int) * 2 + sizeof(float), runs[0].size);
+		}
+
+		TEST_METHOD(TestRoundTrip)
+		{
+			Hero hero;
+			hero.name = "A name that does not fit in the small string buffer";
+			hero.stats = Stats(100, 25, 3.5f);
+			hero.alive = true;
+			hero.path = { 1.0f, 2.0f, 3.0f };
+			hero.history = { Stats(1, 2, 3.0f), Stats(4, 5, 6.0f) };
+			hero.level = 7;
+			hero.portrait = "Images/hero.png";
+
+			MemoryWriter writer;
+			Meta::SaveBinary(hero, writer);
+
+			Hero loaded;
+			MemoryReader reader(writer.GetData(), writer.GetSize());
+			Assert::IsTrue(Meta::LoadBinary(loaded, reader));
+			Assert::AreEqual(size_t(0), reader.GetRemaining());
+
+			Assert::AreEqual(hero.name, loaded.name);
+			Assert::AreEqual(100, loaded.stats.health);
+			Assert::AreEqual(25, loaded.stats.armor);
+			Assert::AreEqual(3.5f, loaded.stats.speed);
+			Assert::IsTrue(loaded.alive);
+			Assert::IsTrue(hero.path == loaded.path);
+			Assert::AreEqual(size_t(2), loaded.history.size());
+			Assert::AreEqual(5, loaded.history[1].armor);
+			Assert::AreEqual(7, loaded.level);
+			Assert::IsTrue(hero.portrait == loaded.portrait);
+		}
+
+		TEST_METHOD(TestSchemaMismatch)
+		{
+			Assert::AreNotEqual(Meta::GetSchemaHash(Meta::GetMetaType<Unit>()), Meta::GetSchemaHash(Meta::GetMetaType<Hero>()));
+
+			Unit unit;
+			MemoryWriter writer;
+			Meta::SaveBinary(unit, writer);
+
+			Hero hero;
+			MemoryReader reader(writer.GetData(), writer.GetSize());
+			Assert::IsFalse(Meta::LoadBinary(hero, reader));
+		}
+
+		TEST_METHOD(TestTruncated)
+		{
+			Hero hero;
+			hero.path.resize(100);
+			MemoryWriter writer;
+			Meta::SaveBinary(hero, writer);
+
+			Hero loaded;
+			MemoryReader reader(writer.GetData(), writer.GetSize() / 2);
+			Assert::IsFalse(Meta::LoadBinary(loaded, reader));
+		}
+
+		TEST_METHOD(TestFile)
+		{
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "MetaBinaryTest.bin";
+			Stats stats(1, 2, 3.0f);
+			{
+				FileWriter writer(path);
+				Assert::IsTrue(writer.IsOpen());
+				Meta::SaveBinary(stats, writer);
+			}
+
+			Stats loaded;
+			FileReader reader(path);
+			Assert::IsTrue(Meta::LoadBinary(loaded, reader));
+			Assert::AreEqual(2, loaded.armor);
+			Assert::AreEqual(3.0f, loaded.speed);
+		}
+	};
+}
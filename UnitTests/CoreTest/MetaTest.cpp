@@ -7,7 +7,7 @@ using namespace Angazi::Core;
 class Car
 {
 public:
-	META_CLASS_DECLARE
+	META_CLASS_DECLARE(Car)
 public:
 	void Move() { mPosition += 1.0f; }
 
@@ -19,7 +19,7 @@ protected:
 class Tesla : public Car
 {
 public:
-	META_CLASS_DECLARE
+	META_CLASS_DECLARE(Tesla)
 
 	void Move() { mPosition += 10.0f; }
 protected:
@@ -123,5 +123,23 @@ namespace CoreTest
 			Assert::AreEqual(metaField2->GetName(), "GPS");
 			Assert::IsTrue(metaField2 == metaClass->FindField("GPS"));
 		}
+		TEST_METHOD(TestMetaTypeId)
+		{
+			static_assert(Car::StaticGetTypeId() == HashFnv1a("Car"));
+			static_assert(Car::StaticGetTypeId() != Tesla::StaticGetTypeId());
+
+			Assert::AreEqual(Car::StaticGetTypeId(), Car::StaticGetMetaClass()->GetTypeId());
+			Assert::AreEqual(Tesla::StaticGetTypeId(), Tesla::StaticGetMetaClass()->GetTypeId());
+
+			META_REGISTER(Car);
+			META_REGISTER(Tesla);
+			Assert::IsTrue(Meta::FindMetaClass(Car::StaticGetTypeId()) == Car::StaticGetMetaClass());
+			Assert::IsTrue(Meta::FindMetaClass(Tesla::StaticGetTypeId()) == Tesla::StaticGetMetaClass());
+			Assert::IsTrue(Meta::FindMetaClass("Tesla") == Tesla::StaticGetMetaClass());
+			Assert::IsTrue(Meta::FindMetaClass(HashFnv1a("Bicycle")) == nullptr);
+
+			auto& metaClasses = Meta::GetAllMetaClasses();
+			Assert::IsTrue(std::is_sorted(metaClasses.begin(), metaClasses.end(), [](auto a, auto b) { return strcmp(a->GetName(), b->GetName()) < 0; }));
+		}
 	};
 }
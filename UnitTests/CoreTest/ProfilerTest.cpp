@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Core;
+
+namespace CoreTest
+{
+	TEST_CLASS(ProfilerTest)
+	{
+	public:
+
+		TEST_METHOD(ScopeTest)
+		{
+			Profiler::Clear();
+			{
+				Profiler::ScopedEvent outer("Outer");
+				Profiler::ScopedEvent inner("Inner");
+			}
+
+			std::vector<std::pair<uint32_t, Profiler::Event>> events;
+			Profiler::CollectEvents(events);
+			Assert::AreEqual(size_t(2), events.size());
+
+			// Inner closes first, and nests inside outer
+			const auto& inner = events[0].second;
+			const auto& outer = events[1].second;
+			Assert::AreEqual(std::string("Inner"), std::string(inner.name));
+			Assert::AreEqual(std::string("Outer"), std::string(outer.name));
+			Assert::IsTrue(outer.timestamp <= inner.timestamp);
+			Assert::IsTrue(inner.timestamp + inner.duration <= outer.timestamp + outer.duration);
+		}
+
+		TEST_METHOD(DisabledTest)
+		{
+			Profiler::Clear();
+			Profiler::SetEnabled(false);
+			{
+				Profiler::ScopedEvent scope("Ignored");
+				Profiler::RecordCounter("Ignored", 1.0);
+			}
+			Profiler::SetEnabled(true);
+
+			std::vector<std::pair<uint32_t, Profiler::Event>> events;
+			Profiler::CollectEvents(events);
+			Assert::IsTrue(events.empty());
+		}
+
+		TEST_METHOD(ThreadTest)
+		{
+			Profiler::Clear();
+			Profiler::RecordCounter("Main", 1.0);
+			std::thread worker([]()
+			{
+				Profiler::SetThreadName("Worker");
+				Profiler::RecordCounter("Worker", 2.0);
+			});
+			worker.join();
+
+			std::vector<std::pair<uint32_t, Profiler::Event>> events;
+			Profiler::CollectEvents(events);
+			Assert::AreEqual(size_t(2), events.size());
+			Assert::AreNotEqual(events[0].first, events[1].first);
+		}
+
+		TEST_METHOD(ThreadExitTest)
+		{
+			Profiler::Clear();
+			auto runThread = []()
+			{
+				std::thread worker([]() { Profiler::RecordCounter("ShortLived", 1.0); });
+				worker.join();
+			};
+
+			// The first exited thread's buffer is handed to every later one
+			runThread();
+			std::vector<std::pair<uint32_t, Profiler::Event>> events;
+			Profiler::CollectEvents(events);
+			Assert::AreEqual(size_t(1), events.size());
+			const size_t bufferCount = Profiler::GetThreadBufferCount();
+
+			for (int i = 0; i < 8; ++i)
+			{
+				runThread();
+				events.clear();
+				Profiler::CollectEvents(events);
+				Assert::AreEqual(size_t(1), events.size());
+				Assert::AreEqual(std::string("ShortLived"), std::string(events[0].second.name));
+			}
+			Assert::AreEqual(bufferCount, Profiler::GetThreadBufferCount());
+
+			// Already collected, not returned again
+			events.clear();
+			Profiler::CollectEvents(events);
+			Assert::IsTrue(events.empty());
+		}
+
+		TEST_METHOD(CollectWhileWritingTest)
+		{
+			Profiler::Clear();
+			std::atomic<bool> done{ false };
+			std::thread writer([&done]()
+			{
+				for (size_t i = 0; i < Profiler::kEventsPerThread * 4; ++i)
+					Profiler::RecordCounter("Writer", static_cast<double>(i));
+				done = true;
+			});
+
+			// Torn or lapped events are dropped, whatever comes back is whole and in order
+			bool ordered = true;
+			std::vector<std::pair<uint32_t, Profiler::Event>> events;
+			while (!done)
+			{
+				events.clear();
+				Profiler::CollectEvents(events);
+				const Profiler::Event* last = nullptr;
+				for (auto& [threadIndex, event] : events)
+				{
+					if (std::string(event.name) != "Writer")
+						continue;
+					ordered &= event.type == Profiler::EventType::Counter;
+					ordered &= last == nullptr || (last->value < event.value && last->timestamp <= event.timestamp);
+					last = &event;
+				}
+			}
+			writer.join();
+			Profiler::Clear();
+			Assert::IsTrue(ordered);
+		}
+
+		TEST_METHOD(RingBufferTest)
+		{
+			Profiler::Clear();
+			const size_t total = Profiler::kEventsPerThread + 100;
+			for (size_t i = 0; i < total; ++i)
+				Profiler::RecordCounter("Count", static_cast<double>(i));
+
+			// Only the newest events are kept, oldest first
+			std::vector<std::pair<uint32_t, Profiler::Event>> events;
+			Profiler::CollectEvents(events);
+			Assert::AreEqual(Profiler::kEventsPerThread, events.size());
+			Assert::AreEqual(100.0, events.front().second.value);
+			Assert::AreEqual(static_cast<double>(total - 1), events.back().second.value);
+		}
+
+		TEST_METHOD(ExportTest)
+		{
+			Profiler::Clear();
+			Profiler::MarkFrame();
+			{
+				PROFILE_SCOPE("Export \"quoted\"");
+				PROFILE_COUNTER("Value", 42);
+			}
+
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "ProfilerTest.json";
+			Assert::IsTrue(Profiler::ExportChromeTrace(path));
+
+			std::ifstream file(path);
+			std::stringstream text;
+			text << file.rdbuf();
+			rapidjson::Document document;
+			document.Parse(text.str().c_str());
+			Assert::IsFalse(document.HasParseError());
+			Assert::IsTrue(document["traceEvents"].IsArray());
+			Assert::IsTrue(document["traceEvents"].Size() >= 3);
+		}
+	};
+}
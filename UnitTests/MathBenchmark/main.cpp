@@ -0,0 +1,900 @@
+// Math benchmarks. Runs without a window or graphics device.
+//
+// Every kernel runs over the same inputs twice, once through the scalar reference in
+// Math::Scalar and once through the public function, which takes the SIMD path when the
+// build has one. Reports the median time per operation and the speedup.
+//
+// The batch section compares a loop over the single vector functions with Math::Batch, in
+// AoS and SoA layout, first on one thread and then with the JobSystem running. The cull
+// section does the same for Intersect against a frustum and Math::Batch::Cull. The random
+// section compares std::mt19937 with a distribution per call, the way RandomFloat used to
+// work, against RandomStream one value at a time and in bulk. The ray cast section times
+// ray against shape tests as a scalar loop, one ray against a Math::Batch shape set, and
+// packets of rays against it. The raycast2d section does the same for segment queries
+// against 2D walls and obstacles, next to the nested Intersect loops. The BVH section times
+// builds on one thread and with the JobSystem, and compares queries through the tree with a
+// loop over every shape. The interpolation section compares Slerp with FastSlerp and Nlerp, one at a time and through
+// Math::Batch. The quantize section compares the single value encoders and decoders with
+// Math::Batch. The intersect section times the single shape against shape tests.
+//
+// Every measurement runs once untimed and then -repeat times. The tables show the median,
+// -stats adds min, percentiles and mean for all of them and -json writes the same to a file
+// for tracking results across commits. Math and the parts of Core it uses build without
+// Windows, so the benchmark also builds on Linux from the repository root with
+//
+//     g++ -std=c++17 -O2 -pthread -IFramework -IFramework/Math/Inc -IFramework/Core/Inc
+//         -IExternal -o MathBenchmark UnitTests/MathBenchmark/main.cpp
+//         Framework/Math/Src/{Batch,BVH,EngineMath,Random,ShapeSoA}.cpp
+//         Framework/Core/Src/{DebugUtil,JobSystem,Logger,Profiler,TimeUtil}.cpp
+//
+// Math/Inc has to come before Core/Inc, both have a Common.h and the Math one includes Core.
+
+#include <Math/Inc/EngineMath.h>
+
+using namespace Angazi;
+using namespace Angazi::Core;
+using namespace Angazi::Math;
+
+struct Arguments
+{
+	const char* jsonFileName = nullptr;
+	const char* sectionFilter = nullptr;
+	const char* label = "";
+	size_t count = 4096;
+	size_t batchCount = 1 << 20;
+	int repeats = 25;
+	bool printStats = false;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Spread of the timed runs of one measurement, in ns per operation
+struct Stats
+{
+	double min = 0.0;
+	double p10 = 0.0;
+	double median = 0.0;
+	double p90 = 0.0;
+	double p99 = 0.0;
+	double max = 0.0;
+	double mean = 0.0;
+};
+
+struct Measurement
+{
+	std::string section;
+	std::string name;
+	std::string variant;
+	uint32_t threads = 1;
+	size_t ops = 0;
+	int samples = 0;
+	Stats stats;
+};
+
+std::vector<Measurement> sMeasurements;
+const char* sSection = "";
+
+// Linear interpolation between the closest ranks, times must be sorted
+double Percentile(const std::vector<double>& times, double p)
+{
+	const double rank = p * (times.size() - 1);
+	const size_t lower = static_cast<size_t>(rank);
+	const size_t upper = std::min(lower + 1, times.size() - 1);
+	return times[lower] + (times[upper] - times[lower]) * (rank - lower);
+}
+
+// Times fn, which does count operations per call, and records it under the current section.
+// Returns the median ns per operation for the section table.
+template <class Fn>
+double Measure(const Arguments& args, const char* name, const char* variant, uint32_t threads, size_t count, Fn&& fn)
+{
+	// Untimed first run so cold caches and lazy setup do not land in the sample
+	fn();
+
+	std::vector<double> times;
+	for (int i = 0; i < args.repeats; ++i)
+	{
+		const auto start = Clock::now();
+		fn();
+		times.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count);
+	}
+	std::sort(times.begin(), times.end());
+
+	Measurement& measurement = sMeasurements.emplace_back();
+	measurement.section = sSection;
+	measurement.name = name;
+	measurement.variant = variant;
+	measurement.threads = threads;
+	measurement.ops = count;
+	measurement.samples = args.repeats;
+	measurement.stats.min = times.front();
+	measurement.stats.p10 = Percentile(times, 0.1);
+	measurement.stats.median = Percentile(times, 0.5);
+	measurement.stats.p90 = Percentile(times, 0.9);
+	measurement.stats.p99 = Percentile(times, 0.99);
+	measurement.stats.max = times.back();
+	measurement.stats.mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+	return measurement.stats.median;
+}
+
+const char* GetBackendName()
+{
+#if defined(MATH_SIMD_AVX2)
+	return "AVX2";
+#elif defined(MATH_SIMD_SSE)
+	return "SSE";
+#elif defined(MATH_SIMD_NEON)
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
+
+struct Inputs
+{
+	std::vector<Matrix4> matrices;
+	std::vector<Matrix4> others;
+	std::vector<Vector3> points;
+	std::vector<Vector4> vectors;
+	std::vector<Quaternion> rotations;
+};
+
+Inputs MakeInputs(size_t count)
+{
+	Inputs inputs;
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Quaternion rotation = Normalize(Quaternion(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)));
+		inputs.matrices.push_back(Matrix4::Transform(RandomVector3({ -10.0f, -10.0f, -10.0f }, { 10.0f, 10.0f, 10.0f }), rotation, RandomVector3({ 0.5f, 0.5f, 0.5f }, { 2.0f, 2.0f, 2.0f })));
+		inputs.others.push_back(Matrix4::RotationAxis(RandomUnitSphere(), RandomFloat(0.0f, Constants::TwoPi)));
+		inputs.points.push_back(RandomVector3());
+		inputs.vectors.push_back({ RandomFloat(), RandomFloat(), RandomFloat(), 1.0f });
+		inputs.rotations.push_back(rotation);
+	}
+	return inputs;
+}
+
+template <class ScalarFn, class SIMDFn>
+void Report(const char* name, const Arguments& args, ScalarFn&& scalarFn, SIMDFn&& simdFn)
+{
+	const double scalar = Measure(args, name, "Scalar", 1, args.count, scalarFn);
+	const double simd = Measure(args, name, "SIMD", 1, args.count, simdFn);
+	printf("%-20s %12.2f %12.2f %9.2fx\n", name, scalar, simd, scalar / simd);
+}
+
+void RunKernels(const Arguments& args)
+{
+	const Inputs in = MakeInputs(args.count);
+	std::vector<Matrix4> matrices(args.count);
+	std::vector<Vector3> points(args.count);
+	std::vector<Vector4> vectors(args.count);
+	std::vector<Quaternion> rotations(args.count);
+
+	printf("\n== Math kernels (%s, %zu ops per run, median of %d) ==\n", GetBackendName(), args.count, args.repeats);
+	printf("%-20s %12s %12s %10s\n", "Kernel", "Scalar ns", "SIMD ns", "Speedup");
+
+	const size_t n = args.count;
+	Report("Matrix4 * Matrix4", args,
+		[&]() { for (size_t i = 0; i < n; ++i) matrices[i] = Scalar::Multiply(in.matrices[i], in.others[i]); },
+		[&]() { for (size_t i = 0; i < n; ++i) matrices[i] = in.matrices[i] * in.others[i]; });
+	Report("Inverse", args,
+		[&]() { for (size_t i = 0; i < n; ++i) matrices[i] = Scalar::Inverse(in.matrices[i]); },
+		[&]() { for (size_t i = 0; i < n; ++i) matrices[i] = Inverse(in.matrices[i]); });
+	Report("InverseAffine", args,
+		[&]() { for (size_t i = 0; i < n; ++i) matrices[i] = Scalar::InverseAffine(in.matrices[i]); },
+		[&]() { for (size_t i = 0; i < n; ++i) matrices[i] = InverseAffine(in.matrices[i]); });
+	Report("TransformCoord", args,
+		[&]() { for (size_t i = 0; i < n; ++i) points[i] = Scalar::TransformCoord(in.points[i], in.matrices[i]); },
+		[&]() { for (size_t i = 0; i < n; ++i) points[i] = TransformCoord(in.points[i], in.matrices[i]); });
+	Report("TransformNormal", args,
+		[&]() { for (size_t i = 0; i < n; ++i) points[i] = Scalar::TransformNormal(in.points[i], in.matrices[i]); },
+		[&]() { for (size_t i = 0; i < n; ++i) points[i] = TransformNormal(in.points[i], in.matrices[i]); });
+	Report("Transform Vector4", args,
+		[&]() { for (size_t i = 0; i < n; ++i) vectors[i] = Scalar::Transform(in.vectors[i], in.matrices[i]); },
+		[&]() { for (size_t i = 0; i < n; ++i) vectors[i] = Transform(in.vectors[i], in.matrices[i]); });
+	Report("Quaternion * Quat", args,
+		[&]() { for (size_t i = 0; i < n; ++i) rotations[i] = Scalar::Multiply(in.rotations[i], rotations[i]); },
+		[&]() { for (size_t i = 0; i < n; ++i) rotations[i] = in.rotations[i] * rotations[i]; });
+
+	// Keep the results alive so the loops are not optimized away
+	float checksum = 0.0f;
+	for (size_t i = 0; i < n; ++i)
+		checksum += matrices[i]._41 + points[i].x + vectors[i].w + rotations[i].w;
+	printf("checksum %f\n", checksum);
+}
+
+void RunBatchKernels(const Arguments& args)
+{
+	const size_t n = args.batchCount;
+	std::vector<Vector3> points(n), results(n);
+	std::vector<float> x(n), y(n), z(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		points[i] = RandomVector3({ -10.0f, -10.0f, -10.0f }, { 10.0f, 10.0f, 10.0f });
+		x[i] = points[i].x;
+		y[i] = points[i].y;
+		z[i] = points[i].z;
+	}
+	const Matrix4 m = Matrix4::Transform({ 1.0f, 2.0f, 3.0f }, Quaternion::RotationAxis(Vector3::YAxis, 0.5f), Vector3::One);
+	const Vector3SoA soa{ x.data(), y.data(), z.data() };
+	std::vector<float> ox(n), oy(n), oz(n);
+	const Vector3SoA soaOut{ ox.data(), oy.data(), oz.data() };
+
+	printf("\n== Batch kernels (%zu vectors, median of %d) ==\n", n, args.repeats);
+	printf("%-20s %8s %12s %12s %12s\n", "Kernel", "Threads", "Loop ns", "AoS ns", "SoA ns");
+
+	const auto run = [&](uint32_t threads)
+	{
+		const auto report = [&](const char* name, auto&& loop, auto&& aos, auto&& soa)
+		{
+			// Braces run the measurements in order, function arguments would not
+			const double times[] =
+			{
+				Measure(args, name, "Loop", threads, n, loop),
+				Measure(args, name, "AoS", threads, n, aos),
+				Measure(args, name, "SoA", threads, n, soa)
+			};
+			printf("%-20s %8u %12.3f %12.3f %12.3f\n", name, threads, times[0], times[1], times[2]);
+		};
+		report("TransformCoord",
+			[&]() { for (size_t i = 0; i < n; ++i) results[i] = TransformCoord(points[i], m); },
+			[&]() { Batch::TransformCoord(points.data(), results.data(), n, m); },
+			[&]() { Batch::TransformCoord(soa, soaOut, n, m); });
+		report("TransformNormal",
+			[&]() { for (size_t i = 0; i < n; ++i) results[i] = TransformNormal(points[i], m); },
+			[&]() { Batch::TransformNormal(points.data(), results.data(), n, m); },
+			[&]() { Batch::TransformNormal(soa, soaOut, n, m); });
+		report("Normalize",
+			[&]() { for (size_t i = 0; i < n; ++i) results[i] = Normalize(points[i]); },
+			[&]() { Batch::Normalize(points.data(), results.data(), n); },
+			[&]() { Batch::Normalize(soa, soaOut, n); });
+		report("Dot",
+			[&]() { for (size_t i = 0; i < n; ++i) ox[i] = Dot(points[i], results[i]); },
+			[&]() { Batch::Dot(points.data(), results.data(), ox.data(), n); },
+			[&]() { Batch::Dot(soa, soaOut, ox.data(), n); });
+	};
+
+	run(1);
+	JobSystem::StaticInitialize();
+	run(JobSystem::Get()->GetThreadCount());
+	JobSystem::StaticTerminate();
+}
+
+void RunCullKernels(const Arguments& args)
+{
+	const size_t n = args.batchCount;
+	std::vector<Sphere> spheres(n);
+	std::vector<AABB> aabbs(n);
+	std::vector<OBB> obbs(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		// Neighbouring objects are close together, as they would be in a scene sorted by cell
+		const float side = std::cbrt(static_cast<float>(n));
+		const float x = std::fmod(static_cast<float>(i), side);
+		const float y = std::fmod(std::floor(i / side), side);
+		const float z = std::floor(i / (side * side));
+		const Vector3 center = Vector3{ x, y, z } * (200.0f / side) - Vector3{ 100.0f, 100.0f, 100.0f };
+		spheres[i] = { center, 1.0f };
+		aabbs[i] = { center, Vector3::One };
+		obbs[i] = { center, Vector3::One, Quaternion::RotationAxis(RandomUnitSphere(), RandomFloat(0.0f, Constants::TwoPi)) };
+	}
+	const Matrix4 projection
+	{
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 1.0f,
+		0.0f, 0.0f, -1.0f, 0.0f
+	};
+	const Frustum frustum = Frustum::FromViewProjection(projection);
+	std::vector<uint32_t> mask((n + 31) / 32);
+	std::vector<uint8_t> planeCache(n, 0);
+
+	printf("\n== Cull kernels (%zu objects, median of %d) ==\n", n, args.repeats);
+	printf("%-20s %8s %12s %12s %12s\n", "Kernel", "Threads", "Loop ns", "Batch ns", "Cached ns");
+
+	const auto run = [&](uint32_t threads)
+	{
+		const auto report = [&](const char* name, const auto& shapes)
+		{
+			const auto loop = [&]()
+			{
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (Intersect(frustum, shapes[i]))
+						mask[i / 32] |= 1u << (i % 32);
+				}
+			};
+			const double times[] =
+			{
+				Measure(args, name, "Loop", threads, n, loop),
+				Measure(args, name, "Batch", threads, n, [&]() { Batch::Cull(frustum, shapes.data(), n, mask.data()); }),
+				Measure(args, name, "Cached", threads, n, [&]() { Batch::Cull(frustum, shapes.data(), n, mask.data(), planeCache.data()); })
+			};
+			printf("%-20s %8u %12.3f %12.3f %12.3f\n", name, threads, times[0], times[1], times[2]);
+		};
+		report("Cull Sphere", spheres);
+		report("Cull AABB", aabbs);
+		report("Cull OBB", obbs);
+	};
+
+	run(1);
+	JobSystem::StaticInitialize();
+	run(JobSystem::Get()->GetThreadCount());
+	JobSystem::StaticTerminate();
+}
+
+void RunRandomKernels(const Arguments& args)
+{
+	const size_t n = args.batchCount;
+	std::vector<float> values(n);
+	std::mt19937 engine{ 1234 };
+	RandomStream stream{ 1234 };
+
+	printf("\n== Random (%zu values, median of %d) ==\n", n, args.repeats);
+	printf("%-20s %12s %12s %12s\n", "Kernel", "mt19937 ns", "Stream ns", "Fill ns");
+	const double uniform[] =
+	{
+		Measure(args, "Uniform", "mt19937", 1, n, [&]() { for (auto& v : values) v = std::uniform_real_distribution<float>{ 0.0f, 1.0f }(engine); }),
+		Measure(args, "Uniform", "Stream", 1, n, [&]() { for (auto& v : values) v = stream.NextFloat(); }),
+		Measure(args, "Uniform", "Fill", 1, n, [&]() { stream.FillUniform(values.data(), n); })
+	};
+	printf("%-20s %12.3f %12.3f %12.3f\n", "Uniform", uniform[0], uniform[1], uniform[2]);
+	const double normal[] =
+	{
+		Measure(args, "Normal", "mt19937", 1, n, [&]() { for (auto& v : values) v = std::normal_distribution<float>{ 0.0f, 1.0f }(engine); }),
+		Measure(args, "Normal", "Stream", 1, n, [&]() { for (auto& v : values) v = stream.NextNormal(); }),
+		Measure(args, "Normal", "Fill", 1, n, [&]() { stream.FillNormal(values.data(), n); })
+	};
+	printf("%-20s %12.3f %12.3f %12.3f\n", "Normal", normal[0], normal[1], normal[2]);
+	printf("checksum %f\n", values[n / 2]);
+}
+
+void RunRaycastKernels(const Arguments& args)
+{
+	const size_t rayCount = 256;
+	const size_t shapeCount = 1024;
+	std::vector<Ray> rays(rayCount);
+	for (auto& ray : rays)
+		ray = { RandomUnitSphere() * 50.0f, RandomUnitSphere() };
+	std::vector<Sphere> spheres;
+	std::vector<OBB> obbs;
+	SphereSoA sphereSet;
+	AABBSoA aabbSet;
+	OBBSoA obbSet;
+	PlaneSoA planeSet;
+	std::vector<Plane> planes;
+	for (size_t i = 0; i < shapeCount; ++i)
+	{
+		const Vector3 center = RandomVector3({ -20.0f, -20.0f, -20.0f }, { 20.0f, 20.0f, 20.0f });
+		spheres.push_back({ center, 1.0f });
+		obbs.push_back({ center, Vector3::One, Quaternion::RotationAxis(RandomUnitSphere(), RandomFloat(0.0f, Constants::TwoPi)) });
+		planes.push_back({ RandomUnitSphere(), RandomFloat(-20.0f, 20.0f) });
+		sphereSet.Add(spheres.back());
+		aabbSet.Add({ center, Vector3::One });
+		obbSet.Add(obbs.back());
+		planeSet.Add(planes.back());
+	}
+	std::vector<RayHit> hits(rayCount);
+	float checksum = 0.0f;
+
+	printf("\n== Ray casts (%zu rays x %zu shapes, ns per test, median of %d) ==\n", rayCount, shapeCount, args.repeats);
+	printf("%-20s %12s %12s %12s\n", "Kernel", "Loop ns", "Single ns", "Packet ns");
+
+	const size_t tests = rayCount * shapeCount;
+	const auto report = [&](const char* name, auto&& loop, const auto& set)
+	{
+		const double times[] =
+		{
+			Measure(args, name, "Loop", 1, tests, loop),
+			Measure(args, name, "Single", 1, tests, [&]() { for (size_t r = 0; r < rayCount; ++r) hits[r] = Batch::Raycast(rays[r], set); }),
+			Measure(args, name, "Packet", 1, tests, [&]() { Batch::Raycast(rays.data(), rayCount, set, hits.data()); })
+		};
+		printf("%-20s %12.3f %12.3f %12.3f\n", name, times[0], times[1], times[2]);
+		for (auto& hit : hits)
+			checksum += hit.IsHit() ? hit.distance : 0.0f;
+	};
+	report("Sphere", [&]()
+	{
+		for (auto& ray : rays)
+		{
+			for (auto& sphere : spheres)
+			{
+				const Vector3 p = ray.origin - sphere.center;
+				const float b = Dot(p, ray.direction);
+				const float discriminant = b * b - (Dot(p, p) - sphere.radius * sphere.radius);
+				if (discriminant >= 0.0f)
+					checksum += -b - sqrtf(discriminant);
+			}
+		}
+	}, sphereSet);
+	report("AABB", [&]()
+	{
+		for (auto& ray : rays)
+		{
+			for (size_t i = 0; i < shapeCount; ++i)
+			{
+				const Vector3 min = spheres[i].center - Vector3::One, max = spheres[i].center + Vector3::One;
+				float tNear = 0.0f, tFar = std::numeric_limits<float>::max();
+				for (size_t axis = 0; axis < 3; ++axis)
+				{
+					const float t0 = (min.v[axis] - ray.origin.v[axis]) / ray.direction.v[axis];
+					const float t1 = (max.v[axis] - ray.origin.v[axis]) / ray.direction.v[axis];
+					tNear = Max(tNear, Min(t0, t1));
+					tFar = Min(tFar, Max(t0, t1));
+				}
+				if (tNear <= tFar)
+					checksum += tNear;
+			}
+		}
+	}, aabbSet);
+	report("OBB", [&]()
+	{
+		Vector3 point, normal;
+		for (auto& ray : rays)
+			for (auto& obb : obbs)
+				if (GetContactPoint(ray, obb, point, normal))
+					checksum += point.x;
+	}, obbSet);
+	report("Plane", [&]()
+	{
+		float distance;
+		for (auto& ray : rays)
+			for (auto& plane : planes)
+				if (Intersect(ray, plane, distance))
+					checksum += distance;
+	}, planeSet);
+	printf("checksum %f\n", checksum);
+}
+
+void RunRaycast2DKernels(const Arguments& args)
+{
+	const size_t queryCount = 256;
+	const size_t shapeCount = 1024;
+	std::vector<LineSegment> queries(queryCount);
+	std::vector<Ray2D> rays(queryCount);
+	for (size_t i = 0; i < queryCount; ++i)
+	{
+		queries[i] = { RandomVector2({ -40.0f, -40.0f }, { 40.0f, 40.0f }), RandomVector2({ -40.0f, -40.0f }, { 40.0f, 40.0f }) };
+		rays[i] = { queries[i].from, queries[i].to - queries[i].from };
+	}
+	std::vector<LineSegment> walls;
+	std::vector<Circle> obstacles;
+	LineSegmentSoA wallSet;
+	CircleSoA obstacleSet;
+	for (size_t i = 0; i < shapeCount; ++i)
+	{
+		const Vector2 center = RandomVector2({ -40.0f, -40.0f }, { 40.0f, 40.0f });
+		walls.push_back({ center, center + RandomUnitCircle() * 2.0f });
+		obstacles.push_back({ center, 0.5f });
+		wallSet.Add(walls.back());
+		obstacleSet.Add(obstacles.back());
+	}
+	std::vector<RayHit2D> hits(queryCount);
+	std::vector<uint32_t> hitMask((queryCount + 31) / 32);
+	size_t checksum = 0;
+
+	printf("\n== 2D queries (%zu segments x %zu shapes, ns per test, median of %d) ==\n", queryCount, shapeCount, args.repeats);
+	printf("%-20s %12s %12s %12s %12s %12s\n", "Kernel", "Loop ns", "Single ns", "Packet ns", "Any ns", "AnyPacket ns");
+
+	// The loops are the nested Intersect calls gameplay code makes today, testing every pair.
+	// They only answer whether two shapes touch, the any hit versions stop at the first hit.
+	const size_t tests = queryCount * shapeCount;
+	const auto report = [&](const char* name, auto&& loop, const auto& set)
+	{
+		const double times[] =
+		{
+			Measure(args, name, "Loop", 1, tests, loop),
+			Measure(args, name, "Single", 1, tests, [&]() { for (size_t q = 0; q < queryCount; ++q) hits[q] = Batch::Raycast(queries[q], set); }),
+			Measure(args, name, "Packet", 1, tests, [&]() { Batch::Raycast(rays.data(), queryCount, set, hits.data(), 1.0f); }),
+			Measure(args, name, "AnyHit", 1, tests, [&]() { for (size_t q = 0; q < queryCount; ++q) checksum += Batch::AnyHit(queries[q], set); }),
+			Measure(args, name, "AnyHitPacket", 1, tests, [&]() { Batch::AnyHit(rays.data(), queryCount, set, hitMask.data(), 1.0f); })
+		};
+		printf("%-20s %12.3f %12.3f %12.3f %12.3f %12.3f\n", name, times[0], times[1], times[2], times[3], times[4]);
+		for (auto& hit : hits)
+			checksum += hit.index;
+		for (uint32_t word : hitMask)
+			checksum += word;
+	};
+	report("Segment", [&]()
+	{
+		for (auto& query : queries)
+		{
+			for (auto& wall : walls)
+			{
+				if (Intersect(query, wall))
+					++checksum;
+			}
+		}
+	}, wallSet);
+	report("Circle", [&]()
+	{
+		for (auto& query : queries)
+		{
+			for (auto& obstacle : obstacles)
+			{
+				if (Intersect(query, obstacle))
+					++checksum;
+			}
+		}
+	}, obstacleSet);
+	printf("checksum %zu\n", checksum);
+}
+
+void RunBVHKernels(const Arguments& args)
+{
+	const size_t queryCount = 256;
+	std::vector<Ray> rays(queryCount);
+	std::vector<AABB> boxes(queryCount);
+	std::vector<Sphere> spheres(queryCount);
+	for (size_t i = 0; i < queryCount; ++i)
+	{
+		const Vector3 origin = RandomUnitSphere() * 150.0f;
+		rays[i] = { origin, Normalize(RandomVector3({ -50.0f, -50.0f, -50.0f }, { 50.0f, 50.0f, 50.0f }) - origin) };
+		boxes[i] = { RandomVector3({ -100.0f, -100.0f, -100.0f }, { 100.0f, 100.0f, 100.0f }), { 4.0f, 4.0f, 4.0f } };
+		spheres[i] = { boxes[i].center, 4.0f };
+	}
+	size_t checksum = 0;
+
+	printf("\n== BVH (%zu queries, median of %d) ==\n", queryCount, args.repeats);
+	printf("%-20s %12s %12s %12s %12s\n", "Shapes", "Build ms", "Jobs ms", "Loop ns", "Tree ns");
+	for (size_t shapeCount : { size_t(1024), size_t(16384), size_t(131072) })
+	{
+		SphereSoA set;
+		std::vector<AABB> bounds;
+		for (size_t i = 0; i < shapeCount; ++i)
+		{
+			const Sphere sphere(RandomVector3({ -100.0f, -100.0f, -100.0f }, { 100.0f, 100.0f, 100.0f }), RandomFloat(0.2f, 1.5f));
+			set.Add(sphere);
+			bounds.push_back(GetBounds(sphere));
+		}
+
+		// Builds are recorded as one operation each, the table shows them in ms
+		char name[32];
+		snprintf(name, sizeof(name), "%zu Build", shapeCount);
+		BVH bvh;
+		const double build = Measure(args, name, "Serial", 1, 1, [&]() { bvh.Build(set); });
+		JobSystem::StaticInitialize();
+		const double parallelBuild = Measure(args, name, "Jobs", JobSystem::Get()->GetThreadCount(), 1, [&]() { bvh.Build(set); });
+		JobSystem::StaticTerminate();
+
+		snprintf(name, sizeof(name), "%zu ray", shapeCount);
+		const double rayTimes[] =
+		{
+			Measure(args, name, "Loop", 1, queryCount, [&]() { for (auto& ray : rays) checksum += Batch::Raycast(ray, set).index; }),
+			Measure(args, name, "Tree", 1, queryCount, [&]() { for (auto& ray : rays) checksum += Batch::Raycast(ray, bvh, set).index; })
+		};
+		printf("%-20s %12.3f %12.3f %12.1f %12.1f\n", name, build * 1e-6, parallelBuild * 1e-6, rayTimes[0], rayTimes[1]);
+
+		const auto overlaps = [](const AABB& a, const AABB& b)
+		{
+			const Vector3 d = a.center - b.center, e = a.extend + b.extend;
+			return Abs(d.x) <= e.x && Abs(d.y) <= e.y && Abs(d.z) <= e.z;
+		};
+		snprintf(name, sizeof(name), "%zu AABB", shapeCount);
+		const double boxTimes[] =
+		{
+			Measure(args, name, "Loop", 1, queryCount, [&]() { for (auto& box : boxes) for (auto& b : bounds) checksum += overlaps(box, b); }),
+			Measure(args, name, "Tree", 1, queryCount, [&]() { for (auto& box : boxes) bvh.Query(box, [&](uint32_t) { ++checksum; }); })
+		};
+		printf("%-20s %12s %12s %12.1f %12.1f\n", name, "", "", boxTimes[0], boxTimes[1]);
+
+		snprintf(name, sizeof(name), "%zu Sphere", shapeCount);
+		const double sphereTimes[] =
+		{
+			Measure(args, name, "Loop", 1, queryCount, [&]() { for (auto& sphere : spheres) for (auto& b : bounds) checksum += MagnitudeSqr(sphere.center - b.center) <= Sqr(sphere.radius + b.extend.x); }),
+			Measure(args, name, "Tree", 1, queryCount, [&]() { for (auto& sphere : spheres) bvh.Query(sphere, [&](uint32_t) { ++checksum; }); })
+		};
+		printf("%-20s %12s %12s %12.1f %12.1f\n", name, "", "", sphereTimes[0], sphereTimes[1]);
+
+		// Refit after everything moved, the tree keeps its shape
+		for (auto& b : bounds)
+			b.center += Vector3(0.1f, 0.0f, -0.1f);
+		snprintf(name, sizeof(name), "%zu Refit", shapeCount);
+		printf("%-20s %12.3f\n", name, Measure(args, name, "Serial", 1, 1, [&]() { bvh.Refit(bounds.data()); }) * 1e-6);
+	}
+	printf("checksum %zu\n", checksum);
+}
+
+void RunInterpolationKernels(const Arguments& args)
+{
+	const size_t n = args.batchCount;
+	std::vector<Quaternion> from(n), to(n), results(n);
+	std::vector<float> t(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		from[i] = Normalize(Quaternion(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)));
+		to[i] = Normalize(Quaternion(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)));
+		t[i] = RandomFloat();
+	}
+
+	printf("\n== Interpolation (%zu quaternions, median of %d) ==\n", n, args.repeats);
+	printf("%-20s %8s %12s %12s %12s\n", "Kernel", "Threads", "Slerp ns", "Loop ns", "Batch ns");
+
+	const auto run = [&](uint32_t threads)
+	{
+		const double slerp = Measure(args, "Slerp", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) results[i] = Slerp(from[i], to[i], t[i]); });
+		const double fastSlerp[] =
+		{
+			Measure(args, "FastSlerp", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) results[i] = FastSlerp(from[i], to[i], t[i]); }),
+			Measure(args, "FastSlerp", "Batch", threads, n, [&]() { Batch::Slerp(from.data(), to.data(), t.data(), results.data(), n); })
+		};
+		printf("%-20s %8u %12.3f %12.3f %12.3f\n", "FastSlerp", threads, slerp, fastSlerp[0], fastSlerp[1]);
+		const double nlerp[] =
+		{
+			Measure(args, "Nlerp", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) results[i] = Nlerp(from[i], to[i], t[i]); }),
+			Measure(args, "Nlerp", "Batch", threads, n, [&]() { Batch::Nlerp(from.data(), to.data(), t.data(), results.data(), n); })
+		};
+		printf("%-20s %8u %12.3f %12.3f %12.3f\n", "Nlerp", threads, slerp, nlerp[0], nlerp[1]);
+	};
+
+	run(1);
+	JobSystem::StaticInitialize();
+	run(JobSystem::Get()->GetThreadCount());
+	JobSystem::StaticTerminate();
+	printf("checksum %f\n", results[n / 2].w);
+}
+
+void RunQuantizeKernels(const Arguments& args)
+{
+	const size_t n = args.batchCount;
+	std::vector<float> floats(n), decodedFloats(n);
+	std::vector<Vector3> normals(n), decodedNormals(n);
+	std::vector<Quaternion> rotations(n), decodedRotations(n);
+	std::vector<uint16_t> halfs(n);
+	std::vector<int16_t> snorms(n);
+	std::vector<uint32_t> packed(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		floats[i] = RandomFloat(-1.0f, 1.0f);
+		normals[i] = RandomUnitSphere();
+		rotations[i] = Normalize(Quaternion(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)));
+	}
+
+	printf("\n== Quantize (%zu values, median of %d) ==\n", n, args.repeats);
+	printf("%-20s %8s %12s %12s\n", "Kernel", "Threads", "Loop ns", "Batch ns");
+
+	const auto run = [&](uint32_t threads)
+	{
+		const auto print = [&](const char* name, const double(&times)[2]) { printf("%-20s %8u %12.3f %12.3f\n", name, threads, times[0], times[1]); };
+		const double toHalf[] =
+		{
+			Measure(args, "FloatToHalf", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) halfs[i] = FloatToHalf(floats[i]); }),
+			Measure(args, "FloatToHalf", "Batch", threads, n, [&]() { Batch::FloatToHalf(floats.data(), halfs.data(), n); })
+		};
+		print("FloatToHalf", toHalf);
+		const double fromHalf[] =
+		{
+			Measure(args, "HalfToFloat", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) decodedFloats[i] = HalfToFloat(halfs[i]); }),
+			Measure(args, "HalfToFloat", "Batch", threads, n, [&]() { Batch::HalfToFloat(halfs.data(), decodedFloats.data(), n); })
+		};
+		print("HalfToFloat", fromHalf);
+		const double toSNorm[] =
+		{
+			Measure(args, "ToSNorm16", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) snorms[i] = ToSNorm16(floats[i]); }),
+			Measure(args, "ToSNorm16", "Batch", threads, n, [&]() { Batch::ToSNorm16(floats.data(), snorms.data(), n); })
+		};
+		print("ToSNorm16", toSNorm);
+		const double encodeNormal[] =
+		{
+			Measure(args, "EncodeOctahedral", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) packed[i] = EncodeOctahedral(normals[i]); }),
+			Measure(args, "EncodeOctahedral", "Batch", threads, n, [&]() { Batch::EncodeOctahedral(normals.data(), packed.data(), n); })
+		};
+		print("EncodeOctahedral", encodeNormal);
+		const double decodeNormal[] =
+		{
+			Measure(args, "DecodeOctahedral", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) decodedNormals[i] = DecodeOctahedral(packed[i]); }),
+			Measure(args, "DecodeOctahedral", "Batch", threads, n, [&]() { Batch::DecodeOctahedral(packed.data(), decodedNormals.data(), n); })
+		};
+		print("DecodeOctahedral", decodeNormal);
+		const double encodeRotation[] =
+		{
+			Measure(args, "EncodeQuaternion", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) packed[i] = EncodeQuaternion(rotations[i]); }),
+			Measure(args, "EncodeQuaternion", "Batch", threads, n, [&]() { Batch::EncodeQuaternion(rotations.data(), packed.data(), n); })
+		};
+		print("EncodeQuaternion", encodeRotation);
+		const double decodeRotation[] =
+		{
+			Measure(args, "DecodeQuaternion", "Loop", threads, n, [&]() { for (size_t i = 0; i < n; ++i) decodedRotations[i] = DecodeQuaternion(packed[i]); }),
+			Measure(args, "DecodeQuaternion", "Batch", threads, n, [&]() { Batch::DecodeQuaternion(packed.data(), decodedRotations.data(), n); })
+		};
+		print("DecodeQuaternion", decodeRotation);
+	};
+
+	run(1);
+	JobSystem::StaticInitialize();
+	run(JobSystem::Get()->GetThreadCount());
+	JobSystem::StaticTerminate();
+	printf("checksum %f %f %f\n", decodedFloats[n / 2], decodedNormals[n / 2].x, decodedRotations[n / 2].w);
+}
+
+void RunIntersectKernels(const Arguments& args)
+{
+	const size_t n = args.count;
+	std::vector<Ray> rays(n);
+	std::vector<Plane> planes(n);
+	std::vector<OBB> obbs(n);
+	std::vector<LineSegment> segments(n), otherSegments(n);
+	std::vector<Circle> circles(n), otherCircles(n);
+	std::vector<Rect> rects(n), otherRects(n);
+	const auto randomRect = []()
+	{
+		const Vector2 min = RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f });
+		return Rect(min.x, min.y, min.x + RandomFloat(0.5f, 4.0f), min.y + RandomFloat(0.5f, 4.0f));
+	};
+	for (size_t i = 0; i < n; ++i)
+	{
+		rays[i] = { RandomUnitSphere() * 20.0f, RandomUnitSphere() };
+		planes[i] = { RandomUnitSphere(), RandomFloat(-10.0f, 10.0f) };
+		obbs[i] = { RandomVector3({ -5.0f, -5.0f, -5.0f }, { 5.0f, 5.0f, 5.0f }), Vector3::One, Quaternion::RotationAxis(RandomUnitSphere(), RandomFloat(0.0f, Constants::TwoPi)) };
+		segments[i] = { RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f }), RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f }) };
+		otherSegments[i] = { RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f }), RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f }) };
+		circles[i] = { RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f }), RandomFloat(0.5f, 4.0f) };
+		otherCircles[i] = { RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f }), RandomFloat(0.5f, 4.0f) };
+		rects[i] = randomRect();
+		otherRects[i] = randomRect();
+	}
+	size_t checksum = 0;
+
+	printf("\n== Intersect (%zu tests per run, median of %d) ==\n", n, args.repeats);
+	printf("%-20s %12s %12s %12s\n", "Kernel", "Median ns", "P90 ns", "P99 ns");
+
+	const auto report = [&](const char* name, auto&& test)
+	{
+		Measure(args, name, "Loop", 1, n, [&]() { for (size_t i = 0; i < n; ++i) checksum += test(i); });
+		const Stats& stats = sMeasurements.back().stats;
+		printf("%-20s %12.3f %12.3f %12.3f\n", name, stats.median, stats.p90, stats.p99);
+	};
+	report("Ray Plane", [&](size_t i) { float distance; return Intersect(rays[i], planes[i], distance); });
+	report("Ray OBB", [&](size_t i) { Vector3 point, normal; return GetContactPoint(rays[i], obbs[i], point, normal); });
+	report("Segment Segment", [&](size_t i) { return Intersect(segments[i], otherSegments[i]); });
+	report("Circle Circle", [&](size_t i) { return Intersect(circles[i], otherCircles[i]); });
+	report("Rect Rect", [&](size_t i) { return Intersect(rects[i], otherRects[i]); });
+	report("Circle Segment", [&](size_t i) { return Intersect(circles[i], segments[i]); });
+	report("Circle Rect", [&](size_t i) { return Intersect(circles[i], rects[i]); });
+	printf("checksum %zu\n", checksum);
+}
+
+void PrintStats()
+{
+	printf("\n== Statistics (ns per op) ==\n");
+	printf("%-14s %-20s %-8s %7s %12s %12s %12s %12s %12s %12s\n", "Section", "Name", "Variant", "Threads", "Min", "P10", "Median", "P90", "P99", "Max");
+	for (auto& m : sMeasurements)
+	{
+		printf("%-14s %-20s %-8s %7u %12.3f %12.3f %12.3f %12.3f %12.3f %12.3f\n",
+			m.section.c_str(), m.name.c_str(), m.variant.c_str(), m.threads,
+			m.stats.min, m.stats.p10, m.stats.median, m.stats.p90, m.stats.p99, m.stats.max);
+	}
+}
+
+// Same shape as the other JSON files the engine writes, one result object per line
+bool WriteJson(const char* fileName, const Arguments& args)
+{
+	std::string json;
+	char line[512];
+	snprintf(line, std::size(line), "{\"label\":\"%s\",\"backend\":\"%s\",\"hardwareThreads\":%u,\"repeats\":%d,\"results\":[\n",
+		args.label, GetBackendName(), std::thread::hardware_concurrency(), args.repeats);
+	json += line;
+	for (size_t i = 0; i < sMeasurements.size(); ++i)
+	{
+		const Measurement& m = sMeasurements[i];
+		snprintf(line, std::size(line),
+			"{\"section\":\"%s\",\"name\":\"%s\",\"variant\":\"%s\",\"threads\":%u,\"ops\":%llu,\"samples\":%d,"
+			"\"nsPerOp\":{\"min\":%.4f,\"p10\":%.4f,\"median\":%.4f,\"p90\":%.4f,\"p99\":%.4f,\"max\":%.4f,\"mean\":%.4f}}%s\n",
+			m.section.c_str(), m.name.c_str(), m.variant.c_str(), m.threads, static_cast<unsigned long long>(m.ops), m.samples,
+			m.stats.min, m.stats.p10, m.stats.median, m.stats.p90, m.stats.p99, m.stats.max, m.stats.mean,
+			i + 1 < sMeasurements.size() ? "," : "");
+		json += line;
+	}
+	json += "]}\n";
+
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file)
+		return false;
+	file.write(json.data(), json.size());
+	return true;
+}
+
+std::optional<Arguments> ParseArgs(int argc, char* argv[])
+{
+	Arguments args;
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "-count") == 0 && hasValue)
+			args.count = static_cast<size_t>(atoi(argv[++i]));
+		else if (strcmp(argv[i], "-batch") == 0 && hasValue)
+			args.batchCount = static_cast<size_t>(atoi(argv[++i]));
+		else if (strcmp(argv[i], "-repeat") == 0 && hasValue)
+			args.repeats = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-section") == 0 && hasValue)
+			args.sectionFilter = argv[++i];
+		else if (strcmp(argv[i], "-json") == 0 && hasValue)
+			args.jsonFileName = argv[++i];
+		else if (strcmp(argv[i], "-label") == 0 && hasValue && !strpbrk(argv[i + 1], "\"\\"))
+			args.label = argv[++i];
+		else if (strcmp(argv[i], "-stats") == 0)
+			args.printStats = true;
+		else
+			return std::nullopt;
+	}
+	if (args.count == 0 || args.batchCount == 0 || args.repeats <= 0)
+		return std::nullopt;
+	return args;
+}
+
+void PrintUsage()
+{
+	printf
+	(
+		"== MathBenchmark Help ==\n"
+		"\n"
+		"Usage:\n"
+		"    MathBenchmark [Options]\n"
+		"\n"
+		"Options:\n"
+		"    -count <n>      Operations per run (default 4096).\n"
+		"    -batch <n>      Points per run in the batch section (default 1048576).\n"
+		"    -repeat <n>     Timed runs per measurement (default 25).\n"
+		"    -section <name> Only run the named section: kernels, batch, cull, random, raycast,\n"
+		"                    raycast2d, bvh, interpolation, quantize or intersect.\n"
+		"    -stats          Print min, percentiles and max of every measurement at the end.\n"
+		"    -json <file>    Write every measurement to a JSON file.\n"
+		"    -label <text>   Label stored in the JSON file, e.g. the commit hash.\n"
+		"\n"
+	);
+}
+
+struct SectionDesc
+{
+	const char* name;
+	void(*run)(const Arguments&);
+};
+
+int main(int argc, char* argv[])
+{
+	const auto argsOpt = ParseArgs(argc, argv);
+	if (!argsOpt.has_value())
+	{
+		PrintUsage();
+		return -1;
+	}
+	const auto& args = argsOpt.value();
+
+	const SectionDesc sections[] =
+	{
+		{ "kernels", RunKernels },
+		{ "batch", RunBatchKernels },
+		{ "cull", RunCullKernels },
+		{ "random", RunRandomKernels },
+		{ "raycast", RunRaycastKernels },
+		{ "raycast2d", RunRaycast2DKernels },
+		{ "bvh", RunBVHKernels },
+		{ "interpolation", RunInterpolationKernels },
+		{ "quantize", RunQuantizeKernels },
+		{ "intersect", RunIntersectKernels }
+	};
+
+	bool found = false;
+	for (auto& section : sections)
+	{
+		if (args.sectionFilter && strcmp(args.sectionFilter, section.name) != 0)
+			continue;
+		sSection = section.name;
+		section.run(args);
+		found = true;
+	}
+	if (!found)
+	{
+		printf("Error: Unknown section %s\n", args.sectionFilter);
+		return -1;
+	}
+
+	if (args.printStats)
+		PrintStats();
+	if (args.jsonFileName && !WriteJson(args.jsonFileName, args))
+	{
+		printf("Error: Cannot write %s\n", args.jsonFileName);
+		return -1;
+	}
+	return 0;
+}
@@ -0,0 +1,287 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "TestUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+using namespace MathTest::TestUtil;
+
+namespace
+{
+	// Quarter units so that min, max, center and extend convert back and forth exactly
+	AABB RandomBox(float range = 40.0f)
+	{
+		const auto quarter = [](float min, float max) { return static_cast<float>(RandomInt(static_cast<int>(min * 4.0f), static_cast<int>(max * 4.0f))) * 0.25f; };
+		return
+		{
+			{ quarter(-range, range), quarter(-range, range), quarter(-range, range) },
+			{ quarter(0.25f, 2.0f), quarter(0.25f, 2.0f), quarter(0.25f, 2.0f) }
+		};
+	}
+
+	bool Overlaps(const AABB& a, const AABB& b)
+	{
+		const Vector3 aMin = a.Min(), aMax = a.Max(), bMin = b.Min(), bMax = b.Max();
+		return aMin.x <= bMax.x && aMax.x >= bMin.x &&
+			aMin.y <= bMax.y && aMax.y >= bMin.y &&
+			aMin.z <= bMax.z && aMax.z >= bMin.z;
+	}
+
+	bool Overlaps(const Sphere& sphere, const AABB& box)
+	{
+		const Vector3 min = box.Min(), max = box.Max();
+		float distanceSqr = 0.0f;
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			const float c = sphere.center.v[axis];
+			const float d = c < min.v[axis] ? min.v[axis] - c : (c > max.v[axis] ? c - max.v[axis] : 0.0f);
+			distanceSqr += d * d;
+		}
+		return distanceSqr <= sphere.radius * sphere.radius;
+	}
+
+	template <class Shape>
+	std::vector<uint32_t> QueryTree(const BVH& bvh, const Shape& shape)
+	{
+		std::vector<uint32_t> result;
+		bvh.Query(shape, [&result](uint32_t primitive) { result.push_back(primitive); });
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	// Every query against the live boxes, 'alive' marks the ones in the tree
+	void CheckQueries(const BVH& bvh, const std::vector<AABB>& boxes, const std::vector<bool>& alive)
+	{
+		for (int i = 0; i < 20; ++i)
+		{
+			const AABB box = RandomBox();
+			const Sphere sphere(RandomVector3({ -40.0f, -40.0f, -40.0f }, { 40.0f, 40.0f, 40.0f }), RandomFloat(1.0f, 10.0f));
+			const Frustum frustum = RandomFrustum(60.0f, 20.0f);
+			std::vector<uint32_t> boxExpected, sphereExpected, frustumExpected;
+			for (uint32_t j = 0; j < boxes.size(); ++j)
+			{
+				if (!alive[j])
+					continue;
+				if (Overlaps(box, boxes[j]))
+					boxExpected.push_back(j);
+				if (Overlaps(sphere, boxes[j]))
+					sphereExpected.push_back(j);
+				if (Intersect(frustum, boxes[j]))
+					frustumExpected.push_back(j);
+			}
+			Assert::IsTrue(boxExpected == QueryTree(bvh, box));
+			Assert::IsTrue(sphereExpected == QueryTree(bvh, sphere));
+			Assert::IsTrue(frustumExpected == QueryTree(bvh, frustum));
+		}
+	}
+}
+
+namespace MathTest
+{
+	TEST_CLASS(BVHTest)
+	{
+	public:
+		TEST_METHOD(TestBuild)
+		{
+			static_assert(sizeof(BVH::Node) == 32, "BVHTest -- Nodes should stay compact.");
+
+			BVH bvh;
+			Assert::IsTrue(QueryTree(bvh, RandomBox()).empty());
+			Assert::IsFalse(bvh.Raycast(Ray(), [](uint32_t, float&, Vector3&) { return true; }).IsHit());
+
+			for (size_t count : { 1, 2, 5, 100, 2000 })
+			{
+				std::vector<AABB> boxes(count);
+				for (auto& box : boxes)
+					box = RandomBox();
+				bvh.Build(boxes.data(), boxes.size());
+				Assert::AreEqual(count, bvh.Size());
+				Assert::IsTrue(bvh.GetNodes().size() < 2 * count);
+				for (uint32_t i = 0; i < count; ++i)
+					Assert::IsTrue(bvh.Contains(i));
+				Assert::IsFalse(bvh.Contains(static_cast<uint32_t>(count)));
+				CheckQueries(bvh, boxes, std::vector<bool>(count, true));
+			}
+			Assert::IsTrue(bvh.GetCost() < 0.1f);
+
+			// Identical boxes cannot be split by SAH and still end up in small leaves
+			std::vector<AABB> same(50, AABB{ Vector3::One, Vector3::One });
+			bvh.Build(same.data(), same.size());
+			for (auto& node : bvh.GetNodes())
+				Assert::IsTrue(node.count <= BVH::kMaxLeafSize);
+			Assert::AreEqual(size_t(50), QueryTree(bvh, AABB()).size());
+		}
+
+		TEST_METHOD(TestShapeSets)
+		{
+			SphereSoA spheres;
+			AABBSoA aabbs;
+			OBBSoA obbs;
+			std::vector<Sphere> sphereArray;
+			for (int i = 0; i < 300; ++i)
+			{
+				const Vector3 center = RandomVector3({ -20.0f, -20.0f, -20.0f }, { 20.0f, 20.0f, 20.0f });
+				const Quaternion rotation = RandomRotation();
+				sphereArray.push_back({ center, RandomFloat(0.2f, 2.0f) });
+				spheres.Add(sphereArray.back());
+				aabbs.Add({ center, RandomVector3({ 0.2f, 0.2f, 0.2f }, { 2.0f, 2.0f, 2.0f }) });
+				obbs.Add({ center, RandomVector3({ 0.2f, 0.2f, 0.2f }, { 2.0f, 2.0f, 2.0f }), rotation });
+			}
+
+			BVH sphereTree, aabbTree, obbTree, arrayTree;
+			sphereTree.Build(spheres);
+			aabbTree.Build(aabbs);
+			obbTree.Build(obbs);
+			arrayTree.Build(sphereArray.data(), sphereArray.size());
+			Assert::AreEqual(sphereTree.GetCost(), arrayTree.GetCost(), 1e-5f);
+
+			// OBB bounds hold every corner
+			const AABB bounds = GetBounds(obbs.Get(7));
+			const Matrix4 world = Matrix4::RotationQuaternion(obbs.Get(7).rot) * Matrix4::Translation(obbs.Get(7).center);
+			for (int corner = 0; corner < 8; ++corner)
+			{
+				const Vector3 extend = obbs.Get(7).extend;
+				const Vector3 local{ corner & 1 ? extend.x : -extend.x, corner & 2 ? extend.y : -extend.y, corner & 4 ? extend.z : -extend.z };
+				const Vector3 p = TransformCoord(local, world) - bounds.center;
+				Assert::IsTrue(fabsf(p.x) <= bounds.extend.x + 1e-4f && fabsf(p.y) <= bounds.extend.y + 1e-4f && fabsf(p.z) <= bounds.extend.z + 1e-4f);
+			}
+
+			// The tree only skips shapes, the hits are the same as the flat versions
+			for (int i = 0; i < 200; ++i)
+			{
+				const Ray ray = RandomRay(40.0f, 15.0f);
+				const float maxDistance = i % 2 ? 50.0f : std::numeric_limits<float>::max();
+				AreEqual(Batch::Raycast(ray, spheres, maxDistance), Batch::Raycast(ray, sphereTree, spheres, maxDistance));
+				AreEqual(Batch::Raycast(ray, aabbs, maxDistance), Batch::Raycast(ray, aabbTree, aabbs, maxDistance));
+				AreEqual(Batch::Raycast(ray, obbs, maxDistance), Batch::Raycast(ray, obbTree, obbs, maxDistance));
+
+				// Generic hit test on plain spheres
+				const RayHit hit = arrayTree.Raycast(ray, [&](uint32_t index, float& distance, Vector3& normal)
+				{
+					const Sphere& s = sphereArray[index];
+					const Vector3 p = ray.origin - s.center;
+					const float b = Dot(p, ray.direction);
+					const float c = Dot(p, p) - s.radius * s.radius;
+					const float discriminant = b * b - c;
+					const float t = c <= 0.0f ? 0.0f : -b - sqrtf(Max(discriminant, 0.0f));
+					if (discriminant < 0.0f || t < 0.0f || t > distance)
+						return false;
+					distance = t;
+					normal = Normalize(ray.origin + ray.direction * t - s.center);
+					return true;
+				}, maxDistance);
+				const RayHit expected = Batch::Raycast(ray, spheres, maxDistance);
+				Assert::AreEqual(expected.index, hit.index);
+				if (hit.IsHit())
+					Assert::AreEqual(expected.distance, hit.distance, 1e-4f * Max(1.0f, expected.distance));
+			}
+		}
+
+		TEST_METHOD(TestInsertRemove)
+		{
+			BVH bvh;
+			std::vector<AABB> boxes(600);
+			std::vector<bool> alive(boxes.size(), false);
+			for (uint32_t i = 0; i < boxes.size(); ++i)
+			{
+				boxes[i] = RandomBox();
+				bvh.Insert(i, boxes[i]);
+				alive[i] = true;
+			}
+			CheckQueries(bvh, boxes, alive);
+
+			// Churn, including emptying the tree and the index list compaction
+			for (int round = 0; round < 3; ++round)
+			{
+				for (uint32_t i = 0; i < boxes.size(); ++i)
+				{
+					if (alive[i] && RandomInt(0, 2) != 0)
+					{
+						bvh.Remove(i);
+						alive[i] = false;
+					}
+				}
+				Assert::AreEqual(static_cast<size_t>(std::count(alive.begin(), alive.end(), true)), bvh.Size());
+				CheckQueries(bvh, boxes, alive);
+				for (uint32_t i = 0; i < boxes.size(); ++i)
+				{
+					if (!alive[i] && RandomInt(0, 1) == 0)
+					{
+						boxes[i] = RandomBox();
+						bvh.Insert(i, boxes[i]);
+						alive[i] = true;
+					}
+				}
+				CheckQueries(bvh, boxes, alive);
+			}
+			for (uint32_t i = 0; i < boxes.size(); ++i)
+			{
+				if (alive[i])
+					bvh.Remove(i);
+			}
+			Assert::IsTrue(bvh.Empty());
+			Assert::IsTrue(bvh.GetNodes().empty());
+
+			// Removing from a built tree with multi primitive leaves
+			bvh.Build(boxes.data(), boxes.size());
+			std::fill(alive.begin(), alive.end(), true);
+			for (uint32_t i = 0; i < boxes.size(); i += 3)
+			{
+				bvh.Remove(i);
+				alive[i] = false;
+			}
+			bvh.Insert(9000, RandomBox());
+			bvh.Remove(9000);
+			CheckQueries(bvh, boxes, alive);
+		}
+
+		TEST_METHOD(TestRefit)
+		{
+			std::vector<AABB> boxes(1000);
+			for (auto& box : boxes)
+				box = RandomBox();
+			BVH bvh;
+			bvh.Build(boxes.data(), boxes.size());
+			const float builtCost = bvh.GetCost();
+
+			// Small moves keep the tree close to a fresh build
+			for (auto& box : boxes)
+				box.center += Vector3(0.5f, -0.25f, 0.75f);
+			bvh.Refit(boxes.data());
+			CheckQueries(bvh, boxes, std::vector<bool>(boxes.size(), true));
+			Assert::AreEqual(builtCost, bvh.GetCost(), builtCost * 0.1f);
+
+			for (uint32_t i = 0; i < boxes.size(); i += 7)
+			{
+				boxes[i] = RandomBox();
+				bvh.Update(i, boxes[i]);
+			}
+			CheckQueries(bvh, boxes, std::vector<bool>(boxes.size(), true));
+			const AABB bounds = bvh.GetTreeBounds();
+			for (auto& box : boxes)
+				Assert::IsTrue(Overlaps(bounds, box));
+		}
+
+		TEST_METHOD(TestParallelBuild)
+		{
+			std::vector<AABB> boxes(BVH::kParallelBuildThreshold * 3);
+			for (auto& box : boxes)
+				box = RandomBox(200.0f);
+			BVH serial, parallel;
+			serial.Build(boxes.data(), boxes.size());
+
+			Angazi::Core::JobSystem::StaticInitialize(3);
+			parallel.Build(boxes.data(), boxes.size());
+			Angazi::Core::JobSystem::StaticTerminate();
+
+			// Same splits, only the node order differs
+			Assert::AreEqual(serial.GetNodes().size(), parallel.GetNodes().size());
+			Assert::AreEqual(serial.GetCost(), parallel.GetCost());
+			for (int i = 0; i < 20; ++i)
+			{
+				const AABB box = RandomBox(200.0f);
+				Assert::IsTrue(QueryTree(serial, box) == QueryTree(parallel, box));
+			}
+		}
+	};
+}
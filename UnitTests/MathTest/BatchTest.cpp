@@ -0,0 +1,206 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "TestUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+using namespace MathTest::TestUtil;
+
+namespace
+{
+	void AreNear(const Vector3& expected, const Vector3& actual, float tolerance = 1e-4f)
+	{
+		Assert::AreEqual(expected.x, actual.x, tolerance);
+		Assert::AreEqual(expected.y, actual.y, tolerance);
+		Assert::AreEqual(expected.z, actual.z, tolerance);
+	}
+
+	Matrix4 RandomTransform()
+	{
+		const Quaternion rotation = RandomRotation();
+		return Matrix4::Transform(RandomVector3(), rotation, RandomVector3({ 0.5f, 0.5f, 0.5f }, { 2.0f, 2.0f, 2.0f }));
+	}
+
+	struct SoAStorage
+	{
+		explicit SoAStorage(const std::vector<Vector3>& v)
+		{
+			for (auto& p : v)
+			{
+				x.push_back(p.x);
+				y.push_back(p.y);
+				z.push_back(p.z);
+			}
+		}
+		Vector3SoA View() { return { x.data(), y.data(), z.data() }; }
+		Vector3 operator[](size_t i) const { return { x[i], y[i], z[i] }; }
+
+		std::vector<float> x, y, z;
+	};
+}
+
+namespace MathTest
+{
+	TEST_CLASS(BatchTest)
+	{
+	public:
+		TEST_METHOD(TestAoS)
+		{
+			// Every count up to a few groups, so both the SIMD body and the tail run
+			for (size_t count = 0; count < 13; ++count)
+			{
+				std::vector<Vector3> a(count), b(count), out(count);
+				std::vector<Vector4> v4(count), out4(count);
+				std::vector<float> scalars(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					a[i] = RandomVector3({ -5.0f, -5.0f, -5.0f }, { 5.0f, 5.0f, 5.0f });
+					b[i] = RandomVector3({ -5.0f, -5.0f, -5.0f }, { 5.0f, 5.0f, 5.0f });
+					v4[i] = { a[i].x, a[i].y, a[i].z, 1.0f };
+				}
+				const Matrix4 m = RandomTransform();
+
+				Batch::TransformCoord(a.data(), out.data(), count, m);
+				for (size_t i = 0; i < count; ++i)
+					AreNear(TransformCoord(a[i], m), out[i]);
+				Batch::TransformNormal(a.data(), out.data(), count, m);
+				for (size_t i = 0; i < count; ++i)
+					AreNear(TransformNormal(a[i], m), out[i]);
+				Batch::Transform(v4.data(), out4.data(), count, m);
+				for (size_t i = 0; i < count; ++i)
+					AreNear(TransformCoord(a[i], m), { out4[i].x, out4[i].y, out4[i].z });
+
+				Batch::Cross(a.data(), b.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					AreNear(Cross(a[i], b[i]), out[i]);
+				Batch::Normalize(a.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					AreNear(Normalize(a[i]), out[i]);
+				Batch::Dot(a.data(), b.data(), scalars.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(Dot(a[i], b[i]), scalars[i], 1e-4f);
+				Batch::Magnitude(a.data(), scalars.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(Magnitude(a[i]), scalars[i], 1e-4f);
+			}
+		}
+
+		TEST_METHOD(TestSoA)
+		{
+			const size_t count = 11;
+			std::vector<Vector3> a(count), b(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				a[i] = RandomVector3({ -5.0f, -5.0f, -5.0f }, { 5.0f, 5.0f, 5.0f });
+				b[i] = RandomVector3({ -5.0f, -5.0f, -5.0f }, { 5.0f, 5.0f, 5.0f });
+			}
+			a[3] = Vector3::Zero;
+			const Matrix4 m = RandomTransform();
+
+			SoAStorage sa(a), sb(b), out(a);
+			Batch::TransformCoord(sa.View(), out.View(), count, m);
+			for (size_t i = 0; i < count; ++i)
+				AreNear(TransformCoord(a[i], m), out[i]);
+			Batch::TransformNormal(sa.View(), out.View(), count, m);
+			for (size_t i = 0; i < count; ++i)
+				AreNear(TransformNormal(a[i], m), out[i]);
+			Batch::Cross(sa.View(), sb.View(), out.View(), count);
+			for (size_t i = 0; i < count; ++i)
+				AreNear(Cross(a[i], b[i]), out[i]);
+			Batch::Normalize(sa.View(), out.View(), count);
+			for (size_t i = 0; i < count; ++i)
+				AreNear(Normalize(a[i]), out[i]);
+
+			std::vector<float> scalars(count);
+			Batch::Dot(sa.View(), sb.View(), scalars.data(), count);
+			for (size_t i = 0; i < count; ++i)
+				Assert::AreEqual(Dot(a[i], b[i]), scalars[i], 1e-4f);
+			Batch::Magnitude(sa.View(), scalars.data(), count);
+			for (size_t i = 0; i < count; ++i)
+				Assert::AreEqual(Magnitude(a[i]), scalars[i], 1e-4f);
+
+			// In place
+			Batch::TransformCoord(sa.View(), sa.View(), count, m);
+			for (size_t i = 0; i < count; ++i)
+				AreNear(TransformCoord(a[i], m), sa[i]);
+		}
+
+		TEST_METHOD(TestMatrixIndices)
+		{
+			const size_t count = 9;
+			const Matrix4 matrices[3] = { RandomTransform(), RandomTransform(), RandomTransform() };
+			std::vector<Vector3> points(count), out(count);
+			std::vector<uint32_t> indices(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				points[i] = RandomVector3();
+				indices[i] = static_cast<uint32_t>(RandomInt(0, 2));
+			}
+
+			Batch::TransformCoord(points.data(), out.data(), count, matrices, indices.data());
+			for (size_t i = 0; i < count; ++i)
+				AreNear(TransformCoord(points[i], matrices[indices[i]]), out[i]);
+
+			SoAStorage soa(points);
+			Batch::TransformNormal(soa.View(), soa.View(), count, matrices, indices.data());
+			for (size_t i = 0; i < count; ++i)
+				AreNear(TransformNormal(points[i], matrices[indices[i]]), soa[i]);
+		}
+
+		TEST_METHOD(TestInterpolate)
+		{
+			for (size_t count = 0; count < 13; ++count)
+			{
+				std::vector<Quaternion> a(count), b(count), out(count);
+				std::vector<float> t(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					a[i] = RandomRotation();
+					b[i] = RandomRotation();
+					t[i] = RandomFloat();
+				}
+				const auto check = [&](const Quaternion& expected, const Quaternion& actual)
+				{
+					Assert::AreEqual(expected.x, actual.x, 1e-6f);
+					Assert::AreEqual(expected.y, actual.y, 1e-6f);
+					Assert::AreEqual(expected.z, actual.z, 1e-6f);
+					Assert::AreEqual(expected.w, actual.w, 1e-6f);
+				};
+
+				Batch::Slerp(a.data(), b.data(), t.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					check(FastSlerp(a[i], b[i], t[i]), out[i]);
+				Batch::Slerp(a.data(), b.data(), 0.25f, out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					check(FastSlerp(a[i], b[i], 0.25f), out[i]);
+				Batch::Nlerp(a.data(), b.data(), 0.75f, out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					check(Nlerp(a[i], b[i], 0.75f), out[i]);
+
+				// In place
+				out = a;
+				Batch::Nlerp(out.data(), b.data(), t.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					check(Nlerp(a[i], b[i], t[i]), out[i]);
+			}
+		}
+
+		TEST_METHOD(TestParallel)
+		{
+			Angazi::Core::JobSystem::StaticInitialize(3);
+
+			const size_t count = Batch::kParallelThreshold * 4 + 3;
+			std::vector<Vector3> points(count), out(count);
+			for (size_t i = 0; i < count; ++i)
+				points[i] = { static_cast<float>(i % 100), 1.0f, -2.0f };
+			const Matrix4 m = RandomTransform();
+
+			Batch::TransformCoord(points.data(), out.data(), count, m);
+			for (size_t i = 0; i < count; i += 97)
+				AreNear(TransformCoord(points[i], m), out[i]);
+			AreNear(TransformCoord(points.back(), m), out.back());
+
+			Angazi::Core::JobSystem::StaticTerminate();
+		}
+	};
+}
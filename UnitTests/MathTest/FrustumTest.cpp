@@ -0,0 +1,127 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "TestUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+using namespace MathTest::TestUtil;
+
+namespace
+{
+	bool IsVisible(const std::vector<uint32_t>& mask, size_t i)
+	{
+		return (mask[i / 32] & (1u << (i % 32))) != 0;
+	}
+
+	template <class Shape>
+	void CheckCull(const Frustum& frustum, const std::vector<Shape>& shapes, std::vector<uint8_t>* planeCache = nullptr)
+	{
+		std::vector<uint32_t> mask((shapes.size() + 31) / 32, 0xDEADBEEF);
+		Batch::Cull(frustum, shapes.data(), shapes.size(), mask.data(), planeCache ? planeCache->data() : nullptr);
+		for (size_t i = 0; i < shapes.size(); ++i)
+			Assert::AreEqual(Intersect(frustum, shapes[i]), IsVisible(mask, i));
+		if (shapes.size() % 32)
+			Assert::AreEqual(0u, mask.back() >> (shapes.size() % 32));
+	}
+}
+
+namespace MathTest
+{
+	TEST_CLASS(FrustumTest)
+	{
+	public:
+		TEST_METHOD(TestFromViewProjection)
+		{
+			const Frustum frustum = Frustum::FromViewProjection(PerspectiveMatrix(1.0f, 100.0f));
+			const float s = sqrtf(0.5f);
+			const Vector3 normals[] = { { s, 0.0f, s }, { -s, 0.0f, s }, { 0.0f, s, s }, { 0.0f, -s, s }, Vector3::ZAxis, -Vector3::ZAxis };
+			const float distances[] = { 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, -100.0f };
+			for (size_t i = 0; i < Frustum::Count; ++i)
+			{
+				Assert::AreEqual(normals[i].x, frustum.planes[i].n.x, 1e-5f);
+				Assert::AreEqual(normals[i].y, frustum.planes[i].n.y, 1e-5f);
+				Assert::AreEqual(normals[i].z, frustum.planes[i].n.z, 1e-5f);
+				Assert::AreEqual(distances[i], frustum.planes[i].d, 1e-3f);
+			}
+
+			Assert::IsTrue(Intersect(frustum, Sphere(0.0f, 0.0f, 50.0f, 1.0f)));
+			Assert::IsTrue(Intersect(frustum, Sphere(0.0f, 0.0f, 0.5f, 0.6f)));
+			Assert::IsFalse(Intersect(frustum, Sphere(0.0f, 0.0f, -5.0f, 1.0f)));
+			Assert::IsFalse(Intersect(frustum, Sphere(20.0f, 0.0f, 10.0f, 1.0f)));
+			Assert::IsTrue(Intersect(frustum, AABB{ { 12.0f, 0.0f, 10.0f }, { 3.0f, 1.0f, 1.0f } }));
+			Assert::IsFalse(Intersect(frustum, AABB{ { 0.0f, 0.0f, 102.0f }, { 1.0f, 1.0f, 1.0f } }));
+
+			// A long thin box only reaches inside when turned towards the frustum
+			OBB obb{ { 14.0f, 0.0f, 10.0f }, { 5.0f, 0.1f, 0.1f }, Quaternion::Identity };
+			Assert::IsTrue(Intersect(frustum, obb));
+			obb.rot = Quaternion::RotationAxis(Vector3::ZAxis, Constants::Pi * 0.5f);
+			Assert::IsFalse(Intersect(frustum, obb));
+		}
+
+		TEST_METHOD(TestBatchCull)
+		{
+			for (size_t count : { 0, 1, 5, 32, 37, 100 })
+			{
+				const Frustum frustum = RandomFrustum();
+				std::vector<Sphere> spheres;
+				std::vector<AABB> aabbs;
+				std::vector<OBB> obbs;
+				for (size_t i = 0; i < count; ++i)
+				{
+					const Vector3 center = RandomVector3({ -25.0f, -25.0f, -25.0f }, { 25.0f, 25.0f, 25.0f });
+					const Vector3 extend = RandomVector3({ 0.1f, 0.1f, 0.1f }, { 3.0f, 3.0f, 3.0f });
+					const Quaternion rotation = RandomRotation();
+					spheres.emplace_back(center, extend.x);
+					aabbs.push_back({ center, extend });
+					obbs.push_back({ center, extend, rotation });
+				}
+				CheckCull(frustum, spheres);
+				CheckCull(frustum, aabbs);
+				CheckCull(frustum, obbs);
+			}
+		}
+
+		TEST_METHOD(TestPlaneCache)
+		{
+			const size_t count = 61;
+			std::vector<Sphere> spheres(count);
+			std::vector<OBB> obbs(count);
+			std::vector<uint8_t> sphereCache(count, 0), obbCache(count, 0);
+
+			// The camera turns a little each frame, the cached planes must never change the result
+			for (int frame = 0; frame < 20; ++frame)
+			{
+				const Matrix4 view = InverseAffine(Matrix4::RotationAxis(Vector3::YAxis, frame * 0.3f));
+				const Frustum frustum = Frustum::FromViewProjection(view * PerspectiveMatrix(0.5f, 20.0f));
+				if (frame % 5 == 0)
+				{
+					for (size_t i = 0; i < count; ++i)
+					{
+						spheres[i] = { RandomVector3({ -25.0f, -25.0f, -25.0f }, { 25.0f, 25.0f, 25.0f }), RandomFloat(0.1f, 2.0f) };
+						obbs[i] = { spheres[i].center, { spheres[i].radius, 0.5f, 1.0f }, Quaternion::RotationAxis(Vector3::XAxis, RandomFloat(0.0f, 3.0f)) };
+					}
+				}
+				CheckCull(frustum, spheres, &sphereCache);
+				CheckCull(frustum, obbs, &obbCache);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(sphereCache[i] < Frustum::Count && obbCache[i] < Frustum::Count);
+			}
+		}
+
+		TEST_METHOD(TestParallelCull)
+		{
+			Angazi::Core::JobSystem::StaticInitialize(3);
+
+			const size_t count = Batch::kParallelThreshold * 2 + 45;
+			std::vector<AABB> aabbs(count);
+			for (size_t i = 0; i < count; ++i)
+				aabbs[i] = { RandomVector3({ -25.0f, -25.0f, -25.0f }, { 25.0f, 25.0f, 25.0f }), Vector3::One };
+			std::vector<uint8_t> planeCache(count, 0);
+			const Frustum frustum = RandomFrustum();
+			CheckCull(frustum, aabbs);
+			CheckCull(frustum, aabbs, &planeCache);
+
+			Angazi::Core::JobSystem::StaticTerminate();
+		}
+	};
+}
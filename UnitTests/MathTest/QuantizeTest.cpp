@@ -0,0 +1,215 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "TestUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+using namespace MathTest::TestUtil;
+
+namespace
+{
+	// Angle between two unit vectors from the chord, acos is too coarse this close to 1
+	float AngleDegrees(const Vector3& a, const Vector3& b)
+	{
+		return 2.0f * asinf(Min(Magnitude(a - b) * 0.5f, 1.0f)) * Constants::RadToDeg;
+	}
+
+	uint32_t Bits(float f)
+	{
+		uint32_t u;
+		memcpy(&u, &f, sizeof(u));
+		return u;
+	}
+}
+
+namespace MathTest
+{
+	TEST_CLASS(QuantizeTest)
+	{
+	public:
+		TEST_METHOD(TestHalf)
+		{
+			Assert::AreEqual(0x3C00, static_cast<int>(FloatToHalf(1.0f)));
+			Assert::AreEqual(0xC000, static_cast<int>(FloatToHalf(-2.0f)));
+			Assert::AreEqual(0x8000, static_cast<int>(FloatToHalf(-0.0f)));
+			Assert::AreEqual(0x7BFF, static_cast<int>(FloatToHalf(65504.0f)));
+			Assert::AreEqual(0x7C00, static_cast<int>(FloatToHalf(65520.0f)));
+			Assert::AreEqual(0x7C00, static_cast<int>(FloatToHalf(std::numeric_limits<float>::infinity())));
+			Assert::AreEqual(0x0001, static_cast<int>(FloatToHalf(6e-8f)));
+			Assert::AreEqual(0x0000, static_cast<int>(FloatToHalf(1e-8f)));
+			Assert::IsTrue(std::isnan(HalfToFloat(FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+
+			// Halfway cases round to the even mantissa
+			Assert::AreEqual(0x3C00, static_cast<int>(FloatToHalf(1.0f + 1.0f / 2048.0f)));
+			Assert::AreEqual(0x3C02, static_cast<int>(FloatToHalf(1.0f + 3.0f / 2048.0f)));
+
+			// Every half survives the round trip, NaN only has to stay NaN
+			for (uint32_t h = 0; h < 0x10000; ++h)
+			{
+				const float f = HalfToFloat(static_cast<uint16_t>(h));
+				if (std::isnan(f))
+					Assert::IsTrue((h & 0x7C00) == 0x7C00 && (h & 0x3FF) != 0);
+				else
+					Assert::AreEqual(h, static_cast<uint32_t>(FloatToHalf(f)));
+			}
+
+			// Anything in range is within half a step of the input
+			for (int i = 0; i < 10000; ++i)
+			{
+				const float f = RandomFloat(-60000.0f, 60000.0f) * powf(2.0f, -static_cast<float>(RandomInt(0, 24)));
+				const float step = Max(Abs(f) / 1024.0f, 6e-8f);
+				Assert::AreEqual(f, HalfToFloat(FloatToHalf(f)), step * 0.5f);
+			}
+		}
+
+		TEST_METHOD(TestOctahedral)
+		{
+			const Vector3 axes[] = { Vector3::XAxis, Vector3::YAxis, Vector3::ZAxis, -Vector3::XAxis, -Vector3::YAxis, -Vector3::ZAxis };
+			for (auto& axis : axes)
+				Assert::IsTrue(AngleDegrees(axis, DecodeOctahedral(EncodeOctahedral(axis))) < 0.004f);
+
+			for (int i = 0; i < 10000; ++i)
+			{
+				const Vector3 n = RandomUnitSphere();
+				const Vector3 decoded = DecodeOctahedral(EncodeOctahedral(n));
+				Assert::AreEqual(1.0f, Magnitude(decoded), 1e-6f);
+				Assert::IsTrue(AngleDegrees(n, decoded) < 0.004f);
+
+				// Already quantized normals come back with the same bits
+				Assert::AreEqual(EncodeOctahedral(decoded), EncodeOctahedral(DecodeOctahedral(EncodeOctahedral(decoded))));
+			}
+		}
+
+		TEST_METHOD(TestQuaternion)
+		{
+			Assert::AreEqual(0.0f, Magnitude(Quaternion::Identity - DecodeQuaternion(EncodeQuaternion(Quaternion::Identity))), 1e-6f);
+			for (int i = 0; i < 10000; ++i)
+			{
+				const Quaternion q = RandomRotation();
+				Quaternion decoded = DecodeQuaternion(EncodeQuaternion(q));
+				Assert::AreEqual(1.0f, Magnitude(decoded), 1e-6f);
+				if (Dot(q, decoded) < 0.0f)
+					decoded = -decoded;
+				Assert::AreEqual(q.x, decoded.x, 0.002f);
+				Assert::AreEqual(q.y, decoded.y, 0.002f);
+				Assert::AreEqual(q.z, decoded.z, 0.002f);
+				Assert::AreEqual(q.w, decoded.w, 0.002f);
+				Assert::IsTrue(4.0f * asinf(Magnitude(q - decoded) * 0.5f) * Constants::RadToDeg < 0.25f);
+			}
+		}
+
+		TEST_METHOD(TestNorm)
+		{
+			Assert::AreEqual(0, static_cast<int>(ToUNorm8(-1.0f)));
+			Assert::AreEqual(128, static_cast<int>(ToUNorm8(0.5f)));
+			Assert::AreEqual(255, static_cast<int>(ToUNorm8(2.0f)));
+			Assert::AreEqual(-127, static_cast<int>(ToSNorm8(-2.0f)));
+			Assert::AreEqual(0, static_cast<int>(ToSNorm8(0.0f)));
+			Assert::AreEqual(127, static_cast<int>(ToSNorm8(1.0f)));
+			Assert::AreEqual(65535, static_cast<int>(ToUNorm16(1.0f)));
+			Assert::AreEqual(-32767, static_cast<int>(ToSNorm16(-1.0f)));
+			Assert::AreEqual(-1.0f, FromSNorm8(-128));
+			Assert::AreEqual(-1.0f, FromSNorm16(-32768));
+			Assert::AreEqual(1.0f, FromUNorm8(255));
+			Assert::AreEqual(1.0f, FromUNorm16(65535));
+
+			// Every code survives the round trip
+			for (int i = 0; i < 256; ++i)
+				Assert::AreEqual(i, static_cast<int>(ToUNorm8(FromUNorm8(static_cast<uint8_t>(i)))));
+			for (int i = -127; i < 128; ++i)
+				Assert::AreEqual(i, static_cast<int>(ToSNorm8(FromSNorm8(static_cast<int8_t>(i)))));
+			for (int i = 0; i < 65536; ++i)
+				Assert::AreEqual(i, static_cast<int>(ToUNorm16(FromUNorm16(static_cast<uint16_t>(i)))));
+			for (int i = -32767; i < 32768; ++i)
+				Assert::AreEqual(i, static_cast<int>(ToSNorm16(FromSNorm16(static_cast<int16_t>(i)))));
+
+			// Rounded to the nearest step
+			for (int i = 0; i < 10000; ++i)
+			{
+				const float u = RandomFloat();
+				const float s = RandomFloat(-1.0f, 1.0f);
+				Assert::AreEqual(u, FromUNorm8(ToUNorm8(u)), 0.5f / 255.0f + 1e-6f);
+				Assert::AreEqual(s, FromSNorm8(ToSNorm8(s)), 0.5f / 127.0f + 1e-6f);
+				Assert::AreEqual(u, FromUNorm16(ToUNorm16(u)), 0.5f / 65535.0f + 1e-6f);
+				Assert::AreEqual(s, FromSNorm16(ToSNorm16(s)), 0.5f / 32767.0f + 1e-6f);
+			}
+		}
+
+		TEST_METHOD(TestBatch)
+		{
+			for (size_t count : { size_t(0), size_t(1), size_t(3), size_t(4), size_t(7), size_t(13), size_t(40000) })
+			{
+				std::vector<float> floats(count), decodedFloats(count);
+				std::vector<Vector3> normals(count), decodedNormals(count);
+				std::vector<Quaternion> rotations(count), decodedRotations(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					floats[i] = RandomFloat(-1.5f, 1.5f);
+					normals[i] = RandomUnitSphere();
+					rotations[i] = RandomRotation();
+				}
+
+				std::vector<uint16_t> halfs(count);
+				Batch::FloatToHalf(floats.data(), halfs.data(), count);
+				Batch::HalfToFloat(halfs.data(), decodedFloats.data(), count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					Assert::AreEqual(FloatToHalf(floats[i]), halfs[i]);
+					Assert::AreEqual(Bits(HalfToFloat(halfs[i])), Bits(decodedFloats[i]));
+				}
+
+				std::vector<uint32_t> packed(count);
+				Batch::EncodeOctahedral(normals.data(), packed.data(), count);
+				Batch::DecodeOctahedral(packed.data(), decodedNormals.data(), count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					Assert::AreEqual(EncodeOctahedral(normals[i]), packed[i]);
+					const Vector3 decoded = DecodeOctahedral(packed[i]);
+					Assert::AreEqual(Bits(decoded.x), Bits(decodedNormals[i].x));
+					Assert::AreEqual(Bits(decoded.y), Bits(decodedNormals[i].y));
+					Assert::AreEqual(Bits(decoded.z), Bits(decodedNormals[i].z));
+				}
+
+				Batch::EncodeQuaternion(rotations.data(), packed.data(), count);
+				Batch::DecodeQuaternion(packed.data(), decodedRotations.data(), count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					Assert::AreEqual(EncodeQuaternion(rotations[i]), packed[i]);
+					const Quaternion decoded = DecodeQuaternion(packed[i]);
+					Assert::AreEqual(Bits(decoded.x), Bits(decodedRotations[i].x));
+					Assert::AreEqual(Bits(decoded.y), Bits(decodedRotations[i].y));
+					Assert::AreEqual(Bits(decoded.z), Bits(decodedRotations[i].z));
+					Assert::AreEqual(Bits(decoded.w), Bits(decodedRotations[i].w));
+				}
+
+				std::vector<uint8_t> unorm8(count);
+				std::vector<int8_t> snorm8(count);
+				std::vector<int16_t> snorm16(count);
+				Batch::ToUNorm8(floats.data(), unorm8.data(), count);
+				Batch::ToSNorm8(floats.data(), snorm8.data(), count);
+				Batch::ToUNorm16(floats.data(), halfs.data(), count);
+				Batch::ToSNorm16(floats.data(), snorm16.data(), count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					Assert::AreEqual(ToUNorm8(floats[i]), unorm8[i]);
+					Assert::AreEqual(ToSNorm8(floats[i]), snorm8[i]);
+					Assert::AreEqual(ToUNorm16(floats[i]), halfs[i]);
+					Assert::AreEqual(ToSNorm16(floats[i]), snorm16[i]);
+				}
+
+				Batch::FromUNorm8(unorm8.data(), decodedFloats.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(FromUNorm8(unorm8[i]), decodedFloats[i]);
+				Batch::FromSNorm8(snorm8.data(), decodedFloats.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(FromSNorm8(snorm8[i]), decodedFloats[i]);
+				Batch::FromUNorm16(halfs.data(), decodedFloats.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(FromUNorm16(halfs[i]), decodedFloats[i]);
+				Batch::FromSNorm16(snorm16.data(), decodedFloats.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(FromSNorm16(snorm16[i]), decodedFloats[i]);
+			}
+		}
+	};
+}
@@ -1,8 +1,39 @@
 #include "stdafx.h"
 #include "CppUnitTest.h"
+#include "TestUtil.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace Angazi::Math;
+using namespace MathTest::TestUtil;
+
+namespace
+{
+	// Slerp along the shorter arc in double precision
+	Quaternion SlerpReference(const Quaternion& q1, const Quaternion& q2, float t)
+	{
+		double dot = (double)q1.x * q2.x + (double)q1.y * q2.y + (double)q1.z * q2.z + (double)q1.w * q2.w;
+		const double sign = dot < 0.0 ? -1.0 : 1.0;
+		dot = std::min(fabs(dot), 1.0);
+		const double theta = acos(dot);
+		const double w1 = theta < 1e-9 ? 1.0 - t : sin((1.0 - t) * theta) / sin(theta);
+		const double w2 = (theta < 1e-9 ? t : sin(t * theta) / sin(theta)) * sign;
+		return Quaternion
+		(
+			static_cast<float>(q1.x * w1 + q2.x * w2),
+			static_cast<float>(q1.y * w1 + q2.y * w2),
+			static_cast<float>(q1.z * w1 + q2.z * w2),
+			static_cast<float>(q1.w * w1 + q2.w * w2)
+		);
+	}
+
+	void AreNear(const Quaternion& expected, const Quaternion& actual, float tolerance)
+	{
+		Assert::AreEqual(expected.x, actual.x, tolerance);
+		Assert::AreEqual(expected.y, actual.y, tolerance);
+		Assert::AreEqual(expected.z, actual.z, tolerance);
+		Assert::AreEqual(expected.w, actual.w, tolerance);
+	}
+}
 
 namespace MathTest
 {
@@ -196,5 +227,50 @@ namespace MathTest
 			Assert::AreEqual(q2.z, 0.782413125f, 0.000001f);
 			Assert::AreEqual(q2.w, -0.523719609f, 0.000001f);
 		}
+
+		TEST_METHOD(TestFastSlerp)
+		{
+			Quaternion q0 = Quaternion::RotationAxis({ 1.0f, 2.0f, 3.0f }, 4.0f);
+			Quaternion q1 = Quaternion::RotationAxis({ 1.0f, -1.0f, 2.0f }, -2.0f);
+			AreNear(Slerp(q0, q1, 0.47f), FastSlerp(q0, q1, 0.47f), 1.5e-6f);
+
+			for (int i = 0; i < 2000; ++i)
+			{
+				const Quaternion a = RandomRotation();
+				const Quaternion b = i % 4 == 0 ? Normalize(a + RandomRotation() * 1e-3f) : RandomRotation();
+				const float t = i % 10 == 0 ? static_cast<float>(i % 20 == 0) : RandomFloat();
+				AreNear(SlerpReference(a, b, t), FastSlerp(a, b, t), 1.5e-6f);
+			}
+
+			// Opposite signs are the same rotation
+			const Quaternion q = RandomRotation();
+			AreNear(q, FastSlerp(q, -q, 0.3f), 1e-6f);
+			AreNear(q, FastSlerp(q, q, 0.7f), 1e-6f);
+		}
+
+		TEST_METHOD(TestNlerp)
+		{
+			// The documented bounds, in degrees, for rotations this far apart
+			const float angles[] = { 30.0f, 60.0f, 90.0f, 180.0f };
+			const float bounds[] = { 0.034f, 0.27f, 0.92f, 8.2f };
+			for (size_t i = 0; i < std::size(angles); ++i)
+			{
+				float worst = 0.0f;
+				for (int j = 0; j < 200; ++j)
+				{
+					const Quaternion a = RandomRotation();
+					const Quaternion b = a * Quaternion::RotationAxis(RandomUnitSphere(), angles[i] * Constants::DegToRad);
+					const float t = RandomFloat();
+					const Quaternion q = Nlerp(a, b, t);
+					Assert::AreEqual(1.0f, Magnitude(q), 1e-5f);
+					// From the chord rather than acos of the dot, which is too coarse near 1
+					const Quaternion r = SlerpReference(a, b, t);
+					const float chord = Magnitude(Dot(q, r) < 0.0f ? q + r : q - r);
+					worst = Max(worst, 4.0f * asinf(chord * 0.5f) * Constants::RadToDeg);
+				}
+				Assert::IsTrue(worst <= bounds[i] * 1.02f);
+			}
+			AreNear(Quaternion::Identity, Nlerp(Quaternion::Identity, -Quaternion::Identity, 0.5f), 1e-6f);
+		}
 	};
 }
\ No newline at end of file
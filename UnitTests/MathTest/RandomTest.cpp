@@ -0,0 +1,141 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+
+namespace
+{
+	void MeanAndDeviation(const std::vector<float>& values, double& mean, double& deviation)
+	{
+		mean = 0.0;
+		for (float v : values)
+			mean += v;
+		mean /= values.size();
+		double variance = 0.0;
+		for (float v : values)
+			variance += (v - mean) * (v - mean);
+		deviation = sqrt(variance / values.size());
+	}
+}
+
+namespace MathTest
+{
+	TEST_CLASS(RandomTest)
+	{
+	public:
+		TEST_METHOD(TestStreams)
+		{
+			RandomStream a(42), b(42), c(42, 1), d(43);
+			bool differentStream = false, differentSeed = false;
+			for (int i = 0; i < 100; ++i)
+			{
+				const uint32_t value = a.NextUInt();
+				Assert::AreEqual(value, b.NextUInt());
+				differentStream |= value != c.NextUInt();
+				differentSeed |= value != d.NextUInt();
+			}
+			Assert::IsTrue(differentStream);
+			Assert::IsTrue(differentSeed);
+
+			a.Seed(7, 3);
+			b.Seed(7, 3);
+			Assert::AreEqual(a.NextFloat(), b.NextFloat());
+		}
+
+		TEST_METHOD(TestRanges)
+		{
+			RandomStream stream(1234);
+			int counts[5] = {};
+			for (int i = 0; i < 10000; ++i)
+			{
+				const float f = stream.NextFloat(-2.0f, 3.0f);
+				Assert::IsTrue(f >= -2.0f && f < 3.0f);
+				const double d = stream.NextDouble();
+				Assert::IsTrue(d >= 0.0 && d < 1.0);
+				const int n = stream.NextInt(-2, 2);
+				Assert::IsTrue(n >= -2 && n <= 2);
+				++counts[n + 2];
+			}
+			for (int count : counts)
+				Assert::IsTrue(count > 1800 && count < 2200);
+
+			Assert::AreEqual(INT_MIN, RandomStream().NextInt(INT_MIN, INT_MIN));
+			const int wide = stream.NextInt(INT_MIN, INT_MAX);
+			Assert::IsTrue(wide >= INT_MIN && wide <= INT_MAX);
+		}
+
+		TEST_METHOD(TestFill)
+		{
+			// Every count around the SIMD switch and tail sizes
+			for (size_t count = 0; count < 40; ++count)
+			{
+				std::vector<float> uniforms(count + 1, -1.0f), normals(count + 1, -100.0f);
+				RandomStream stream(99);
+				stream.FillUniform(uniforms.data(), count, 5.0f, 6.0f);
+				stream.FillNormal(normals.data(), count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					Assert::IsTrue(uniforms[i] >= 5.0f && uniforms[i] < 6.0f);
+					Assert::IsTrue(std::isfinite(normals[i]));
+				}
+				Assert::AreEqual(-1.0f, uniforms[count]);
+				Assert::AreEqual(-100.0f, normals[count]);
+			}
+
+			std::vector<float> values(100000);
+			double mean, deviation;
+			RandomStream stream(5);
+			stream.FillUniform(values.data(), values.size());
+			MeanAndDeviation(values, mean, deviation);
+			Assert::AreEqual(0.5, mean, 0.01);
+			Assert::AreEqual(sqrt(1.0 / 12.0), deviation, 0.01);
+
+			stream.FillNormal(values.data(), values.size(), 3.0f, 2.0f);
+			MeanAndDeviation(values, mean, deviation);
+			Assert::AreEqual(3.0, mean, 0.03);
+			Assert::AreEqual(2.0, deviation, 0.03);
+
+			for (auto& v : values)
+				v = stream.NextNormal();
+			MeanAndDeviation(values, mean, deviation);
+			Assert::AreEqual(0.0, mean, 0.02);
+			Assert::AreEqual(1.0, deviation, 0.02);
+		}
+
+		TEST_METHOD(TestThreadStreams)
+		{
+			SeedRandom(2020);
+			const float first = RandomFloat();
+			SeedRandom(2020);
+			Assert::AreEqual(first, RandomFloat());
+
+			// Other threads get their own sequence
+			float other = first;
+			std::thread([&other]() { other = RandomFloat(); }).join();
+			Assert::AreNotEqual(first, other);
+		}
+
+		TEST_METHOD(TestBatchReproducible)
+		{
+			const size_t count = Batch::kParallelThreshold * 2 + 123;
+			std::vector<float> serial(count), parallel(count);
+			Batch::RandomUniform(17, serial.data(), count);
+			Batch::RandomNormal(17, serial.data() + count / 2, count / 2);
+
+			Angazi::Core::JobSystem::StaticInitialize(3);
+			Batch::RandomUniform(17, parallel.data(), count);
+			Batch::RandomNormal(17, parallel.data() + count / 2, count / 2);
+			Angazi::Core::JobSystem::StaticTerminate();
+
+			for (size_t i = 0; i < count; ++i)
+				Assert::AreEqual(serial[i], parallel[i]);
+
+			// Each block is a plain stream
+			std::vector<float> block(Batch::kRandomBlockSize);
+			RandomStream(17, 1).FillUniform(block.data(), block.size());
+			for (size_t i = 0; i < block.size(); ++i)
+				Assert::AreEqual(block[i], serial[Batch::kRandomBlockSize + i]);
+		}
+	};
+}
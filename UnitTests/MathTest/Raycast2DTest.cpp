@@ -0,0 +1,273 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "TestUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+using namespace MathTest::TestUtil;
+
+namespace
+{
+	void AreNear(const Vector2& expected, const Vector2& actual, float tolerance = 1e-3f)
+	{
+		Assert::AreEqual(expected.x, actual.x, tolerance);
+		Assert::AreEqual(expected.y, actual.y, tolerance);
+	}
+
+	float Cross(const Vector2& a, const Vector2& b)
+	{
+		return a.x * b.y - a.y * b.x;
+	}
+
+	bool SegmentReference(const Ray2D& ray, const LineSegment& segment, float maxDistance, float& t)
+	{
+		const Vector2 edge = segment.to - segment.from;
+		const Vector2 w = segment.from - ray.origin;
+		const float denominator = Cross(ray.direction, edge);
+		if (denominator == 0.0f)
+			return false;
+		t = Cross(w, edge) / denominator;
+		const float u = Cross(w, ray.direction) / denominator;
+		return t >= 0.0f && t <= maxDistance && u >= 0.0f && u <= 1.0f;
+	}
+
+	bool CircleReference(const Ray2D& ray, const Circle& circle, float maxDistance, float& t)
+	{
+		const Vector2 p = ray.origin - circle.center;
+		const float a = Dot(ray.direction, ray.direction);
+		const float b = Dot(p, ray.direction);
+		const float c = Dot(p, p) - circle.radius * circle.radius;
+		if (c <= 0.0f)
+		{
+			t = 0.0f;
+			return true;
+		}
+		const float disc = b * b - a * c;
+		t = (-b - sqrtf(disc)) / a;
+		return disc >= 0.0f && t >= 0.0f && t <= maxDistance;
+	}
+}
+
+namespace MathTest
+{
+	TEST_CLASS(Raycast2DTest)
+	{
+	public:
+		TEST_METHOD(TestShapeSoA)
+		{
+			LineSegmentSoA segments;
+			CircleSoA circles;
+			for (uint32_t i = 0; i < 11; ++i)
+			{
+				Assert::AreEqual(i, segments.Add({ static_cast<float>(i), 1.0f, 2.0f, 3.0f }));
+				Assert::AreEqual(i, circles.Add({ static_cast<float>(i), 1.0f, 0.5f }));
+			}
+			Assert::AreEqual(size_t(11), segments.Size());
+			Assert::AreEqual(7.0f, segments.Get(7).from.x);
+			Assert::AreEqual(3.0f, segments.Get(7).to.y);
+			Assert::AreEqual(7.0f, circles.Get(7).center.x);
+			Assert::AreEqual(0.5f, circles.Get(7).radius);
+			Assert::AreEqual(0.0f, circles.Component(CircleSoA::Radius)[15]);
+
+			segments.Set(3, { 1.0f, 2.0f, 3.0f, 4.0f });
+			Assert::AreEqual(4.0f, segments.Component(LineSegmentSoA::ToY)[3]);
+
+			circles.Clear();
+			Assert::IsTrue(circles.Empty());
+		}
+
+		TEST_METHOD(TestSimple)
+		{
+			LineSegmentSoA walls;
+			walls.Add({ 2.0f, -1.0f, 2.0f, 1.0f });
+			walls.Add({ 0.0f, -1.0f, 0.0f, 1.0f });
+			walls.Add({ 4.0f, 0.0f, 6.0f, 0.0f });
+
+			const Ray2D ray{ { -1.0f, 0.0f }, Vector2::XAxis };
+			RayHit2D hit = Batch::Raycast(ray, walls);
+			Assert::AreEqual(1u, hit.index);
+			Assert::AreEqual(1.0f, hit.distance, 1e-6f);
+			AreNear(-Vector2::XAxis, hit.normal);
+			Assert::IsFalse(Batch::Raycast(ray, walls, 0.5f).IsHit());
+			Assert::IsFalse(Batch::AnyHit(ray, walls, 0.5f));
+			Assert::IsTrue(Batch::AnyHit(ray, walls));
+
+			// Either side, and the end points count
+			hit = Batch::Raycast(Ray2D{ { 3.0f, 1.0f }, -Vector2::XAxis }, walls);
+			Assert::AreEqual(0u, hit.index);
+			Assert::AreEqual(1.0f, hit.distance, 1e-6f);
+			AreNear(Vector2::XAxis, hit.normal);
+
+			// A segment along the ray is hit at its nearer end, or at 0 from inside
+			hit = Batch::Raycast(Ray2D{ { 3.0f, 0.0f }, { 2.0f, 0.0f } }, walls);
+			Assert::AreEqual(2u, hit.index);
+			Assert::AreEqual(0.5f, hit.distance, 1e-6f);
+			AreNear(-Vector2::XAxis, hit.normal);
+			hit = Batch::Raycast(Ray2D{ { 5.0f, 0.0f }, -Vector2::XAxis }, walls);
+			Assert::AreEqual(2u, hit.index);
+			Assert::AreEqual(0.0f, hit.distance);
+			Assert::IsFalse(Batch::Raycast(Ray2D{ { 7.0f, 0.0f }, Vector2::XAxis }, walls).IsHit());
+
+			// Segment queries measure in fractions of the segment
+			hit = Batch::Raycast(LineSegment(-1.0f, 0.5f, 1.0f, 0.5f), walls);
+			Assert::AreEqual(1u, hit.index);
+			Assert::AreEqual(0.5f, hit.distance, 1e-6f);
+			Assert::IsTrue(Batch::AnyHit(LineSegment(-1.0f, 0.5f, 1.0f, 0.5f), walls));
+			Assert::IsFalse(Batch::AnyHit(LineSegment(0.5f, 0.5f, 1.5f, 0.5f), walls));
+			Assert::IsFalse(Batch::Raycast(ray, LineSegmentSoA()).IsHit());
+
+			CircleSoA circles;
+			circles.Add({ 10.0f, 0.0f, 1.0f });
+			circles.Add({ 5.0f, 0.0f, 1.0f });
+			circles.Add({ 5.0f, 5.0f, 1.0f });
+
+			// Unnormalized directions measure in direction lengths
+			hit = Batch::Raycast(Ray2D{ Vector2::Zero, { 2.0f, 0.0f } }, circles);
+			Assert::AreEqual(1u, hit.index);
+			Assert::AreEqual(2.0f, hit.distance, 1e-5f);
+			AreNear(-Vector2::XAxis, hit.normal);
+
+			// Sweeping a circle hits earlier and may clip circles the ray misses
+			hit = Batch::Raycast(Ray2D{ Vector2::Zero, Vector2::XAxis }, circles, 100.0f, 0.5f);
+			Assert::AreEqual(3.5f, hit.distance, 1e-5f);
+			hit = Batch::Raycast(Ray2D{ { 0.0f, 3.5f }, Vector2::XAxis }, circles, 100.0f, 1.0f);
+			Assert::AreEqual(2u, hit.index);
+			Assert::IsFalse(Batch::Raycast(Ray2D{ { 0.0f, 3.5f }, Vector2::XAxis }, circles).IsHit());
+			Assert::IsFalse(Batch::AnyHit(LineSegment(0.0f, 3.5f, 20.0f, 3.5f), circles));
+			Assert::IsTrue(Batch::AnyHit(LineSegment(0.0f, 3.5f, 20.0f, 3.5f), circles, 1.0f));
+
+			// Starting inside
+			hit = Batch::Raycast(Ray2D{ { 5.0f, 5.0f }, Vector2::YAxis }, circles);
+			Assert::AreEqual(2u, hit.index);
+			Assert::AreEqual(0.0f, hit.distance);
+			AreNear(-Vector2::YAxis, hit.normal);
+
+			hit = Batch::Raycast(LineSegment(0.0f, 0.0f, 8.0f, 0.0f), circles);
+			Assert::AreEqual(1u, hit.index);
+			Assert::AreEqual(0.5f, hit.distance, 1e-6f);
+
+			// Overlaps follow Intersect, touching does not count
+			Assert::IsFalse(Batch::Intersect(Circle(3.0f, 0.0f, 1.0f), circles));
+			Assert::IsTrue(Batch::Intersect(Circle(3.1f, 0.0f, 1.0f), circles));
+			Assert::IsTrue(Batch::Intersect(Circle(0.5f, 0.5f, 0.6f), walls));
+			Assert::IsFalse(Batch::Intersect(Circle(1.0f, 0.5f, 0.9f), walls));
+			Assert::IsTrue(Batch::Intersect(Circle(0.0f, 1.5f, 0.6f), walls));
+			Assert::IsFalse(Batch::Intersect(Circle(0.0f, 1.5f, 0.4f), walls));
+			Assert::IsFalse(Batch::Intersect(Circle(), CircleSoA()));
+		}
+
+		TEST_METHOD(TestSegmentsAndCircles)
+		{
+			for (size_t count : { 0, 1, 3, 4, 5, 8, 9, 15, 16, 17, 40 })
+			{
+				LineSegmentSoA segments;
+				CircleSoA circles;
+				for (size_t i = 0; i < count; ++i)
+				{
+					const Vector2 center = RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f });
+					segments.Add({ center, center + RandomUnitCircle() * RandomFloat(0.5f, 6.0f) });
+					circles.Add({ center, RandomFloat(0.5f, 3.0f) });
+				}
+
+				std::vector<Ray2D> rays;
+				for (int r = 0; r < 37; ++r)
+					rays.push_back(RandomRay2D());
+				for (const Ray2D& ray : rays)
+				{
+					for (float maxDistance : { 20.0f, std::numeric_limits<float>::max() })
+					{
+						float expected;
+						int index = NearestReference(count, expected, [&](size_t i, float& t)
+						{
+							return SegmentReference(ray, segments.Get(static_cast<uint32_t>(i)), maxDistance, t);
+						});
+						RayHit2D hit = Batch::Raycast(ray, segments, maxDistance);
+						Assert::AreEqual(index >= 0, hit.IsHit());
+						if (hit.IsHit())
+						{
+							Assert::AreEqual(static_cast<uint32_t>(index), hit.index);
+							Assert::AreEqual(expected, hit.distance, 1e-4f * Max(1.0f, expected));
+							const LineSegment segment = segments.Get(hit.index);
+							Assert::AreEqual(0.0f, Dot(hit.normal, segment.to - segment.from), 1e-4f);
+							Assert::IsTrue(Dot(hit.normal, ray.direction) <= 0.0f);
+						}
+
+						index = NearestReference(count, expected, [&](size_t i, float& t)
+						{
+							return CircleReference(ray, circles.Get(static_cast<uint32_t>(i)), maxDistance, t);
+						});
+						hit = Batch::Raycast(ray, circles, maxDistance);
+						Assert::AreEqual(index >= 0, hit.IsHit());
+						if (hit.IsHit())
+						{
+							Assert::AreEqual(static_cast<uint32_t>(index), hit.index);
+							Assert::AreEqual(expected, hit.distance, 1e-4f * Max(1.0f, expected));
+							AreNear(Normalize(ray.origin + ray.direction * hit.distance - circles.Get(hit.index).center), hit.normal);
+						}
+					}
+
+					// Sweeps are ray casts against the grown circles
+					const float radius = RandomFloat(0.1f, 2.0f);
+					CircleSoA grown;
+					for (size_t i = 0; i < count; ++i)
+					{
+						Circle circle = circles.Get(static_cast<uint32_t>(i));
+						circle.radius += radius;
+						grown.Add(circle);
+					}
+					const RayHit2D swept = Batch::Raycast(ray, circles, 50.0f, radius);
+					const RayHit2D expectedHit = Batch::Raycast(ray, grown, 50.0f);
+					Assert::AreEqual(expectedHit.index, swept.index);
+					Assert::AreEqual(expectedHit.distance, swept.distance, 1e-4f);
+					Assert::AreEqual(swept.IsHit(), Batch::AnyHit(ray, circles, 50.0f, radius));
+
+					// Segment queries against the single pair tests
+					const LineSegment query{ ray.origin, ray.origin + ray.direction * 30.0f };
+					bool anySegment = false;
+					for (size_t i = 0; i < count; ++i)
+						anySegment |= Intersect(query, segments.Get(static_cast<uint32_t>(i)));
+					Assert::AreEqual(anySegment, Batch::AnyHit(query, segments));
+					Assert::AreEqual(anySegment, Batch::Raycast(query, segments).IsHit());
+
+					const Circle probe{ RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f }), RandomFloat(0.1f, 2.0f) };
+					bool anyCircle = false, anyWall = false;
+					for (size_t i = 0; i < count; ++i)
+					{
+						anyCircle |= Intersect(probe, circles.Get(static_cast<uint32_t>(i)));
+						anyWall |= Intersect(probe, segments.Get(static_cast<uint32_t>(i)));
+					}
+					Assert::AreEqual(anyCircle, Batch::Intersect(probe, circles));
+					Assert::AreEqual(anyWall, Batch::Intersect(probe, segments));
+				}
+				CheckPackets(rays, segments, 20.0f);
+				CheckPackets(rays, circles, 20.0f);
+			}
+		}
+
+		TEST_METHOD(TestParallelPackets)
+		{
+			Angazi::Core::JobSystem::StaticInitialize(3);
+
+			LineSegmentSoA segments;
+			for (int i = 0; i < 50; ++i)
+			{
+				const Vector2 from = RandomVector2({ -10.0f, -10.0f }, { 10.0f, 10.0f });
+				segments.Add({ from, from + RandomUnitCircle() * 2.0f });
+			}
+			std::vector<Ray2D> rays(Batch::kParallelThreshold + 7);
+			for (auto& ray : rays)
+				ray = RandomRay2D();
+			std::vector<RayHit2D> hits(rays.size());
+			std::vector<uint32_t> hitMask((rays.size() + 31) / 32);
+			Batch::Raycast(rays.data(), rays.size(), segments, hits.data(), 25.0f);
+			Batch::AnyHit(rays.data(), rays.size(), segments, hitMask.data(), 25.0f);
+			for (size_t i = 0; i < rays.size(); ++i)
+				Assert::AreEqual(hits[i].IsHit(), (hitMask[i / 32] & (1u << (i % 32))) != 0);
+			for (size_t i = 0; i < rays.size(); i += 101)
+				AreEqual(Batch::Raycast(rays[i], segments, 25.0f), hits[i]);
+			AreEqual(Batch::Raycast(rays.back(), segments, 25.0f), hits.back());
+
+			Angazi::Core::JobSystem::StaticTerminate();
+		}
+	};
+}
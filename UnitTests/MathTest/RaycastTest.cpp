@@ -0,0 +1,242 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "TestUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+using namespace MathTest::TestUtil;
+
+namespace
+{
+	void AreNear(const Vector3& expected, const Vector3& actual, float tolerance = 1e-3f)
+	{
+		Assert::AreEqual(expected.x, actual.x, tolerance);
+		Assert::AreEqual(expected.y, actual.y, tolerance);
+		Assert::AreEqual(expected.z, actual.z, tolerance);
+	}
+
+	bool SlabReference(const Ray& ray, const Vector3& min, const Vector3& max, float& t)
+	{
+		float tNear = 0.0f, tFar = std::numeric_limits<float>::max();
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			const float t0 = (min.v[axis] - ray.origin.v[axis]) / ray.direction.v[axis];
+			const float t1 = (max.v[axis] - ray.origin.v[axis]) / ray.direction.v[axis];
+			tNear = Max(tNear, Min(t0, t1));
+			tFar = Min(tFar, Max(t0, t1));
+		}
+		t = tNear;
+		return tNear <= tFar;
+	}
+}
+
+namespace MathTest
+{
+	TEST_CLASS(RaycastTest)
+	{
+	public:
+		TEST_METHOD(TestShapeSoA)
+		{
+			SphereSoA spheres;
+			OBBSoA obbs;
+			for (uint32_t i = 0; i < 11; ++i)
+			{
+				Assert::AreEqual(i, spheres.Add({ static_cast<float>(i), 1.0f, 2.0f, 0.5f }));
+				obbs.Add({ { 1.0f, 2.0f, 3.0f }, { 0.5f, 1.0f, 2.0f }, Quaternion::RotationAxis(Vector3::YAxis, 0.3f) });
+			}
+			Assert::AreEqual(size_t(11), spheres.Size());
+			Assert::AreEqual(7.0f, spheres.Get(7).center.x);
+			Assert::AreEqual(0.0f, spheres.Component(SphereSoA::Radius)[15]);
+
+			AABBSoA aabbs;
+			aabbs.Add({ { 1.0f, 2.0f, 3.0f }, { 0.5f, 1.0f, 2.0f } });
+			AreNear({ 1.0f, 2.0f, 3.0f }, aabbs.Get(0).center, 1e-6f);
+			AreNear({ 0.5f, 1.0f, 2.0f }, aabbs.Get(0).extend, 1e-6f);
+			Assert::AreEqual(0.5f, aabbs.Component(AABBSoA::MinX)[0]);
+
+			const Matrix4 rotation = Matrix4::RotationQuaternion(obbs.Get(3).rot);
+			AreNear(GetLook(rotation), { obbs.Component(OBBSoA::LookX)[3], obbs.Component(OBBSoA::LookY)[3], obbs.Component(OBBSoA::LookZ)[3] }, 1e-6f);
+
+			spheres.Clear();
+			Assert::IsTrue(spheres.Empty());
+		}
+
+		TEST_METHOD(TestSimple)
+		{
+			SphereSoA spheres;
+			spheres.Add({ 0.0f, 0.0f, 10.0f, 1.0f });
+			spheres.Add({ 0.0f, 0.0f, 5.0f, 1.0f });
+			spheres.Add({ 5.0f, 0.0f, 2.0f, 1.0f });
+
+			const Ray ray{ Vector3::Zero, Vector3::ZAxis };
+			RayHit hit = Batch::Raycast(ray, spheres);
+			Assert::AreEqual(1u, hit.index);
+			Assert::AreEqual(4.0f, hit.distance, 1e-5f);
+			AreNear(-Vector3::ZAxis, hit.normal);
+
+			Assert::IsFalse(Batch::Raycast(ray, spheres, 3.0f).IsHit());
+			Assert::IsFalse(Batch::Raycast({ Vector3::Zero, -Vector3::ZAxis }, spheres).IsHit());
+
+			// Unnormalized directions measure in direction lengths
+			hit = Batch::Raycast({ Vector3::Zero, { 0.0f, 0.0f, 2.0f } }, spheres);
+			Assert::AreEqual(2.0f, hit.distance, 1e-5f);
+
+			// Starting inside
+			hit = Batch::Raycast({ { 5.0f, 0.0f, 2.0f }, Vector3::XAxis }, spheres);
+			Assert::AreEqual(2u, hit.index);
+			Assert::AreEqual(0.0f, hit.distance);
+			AreNear(-Vector3::XAxis, hit.normal);
+
+			AABBSoA aabbs;
+			aabbs.Add({ { 0.0f, 0.0f, 10.0f }, { 1.0f, 1.0f, 1.0f } });
+			aabbs.Add({ { 3.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } });
+			hit = Batch::Raycast({ Vector3::Zero, Vector3::XAxis }, aabbs);
+			Assert::AreEqual(1u, hit.index);
+			Assert::AreEqual(2.0f, hit.distance, 1e-5f);
+			AreNear(-Vector3::XAxis, hit.normal);
+
+			OBBSoA obbs;
+			obbs.Add({ { 0.0f, 0.0f, 10.0f }, { 1.0f, 1.0f, 1.0f }, Quaternion::RotationAxis(Vector3::YAxis, Constants::Pi * 0.25f) });
+			hit = Batch::Raycast(ray, obbs);
+			Assert::AreEqual(0u, hit.index);
+			Assert::AreEqual(10.0f - sqrtf(2.0f), hit.distance, 1e-4f);
+
+			PlaneSoA planes;
+			planes.Add({ Vector3::YAxis, -2.0f });
+			planes.Add({ Vector3::ZAxis, 3.0f });
+			hit = Batch::Raycast(ray, planes);
+			Assert::AreEqual(1u, hit.index);
+			Assert::AreEqual(3.0f, hit.distance, 1e-5f);
+			AreNear(-Vector3::ZAxis, hit.normal);
+			Assert::IsFalse(Batch::Raycast(ray, PlaneSoA()).IsHit());
+		}
+
+		TEST_METHOD(TestSpheresAndAABBs)
+		{
+			for (size_t count = 0; count < 20; ++count)
+			{
+				SphereSoA spheres;
+				AABBSoA aabbs;
+				for (size_t i = 0; i < count; ++i)
+				{
+					const Vector3 center = RandomVector3({ -10.0f, -10.0f, -10.0f }, { 10.0f, 10.0f, 10.0f });
+					spheres.Add({ center, RandomFloat(0.5f, 3.0f) });
+					aabbs.Add({ center, RandomVector3({ 0.5f, 0.5f, 0.5f }, { 3.0f, 3.0f, 3.0f }) });
+				}
+
+				std::vector<Ray> rays;
+				for (int r = 0; r < 9; ++r)
+					rays.push_back(RandomRay());
+				for (const Ray& ray : rays)
+				{
+					float expected;
+					int index = NearestReference(count, expected, [&](size_t i, float& t)
+					{
+						const Sphere s = spheres.Get(static_cast<uint32_t>(i));
+						const Vector3 p = ray.origin - s.center;
+						const float b = Dot(p, ray.direction);
+						const float disc = b * b - (Dot(p, p) - s.radius * s.radius);
+						t = -b - sqrtf(disc);
+						return disc >= 0.0f && t >= 0.0f;
+					});
+					RayHit hit = Batch::Raycast(ray, spheres);
+					Assert::AreEqual(index >= 0, hit.IsHit());
+					if (hit.IsHit())
+					{
+						Assert::AreEqual(static_cast<uint32_t>(index), hit.index);
+						Assert::AreEqual(expected, hit.distance, 1e-4f * Max(1.0f, expected));
+						AreNear(Normalize(ray.origin + ray.direction * hit.distance - spheres.Get(hit.index).center), hit.normal);
+					}
+
+					index = NearestReference(count, expected, [&](size_t i, float& t)
+					{
+						const AABB box = aabbs.Get(static_cast<uint32_t>(i));
+						return SlabReference(ray, box.Min(), box.Max(), t);
+					});
+					hit = Batch::Raycast(ray, aabbs);
+					Assert::AreEqual(index >= 0, hit.IsHit());
+					if (hit.IsHit())
+					{
+						Assert::AreEqual(static_cast<uint32_t>(index), hit.index);
+						Assert::AreEqual(expected, hit.distance, 1e-4f * Max(1.0f, expected));
+						Assert::AreEqual(1.0f, Magnitude(hit.normal), 1e-5f);
+					}
+				}
+				CheckPackets(rays, spheres);
+				CheckPackets(rays, aabbs);
+			}
+		}
+
+		TEST_METHOD(TestOBBsAndPlanes)
+		{
+			for (size_t count = 0; count < 20; ++count)
+			{
+				OBBSoA obbs;
+				PlaneSoA planes;
+				for (size_t i = 0; i < count; ++i)
+				{
+					obbs.Add({ RandomVector3({ -10.0f, -10.0f, -10.0f }, { 10.0f, 10.0f, 10.0f }), RandomVector3({ 0.5f, 0.5f, 0.5f }, { 3.0f, 3.0f, 3.0f }), RandomRotation() });
+					planes.Add({ RandomUnitSphere(), RandomFloat(-50.0f, 50.0f) });
+				}
+
+				std::vector<Ray> rays;
+				for (int r = 0; r < 9; ++r)
+					rays.push_back(RandomRay());
+				for (const Ray& ray : rays)
+				{
+					float expected;
+					int index = NearestReference(count, expected, [&](size_t i, float& t)
+					{
+						const OBB obb = obbs.Get(static_cast<uint32_t>(i));
+						const Matrix4 toLocal = InverseAffine(Matrix4::RotationQuaternion(obb.rot) * Matrix4::Translation(obb.center));
+						const Ray local{ TransformCoord(ray.origin, toLocal), TransformNormal(ray.direction, toLocal) };
+						return SlabReference(local, -obb.extend, obb.extend, t);
+					});
+					RayHit hit = Batch::Raycast(ray, obbs);
+					Assert::AreEqual(index >= 0, hit.IsHit());
+					if (hit.IsHit())
+					{
+						Assert::AreEqual(static_cast<uint32_t>(index), hit.index);
+						Assert::AreEqual(expected, hit.distance, 1e-4f * Max(1.0f, expected));
+						Assert::AreEqual(1.0f, Magnitude(hit.normal), 1e-5f);
+						Assert::IsTrue(Dot(hit.normal, ray.direction) <= 0.0f);
+					}
+
+					index = NearestReference(count, expected, [&](size_t i, float& t)
+					{
+						return Intersect(ray, planes.Get(static_cast<uint32_t>(i)), t) && t >= 0.0f;
+					});
+					hit = Batch::Raycast(ray, planes);
+					Assert::AreEqual(index >= 0, hit.IsHit());
+					if (hit.IsHit())
+					{
+						Assert::AreEqual(static_cast<uint32_t>(index), hit.index);
+						Assert::AreEqual(expected, hit.distance, 1e-4f * Max(1.0f, expected));
+						Assert::IsTrue(Dot(hit.normal, ray.direction) <= 0.0f);
+					}
+				}
+				CheckPackets(rays, obbs);
+				CheckPackets(rays, planes);
+			}
+		}
+
+		TEST_METHOD(TestParallelPackets)
+		{
+			Angazi::Core::JobSystem::StaticInitialize(3);
+
+			AABBSoA aabbs;
+			for (int i = 0; i < 50; ++i)
+				aabbs.Add({ RandomVector3({ -10.0f, -10.0f, -10.0f }, { 10.0f, 10.0f, 10.0f }), Vector3::One });
+			std::vector<Ray> rays(Batch::kParallelThreshold + 7);
+			for (auto& ray : rays)
+				ray = RandomRay();
+			std::vector<RayHit> hits(rays.size());
+			Batch::Raycast(rays.data(), rays.size(), aabbs, hits.data());
+			for (size_t i = 0; i < rays.size(); i += 101)
+				AreEqual(Batch::Raycast(rays[i], aabbs), hits[i]);
+			AreEqual(Batch::Raycast(rays.back(), aabbs), hits.back());
+
+			Angazi::Core::JobSystem::StaticTerminate();
+		}
+	};
+}
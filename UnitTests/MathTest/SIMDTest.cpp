@@ -0,0 +1,92 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "TestUtil.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+using namespace MathTest::TestUtil;
+
+namespace
+{
+	// Evaluated by the compiler, so these always go through the scalar path
+	constexpr Matrix4 kTransform
+	{
+		0.0f, 2.0f, 0.0f, 0.0f,
+		-2.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.5f, 0.0f,
+		3.0f, -4.0f, 5.0f, 1.0f
+	};
+	constexpr Matrix4 kProjection
+	{
+		1.5f, 0.0f, 0.0f, 0.0f,
+		0.0f, 2.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.1f, 1.0f,
+		0.0f, 0.0f, -0.2f, 0.0f
+	};
+	constexpr Matrix4 kProduct = kTransform * kProjection;
+	constexpr Matrix4 kInverse = Inverse(kProjection);
+	constexpr Matrix4 kInverseAffine = InverseAffine(kTransform);
+	constexpr Vector3 kPoint = TransformCoord(Vector3{ 1.0f, 2.0f, 3.0f }, kProjection);
+	constexpr Vector3 kNormal = TransformNormal(Vector3{ 1.0f, 2.0f, 3.0f }, kTransform);
+	constexpr Vector4 kVector = Transform(Vector4{ 1.0f, 2.0f, 3.0f, 1.0f }, kProjection);
+
+	void AreNear(const Matrix4& expected, const Matrix4& actual, float tolerance = 1e-4f)
+	{
+		for (size_t i = 0; i < 16; ++i)
+			Assert::AreEqual(expected.v[i], actual.v[i], tolerance);
+	}
+	void AreNear(const Vector3& expected, const Vector3& actual, float tolerance = 1e-4f)
+	{
+		Assert::AreEqual(expected.x, actual.x, tolerance);
+		Assert::AreEqual(expected.y, actual.y, tolerance);
+		Assert::AreEqual(expected.z, actual.z, tolerance);
+	}
+}
+
+namespace MathTest
+{
+	TEST_CLASS(SIMDTest)
+	{
+	public:
+		TEST_METHOD(TestMatchesConstexpr)
+		{
+			// Same inputs at runtime take the SIMD path when it is enabled
+			Matrix4 transform = kTransform;
+			Matrix4 projection = kProjection;
+
+			AreNear(kProduct, transform * projection);
+			AreNear(kInverse, Inverse(projection));
+			AreNear(kInverseAffine, InverseAffine(transform));
+			AreNear(kPoint, TransformCoord(Vector3{ 1.0f, 2.0f, 3.0f }, projection));
+			AreNear(kNormal, TransformNormal(Vector3{ 1.0f, 2.0f, 3.0f }, transform));
+
+			const Vector4 v = Transform(Vector4{ 1.0f, 2.0f, 3.0f, 1.0f }, projection);
+			Assert::AreEqual(kVector.x, v.x, 1e-4f);
+			Assert::AreEqual(kVector.y, v.y, 1e-4f);
+			Assert::AreEqual(kVector.z, v.z, 1e-4f);
+			Assert::AreEqual(kVector.w, v.w, 1e-4f);
+		}
+
+		TEST_METHOD(TestMatchesScalar)
+		{
+			for (int i = 0; i < 100; ++i)
+			{
+				const Quaternion q0 = RandomRotation();
+				const Quaternion q1 = RandomRotation();
+				const Quaternion q = q0 * q1;
+				const Quaternion expected = Scalar::Multiply(q0, q1);
+				Assert::AreEqual(expected.x, q.x, 1e-5f);
+				Assert::AreEqual(expected.y, q.y, 1e-5f);
+				Assert::AreEqual(expected.z, q.z, 1e-5f);
+				Assert::AreEqual(expected.w, q.w, 1e-5f);
+
+				const Matrix4 a = Matrix4::Transform(RandomVector3(), q0, Vector3(RandomFloat(0.5f, 2.0f)));
+				const Matrix4 b = Matrix4::Transform(RandomVector3(), q1, RandomVector3({ 0.5f, 0.5f, 0.5f }, { 2.0f, 2.0f, 2.0f }));
+				AreNear(Scalar::Multiply(a, b), a * b);
+				AreNear(Scalar::Inverse(a), Inverse(a));
+				AreNear(Scalar::Inverse(b), InverseAffine(b));
+				AreNear(Matrix4::Identity, b * InverseAffine(b));
+			}
+		}
+	};
+}
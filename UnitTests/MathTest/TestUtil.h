@@ -0,0 +1,118 @@
+#pragma once
+
+// Random shapes and ray hit checks shared by the MathTest files
+namespace MathTest::TestUtil
+{
+	using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+	using namespace Angazi::Math;
+
+	inline Quaternion RandomRotation()
+	{
+		return Normalize(Quaternion(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f)));
+	}
+
+	// 90 degree field of view, square, looking down +z from the origin
+	inline Matrix4 PerspectiveMatrix(float zn, float zf)
+	{
+		const float d = zf / (zf - zn);
+		return
+		{
+			1.0f, 0.0f, 0.0f,		0.0f,
+			0.0f, 1.0f, 0.0f,		0.0f,
+			0.0f, 0.0f, d,			1.0f,
+			0.0f, 0.0f, -zn * d,	0.0f
+		};
+	}
+
+	// Randomly oriented, positioned within 'range' of the origin
+	inline Frustum RandomFrustum(float zf = 20.0f, float range = 1.0f)
+	{
+		const Matrix4 view = InverseAffine(Matrix4::RotationQuaternion(RandomRotation()) * Matrix4::Translation(RandomVector3({ -range, -range, -range }, { range, range, range })));
+		return Frustum::FromViewProjection(view * PerspectiveMatrix(0.5f, zf));
+	}
+
+	// Starts 'distance' from the origin and points through a box of half size 'spread'
+	inline Ray RandomRay(float distance = 30.0f, float spread = 8.0f)
+	{
+		const Vector3 origin = RandomUnitSphere() * distance;
+		const Vector3 target = RandomVector3({ -spread, -spread, -spread }, { spread, spread, spread });
+		return { origin, Normalize(target - origin) };
+	}
+
+	inline Ray2D RandomRay2D(float distance = 30.0f, float spread = 8.0f)
+	{
+		const Vector2 origin = RandomUnitCircle() * distance;
+		const Vector2 target = RandomVector2({ -spread, -spread }, { spread, spread });
+		return { origin, Normalize(target - origin) };
+	}
+
+	inline void AreEqual(const RayHit& expected, const RayHit& actual)
+	{
+		Assert::AreEqual(expected.index, actual.index);
+		Assert::AreEqual(expected.distance, actual.distance);
+		Assert::AreEqual(expected.normal.x, actual.normal.x);
+		Assert::AreEqual(expected.normal.y, actual.normal.y);
+		Assert::AreEqual(expected.normal.z, actual.normal.z);
+	}
+
+	inline void AreEqual(const RayHit2D& expected, const RayHit2D& actual)
+	{
+		Assert::AreEqual(expected.index, actual.index);
+		Assert::AreEqual(expected.distance, actual.distance);
+		Assert::AreEqual(expected.normal.x, actual.normal.x);
+		Assert::AreEqual(expected.normal.y, actual.normal.y);
+	}
+
+	// Nearest of the scalar references, -1 for no hit
+	template <class Fn>
+	int NearestReference(size_t count, float& nearest, Fn&& distance)
+	{
+		int index = -1;
+		nearest = std::numeric_limits<float>::max();
+		for (size_t i = 0; i < count; ++i)
+		{
+			float t;
+			if (distance(i, t) && t < nearest)
+			{
+				nearest = t;
+				index = static_cast<int>(i);
+			}
+		}
+		return index;
+	}
+
+	// Single ray against every packet size, packets must give the same hits
+	template <class Shapes>
+	void CheckPackets(const std::vector<Ray>& rays, const Shapes& shapes)
+	{
+		for (size_t count = 1; count <= rays.size(); ++count)
+		{
+			std::vector<RayHit> hits(count);
+			Batch::Raycast(rays.data(), count, shapes, hits.data());
+			for (size_t i = 0; i < count; ++i)
+				AreEqual(Batch::Raycast(rays[i], shapes), hits[i]);
+		}
+	}
+
+	// As above, the any hit masks must agree with the nearest hits as well
+	template <class Shapes>
+	void CheckPackets(const std::vector<Ray2D>& rays, const Shapes& shapes, float maxDistance)
+	{
+		for (size_t count = 1; count <= rays.size(); ++count)
+		{
+			std::vector<RayHit2D> hits(count);
+			std::vector<uint32_t> hitMask((count + 31) / 32, 0xFFFFFFFF);
+			Batch::Raycast(rays.data(), count, shapes, hits.data(), maxDistance);
+			Batch::AnyHit(rays.data(), count, shapes, hitMask.data(), maxDistance);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const RayHit2D hit = Batch::Raycast(rays[i], shapes, maxDistance);
+				AreEqual(hit, hits[i]);
+				Assert::AreEqual(hit.IsHit(), Batch::AnyHit(rays[i], shapes, maxDistance));
+				Assert::AreEqual(hit.IsHit(), (hitMask[i / 32] & (1u << (i % 32))) != 0);
+			}
+			if (count % 32 != 0)
+				Assert::AreEqual(0u, hitMask.back() >> (count % 32));
+		}
+	}
+}
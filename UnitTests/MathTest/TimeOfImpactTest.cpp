@@ -0,0 +1,123 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi::Math;
+
+namespace
+{
+	void AreNear(const Vector3& expected, const Vector3& actual, float tolerance = 1e-5f)
+	{
+		Assert::AreEqual(expected.x, actual.x, tolerance);
+		Assert::AreEqual(expected.y, actual.y, tolerance);
+		Assert::AreEqual(expected.z, actual.z, tolerance);
+	}
+}
+
+namespace MathTest
+{
+	TEST_CLASS(TimeOfImpactTest)
+	{
+	public:
+		TEST_METHOD(TestPlane)
+		{
+			const Plane ground{ Vector3::YAxis, 0.0f };
+			float toi = -1.0f;
+
+			Assert::IsTrue(GetTimeOfImpact({ 0.0f, 5.0f, 0.0f, 1.0f }, { 0.0f, -8.0f, 0.0f }, ground, toi));
+			Assert::AreEqual(0.5f, toi, 1e-6f);
+
+			// Fast enough to pass through the plane several times over in one step
+			Assert::IsTrue(GetTimeOfImpact({ 0.0f, 5.0f, 0.0f, 1.0f }, { 3.0f, -1000.0f, 0.0f }, ground, toi));
+			Assert::AreEqual(4.0f / 1000.0f, toi, 1e-6f);
+
+			// Already touching or inside
+			Assert::IsTrue(GetTimeOfImpact({ 0.0f, 1.0f, 0.0f, 1.0f }, { 0.0f, -1.0f, 0.0f }, ground, toi));
+			Assert::AreEqual(0.0f, toi);
+			toi = -1.0f;
+			Assert::IsTrue(GetTimeOfImpact({ 0.0f, 0.5f, 0.0f, 1.0f }, { 1.0f, -1.0f, 0.0f }, ground, toi));
+			Assert::AreEqual(0.0f, toi);
+
+			// Stops short, moves away, or comes from behind
+			Assert::IsFalse(GetTimeOfImpact({ 0.0f, 5.0f, 0.0f, 1.0f }, { 0.0f, -3.0f, 0.0f }, ground, toi));
+			Assert::IsFalse(GetTimeOfImpact({ 0.0f, 5.0f, 0.0f, 1.0f }, { 5.0f, 0.0f, 0.0f }, ground, toi));
+			Assert::IsFalse(GetTimeOfImpact({ 0.0f, 0.5f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, ground, toi));
+			Assert::IsFalse(GetTimeOfImpact({ 0.0f, -2.0f, 0.0f, 1.0f }, { 0.0f, -1.0f, 0.0f }, ground, toi));
+		}
+
+		TEST_METHOD(TestThinOBB)
+		{
+			// A slab far thinner than the distance covered in one step
+			const OBB slab{ Vector3::Zero, { 5.0f, 0.01f, 5.0f } };
+			float toi = -1.0f;
+			Vector3 normal;
+			Assert::IsTrue(GetTimeOfImpact({ 0.0f, 10.0f, 0.0f, 0.5f }, { 0.0f, -100.0f, 0.0f }, slab, toi, normal));
+			Assert::AreEqual((10.0f - 0.51f) / 100.0f, toi, 1e-6f);
+			AreNear(Vector3::YAxis, normal);
+
+			Assert::IsTrue(GetTimeOfImpact({ 0.0f, -10.0f, 0.0f, 0.5f }, { 1.0f, 100.0f, 0.0f }, slab, toi, normal));
+			Assert::AreEqual((10.0f - 0.51f) / 100.0f, toi, 1e-6f);
+			AreNear(-Vector3::YAxis, normal);
+
+			// Rotated so the thin side faces +/-Z
+			const OBB wall{ { 0.0f, 0.0f, 0.0f }, { 0.01f, 1.0f, 1.0f }, Quaternion::RotationAxis(Vector3::YAxis, Constants::Pi * 0.5f) };
+			Assert::IsTrue(GetTimeOfImpact({ 0.0f, 0.0f, -5.0f, 0.1f }, { 0.0f, 0.0f, 100.0f }, wall, toi, normal));
+			Assert::AreEqual((5.0f - 0.11f) / 100.0f, toi, 1e-5f);
+			AreNear(-Vector3::ZAxis, normal, 1e-4f);
+		}
+
+		TEST_METHOD(TestGrazingOBB)
+		{
+			const OBB box;
+			float toi = -1.0f;
+			Vector3 normal;
+
+			// Passes just inside the top edge, the inflated box has square edges so this is a hit
+			Assert::IsTrue(GetTimeOfImpact({ -5.0f, 1.4f, 0.0f, 0.5f }, { 10.0f, 0.0f, 0.0f }, box, toi, normal));
+			Assert::AreEqual(0.35f, toi, 1e-6f);
+			AreNear(-Vector3::XAxis, normal);
+
+			// Just above it
+			Assert::IsFalse(GetTimeOfImpact({ -5.0f, 1.6f, 0.0f, 0.5f }, { 10.0f, 0.0f, 0.0f }, box, toi, normal));
+		}
+
+		TEST_METHOD(TestStartInsideOBB)
+		{
+			const OBB box;
+			float toi = -1.0f;
+			Vector3 normal;
+
+			// Touching the -X face
+			Assert::IsTrue(GetTimeOfImpact({ -1.5f, 0.0f, 0.0f, 0.5f }, { 1.0f, 0.0f, 0.0f }, box, toi, normal));
+			Assert::AreEqual(0.0f, toi);
+			AreNear(-Vector3::XAxis, normal);
+
+			// Overlapping, pushed out through the face with the least penetration
+			toi = -1.0f;
+			Assert::IsTrue(GetTimeOfImpact({ 0.9f, 0.2f, 0.0f, 0.5f }, { -1.0f, 0.0f, 0.0f }, box, toi, normal));
+			Assert::AreEqual(0.0f, toi);
+			AreNear(Vector3::XAxis, normal);
+
+			// Already leaving through that face
+			Assert::IsFalse(GetTimeOfImpact({ 0.9f, 0.2f, 0.0f, 0.5f }, { 1.0f, 0.0f, 0.0f }, box, toi, normal));
+		}
+
+		TEST_METHOD(TestMissOBB)
+		{
+			const OBB box;
+			float toi = -1.0f;
+			Vector3 normal;
+
+			// Heading straight at the box but stopping before contact
+			Assert::IsFalse(GetTimeOfImpact({ -5.0f, 0.0f, 0.0f, 0.5f }, { 2.0f, 0.0f, 0.0f }, box, toi, normal));
+			Assert::IsFalse(GetTimeOfImpact({ -5.0f, 0.0f, 0.0f, 0.5f }, { 3.49f, 0.0f, 0.0f }, box, toi, normal));
+			Assert::IsTrue(GetTimeOfImpact({ -5.0f, 0.0f, 0.0f, 0.5f }, { 3.5f, 0.0f, 0.0f }, box, toi, normal));
+			Assert::AreEqual(1.0f, toi, 1e-6f);
+
+			// Moving past the side, toi is left untouched
+			toi = -1.0f;
+			Assert::IsFalse(GetTimeOfImpact({ -5.0f, 0.0f, 3.0f, 0.5f }, { 10.0f, 0.0f, 0.0f }, box, toi, normal));
+			Assert::AreEqual(-1.0f, toi);
+		}
+	};
+}
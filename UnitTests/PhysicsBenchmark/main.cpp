@@ -0,0 +1,424 @@
+// Headless physics benchmark. Builds Framework/Physics with PHYSICS_HEADLESS so no Graphics
+// or window is needed, runs a set of fixed scenes and reports timings plus state hashes.
+//
+// The state hashes make the run a deterministic replay: record a golden file before an
+// optimisation, then verify against it afterwards to prove the simulation did not change.
+
+#include <Physics/Inc/Physics.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+using namespace Angazi;
+using namespace Angazi::Physics;
+
+struct Arguments
+{
+	const char* recordFileName = nullptr;
+	const char* verifyFileName = nullptr;
+	const char* sceneFilter = nullptr;
+	int steps = 600;
+	int hashInterval = 60;
+};
+
+// Scene setup must not depend on the global Math random engine, it is seeded per run
+class SceneRandom
+{
+public:
+	explicit SceneRandom(uint32_t seed) : mState(seed) {}
+
+	float Float(float min, float max)
+	{
+		mState = mState * 1664525u + 1013904223u;
+		return min + (max - min) * ((mState >> 8) * (1.0f / 16777216.0f));
+	}
+
+private:
+	uint32_t mState;
+};
+
+struct Scene
+{
+	PhysicsWorld world;
+	std::vector<Particle*> particles;
+	size_t constraintCount = 0;
+	int iterations = 1;
+
+	Particle* AddParticle(const Math::Vector3& position, float radius, float bounce)
+	{
+		auto p = new Particle();
+		p->SetPosition(position);
+		p->radius = radius;
+		p->bounce = bounce;
+		world.AddParticles(p);
+		particles.push_back(p);
+		return p;
+	}
+
+	void AddSpring(Particle* a, Particle* b)
+	{
+		world.AddConstraint(new Spring(a, b));
+		++constraintCount;
+	}
+
+	void AddFixed(Particle* p)
+	{
+		world.AddConstraint(new Fixed(p));
+		++constraintCount;
+	}
+};
+
+using SceneBuilder = void(*)(Scene&);
+
+struct SceneDesc
+{
+	const char* name;
+	SceneBuilder build;
+};
+
+void InitializeWorld(Scene& scene, int iterations)
+{
+	PhysicsWorld::Settings settings;
+	settings.iterations = iterations;
+	scene.iterations = iterations;
+	scene.world.Initialize(settings);
+	scene.world.AddStaticPlane({ Math::Vector3::YAxis, 0.0f });
+}
+
+void BuildParticleRain(Scene& scene)
+{
+	InitializeWorld(scene, 1);
+	scene.world.AddStaticOBB({ { 0.0f, 2.0f, 0.0f }, { 4.0f, 0.5f, 4.0f }, Math::Quaternion::RotationAxis(Math::Vector3::ZAxis, 0.3f) });
+	scene.world.AddStaticOBB({ { 6.0f, 1.0f, 6.0f }, { 2.0f, 1.0f, 2.0f }, Math::Quaternion::Identity });
+
+	SceneRandom random(1);
+	for (int i = 0; i < 20000; ++i)
+	{
+		auto p = scene.AddParticle({ random.Float(-10.0f, 10.0f), random.Float(5.0f, 30.0f), random.Float(-10.0f, 10.0f) }, 0.1f, 0.5f);
+		p->SetVelocity({ random.Float(-0.05f, 0.05f), random.Float(-0.1f, 0.0f), random.Float(-0.05f, 0.05f) });
+	}
+}
+
+void BuildCloth(Scene& scene)
+{
+	InitializeWorld(scene, 4);
+
+	constexpr int rows = 128;
+	constexpr int columns = 128;
+	constexpr float spacing = 0.1f;
+	const size_t first = scene.particles.size();
+	for (int y = 0; y < rows; ++y)
+		for (int x = 0; x < columns; ++x)
+			scene.AddParticle({ (x - columns * 0.5f) * spacing, 15.0f, y * spacing }, 0.02f, 0.2f);
+
+	auto at = [&](int x, int y) { return scene.particles[first + y * columns + x]; };
+	for (int y = 0; y < rows; ++y)
+	{
+		for (int x = 0; x < columns; ++x)
+		{
+			if (x + 1 < columns)
+				scene.AddSpring(at(x, y), at(x + 1, y));
+			if (y + 1 < rows)
+				scene.AddSpring(at(x, y), at(x, y + 1));
+		}
+	}
+	scene.AddFixed(at(0, 0));
+	scene.AddFixed(at(columns - 1, 0));
+}
+
+void BuildRagdolls(Scene& scene)
+{
+	InitializeWorld(scene, 2);
+
+	// Stick figure: head, neck, pelvis, shoulders, elbows, hands, hips, knees, feet
+	const Math::Vector3 joints[] =
+	{
+		{ 0.0f, 1.75f, 0.0f }, { 0.0f, 1.5f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+		{ -0.2f, 1.45f, 0.0f }, { -0.45f, 1.2f, 0.0f }, { -0.6f, 0.95f, 0.0f },
+		{ 0.2f, 1.45f, 0.0f }, { 0.45f, 1.2f, 0.0f }, { 0.6f, 0.95f, 0.0f },
+		{ -0.1f, 0.95f, 0.0f }, { -0.12f, 0.5f, 0.0f }, { -0.12f, 0.05f, 0.0f },
+		{ 0.1f, 0.95f, 0.0f }, { 0.12f, 0.5f, 0.0f }, { 0.12f, 0.05f, 0.0f }
+	};
+	const int bones[][2] =
+	{
+		{ 0, 1 }, { 1, 2 }, { 1, 3 }, { 3, 4 }, { 4, 5 }, { 1, 6 }, { 6, 7 }, { 7, 8 },
+		{ 2, 9 }, { 9, 10 }, { 10, 11 }, { 2, 12 }, { 12, 13 }, { 13, 14 },
+		{ 3, 6 }, { 9, 12 }, { 3, 2 }, { 6, 2 }, { 3, 9 }, { 6, 12 }
+	};
+
+	SceneRandom random(3);
+	for (int i = 0; i < 500; ++i)
+	{
+		const Math::Vector3 offset{ (i % 25) * 1.5f - 18.0f, 2.0f + (i / 25) * 0.5f, (i / 25) * 1.5f - 15.0f };
+		const Math::Vector3 velocity{ random.Float(-0.02f, 0.02f), 0.0f, random.Float(-0.02f, 0.02f) };
+		const size_t first = scene.particles.size();
+		for (auto& joint : joints)
+			scene.AddParticle(joint + offset, 0.05f, 0.3f)->SetVelocity(velocity);
+		for (auto& bone : bones)
+			scene.AddSpring(scene.particles[first + bone[0]], scene.particles[first + bone[1]]);
+	}
+}
+
+void BuildBoxStack(Scene& scene)
+{
+	InitializeWorld(scene, 8);
+
+	// Particles do not collide with each other, so each box rests on its own static shelf
+	for (int level = 0; level < 50; ++level)
+	{
+		const float y = level * 1.5f;
+		scene.world.AddStaticOBB({ { 0.0f, y + 0.25f, 0.0f }, { 1.0f, 0.25f, 1.0f }, Math::Quaternion::RotationAxis(Math::Vector3::XAxis, level * 0.01f) });
+		for (int i = 0; i < 4; ++i)
+		{
+			const Math::Vector3 center{ -0.6f + (i % 2) * 1.2f, y + 1.0f, -0.6f + (i / 2) * 1.2f };
+			Particle* corners[8];
+			for (int c = 0; c < 8; ++c)
+			{
+				const Math::Vector3 corner{ (c & 1) ? 0.25f : -0.25f, (c & 2) ? 0.25f : -0.25f, (c & 4) ? 0.25f : -0.25f };
+				corners[c] = scene.AddParticle(center + corner, 0.05f, 0.1f);
+			}
+			for (int a = 0; a < 8; ++a)
+				for (int b = a + 1; b < 8; ++b)
+					scene.AddSpring(corners[a], corners[b]);
+		}
+	}
+}
+
+void BuildDebris(Scene& scene)
+{
+	InitializeWorld(scene, 1);
+	scene.world.AddStaticOBB({ { 0.0f, 1.0f, 0.0f }, { 5.0f, 1.0f, 5.0f }, Math::Quaternion::RotationAxis(Math::Vector3::XAxis, 0.2f) });
+
+	// Rigid chunks held by one shape matching cluster each instead of a spring lattice
+	SceneRandom random(4);
+	for (int i = 0; i < 2000; ++i)
+	{
+		const Math::Vector3 center{ random.Float(-8.0f, 8.0f), random.Float(3.0f, 20.0f), random.Float(-8.0f, 8.0f) };
+		const Math::Vector3 velocity{ random.Float(-0.05f, 0.05f), 0.0f, random.Float(-0.05f, 0.05f) };
+		std::vector<Particle*> chunk;
+		for (int c = 0; c < 8; ++c)
+		{
+			const Math::Vector3 corner{ random.Float(-0.3f, 0.3f), random.Float(-0.3f, 0.3f), random.Float(-0.3f, 0.3f) };
+			chunk.push_back(scene.AddParticle(center + corner, 0.05f, 0.2f));
+			chunk.back()->SetVelocity(velocity + corner * 0.05f);
+		}
+		scene.world.AddConstraint(new RigidCluster(std::move(chunk)));
+		++scene.constraintCount;
+	}
+}
+
+// FNV-1a over the raw bits of every particle position, any change in the simulation shows up here
+uint64_t HashState(const Scene& scene)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (auto p : scene.particles)
+	{
+		const auto bytes = reinterpret_cast<const uint8_t*>(&p->position);
+		for (size_t i = 0; i < sizeof(Math::Vector3); ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+struct SceneResult
+{
+	std::string name;
+	std::vector<uint64_t> hashes; // one per hash interval, the last entry is the final state
+	size_t particleCount = 0;
+	size_t constraintCount = 0;
+	int iterations = 1;
+	double seconds = 0.0;
+};
+
+SceneResult RunScene(const SceneDesc& desc, const Arguments& args)
+{
+	Scene scene;
+	desc.build(scene);
+
+	SceneResult result;
+	result.name = desc.name;
+	result.particleCount = scene.particles.size();
+	result.constraintCount = scene.constraintCount;
+	result.iterations = scene.iterations;
+
+	// Feeding exactly one time step per update keeps the accumulator out of the measurement
+	const float timeStep = PhysicsWorld::Settings().timeStep;
+	std::chrono::high_resolution_clock::duration elapsed{};
+	for (int step = 1; step <= args.steps; ++step)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		scene.world.Update(timeStep);
+		elapsed += std::chrono::high_resolution_clock::now() - start;
+
+		if (step % args.hashInterval == 0 || step == args.steps)
+			result.hashes.push_back(HashState(scene));
+	}
+	result.seconds = std::chrono::duration<double>(elapsed).count();
+
+	scene.world.Clear();
+	return result;
+}
+
+void PrintResult(const SceneResult& result, int steps)
+{
+	const double particleSteps = static_cast<double>(result.particleCount) * steps;
+	const double constraintSolves = static_cast<double>(result.constraintCount) * result.iterations * steps;
+	printf("%-14s %9zu %9zu %10.2f %12.2f %14.3f  %016llx\n",
+		result.name.c_str(),
+		result.particleCount,
+		result.constraintCount,
+		result.seconds * 1000.0,
+		particleSteps > 0.0 ? result.seconds * 1e9 / particleSteps : 0.0,
+		result.seconds > 0.0 ? constraintSolves / result.seconds / 1e6 : 0.0,
+		static_cast<unsigned long long>(result.hashes.back()));
+}
+
+// Golden file format: one "<scene> <index> <hash>" line per recorded hash
+bool RecordGolden(const char* fileName, const std::vector<SceneResult>& results)
+{
+	std::ofstream file(fileName);
+	if (!file)
+		return false;
+	for (auto& result : results)
+		for (size_t i = 0; i < result.hashes.size(); ++i)
+			file << result.name << ' ' << i << ' ' << std::hex << result.hashes[i] << std::dec << '\n';
+	return true;
+}
+
+int VerifyGolden(const char* fileName, const std::vector<SceneResult>& results)
+{
+	std::ifstream file(fileName);
+	if (!file)
+	{
+		printf("Error: Cannot open golden file %s\n", fileName);
+		return -1;
+	}
+
+	std::map<std::string, std::vector<uint64_t>> golden;
+	std::string name;
+	size_t index;
+	uint64_t hash;
+	while (file >> name >> index >> std::hex >> hash >> std::dec)
+		golden[name].push_back(hash);
+
+	int mismatches = 0;
+	for (auto& result : results)
+	{
+		auto iter = golden.find(result.name);
+		if (iter == golden.end())
+		{
+			printf("%s: not in golden file\n", result.name.c_str());
+			++mismatches;
+			continue;
+		}
+		const auto& expected = iter->second;
+		bool diverged = false;
+		for (size_t i = 0; i < result.hashes.size(); ++i)
+		{
+			if (i >= expected.size() || expected[i] != result.hashes[i])
+			{
+				printf("%s: diverged at hash %zu\n", result.name.c_str(), i);
+				++mismatches;
+				diverged = true;
+				break;
+			}
+		}
+		if (!diverged && expected.size() > result.hashes.size())
+		{
+			printf("%s: golden file has %zu hashes, run produced %zu\n", result.name.c_str(), expected.size(), result.hashes.size());
+			++mismatches;
+		}
+	}
+	printf(mismatches == 0 ? "Replay matches golden file.\n" : "Replay does NOT match golden file.\n");
+	return mismatches;
+}
+
+std::optional<Arguments> ParseArgs(int argc, char* argv[])
+{
+	Arguments args;
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "-steps") == 0 && hasValue)
+			args.steps = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-hash") == 0 && hasValue)
+			args.hashInterval = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-scene") == 0 && hasValue)
+			args.sceneFilter = argv[++i];
+		else if (strcmp(argv[i], "-record") == 0 && hasValue)
+			args.recordFileName = argv[++i];
+		else if (strcmp(argv[i], "-verify") == 0 && hasValue)
+			args.verifyFileName = argv[++i];
+		else
+			return std::nullopt;
+	}
+	if (args.steps <= 0 || args.hashInterval <= 0)
+		return std::nullopt;
+	return args;
+}
+
+void PrintUsage()
+{
+	printf
+	(
+		"== PhysicsBenchmark Help ==\n"
+		"\n"
+		"Usage:\n"
+		"    PhysicsBenchmark.exe [Options]\n"
+		"\n"
+		"Options:\n"
+		"    -steps <n>       Simulation steps per scene (default 600).\n"
+		"    -hash <n>        Steps between state hashes (default 60).\n"
+		"    -scene <name>    Only run the named scene.\n"
+		"    -record <file>   Write state hashes to a golden file.\n"
+		"    -verify <file>   Compare state hashes against a golden file.\n"
+		"\n"
+	);
+}
+
+int main(int argc, char* argv[])
+{
+	const auto argsOpt = ParseArgs(argc, argv);
+	if (!argsOpt.has_value())
+	{
+		PrintUsage();
+		return -1;
+	}
+	const auto& args = argsOpt.value();
+
+	const SceneDesc scenes[] =
+	{
+		{ "ParticleRain", BuildParticleRain },
+		{ "Cloth128", BuildCloth },
+		{ "Ragdolls500", BuildRagdolls },
+		{ "BoxStack", BuildBoxStack },
+		{ "Debris2000", BuildDebris }
+	};
+
+	printf("%-14s %9s %9s %10s %12s %14s  %s\n", "Scene", "Particles", "Constr", "Total ms", "ns/part/step", "M constr/s", "Final hash");
+	std::vector<SceneResult> results;
+	for (auto& scene : scenes)
+	{
+		if (args.sceneFilter && strcmp(args.sceneFilter, scene.name) != 0)
+			continue;
+		results.push_back(RunScene(scene, args));
+		PrintResult(results.back(), args.steps);
+	}
+
+	if (args.recordFileName)
+	{
+		if (!RecordGolden(args.recordFileName, results))
+		{
+			printf("Error: Cannot write golden file %s\n", args.recordFileName);
+			return -1;
+		}
+		printf("Recorded golden file %s\n", args.recordFileName);
+	}
+	if (args.verifyFileName)
+		return VerifyGolden(args.verifyFileName, results) == 0 ? 0 : 1;
+	return 0;
+}
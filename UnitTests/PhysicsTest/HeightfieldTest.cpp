@@ -0,0 +1,227 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi;
+using namespace Angazi::Physics;
+
+namespace
+{
+	// Planar field, height = slope * x
+	void InitializeSlope(Heightfield& heightfield, uint32_t numRows, uint32_t numColumns, float slope)
+	{
+		heightfield.Initialize(numRows, numColumns, 1.0f);
+		for (uint32_t row = 0; row < numRows; ++row)
+			for (uint32_t column = 0; column < numColumns; ++column)
+				heightfield.SetHeight(row, column, slope * column);
+	}
+
+	// Height of the triangles Terrain::GenerateIndices draws, (lb, lt, rb) and (lt, rt, rb)
+	float RenderedHeight(const Heightfield& heightfield, float x, float z)
+	{
+		const float cellSize = heightfield.GetCellSize();
+		const uint32_t column = static_cast<uint32_t>(x / cellSize);
+		const uint32_t row = static_cast<uint32_t>(z / cellSize);
+		const auto vertex = [&](uint32_t c, uint32_t r) { return Math::Vector3(c * cellSize, heightfield.GetSample(r, c), r * cellSize); };
+		const Math::Vector3 lb = vertex(column, row);
+		const Math::Vector3 lt = vertex(column, row + 1);
+		const Math::Vector3 rb = vertex(column + 1, row);
+		const Math::Vector3 rt = vertex(column + 1, row + 1);
+
+		const bool lower = (x - lb.x) + (z - lb.z) <= cellSize;
+		const Math::Vector3 a = lower ? lb : lt;
+		const Math::Vector3 b = lower ? lt : rt;
+		const Math::Vector3 c = rb;
+		const Math::Vector3 n = Math::Cross(b - a, c - a);
+		return a.y - ((n.x * (x - a.x)) + (n.z * (z - a.z))) / n.y;
+	}
+}
+
+namespace PhysicsTest
+{
+	TEST_CLASS(HeightfieldTest)
+	{
+	public:
+		TEST_METHOD(TestGetHeight)
+		{
+			Heightfield heightfield;
+			heightfield.Initialize(3, 3, 2.0f, { 10.0f, 1.0f, 20.0f });
+			heightfield.SetHeight(0, 1, 2.0f);
+			heightfield.SetHeight(1, 0, 4.0f);
+			heightfield.SetHeight(1, 1, 10.0f);
+			heightfield.SetHeight(0, 2, 3.0f);
+			heightfield.SetHeight(2, 2, 7.0f);
+
+			// Samples, offset by the origin
+			Assert::AreEqual(1.0f, heightfield.GetHeight(10.0f, 20.0f));
+			Assert::AreEqual(3.0f, heightfield.GetHeight(12.0f, 20.0f));
+			Assert::AreEqual(11.0f, heightfield.GetHeight(12.0f, 22.0f));
+			Assert::AreEqual(8.0f, heightfield.GetSample(2, 2));
+
+			// Bilinear inside a cell
+			Assert::AreEqual(2.0f, heightfield.GetHeight(11.0f, 20.0f), 1e-5f);
+			Assert::AreEqual(5.0f, heightfield.GetHeight(11.0f, 21.0f), 1e-5f);
+			Assert::AreEqual(4.0f, heightfield.GetHeight(10.5f, 21.0f), 1e-5f);
+
+			// Clamped to the border outside the grid
+			Assert::AreEqual(1.0f, heightfield.GetHeight(0.0f, 0.0f));
+			Assert::AreEqual(8.0f, heightfield.GetHeight(100.0f, 100.0f));
+			Assert::AreEqual(4.0f, heightfield.GetHeight(100.0f, 20.0f));
+			Assert::AreEqual(2.0f, heightfield.GetHeight(11.0f, -5.0f), 1e-5f);
+
+			Assert::IsTrue(heightfield.IsInside(14.0f, 24.0f));
+			Assert::IsFalse(heightfield.IsInside(14.1f, 24.0f));
+			Assert::IsFalse(heightfield.IsInside(9.9f, 20.0f));
+		}
+
+		TEST_METHOD(TestGetNormal)
+		{
+			Heightfield heightfield;
+			heightfield.Initialize(4, 4, 1.0f);
+			Math::Vector3 n = heightfield.GetNormal(1.5f, 1.5f);
+			Assert::AreEqual(0.0f, n.x);
+			Assert::AreEqual(1.0f, n.y);
+			Assert::AreEqual(0.0f, n.z);
+
+			InitializeSlope(heightfield, 4, 4, 0.5f);
+			const Math::Vector3 expected = Math::Normalize({ -0.5f, 1.0f, 0.0f });
+			for (float x : { 0.0f, 0.7f, 2.5f, 3.0f, 10.0f })
+			{
+				n = heightfield.GetNormal(x, 1.2f);
+				Assert::AreEqual(expected.x, n.x, 1e-5f);
+				Assert::AreEqual(expected.y, n.y, 1e-5f);
+				Assert::AreEqual(expected.z, n.z, 1e-5f);
+			}
+		}
+
+		TEST_METHOD(TestGetHeights)
+		{
+			Heightfield heightfield;
+			heightfield.Initialize(9, 17, 0.5f, { -2.0f, 0.0f, -2.0f });
+			for (uint32_t row = 0; row < 9; ++row)
+				for (uint32_t column = 0; column < 17; ++column)
+					heightfield.SetHeight(row, column, Math::RandomFloat(-3.0f, 3.0f));
+
+			// Includes points past every border
+			std::vector<float> x(1000), z(1000), heights(1000);
+			for (size_t i = 0; i < x.size(); ++i)
+			{
+				x[i] = Math::RandomFloat(-4.0f, 9.0f);
+				z[i] = Math::RandomFloat(-4.0f, 5.0f);
+			}
+			heightfield.GetHeights(x.data(), z.data(), heights.data(), x.size());
+			for (size_t i = 0; i < x.size(); ++i)
+				Assert::AreEqual(heightfield.GetHeight(x[i], z[i]), heights[i], 1e-5f);
+		}
+
+		TEST_METHOD(TestSweepRidge)
+		{
+			// Flat ground with a one cell wide ridge at x = 10
+			Heightfield heightfield;
+			heightfield.Initialize(3, 21, 1.0f);
+			for (uint32_t row = 0; row < 3; ++row)
+				heightfield.SetHeight(row, 10, 5.0f);
+
+			// Both ends are above the ground, the ridge is crossed in between
+			float toi = 0.0f;
+			Math::Vector3 normal;
+			Assert::IsTrue(heightfield.GetTimeOfImpact({ 2.0f, 1.0f, 1.0f, 0.25f }, { 16.0f, 0.0f, 0.0f }, toi, normal));
+			Assert::IsTrue(2.0f + (toi * 16.0f) < 10.0f);
+			Assert::IsTrue(normal.x < 0.0f && normal.y > 0.0f);
+
+			Assert::IsTrue(heightfield.GetTimeOfImpact({ 18.0f, 1.0f, 1.0f, 0.25f }, { -16.0f, 0.0f, 0.0f }, toi, normal));
+			Assert::IsTrue(18.0f - (toi * 16.0f) > 10.0f);
+			Assert::IsTrue(normal.x > 0.0f && normal.y > 0.0f);
+
+			// Over the top, alongside it, and off the grid
+			Assert::IsFalse(heightfield.GetTimeOfImpact({ 2.0f, 6.0f, 1.0f, 0.25f }, { 16.0f, 0.0f, 0.0f }, toi, normal));
+			Assert::IsFalse(heightfield.GetTimeOfImpact({ 5.0f, 1.0f, 0.0f, 0.25f }, { 0.0f, 0.0f, 2.0f }, toi, normal));
+			Assert::IsFalse(heightfield.GetTimeOfImpact({ 2.0f, -1.0f, 10.0f, 0.25f }, { 16.0f, 0.0f, 0.0f }, toi, normal));
+		}
+
+		TEST_METHOD(TestSweepTwistedCell)
+		{
+			// One corner raised, so the two diagonals give different surfaces
+			Heightfield heightfield;
+			heightfield.Initialize(2, 2, 1.0f);
+			heightfield.SetHeight(1, 1, 2.0f);
+
+			const float radius = 0.01f;
+			for (const auto& [x, z] : { std::pair{ 0.3f, 0.2f }, std::pair{ 0.8f, 0.7f }, std::pair{ 0.2f, 0.6f }, std::pair{ 0.9f, 0.3f } })
+			{
+				float toi = 0.0f;
+				Math::Vector3 normal;
+				Assert::IsTrue(heightfield.GetTimeOfImpact({ x, 5.0f, z, radius }, { 0.0f, -10.0f, 0.0f }, toi, normal));
+
+				// The center rests one radius along the normal above the drawn triangle
+				const float contactY = 5.0f - (toi * 10.0f) - (radius / normal.y);
+				Assert::AreEqual(RenderedHeight(heightfield, x, z), contactY, 1e-4f);
+			}
+		}
+
+		TEST_METHOD(TestSweepSteepSlope)
+		{
+			Heightfield heightfield;
+			InitializeSlope(heightfield, 3, 5, 2.0f);
+
+			// Contact is at a distance of one radius along the normal, not vertically
+			float toi = 0.0f;
+			Math::Vector3 normal;
+			Assert::IsTrue(heightfield.GetTimeOfImpact({ 1.5f, 10.0f, 1.0f, 0.5f }, { 0.0f, -10.0f, 0.0f }, toi, normal));
+			const float contactY = 3.0f + (0.5f * sqrtf(5.0f));
+			Assert::AreEqual((10.0f - contactY) / 10.0f, toi, 1e-5f);
+			Assert::AreEqual(-2.0f / sqrtf(5.0f), normal.x, 1e-5f);
+			Assert::AreEqual(1.0f / sqrtf(5.0f), normal.y, 1e-5f);
+		}
+
+		TEST_METHOD(TestRestingOnSlope)
+		{
+			Heightfield heightfield;
+			InitializeSlope(heightfield, 5, 9, 0.5f);
+			const Math::Vector3 n = heightfield.GetNormal(0.0f, 0.0f);
+			const float radius = 0.25f;
+			const Math::Vector3 start = Math::Vector3(6.0f, heightfield.GetHeight(6.0f, 2.0f), 2.0f) + (n * radius);
+
+			// Full drag holds it in place
+			PhysicsWorld::Settings settings;
+			settings.drag = 1.0f;
+			PhysicsWorld world;
+			world.Initialize(settings);
+			world.AddStaticHeightfield(&heightfield);
+
+			auto particle = new Particle();
+			particle->SetPosition(start);
+			particle->radius = radius;
+			particle->bounce = 0.0f;
+			world.AddParticles(particle);
+
+			for (int i = 0; i < 60; ++i)
+				world.Update(settings.timeStep);
+			Math::Vector3 position = world.GetParticlePosition(0);
+			Assert::AreEqual(start.x, position.x, 1e-4f);
+			Assert::AreEqual(start.y, position.y, 1e-4f);
+			Assert::AreEqual(start.z, position.z, 1e-4f);
+			world.Clear(true);
+
+			// Without drag it slides downhill and stays one radius off the surface
+			settings.drag = 0.0f;
+			world.Initialize(settings);
+			particle = new Particle();
+			particle->SetPosition(start);
+			particle->radius = radius;
+			particle->bounce = 0.0f;
+			world.AddParticles(particle);
+
+			for (int i = 0; i < 30; ++i)
+			{
+				world.Update(settings.timeStep);
+				position = world.GetParticlePosition(0);
+				const float distance = (position.y - heightfield.GetHeight(position.x, position.z)) * n.y;
+				Assert::AreEqual(radius, distance, 1e-3f);
+			}
+			Assert::IsTrue(position.x < start.x - 0.1f);
+			Assert::AreEqual(start.z, position.z, 1e-4f);
+			world.Clear();
+		}
+	};
+}
@@ -0,0 +1,201 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Angazi;
+using namespace Angazi::Physics;
+
+namespace
+{
+	PhysicsWorld::Settings ClusterSettings()
+	{
+		PhysicsWorld::Settings settings;
+		settings.gravity = Math::Vector3::Zero;
+		settings.timeStep = 1.0f;
+		return settings;
+	}
+
+	std::vector<Particle*> AddParticles(PhysicsWorld& world, const std::vector<Math::Vector3>& positions)
+	{
+		std::vector<Particle*> particles;
+		for (auto& position : positions)
+		{
+			auto particle = new Particle();
+			particle->SetPosition(position);
+			world.AddParticles(particle);
+			particles.push_back(particle);
+		}
+		return particles;
+	}
+
+	Math::Vector3 Center(const std::vector<Math::Vector3>& positions)
+	{
+		Math::Vector3 center = Math::Vector3::Zero;
+		for (auto& position : positions)
+			center += position;
+		return center / static_cast<float>(positions.size());
+	}
+
+	// Rigid when every pairwise distance matches the rest shape
+	void CheckRestShape(const std::vector<Math::Vector3>& rest, const std::vector<Particle*>& particles, float tolerance)
+	{
+		for (size_t i = 0; i < rest.size(); ++i)
+		{
+			for (size_t j = i + 1; j < rest.size(); ++j)
+			{
+				const float current = Math::Magnitude(particles[i]->position - particles[j]->position);
+				Assert::AreEqual(Math::Magnitude(rest[i] - rest[j]), current, tolerance);
+			}
+		}
+	}
+
+	void AreNear(const Math::Quaternion& expected, const Math::Quaternion& actual, float tolerance)
+	{
+		const float sign = Math::Dot(expected, actual) < 0.0f ? -1.0f : 1.0f;
+		Assert::AreEqual(expected.x, actual.x * sign, tolerance);
+		Assert::AreEqual(expected.y, actual.y * sign, tolerance);
+		Assert::AreEqual(expected.z, actual.z * sign, tolerance);
+		Assert::AreEqual(expected.w, actual.w * sign, tolerance);
+	}
+}
+
+namespace PhysicsTest
+{
+	TEST_CLASS(PhysicsWorldTest)
+	{
+	public:
+		TEST_METHOD(TestInterpolationAfterContact)
+		{
+			PhysicsWorld::Settings settings;
+			settings.gravity = { 0.0f, -1.0f, 0.0f };
+			settings.timeStep = 1.0f;
+
+			PhysicsWorld world;
+			world.Initialize(settings);
+			world.AddStaticPlane({ Math::Vector3::YAxis, 0.0f });
+
+			// Sliding along the ground, gravity pushes it into the plane every step
+			auto particle = new Particle();
+			particle->SetPosition({ 0.0f, 0.1f, 0.0f });
+			particle->SetVelocity({ 1.0f, 0.0f, 0.0f });
+			particle->radius = 0.1f;
+			particle->bounce = 0.0f;
+			world.AddParticles(particle);
+
+			world.Update(1.5f);
+			Assert::AreEqual(0.5f, world.GetInterpolationAlpha(), 1e-6f);
+
+			const Math::Vector3 position = world.GetParticlePosition(0);
+			Assert::AreEqual(1.0f, position.x, 1e-5f);
+			Assert::AreEqual(0.1f, position.y, 1e-5f);
+
+			const Math::Vector3 interpolated = world.GetInterpolatedParticlePosition(0);
+			Assert::AreEqual(0.5f, interpolated.x, 1e-5f);
+			Assert::AreEqual(0.1f, interpolated.y, 1e-5f);
+
+			world.Clear();
+		}
+
+		TEST_METHOD(TestRigidClusterRecoversShape)
+		{
+			PhysicsWorld world;
+			world.Initialize(ClusterSettings());
+
+			const std::vector<Math::Vector3> rest = { { 0.0f, 0.0f, 0.0f }, { 2.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 3.0f }, { 1.0f, 1.0f, 1.0f } };
+			const std::vector<Particle*> particles = AddParticles(world, rest);
+			auto cluster = new RigidCluster(particles);
+			world.AddConstraint(cluster);
+
+			// Rotate and move the cluster, then deform it a little
+			const Math::Quaternion rotation = Math::Quaternion::RotationAxis(Math::Normalize({ 1.0f, 2.0f, 3.0f }), 0.7f);
+			const Math::Matrix4 matRot = Math::Matrix4::RotationQuaternion(rotation);
+			const Math::Vector3 restCenter = Center(rest);
+			const Math::Vector3 offset{ 5.0f, -2.0f, 1.0f };
+			for (size_t i = 0; i < rest.size(); ++i)
+			{
+				const Math::Vector3 noise{ 0.02f * ((i % 3) - 1.0f), -0.01f * (i % 2), 0.015f * ((i % 4) - 1.5f) };
+				particles[i]->SetPosition(restCenter + offset + Math::TransformNormal(rest[i] - restCenter, matRot) + noise);
+			}
+
+			world.Update(1.0f);
+
+			CheckRestShape(rest, particles, 1e-4f);
+			AreNear(rotation, cluster->GetRotation(), 0.01f);
+
+			// Goals are the rest offsets under the recovered rotation
+			const Math::Matrix4 recovered = Math::Matrix4::RotationQuaternion(cluster->GetRotation());
+			Math::Vector3 center = Math::Vector3::Zero;
+			for (auto p : particles)
+				center += p->position;
+			center /= static_cast<float>(particles.size());
+			for (size_t i = 0; i < rest.size(); ++i)
+			{
+				const Math::Vector3 goal = center + Math::TransformNormal(rest[i] - restCenter, recovered);
+				Assert::AreEqual(goal.x, particles[i]->position.x, 1e-4f);
+				Assert::AreEqual(goal.y, particles[i]->position.y, 1e-4f);
+				Assert::AreEqual(goal.z, particles[i]->position.z, 1e-4f);
+			}
+
+			world.Clear();
+		}
+
+		TEST_METHOD(TestRigidClusterPinned)
+		{
+			PhysicsWorld world;
+			world.Initialize(ClusterSettings());
+
+			const std::vector<Math::Vector3> rest = { { 0.0f, 5.0f, 0.0f }, { 1.0f, 5.0f, 0.0f }, { 0.0f, 5.0f, 1.0f }, { 1.0f, 6.0f, 1.0f } };
+			const std::vector<Particle*> particles = AddParticles(world, rest);
+			particles[0]->invMass = 0.0f;
+			world.AddConstraint(new RigidCluster(particles));
+
+			// Drag the free members away, the cluster has to rebuild around the pinned one
+			for (size_t i = 1; i < particles.size(); ++i)
+				particles[i]->SetPosition(rest[i] + Math::Vector3{ 0.5f, -1.0f, 0.25f * i });
+
+			for (int i = 0; i < 10; ++i)
+				world.Update(1.0f);
+
+			Assert::AreEqual(rest[0].x, particles[0]->position.x);
+			Assert::AreEqual(rest[0].y, particles[0]->position.y);
+			Assert::AreEqual(rest[0].z, particles[0]->position.z);
+			CheckRestShape(rest, particles, 0.01f);
+
+			world.Clear();
+		}
+
+		TEST_METHOD(TestRigidClusterCollinear)
+		{
+			PhysicsWorld world;
+			world.Initialize(ClusterSettings());
+
+			// Almost a line, the rotation about it is barely constrained
+			const std::vector<Math::Vector3> rest = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0001f, 0.0f }, { 2.0f, 0.0f, 0.0f }, { 3.0f, 0.0f, 0.0001f } };
+			const std::vector<Particle*> particles = AddParticles(world, rest);
+			auto cluster = new RigidCluster(particles);
+			world.AddConstraint(cluster);
+
+			const Math::Quaternion rotation = Math::Quaternion::RotationAxis(Math::Normalize({ 0.3f, 0.2f, 1.0f }), 2.5f);
+			const Math::Matrix4 matRot = Math::Matrix4::RotationQuaternion(rotation);
+			const Math::Vector3 restCenter = Center(rest);
+			for (size_t i = 0; i < rest.size(); ++i)
+				particles[i]->SetPosition(restCenter + Math::TransformNormal(rest[i] - restCenter, matRot));
+
+			world.Update(1.0f);
+
+			const Math::Quaternion& q = cluster->GetRotation();
+			Assert::IsTrue(std::isfinite(q.x) && std::isfinite(q.y) && std::isfinite(q.z) && std::isfinite(q.w));
+			Assert::AreEqual(1.0f, Math::Magnitude(q), 1e-4f);
+			for (auto p : particles)
+				Assert::IsTrue(std::isfinite(p->position.x) && std::isfinite(p->position.y) && std::isfinite(p->position.z));
+			CheckRestShape(rest, particles, 1e-3f);
+
+			// The line itself ends up where it was moved to
+			const Math::Vector3 expected = Math::TransformNormal(Math::Vector3::XAxis, matRot);
+			const Math::Vector3 actual = Math::Normalize(particles[3]->position - particles[0]->position);
+			Assert::IsTrue(Math::Dot(expected, actual) > 0.999f);
+
+			world.Clear();
+		}
+	};
+}
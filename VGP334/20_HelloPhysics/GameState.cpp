@@ -76,9 +76,10 @@ void GameState::Update(float deltaTime)
 	mPhysicsWorld.Update(deltaTime);
 	if (usingClothTexture && mMesh.vertices.size() == mParticles.size() )
 	{
+		const float alpha = mPhysicsWorld.GetInterpolationAlpha();
 		for (size_t i = 0; i < mParticles.size(); i++)
 		{
-			mMesh.vertices[i].position = mParticles[i]->position;
+			mMesh.vertices[i].position = mParticles[i]->GetInterpolatedPosition(alpha);
 		}
 	}
 